@@ -45,6 +45,38 @@ class PrinterController extends ChangeNotifier {
       return;
     }
 
+    // Linux (/dev/usb/lp*): papel y online según el driver, al instante y
+    // sin escribir en la impresora aunque esté imprimiendo.
+    final port = await _plugin.readUsbPortStatus();
+    if (port != null) {
+      _update((s) => s.copyWith(
+            enLineaUsb: port.online && !port.error,
+            papelPresenteUsb: !port.paperOut,
+          ));
+    }
+
+    // Linux: las tres consultas en una sola escritura y una sola lectura.
+    final status = await _plugin.queryStatusUsb(queries: const [
+      PrinterStatusQuery.printer,
+      PrinterStatusQuery.paper,
+      PrinterStatusQuery.offlineCause,
+    ]);
+    if (status.answered) {
+      _addLog('[USB] RSP queryStatus: ${status.replies}');
+      _update((s) => s.copyWith(
+            enLineaUsb: status.offline == false && status.errorOccurred != true,
+            tapaAbiertaUsb: status.coverOpen ?? s.tapaAbiertaUsb,
+            papelPorAcabarseUsb: status.paperEnd == true
+                ? false
+                : status.paperNearEnd ?? s.papelPorAcabarseUsb,
+            papelPresenteUsb: status.paperEnd == null
+                ? s.papelPresenteUsb
+                : !status.paperEnd!,
+          ));
+      return;
+    }
+
+    // Sin queryStatusUsb (Windows) o sin respuesta: una consulta por vez.
     final generator = await _getStatusGenerator();
 
     bool enLinea = _state.enLineaUsb;
@@ -319,6 +351,12 @@ class PrinterController extends ChangeNotifier {
     if (!result) {
       throw Exception('No se pudo abrir el puerto USB seleccionado');
     }
+
+    // La primera vez que se abre esta impresora el plugin la mide; después
+    // sale del perfil guardado.
+    _plugin.getUsbCapabilities().then((caps) {
+      if (caps != null) _addLog('[USB] $caps');
+    });
   }
 
   Future<void> closeUsbPort() async {
@@ -14,6 +14,10 @@ class KnownUsbPrinter {
   });
 
   bool matches(int queryVid, int queryPid) => vid == queryVid && pid == queryPid;
+
+  /// true si imprime imágenes en el modo raster de Star
+  /// (`rasterizeImage(star: true)`); `printImageUsb` lo elige solo.
+  bool get starRaster => protocol.split('/').contains('starprnt');
 }
 
 const knownThermalUsbPrinters = <KnownUsbPrinter>[
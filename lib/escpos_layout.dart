@@ -0,0 +1,34 @@
+/// Alineación de una columna de `layoutRow`.
+enum EscPosRowAlign { left, center, right }
+
+/// Columna de una fila armada en la capa nativa (`layoutRow`).
+///
+/// El ancho va en doceavos de la línea, como `PosColumn`. El texto se mide
+/// en celdas de pantalla: los caracteres chinos/japoneses/coreanos ocupan
+/// dos y las marcas combinantes ninguna; lo que no entra sigue abajo.
+class EscPosRowColumn {
+  const EscPosRowColumn(
+    this.text, {
+    this.width = 12,
+    this.align = EscPosRowAlign.left,
+    this.scale = 1,
+  }) : assert(width >= 1 && width <= 12),
+       assert(scale >= 1 && scale <= 8);
+
+  final String text;
+
+  /// Doceavos de la línea (1..12).
+  final int width;
+
+  final EscPosRowAlign align;
+
+  /// Multiplicador de ancho y alto (GS !) sólo para esta columna.
+  final int scale;
+
+  Map<String, Object> toMap() => {
+        'text': text,
+        'width': width,
+        'align': align.index,
+        'scale': scale,
+      };
+}
@@ -0,0 +1,53 @@
+import 'dart:typed_data';
+
+/// Resultado de `optimizeEscPos`: el stream sin comandos redundantes y
+/// cuánto se ahorró.
+class EscPosOptimizeResult {
+  /// Comandos listos para enviar; imprimen exactamente lo mismo que el
+  /// original.
+  final Uint8List data;
+  final int inputBytes;
+  final int outputBytes;
+
+  /// Cambios de estilo/alineación que no llegaron a la salida.
+  final int droppedCommands;
+
+  /// `LF` / `ESC d` absorbidos por el avance anterior.
+  final int mergedFeeds;
+
+  const EscPosOptimizeResult({
+    required this.data,
+    required this.inputBytes,
+    required this.outputBytes,
+    required this.droppedCommands,
+    required this.mergedFeeds,
+  });
+
+  /// Resultado sin optimizar (plataforma no soportada o error nativo).
+  factory EscPosOptimizeResult.unchanged(Uint8List data) {
+    return EscPosOptimizeResult(
+      data: data,
+      inputBytes: data.length,
+      outputBytes: data.length,
+      droppedCommands: 0,
+      mergedFeeds: 0,
+    );
+  }
+
+  factory EscPosOptimizeResult.fromMap(Map<String, dynamic> map) {
+    return EscPosOptimizeResult(
+      data: map['data'] as Uint8List,
+      inputBytes: map['inputBytes'] as int,
+      outputBytes: map['outputBytes'] as int,
+      droppedCommands: map['droppedCommands'] as int,
+      mergedFeeds: map['mergedFeeds'] as int,
+    );
+  }
+
+  int get savedBytes => inputBytes - outputBytes;
+
+  @override
+  String toString() =>
+      'EscPosOptimizeResult($inputBytes -> $outputBytes bytes, '
+      'dropped=$droppedCommands, mergedFeeds=$mergedFeeds)';
+}
@@ -0,0 +1,8 @@
+/// Formato de la imagen que devuelve `renderEscPos`.
+enum EscPosPreviewFormat {
+  /// PNG en grises de 1 bit; sirve para `Image.memory` y para tests golden.
+  png,
+
+  /// PBM binario (P4), el formato más simple para comparar o procesar.
+  pbm,
+}
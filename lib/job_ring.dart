@@ -0,0 +1,195 @@
+import 'dart:async';
+import 'dart:ffi';
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+/// Avance del ring de trabajos, emitido por la capa nativa cada vez que un
+/// tramo terminó de escribirse en la impresora.
+class JobRingProgress {
+  /// Total de bytes ya escritos en el dispositivo desde que se abrió el ring.
+  final int consumed;
+
+  /// `errno` del fallo (0 si ok). Después de un error el ring no avanza más.
+  final int error;
+
+  const JobRingProgress({required this.consumed, required this.error});
+
+  factory JobRingProgress.fromMap(Map<String, dynamic> map) {
+    return JobRingProgress(
+      consumed: map['consumed'] as int,
+      error: map['error'] as int,
+    );
+  }
+
+  @override
+  String toString() => 'consumed=$consumed error=$error';
+}
+
+typedef _DataNative = Pointer<Uint8> Function(Pointer<Void>);
+typedef _CountNative = Uint64 Function(Pointer<Void>);
+typedef _Count = int Function(Pointer<Void>);
+typedef _ErrorNative = Int32 Function(Pointer<Void>);
+typedef _CommitNative = Int32 Function(Pointer<Void>, Uint64);
+typedef _Commit = int Function(Pointer<Void>, int);
+
+/// Funciones de `job_ring.cc`. Son llamadas "leaf": no vuelven al event
+/// loop ni reservan memoria, cuestan lo mismo que una llamada a C.
+class _JobRingBindings {
+  final Pointer<Uint8> Function(Pointer<Void>) data;
+  final _Count capacity;
+  final _Count writable;
+  final _Count consumed;
+  final _Count error;
+  final _Commit commit;
+
+  _JobRingBindings(DynamicLibrary library)
+      : data = library.lookupFunction<_DataNative, _DataNative>(
+            'ti_job_ring_data',
+            isLeaf: true),
+        capacity = library.lookupFunction<_CountNative, _Count>(
+            'ti_job_ring_capacity',
+            isLeaf: true),
+        writable = library.lookupFunction<_CountNative, _Count>(
+            'ti_job_ring_writable',
+            isLeaf: true),
+        consumed = library.lookupFunction<_CountNative, _Count>(
+            'ti_job_ring_consumed',
+            isLeaf: true),
+        error = library.lookupFunction<_ErrorNative, _Count>(
+            'ti_job_ring_error',
+            isLeaf: true),
+        commit = library.lookupFunction<_CommitNative, _Commit>(
+            'ti_job_ring_commit',
+            isLeaf: true);
+}
+
+/// Ring de bytes en memoria nativa para mandar datos a la impresora USB sin
+/// pasar por el `MethodChannel`.
+///
+/// Los bytes se copian directamente en la memoria del ring y se publican
+/// con una llamada FFI; un hilo nativo los pasa al escritor de la impresora
+/// sin volver a copiarlos. No hay un mensaje por envío ni memoria reservada
+/// por envío: sirve para streams continuos (etiquetas una tras otra).
+///
+/// El hilo corta los tramos en límites de comando y, entre tramo y tramo,
+/// el plugin intercala las consultas de estado. Un comando publicado a
+/// medias (el ring se llenó en el medio) espera en el ring hasta que llegue
+/// el resto; un solo comando más grande que [capacity] deja el ring en
+/// error (`EMSGSIZE`).
+///
+/// Un solo isolate debe escribir en el ring. Después de [close] el objeto
+/// no se puede usar.
+class JobRing {
+  final Pointer<Void> _ring;
+  final _JobRingBindings _native;
+  final Future<bool> Function() _close;
+  late final StreamSubscription<JobRingProgress> _events;
+
+  /// Vista de la memoria del ring mapeada dos veces seguidas: cualquier
+  /// tramo de hasta [capacity] bytes es contiguo.
+  final Uint8List _view;
+
+  /// Tamaño del ring en bytes.
+  final int capacity;
+
+  int _head = 0;
+  bool _closed = false;
+  Completer<void>? _waiter;
+
+  JobRing._(this._ring, this._native, this.capacity, this._close,
+      Stream<JobRingProgress> events)
+      : _view = _native.data(_ring).asTypedList(2 * capacity) {
+    _events = events.listen((_) => _wake(), onError: (_) => _wake());
+  }
+
+  /// Se conecta al ring que devolvió `openUsbJobRing` en [address]. Los
+  /// símbolos se buscan en el proceso: el plugin ya está cargado.
+  factory JobRing.attach(int address,
+      {required Stream<JobRingProgress> events,
+      required Future<bool> Function() close}) {
+    final native = _JobRingBindings(DynamicLibrary.process());
+    final ring = Pointer<Void>.fromAddress(address);
+    return JobRing._(ring, native, native.capacity(ring), close, events);
+  }
+
+  /// Bytes ya escritos en el dispositivo desde que se abrió el ring.
+  int get consumed => _closed ? _head : _native.consumed(_ring);
+
+  /// Bytes publicados que todavía no se escribieron.
+  int get pending => _head - consumed;
+
+  /// `errno` del último fallo (0 si el ring está sano). Después de un error
+  /// hay que cerrar el ring y abrir otro.
+  int get error => _closed ? 0 : _native.error(_ring);
+
+  /// Espacio contiguo para escribir hasta [length] bytes directamente en el
+  /// ring; después se publican con [commit]. La lista puede ser más corta
+  /// (o vacía) si el ring está lleno.
+  Uint8List reserve(int length) {
+    if (_closed) return Uint8List(0);
+    final free = math.min(length, _native.writable(_ring));
+    final offset = _head % capacity;
+    return Uint8List.sublistView(_view, offset, offset + free);
+  }
+
+  /// Publica los próximos [length] bytes escritos con [reserve]. Devuelve
+  /// `false` sin publicar nada si [length] es más de lo que había libre.
+  bool commit(int length) {
+    if (_closed || length < 0) return false;
+    if (length == 0) return true;
+    if (_native.commit(_ring, length) != 0) return false;
+    _head += length;
+    return true;
+  }
+
+  /// Copia [bytes] al ring, esperando espacio si está lleno. Termina cuando
+  /// los bytes están en el ring, no en la impresora (para eso, [flush]).
+  /// Devuelve `false` si el ring falló o se cerró.
+  Future<bool> write(Uint8List bytes) async {
+    var offset = 0;
+    while (offset < bytes.length) {
+      if (_closed || error != 0) return false;
+      final free = _native.writable(_ring);
+      if (free == 0) {
+        await _progress();
+        continue;
+      }
+      final length = math.min(free, bytes.length - offset);
+      final at = _head % capacity;
+      _view.setRange(at, at + length, bytes, offset);
+      if (!commit(length)) return false;
+      offset += length;
+    }
+    return true;
+  }
+
+  /// Espera a que todo lo publicado esté escrito en la impresora. Devuelve
+  /// `false` si el ring falló o se cerró antes.
+  Future<bool> flush() async {
+    while (!_closed && error == 0) {
+      if (consumed >= _head) return true;
+      await _progress();
+    }
+    return false;
+  }
+
+  /// Libera el ring. Lo publicado que no llegó a pasar al escritor se
+  /// descarta: llamar a [flush] antes para no perderlo.
+  Future<bool> close() async {
+    if (_closed) return true;
+    _closed = true;
+    _wake();
+    await _events.cancel();
+    return _close();
+  }
+
+  Future<void> _progress() {
+    return (_waiter ??= Completer<void>()).future;
+  }
+
+  void _wake() {
+    final waiter = _waiter;
+    _waiter = null;
+    waiter?.complete();
+  }
+}
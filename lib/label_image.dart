@@ -0,0 +1,36 @@
+import 'database_printer.dart' show lookupPrinterInfo;
+
+/// Lenguaje y compresión de la etiqueta que arma `encodeLabelImage`.
+///
+/// El índice coincide con el valor que espera la capa nativa.
+enum LabelImageFormat {
+  /// ZPL `^GFA` con la compresión ASCII de ZPL (runs y filas repetidas).
+  /// La entiende cualquier impresora Zebra con ZPL II.
+  zplAscii,
+
+  /// ZPL `^GFA` con `:Z64:` (deflate + base64). Comprime mejor las imágenes
+  /// con trama, pero requiere firmware reciente; si el plugin se compiló
+  /// sin zlib sale como [zplAscii].
+  zplZ64,
+
+  /// TSPL `BITMAP` (TSC, Gprinter y compatibles), en binario.
+  tspl;
+
+  /// Formato para el `protocol` de [knownThermalUsbPrinters] (`zpl`,
+  /// `zpl/epl`, `tspl`, `escpos/tspl`...), o `null` si la impresora no
+  /// habla un lenguaje de etiquetas. Para ZPL elige [zplAscii], que
+  /// funciona en todos los firmwares.
+  static LabelImageFormat? forProtocol(String protocol) {
+    final languages = protocol.split('/');
+    if (languages.contains('zpl')) return LabelImageFormat.zplAscii;
+    if (languages.contains('tspl')) return LabelImageFormat.tspl;
+    return null;
+  }
+
+  /// Igual que [forProtocol], a partir del VID/PID de una impresora USB
+  /// conocida.
+  static LabelImageFormat? forDevice(int vid, int pid) {
+    final known = lookupPrinterInfo(vid, pid);
+    return known == null ? null : forProtocol(known.protocol);
+  }
+}
@@ -0,0 +1,52 @@
+/// Clase de prioridad de un trabajo enviado al scheduler multi-impresora.
+///
+/// El índice coincide con el valor que espera la capa nativa.
+enum PrintJobPriority {
+  /// Comandas de cocina u otros tickets que no pueden esperar.
+  urgent,
+
+  /// Tickets de venta.
+  normal,
+
+  /// Reimpresiones, reportes y todo lo que puede ir al final.
+  low,
+}
+
+/// Estado de la cola de un dispositivo registrado en el scheduler.
+class PrinterQueueStats {
+  final String deviceId;
+  final String group;
+  final bool online;
+  final int queuedJobs;
+  final int queuedBytes;
+
+  /// Throughput medido en bytes/s (promedio exponencial).
+  final double throughput;
+  final int completedJobs;
+
+  const PrinterQueueStats({
+    required this.deviceId,
+    required this.group,
+    required this.online,
+    required this.queuedJobs,
+    required this.queuedBytes,
+    required this.throughput,
+    required this.completedJobs,
+  });
+
+  factory PrinterQueueStats.fromMap(Map<String, dynamic> map) {
+    return PrinterQueueStats(
+      deviceId: map['deviceId'] as String,
+      group: map['group'] as String,
+      online: map['online'] as bool,
+      queuedJobs: map['queuedJobs'] as int,
+      queuedBytes: map['queuedBytes'] as int,
+      throughput: (map['throughput'] as num).toDouble(),
+      completedJobs: map['completedJobs'] as int,
+    );
+  }
+
+  @override
+  String toString() =>
+      '$deviceId [$group] online=$online jobs=$queuedJobs bytes=$queuedBytes';
+}
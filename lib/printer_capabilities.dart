@@ -0,0 +1,72 @@
+/// Lo que contestó la impresora al probe de capacidades (`GS I`,
+/// `GS ( L`, `GS ( k`, `GS a`).
+///
+/// El plugin lo mide una sola vez por impresora (VID/PID + serial) y lo
+/// guarda en disco; las sesiones siguientes lo leen sin volver a preguntar.
+class PrinterCapabilities {
+  /// `true` si contestó al menos a `GS I`. Si es `false`, el resto de los
+  /// campos no dice nada (impresora apagada o que no entiende `GS I`).
+  final bool answered;
+
+  /// `GS I 1`, `GS I 2` y `GS I 3`; -1 sin respuesta.
+  final int modelId;
+  final int typeId;
+  final int romVersion;
+
+  /// `GS I 65`, `66` y `67`; vacíos sin respuesta.
+  final String firmware;
+  final String maker;
+  final String model;
+
+  /// Contesta `GS ( L`: las imágenes salen por `GS ( L` en lugar de `GS v 0`.
+  final bool graphics;
+
+  /// Contesta `GS ( k`: códigos QR/PDF417 nativos.
+  final bool symbols;
+
+  /// Envía Automatic Status Back (`GS a`).
+  final bool autoStatusBack;
+
+  /// Cuándo se midió.
+  final DateTime probedAt;
+
+  const PrinterCapabilities({
+    required this.answered,
+    this.modelId = -1,
+    this.typeId = -1,
+    this.romVersion = -1,
+    this.firmware = '',
+    this.maker = '',
+    this.model = '',
+    this.graphics = false,
+    this.symbols = false,
+    this.autoStatusBack = false,
+    required this.probedAt,
+  });
+
+  factory PrinterCapabilities.fromMap(Map<String, dynamic> map) {
+    return PrinterCapabilities(
+      answered: map['answered'] as bool,
+      modelId: map['modelId'] as int? ?? -1,
+      typeId: map['typeId'] as int? ?? -1,
+      romVersion: map['romVersion'] as int? ?? -1,
+      firmware: map['firmware'] as String? ?? '',
+      maker: map['maker'] as String? ?? '',
+      model: map['model'] as String? ?? '',
+      graphics: map['graphics'] as bool? ?? false,
+      symbols: map['symbols'] as bool? ?? false,
+      autoStatusBack: map['autoStatusBack'] as bool? ?? false,
+      probedAt: DateTime.fromMillisecondsSinceEpoch(
+          (map['probedAt'] as int? ?? 0) * 1000),
+    );
+  }
+
+  /// `GS I 2` bit 1: tiene cortador automático. `null` si no contestó.
+  bool? get hasCutter => typeId < 0 ? null : (typeId & 0x02) != 0;
+
+  @override
+  String toString() => answered
+      ? 'PrinterCapabilities($maker $model, firmware $firmware, '
+          'graphics: $graphics, symbols: $symbols, asb: $autoStatusBack)'
+      : 'PrinterCapabilities(sin respuesta)';
+}
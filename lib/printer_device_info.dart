@@ -1,4 +1,5 @@
-import 'database_printer.dart' show lookupPrinterInfo;
+import 'database_printer.dart'
+    show knownThermalUsbPrinters, lookupPrinterInfo;
 
 class PrinterDeviceInfo {
   final String instanceId;
@@ -6,7 +7,29 @@ class PrinterDeviceInfo {
   final int vid;
   final int pid;
 
+  /// IEEE 1284 device ID que informa la impresora (Linux, `/dev/usb/lp*`);
+  /// vacío si no hay.
+  final String deviceId;
+
+  /// Fabricante y modelo según [deviceId].
+  final String manufacturer;
+  final String model;
+
+  /// Lenguajes que declara la impresora en [deviceId], con los mismos
+  /// nombres que `KnownUsbPrinter.protocol` (`escpos`, `starprnt`, `zpl`,
+  /// `epl`, `tspl`). Vacío si no se sabe: usar la tabla por VID/PID.
+  final String protocol;
+
+  /// Protocolo según la propia impresora o, si no lo informa, según
+  /// [knownThermalUsbPrinters]. `null` si no se conoce.
+  String? get resolvedProtocol {
+    if (protocol.isNotEmpty) return protocol;
+    return lookupPrinterInfo(vid, pid)?.protocol;
+  }
+
   String get resolvedDisplayName {
+    // El modelo que informa la impresora es más preciso que la tabla.
+    if (model.isNotEmpty) return displayName;
     if (vid <= 0 && pid <= 0) return displayName;
 
     final known = lookupPrinterInfo(vid, pid);
@@ -22,6 +45,10 @@ class PrinterDeviceInfo {
     required this.displayName,
     required this.vid,
     required this.pid,
+    this.deviceId = '',
+    this.manufacturer = '',
+    this.model = '',
+    this.protocol = '',
   });
 
   factory PrinterDeviceInfo.fromMap(Map<String, dynamic> map) {
@@ -30,6 +57,10 @@ class PrinterDeviceInfo {
       displayName: map['displayName'] as String,
       vid: map['vid'] as int,
       pid: map['pid'] as int,
+      deviceId: map['deviceId'] as String? ?? '',
+      manufacturer: map['manufacturer'] as String? ?? '',
+      model: map['model'] as String? ?? '',
+      protocol: map['protocol'] as String? ?? '',
     );
   }
 
@@ -38,6 +69,10 @@ class PrinterDeviceInfo {
         'displayName': displayName,
         'vid': vid,
         'pid': pid,
+        'deviceId': deviceId,
+        'manufacturer': manufacturer,
+        'model': model,
+        'protocol': protocol,
       };
 
   @override
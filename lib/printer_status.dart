@@ -0,0 +1,142 @@
+/// Consulta DLE EOT n de `queryStatusUsb` / `queryStatusTcp`.
+enum PrinterStatusQuery {
+  /// DLE EOT 1: estado de la impresora (online, cajón, botón FEED).
+  printer(1),
+
+  /// DLE EOT 2: causa de offline (tapa, fin de papel, error).
+  offlineCause(2),
+
+  /// DLE EOT 3: causa de error (cortador, errores recuperables o no).
+  errorCause(3),
+
+  /// DLE EOT 4: sensor del rollo de papel.
+  paper(4);
+
+  /// El `n` del comando.
+  final int n;
+
+  const PrinterStatusQuery(this.n);
+}
+
+/// Estado decodificado de varias consultas DLE EOT enviadas juntas.
+///
+/// Cada campo es `null` si su consulta no se pidió o la impresora no la
+/// contestó a tiempo.
+class PrinterStatus {
+  /// Byte crudo de cada consulta contestada, por `n`.
+  final Map<int, int> replies;
+
+  // DLE EOT 1
+  final bool? drawerOpen;
+  final bool? offline;
+  final bool? waitingOnlineRecovery;
+  final bool? feedButtonPressed;
+
+  // DLE EOT 2
+  final bool? coverOpen;
+  final bool? feedingByButton;
+  final bool? paperEndStop;
+  final bool? errorOccurred;
+
+  // DLE EOT 3
+  final bool? recoverableError;
+  final bool? cutterError;
+  final bool? unrecoverableError;
+  final bool? autoRecoverableError;
+
+  // DLE EOT 4
+  final bool? paperNearEnd;
+  final bool? paperEnd;
+
+  const PrinterStatus({
+    this.replies = const {},
+    this.drawerOpen,
+    this.offline,
+    this.waitingOnlineRecovery,
+    this.feedButtonPressed,
+    this.coverOpen,
+    this.feedingByButton,
+    this.paperEndStop,
+    this.errorOccurred,
+    this.recoverableError,
+    this.cutterError,
+    this.unrecoverableError,
+    this.autoRecoverableError,
+    this.paperNearEnd,
+    this.paperEnd,
+  });
+
+  /// Sin respuesta (puerto cerrado, impresora apagada o plataforma sin
+  /// soporte).
+  static const PrinterStatus empty = PrinterStatus();
+
+  factory PrinterStatus.fromMap(Map<String, dynamic> map) {
+    final replies = Map<dynamic, dynamic>.from(map['replies'] as Map? ?? {});
+    return PrinterStatus(
+      replies: replies.map((k, v) => MapEntry(k as int, v as int)),
+      drawerOpen: map['drawerOpen'] as bool?,
+      offline: map['offline'] as bool?,
+      waitingOnlineRecovery: map['waitingOnlineRecovery'] as bool?,
+      feedButtonPressed: map['feedButtonPressed'] as bool?,
+      coverOpen: map['coverOpen'] as bool?,
+      feedingByButton: map['feedingByButton'] as bool?,
+      paperEndStop: map['paperEndStop'] as bool?,
+      errorOccurred: map['errorOccurred'] as bool?,
+      recoverableError: map['recoverableError'] as bool?,
+      cutterError: map['cutterError'] as bool?,
+      unrecoverableError: map['unrecoverableError'] as bool?,
+      autoRecoverableError: map['autoRecoverableError'] as bool?,
+      paperNearEnd: map['paperNearEnd'] as bool?,
+      paperEnd: map['paperEnd'] as bool?,
+    );
+  }
+
+  /// `true` si la impresora contestó al menos una consulta.
+  bool get answered => replies.isNotEmpty;
+
+  /// `true` si contestó la consulta [query].
+  bool has(PrinterStatusQuery query) => replies.containsKey(query.n);
+
+  @override
+  String toString() => 'PrinterStatus($replies)';
+}
+
+/// Estado del puerto que informa el driver usblp de Linux (`LPGETSTATUS`).
+///
+/// Lo contesta el driver con un control transfer, sin escribir en el canal
+/// de datos: es instantáneo aunque haya un trabajo imprimiéndose, pero sólo
+/// dice papel, online y error (para tapa o papel por acabarse hace falta
+/// [PrinterStatusQuery]).
+class UsbPortStatus {
+  /// Sin papel.
+  final bool paperOut;
+
+  /// Impresora seleccionada (en línea).
+  final bool online;
+
+  /// La impresora señala un error.
+  final bool error;
+
+  /// Byte de `LPGETSTATUS` tal cual.
+  final int raw;
+
+  const UsbPortStatus({
+    required this.paperOut,
+    required this.online,
+    required this.error,
+    this.raw = 0,
+  });
+
+  factory UsbPortStatus.fromMap(Map<String, dynamic> map) {
+    return UsbPortStatus(
+      paperOut: map['paperOut'] as bool,
+      online: map['online'] as bool,
+      error: map['error'] as bool,
+      raw: map['raw'] as int? ?? 0,
+    );
+  }
+
+  @override
+  String toString() =>
+      'UsbPortStatus(paperOut: $paperOut, online: $online, error: $error)';
+}
@@ -0,0 +1,44 @@
+/// Puerto abierto por el que `sendFile` envía el archivo.
+///
+/// El índice coincide con el valor que espera la capa nativa.
+enum SendFileTarget {
+  /// La impresora abierta con `openUsbPort`.
+  usb,
+
+  /// La conexión abierta con `openTcpPort`.
+  tcp,
+}
+
+/// Avance de un `sendFile` en curso.
+class SendFileProgress {
+  /// Ruta del archivo, tal como se pasó a `sendFile`.
+  final String path;
+
+  /// Bytes ya escritos en el dispositivo.
+  final int sent;
+
+  /// Tamaño del archivo.
+  final int total;
+
+  const SendFileProgress({
+    required this.path,
+    required this.sent,
+    required this.total,
+  });
+
+  factory SendFileProgress.fromMap(Map<String, dynamic> map) {
+    return SendFileProgress(
+      path: map['path'] as String,
+      sent: map['sent'] as int,
+      total: map['total'] as int,
+    );
+  }
+
+  /// Fracción enviada, de 0 a 1.
+  double get fraction => total > 0 ? sent / total : 0;
+
+  bool get done => sent >= total;
+
+  @override
+  String toString() => '$path $sent/$total';
+}
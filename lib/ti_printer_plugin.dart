@@ -1,8 +1,26 @@
 import 'dart:typed_data';
 
 export 'database_printer.dart';
+import 'escpos_layout.dart';
+export 'escpos_layout.dart';
+import 'escpos_optimizer.dart';
+export 'escpos_optimizer.dart';
+import 'escpos_preview.dart';
+export 'escpos_preview.dart';
+import 'job_ring.dart';
+export 'job_ring.dart';
+import 'label_image.dart';
+export 'label_image.dart';
+import 'print_job_scheduler.dart';
+export 'print_job_scheduler.dart';
+import 'printer_capabilities.dart';
+export 'printer_capabilities.dart';
 import 'printer_device_info.dart';
 export 'printer_device_info.dart';
+import 'printer_status.dart';
+export 'printer_status.dart';
+import 'send_file.dart';
+export 'send_file.dart';
 import 'ti_printer_plugin_platform_interface.dart';
 
 class TiPrinterPlugin {
@@ -38,11 +56,313 @@ class TiPrinterPlugin {
     return TiPrinterPluginPlatform.instance.closeUsbPort();
   }
 
+  /// true si el puerto USB abierto lo maneja `ti_printer_daemon` (Linux):
+  /// con el servicio corriendo, `openUsbPort` no abre el dispositivo en este
+  /// proceso sino que lo comparte con las demás apps de la terminal, y los
+  /// trabajos de todas salen en orden por la misma cola.
+  Future<bool> usbViaPrintDaemon() {
+    return TiPrinterPluginPlatform.instance.usbViaPrintDaemon();
+  }
+
+  /// Abre un ring de [capacity] bytes en memoria nativa sobre la impresora
+  /// USB abierta, para mandarle datos por FFI sin un mensaje del
+  /// `MethodChannel` por envío (ver [JobRing]). Los comandos de
+  /// [sendCommandToUsb] y las consultas de estado se siguen atendiendo
+  /// entre tramos del ring. Devuelve `null` si el puerto no está abierto
+  /// localmente (con `ti_printer_daemon` no hay ring) o ya hay un ring
+  /// abierto. Si el puerto se cierra o falla, el ring queda con
+  /// [JobRing.error] y hay que cerrarlo y abrir otro.
+  Future<JobRing?> openUsbJobRing({int capacity = 1024 * 1024}) {
+    return TiPrinterPluginPlatform.instance
+        .openUsbJobRing(capacity: capacity);
+  }
+
   Future<Uint8List> readStatusUsb(Uint8List command) {
     return TiPrinterPluginPlatform.instance.readStatusUsb(command);
   }
 
+  /// Envía todas las [queries] (DLE EOT n) en una sola escritura y lee hasta
+  /// tener una respuesta por consulta: vuelve apenas llegan, sin esperar el
+  /// timeout ni hacer una ida y vuelta por consulta. Devuelve los bits ya
+  /// decodificados; [PrinterStatus.answered] es `false` si la impresora no
+  /// contestó o el puerto no está abierto.
+  Future<PrinterStatus> queryStatusUsb(
+      {List<PrinterStatusQuery> queries = PrinterStatusQuery.values}) {
+    return TiPrinterPluginPlatform.instance.queryStatusUsb(queries: queries);
+  }
+
+  /// Papel, online y error según el driver usblp (`/dev/usb/lp*` en Linux),
+  /// sin escribir nada a la impresora: sirve para consultar en cada ciclo de
+  /// un monitor, aun con un trabajo imprimiéndose. `null` si el puerto no es
+  /// usblp (ttyUSB/ttyACM, Windows) o no está abierto.
+  Future<UsbPortStatus?> readUsbPortStatus() {
+    return TiPrinterPluginPlatform.instance.readUsbPortStatus();
+  }
+
+  /// Capacidades de la impresora USB abierta (firmware, modelo, `GS ( L`,
+  /// `GS ( k`, ASB). El plugin las mide solo la primera vez que se abre
+  /// cada impresora y las guarda en disco; si el probe está corriendo, esto
+  /// espera a que termine. Con [refresh] se descarta lo guardado y se vuelve
+  /// a medir. `null` si no hay puerto abierto o en Windows.
+  Future<PrinterCapabilities?> getUsbCapabilities({bool refresh = false}) {
+    return TiPrinterPluginPlatform.instance
+        .getUsbCapabilities(refresh: refresh);
+  }
+
   Future<bool> sendCommandToUsb(Uint8List command) async {
     return TiPrinterPluginPlatform.instance.sendCommandToUsb(command);
   }
+
+  Future<bool> openTcpPort(String host, {int port = 9100}) {
+    return TiPrinterPluginPlatform.instance.openTcpPort(host, port: port);
+  }
+
+  Future<bool> closeTcpPort() {
+    return TiPrinterPluginPlatform.instance.closeTcpPort();
+  }
+
+  Future<bool> sendCommandToTcp(Uint8List command) {
+    return TiPrinterPluginPlatform.instance.sendCommandToTcp(command);
+  }
+
+  Future<Uint8List> readStatusTcp(Uint8List command) {
+    return TiPrinterPluginPlatform.instance.readStatusTcp(command);
+  }
+
+  /// Como [queryStatusUsb], sobre la conexión abierta con [openTcpPort].
+  Future<PrinterStatus> queryStatusTcp(
+      {List<PrinterStatusQuery> queries = PrinterStatusQuery.values}) {
+    return TiPrinterPluginPlatform.instance.queryStatusTcp(queries: queries);
+  }
+
+  /// Retoma los trabajos que quedaron a medio imprimir en el dispositivo
+  /// USB abierto. Devuelve cuántos se retomaron (se imprimen en segundo plano).
+  Future<int> resumePendingJobs() {
+    return TiPrinterPluginPlatform.instance.resumePendingJobs();
+  }
+
+  /// Descarta los trabajos pendientes del spool (no se reimprimen).
+  Future<bool> discardPendingJobs() {
+    return TiPrinterPluginPlatform.instance.discardPendingJobs();
+  }
+
+  /// Registra un dispositivo en el scheduler multi-impresora. [deviceId] es
+  /// una ruta `/dev/...` o `tcp://host:puerto`; los dispositivos con el mismo
+  /// [group] se balancean entre sí.
+  Future<bool> registerPrinter(String deviceId, {String group = ''}) {
+    return TiPrinterPluginPlatform.instance
+        .registerPrinter(deviceId, group: group);
+  }
+
+  Future<bool> unregisterPrinter(String deviceId) {
+    return TiPrinterPluginPlatform.instance.unregisterPrinter(deviceId);
+  }
+
+  /// Encola [data] en [target] (id de dispositivo o nombre de grupo).
+  /// Devuelve el id del trabajo, o 0 si no hay destino registrado.
+  Future<int> submitJob(String target, Uint8List data,
+      {PrintJobPriority priority = PrintJobPriority.normal}) {
+    return TiPrinterPluginPlatform.instance
+        .submitJob(target, data, priority: priority);
+  }
+
+  Future<List<PrinterQueueStats>> getSchedulerStats() {
+    return TiPrinterPluginPlatform.instance.getSchedulerStats();
+  }
+
+  /// Convierte una imagen a bit image `ESC *` (24 puntos, formato columna)
+  /// en la capa nativa, sin rotar ni copiar la imagen en Dart.
+  ///
+  /// [pixels] son grises de 1 byte por punto (0 = negro) si [bitsPerPixel]
+  /// es 8, o filas empaquetadas MSB primero (1 = negro) si es 1. Devuelve
+  /// los mismos comandos que `Generator.image` sin la alineación, o una
+  /// lista vacía si la plataforma no lo soporta.
+  Future<Uint8List> encodeColumnImage(Uint8List pixels,
+      {required int width, required int height, int bitsPerPixel = 8}) {
+    return TiPrinterPluginPlatform.instance.encodeColumnImage(pixels,
+        width: width, height: height, bitsPerPixel: bitsPerPixel);
+  }
+
+  /// Imprime una imagen por el puerto USB abierto, procesándola por bandas
+  /// en la capa nativa (gris → dither → `GS v 0` → escritura en paralelo):
+  /// la impresora arranca con la primera banda mientras el resto se sigue
+  /// convirtiendo.
+  ///
+  /// [pixels] tiene [channels] bytes por punto (1 gris, 3 RGB o 4 RGBA, como
+  /// `image.getBytes()`). Con [dither] usa Floyd-Steinberg; si no, umbral.
+  Future<bool> printImageUsb(Uint8List pixels,
+      {required int width,
+      required int height,
+      int channels = 4,
+      bool dither = true}) {
+    return TiPrinterPluginPlatform.instance.printImageUsb(pixels,
+        width: width, height: height, channels: channels, dither: dither);
+  }
+
+  /// Decodifica un PNG/JPEG en la capa nativa, lo reduce a [width] puntos
+  /// (384, 576, 832...) con promedio de área y devuelve los comandos
+  /// `GS v 0` listos para `sendCommandToUsb`. Las imágenes más angostas no
+  /// se agrandan. Devuelve una lista vacía si no se pudo decodificar o la
+  /// plataforma no lo soporta.
+  ///
+  /// Con [graphics] cada banda sale como `GS ( L` en vez de `GS v 0`;
+  /// [density] (0..3) pide doble ancho (bit 0) y/o doble alto (bit 1).
+  /// Con [ordered] el tramado es una matriz de Bayer en vez de
+  /// Floyd-Steinberg: se ve más regular y cada banda se procesa por
+  /// separado. Las imágenes altas (un ticket entero) se convierten en
+  /// paralelo en todos los núcleos.
+  /// Con [star] sale en el modo raster de Star (TSP100 y otras StarPRNT,
+  /// ver [KnownUsbPrinter.starRaster]) en vez de ESC/POS: una orden por
+  /// fila, sin los blancos del final de cada fila ni las filas en blanco.
+  /// Ignora [graphics] y [density].
+  /// El resultado queda en una caché por contenido: la misma imagen con los
+  /// mismos parámetros se devuelve sin volver a convertirla.
+  Future<Uint8List> rasterizeImage(Uint8List encoded,
+      {required int width,
+      bool dither = true,
+      bool ordered = false,
+      bool graphics = false,
+      bool star = false,
+      int density = 0}) {
+    return TiPrinterPluginPlatform.instance.rasterizeImage(encoded,
+        width: width,
+        dither: dither,
+        ordered: ordered,
+        graphics: graphics,
+        star: star,
+        density: density);
+  }
+
+  /// Vacía la caché de imágenes convertidas (memoria y disco).
+  Future<bool> clearRasterCache() {
+    return TiPrinterPluginPlatform.instance.clearRasterCache();
+  }
+
+  /// Quita de un ticket ESC/POS los cambios de estilo y alineación que no
+  /// cambian nada (típico de `Generator.text`/`row`, que repiten
+  /// `setStyles` en cada columna) y junta los avances de papel seguidos.
+  /// Lo impreso no cambia. Si la plataforma no lo soporta devuelve los
+  /// mismos bytes con `savedBytes == 0`.
+  Future<EscPosOptimizeResult> optimizeEscPos(Uint8List data) {
+    return TiPrinterPluginPlatform.instance.optimizeEscPos(data);
+  }
+
+  /// Ejecuta los comandos ESC/POS de [data] sobre una página de [width]
+  /// puntos (576 para 80 mm, 384 para 58 mm) y devuelve cómo quedaría
+  /// impreso, en PNG o PBM. Sirve para la vista previa en pantalla y para
+  /// comparar tickets en tests sin gastar papel. Los códigos de barras y QR
+  /// no se dibujan. Devuelve una lista vacía si la plataforma no lo soporta.
+  Future<Uint8List> renderEscPos(Uint8List data,
+      {int width = 576,
+      EscPosPreviewFormat format = EscPosPreviewFormat.png}) {
+    return TiPrinterPluginPlatform.instance
+        .renderEscPos(data, width: width, format: format);
+  }
+
+  /// Compila un template de ticket en la capa nativa y devuelve su id para
+  /// [renderReceipt], o 0 si tiene errores o la plataforma no lo soporta.
+  ///
+  /// El template se analiza una sola vez: texto con `{{campo}}`, estilos
+  /// (`@bold on`, `@align center`, `@size 2`...), filas en columnas
+  /// (`@row 7 2 >3 | {{nombre}} | {{cant}} | {{precio}}`), `@each` sobre
+  /// listas, `@if`/`@else`, `@image` y `@qr`. La sintaxis completa está en
+  /// el README.
+  Future<int> compileReceiptTemplate(String source) {
+    return TiPrinterPluginPlatform.instance.compileReceiptTemplate(source);
+  }
+
+  /// Ejecuta el template [template] con los datos de un pedido y devuelve
+  /// los comandos ESC/POS. Los valores de [data] pueden ser `String`,
+  /// números, `bool`, `Uint8List` (para `@image`) o listas de mapas (para
+  /// `@each`); los importes conviene pasarlos ya formateados. Devuelve una
+  /// lista vacía si el template no existe o la plataforma no lo soporta.
+  Future<Uint8List> renderReceipt(int template, Map<String, Object?> data) {
+    return TiPrinterPluginPlatform.instance.renderReceipt(template, data);
+  }
+
+  /// Libera un template compilado.
+  Future<bool> releaseReceiptTemplate(int template) {
+    return TiPrinterPluginPlatform.instance.releaseReceiptTemplate(template);
+  }
+
+  /// Arma una fila en columnas en la capa nativa y devuelve los bytes
+  /// ESC/POS (una o más líneas). A diferencia de `Generator.row`, mide el
+  /// texto en celdas de pantalla: los caracteres chinos/japoneses/coreanos
+  /// cuentan doble, los acentos combinantes no cuentan, y lo que no entra
+  /// sigue en la línea de abajo cortando en espacios.
+  ///
+  /// [lineChars] son los caracteres por línea de la fuente vigente (48 para
+  /// la fuente A en 80 mm, 32 en 58 mm); [fontB] indica que se usa la fuente
+  /// B. El texto sale en la tabla [codeTable] (ESC t), o en UTF-8 si [utf8]
+  /// (la impresora debe estar en ese modo, `FS ( C`). Devuelve una lista
+  /// vacía si la plataforma no lo soporta.
+  Future<Uint8List> layoutRow(List<EscPosRowColumn> columns,
+      {int lineChars = 48,
+      bool fontB = false,
+      int codeTable = 0,
+      bool utf8 = false}) {
+    return TiPrinterPluginPlatform.instance.layoutRow(columns,
+        lineChars: lineChars, fontB: fontB, codeTable: codeTable, utf8: utf8);
+  }
+
+  /// Dibuja [text] con fuentes TrueType/OpenType en la capa nativa y
+  /// devuelve los comandos GS v 0, para escrituras que la impresora no trae
+  /// en sus tablas (árabe, hebreo, tailandés, emoji...).
+  ///
+  /// [fonts] son rutas a archivos de fuente en orden de preferencia: cada
+  /// carácter sale de la primera que lo tiene (p. ej. una latina, una árabe
+  /// y una de emoji). [size] es el alto de la letra y [width] el ancho de la
+  /// imagen, los dos en puntos de la impresora; lo que no entra sigue en la
+  /// línea de abajo. Las fuentes y los glifos quedan en memoria para los
+  /// próximos tickets. Devuelve una lista vacía si alguna fuente no se pudo
+  /// abrir o el plugin se compiló sin FreeType.
+  Future<Uint8List> rasterizeText(String text,
+      {required List<String> fonts,
+      int size = 24,
+      int width = 576,
+      EscPosRowAlign align = EscPosRowAlign.left}) {
+    return TiPrinterPluginPlatform.instance.rasterizeText(text,
+        fonts: fonts, size: size, width: width, align: align);
+  }
+
+  /// Envía un archivo ya renderizado (cierre del día, lote de etiquetas) a
+  /// la impresora abierta en [target], sin cargarlo en memoria: por TCP los
+  /// bytes van del disco al socket con `sendfile`, por USB el archivo se
+  /// mapea y se escribe por bloques. El avance llega por
+  /// [sendFileProgress]. Devuelve `false` si el archivo no se pudo abrir, el
+  /// puerto no está abierto o la escritura falló.
+  Future<bool> sendFile(String path,
+      {SendFileTarget target = SendFileTarget.usb}) {
+    return TiPrinterPluginPlatform.instance.sendFile(path, target: target);
+  }
+
+  /// Avance de los `sendFile` en curso (unos 10 eventos por segundo y uno al
+  /// terminar cada archivo).
+  Stream<SendFileProgress> get sendFileProgress {
+    return TiPrinterPluginPlatform.instance.sendFileProgress;
+  }
+
+  /// Convierte una imagen PNG/JPEG en una etiqueta lista para enviar a una
+  /// impresora Zebra (ZPL) o TSC/Gprinter (TSPL), con la imagen en ([x],
+  /// [y]) y reducida a [width] puntos. El formato sale del protocolo de la
+  /// impresora con [LabelImageFormat.forProtocol] o
+  /// [LabelImageFormat.forDevice]. En ZPL las filas van comprimidas, lo que
+  /// en una etiqueta de 4×6" suele ser una fracción del `^GFA` en hex.
+  /// [dither] y [ordered] funcionan como en [rasterizeImage]. Devuelve una
+  /// lista vacía si la imagen no se pudo decodificar.
+  Future<Uint8List> encodeLabelImage(Uint8List encoded,
+      {required int width,
+      required LabelImageFormat format,
+      bool dither = true,
+      bool ordered = false,
+      int x = 0,
+      int y = 0}) {
+    return TiPrinterPluginPlatform.instance.encodeLabelImage(encoded,
+        width: width,
+        format: format,
+        dither: dither,
+        ordered: ordered,
+        x: x,
+        y: y);
+  }
 }
@@ -1,7 +1,16 @@
 import 'package:flutter/foundation.dart';
 import 'package:flutter/services.dart';
 
+import 'escpos_layout.dart';
+import 'escpos_optimizer.dart';
+import 'escpos_preview.dart';
+import 'job_ring.dart';
+import 'label_image.dart';
+import 'print_job_scheduler.dart';
+import 'printer_capabilities.dart';
 import 'printer_device_info.dart';
+import 'printer_status.dart';
+import 'send_file.dart';
 import 'ti_printer_plugin_platform_interface.dart';
 
 /// An implementation of [TiPrinterPluginPlatform] that uses method channels.
@@ -10,6 +19,15 @@ class MethodChannelTiPrinterPlugin extends TiPrinterPluginPlatform {
   @visibleForTesting
   final methodChannel = const MethodChannel('ti_printer_plugin');
 
+  /// Avance de `sendFile`, emitido por la capa nativa.
+  @visibleForTesting
+  final sendFileProgressChannel =
+      const EventChannel('ti_printer_plugin/send_file_progress');
+
+  /// Avance del ring de trabajos, emitido por la capa nativa.
+  @visibleForTesting
+  final jobRingChannel = const EventChannel('ti_printer_plugin/job_ring');
+
   @override
   Future<String> getPlatformVersion() async {
     final version =
@@ -74,11 +92,295 @@ class MethodChannelTiPrinterPlugin extends TiPrinterPluginPlatform {
     return _invokeBoolMethod('closeUsbPort');
   }
 
+  @override
+  Future<bool> usbViaPrintDaemon() {
+    return _invokeBoolMethod('usbViaPrintDaemon');
+  }
+
+  @override
+  Future<JobRing?> openUsbJobRing({int capacity = 1024 * 1024}) async {
+    final address = await _invokeIntMethod('openUsbJobRing', capacity);
+    if (address == 0) return null;
+    return JobRing.attach(address,
+        events: jobRingChannel.receiveBroadcastStream().map((e) =>
+            JobRingProgress.fromMap(Map<String, dynamic>.from(e as Map))),
+        close: () => _invokeBoolMethod('closeUsbJobRing'));
+  }
+
   @override
   Future<Uint8List> readStatusUsb(Uint8List command) {
     return _invokeBytesMethod('readStatusUsb', command);
   }
 
+  @override
+  Future<PrinterStatus> queryStatusUsb(
+      {List<PrinterStatusQuery> queries = PrinterStatusQuery.values}) {
+    return _invokeStatusMethod('queryStatusUsb', queries);
+  }
+
+  @override
+  Future<PrinterCapabilities?> getUsbCapabilities({bool refresh = false}) async {
+    try {
+      final map = await methodChannel.invokeMapMethod<String, dynamic>(
+          'getUsbCapabilities', {'refresh': refresh});
+      return map == null ? null : PrinterCapabilities.fromMap(map);
+    } on PlatformException {
+      return null;
+    } on MissingPluginException {
+      return null;
+    }
+  }
+
+  @override
+  Future<UsbPortStatus?> readUsbPortStatus() async {
+    try {
+      final map = await methodChannel
+          .invokeMapMethod<String, dynamic>('readUsbPortStatus');
+      return map == null ? null : UsbPortStatus.fromMap(map);
+    } on PlatformException {
+      return null;
+    } on MissingPluginException {
+      return null;
+    }
+  }
+
+  @override
+  Future<bool> openTcpPort(String host, {int port = 9100}) {
+    return _invokeBoolMethod('openTcpPort', {
+      'host': host,
+      'port': port,
+    });
+  }
+
+  @override
+  Future<bool> closeTcpPort() {
+    return _invokeBoolMethod('closeTcpPort');
+  }
+
+  @override
+  Future<bool> sendCommandToTcp(Uint8List command) {
+    return _invokeBoolMethod('sendCommandToTcp', command);
+  }
+
+  @override
+  Future<Uint8List> readStatusTcp(Uint8List command) {
+    return _invokeBytesMethod('readStatusTcp', command);
+  }
+
+  @override
+  Future<PrinterStatus> queryStatusTcp(
+      {List<PrinterStatusQuery> queries = PrinterStatusQuery.values}) {
+    return _invokeStatusMethod('queryStatusTcp', queries);
+  }
+
+  @override
+  Future<int> resumePendingJobs() {
+    return _invokeIntMethod('resumePendingJobs');
+  }
+
+  @override
+  Future<bool> discardPendingJobs() {
+    return _invokeBoolMethod('discardPendingJobs');
+  }
+
+  @override
+  Future<bool> registerPrinter(String deviceId, {String group = ''}) {
+    return _invokeBoolMethod('registerPrinter', {
+      'deviceId': deviceId,
+      'group': group,
+    });
+  }
+
+  @override
+  Future<bool> unregisterPrinter(String deviceId) {
+    return _invokeBoolMethod('unregisterPrinter', deviceId);
+  }
+
+  @override
+  Future<int> submitJob(String target, Uint8List data,
+      {PrintJobPriority priority = PrintJobPriority.normal}) {
+    return _invokeIntMethod('submitJob', {
+      'target': target,
+      'data': data,
+      'priority': priority.index,
+    });
+  }
+
+  @override
+  Future<List<PrinterQueueStats>> getSchedulerStats() async {
+    try {
+      final List<dynamic>? list =
+          await methodChannel.invokeMethod<List<dynamic>>('getSchedulerStats');
+      if (list == null) return const [];
+      return list
+          .map((e) =>
+              PrinterQueueStats.fromMap(Map<String, dynamic>.from(e as Map)))
+          .toList();
+    } on PlatformException {
+      return const [];
+    } on MissingPluginException {
+      return const [];
+    }
+  }
+
+  @override
+  Future<Uint8List> encodeColumnImage(Uint8List pixels,
+      {required int width, required int height, int bitsPerPixel = 8}) {
+    return _invokeBytesMethod('encodeColumnImage', {
+      'pixels': pixels,
+      'width': width,
+      'height': height,
+      'bitsPerPixel': bitsPerPixel,
+    });
+  }
+
+  @override
+  Future<bool> printImageUsb(Uint8List pixels,
+      {required int width,
+      required int height,
+      int channels = 4,
+      bool dither = true}) {
+    return _invokeBoolMethod('printImageUsb', {
+      'pixels': pixels,
+      'width': width,
+      'height': height,
+      'channels': channels,
+      'dither': dither,
+    });
+  }
+
+  @override
+  Future<Uint8List> rasterizeImage(Uint8List encoded,
+      {required int width,
+      bool dither = true,
+      bool ordered = false,
+      bool graphics = false,
+      bool star = false,
+      int density = 0}) {
+    return _invokeBytesMethod('rasterizeImage', {
+      'data': encoded,
+      'width': width,
+      'dither': dither,
+      'ordered': ordered,
+      'graphics': graphics,
+      'star': star,
+      'density': density,
+    });
+  }
+
+  @override
+  Future<bool> clearRasterCache() {
+    return _invokeBoolMethod('clearRasterCache');
+  }
+
+  @override
+  Future<EscPosOptimizeResult> optimizeEscPos(Uint8List data) async {
+    try {
+      final Map<dynamic, dynamic>? map =
+          await methodChannel.invokeMethod<Map<dynamic, dynamic>>(
+              'optimizeEscPos', data);
+      if (map == null) return EscPosOptimizeResult.unchanged(data);
+      return EscPosOptimizeResult.fromMap(Map<String, dynamic>.from(map));
+    } on PlatformException {
+      return EscPosOptimizeResult.unchanged(data);
+    } on MissingPluginException {
+      return EscPosOptimizeResult.unchanged(data);
+    }
+  }
+
+  @override
+  Future<Uint8List> renderEscPos(Uint8List data,
+      {int width = 576,
+      EscPosPreviewFormat format = EscPosPreviewFormat.png}) {
+    return _invokeBytesMethod('renderEscPos', {
+      'data': data,
+      'width': width,
+      'format': format.name,
+    });
+  }
+
+  @override
+  Future<int> compileReceiptTemplate(String source) {
+    return _invokeIntMethod('compileReceiptTemplate', source);
+  }
+
+  @override
+  Future<Uint8List> renderReceipt(int template, Map<String, Object?> data) {
+    return _invokeBytesMethod('renderReceipt', {
+      'template': template,
+      'data': data,
+    });
+  }
+
+  @override
+  Future<bool> releaseReceiptTemplate(int template) {
+    return _invokeBoolMethod('releaseReceiptTemplate', template);
+  }
+
+  @override
+  Future<Uint8List> layoutRow(List<EscPosRowColumn> columns,
+      {int lineChars = 48,
+      bool fontB = false,
+      int codeTable = 0,
+      bool utf8 = false}) {
+    return _invokeBytesMethod('layoutRow', {
+      'columns': [for (final column in columns) column.toMap()],
+      'lineChars': lineChars,
+      'fontB': fontB,
+      'codeTable': codeTable,
+      'utf8': utf8,
+    });
+  }
+
+  @override
+  Future<Uint8List> rasterizeText(String text,
+      {required List<String> fonts,
+      int size = 24,
+      int width = 576,
+      EscPosRowAlign align = EscPosRowAlign.left}) {
+    return _invokeBytesMethod('rasterizeText', {
+      'text': text,
+      'fonts': fonts,
+      'size': size,
+      'width': width,
+      'align': align.index,
+    });
+  }
+
+  @override
+  Future<bool> sendFile(String path,
+      {SendFileTarget target = SendFileTarget.usb}) {
+    return _invokeBoolMethod('sendFile', {
+      'path': path,
+      'target': target.index,
+    });
+  }
+
+  @override
+  Stream<SendFileProgress> get sendFileProgress => sendFileProgressChannel
+      .receiveBroadcastStream()
+      .map((e) =>
+          SendFileProgress.fromMap(Map<String, dynamic>.from(e as Map)));
+
+  @override
+  Future<Uint8List> encodeLabelImage(Uint8List encoded,
+      {required int width,
+      required LabelImageFormat format,
+      bool dither = true,
+      bool ordered = false,
+      int x = 0,
+      int y = 0}) {
+    return _invokeBytesMethod('encodeLabelImage', {
+      'data': encoded,
+      'width': width,
+      'format': format.index,
+      'dither': dither,
+      'ordered': ordered,
+      'x': x,
+      'y': y,
+    });
+  }
+
   Future<bool> _invokeBoolMethod(String method, [dynamic arguments]) async {
     try {
       return await methodChannel.invokeMethod<bool>(method, arguments) ?? false;
@@ -89,6 +391,29 @@ class MethodChannelTiPrinterPlugin extends TiPrinterPluginPlatform {
     }
   }
 
+  Future<PrinterStatus> _invokeStatusMethod(
+      String method, List<PrinterStatusQuery> queries) async {
+    try {
+      final map = await methodChannel.invokeMapMethod<String, dynamic>(
+          method, queries.map((q) => q.n).toList());
+      return map == null ? PrinterStatus.empty : PrinterStatus.fromMap(map);
+    } on PlatformException {
+      return PrinterStatus.empty;
+    } on MissingPluginException {
+      return PrinterStatus.empty;
+    }
+  }
+
+  Future<int> _invokeIntMethod(String method, [dynamic arguments]) async {
+    try {
+      return await methodChannel.invokeMethod<int>(method, arguments) ?? 0;
+    } on PlatformException {
+      return 0;
+    } on MissingPluginException {
+      return 0;
+    }
+  }
+
   Future<Uint8List> _invokeBytesMethod(
       String method, [dynamic arguments]) async {
     try {
@@ -2,7 +2,16 @@ import 'dart:typed_data';
 
 import 'package:plugin_platform_interface/plugin_platform_interface.dart';
 
+import 'escpos_layout.dart';
+import 'escpos_optimizer.dart';
+import 'escpos_preview.dart';
+import 'job_ring.dart';
+import 'label_image.dart';
+import 'print_job_scheduler.dart';
+import 'printer_capabilities.dart';
 import 'printer_device_info.dart';
+import 'printer_status.dart';
+import 'send_file.dart';
 import 'ti_printer_plugin_method_channel.dart';
 
 abstract class TiPrinterPluginPlatform extends PlatformInterface {
@@ -62,7 +71,160 @@ abstract class TiPrinterPluginPlatform extends PlatformInterface {
     throw UnimplementedError('closeUsbPort() has not been implemented.');
   }
 
+  Future<bool> usbViaPrintDaemon() {
+    throw UnimplementedError('usbViaPrintDaemon() has not been implemented.');
+  }
+
+  Future<JobRing?> openUsbJobRing({int capacity = 1024 * 1024}) {
+    throw UnimplementedError('openUsbJobRing() has not been implemented.');
+  }
+
   Future<Uint8List> readStatusUsb(Uint8List command) {
     throw UnimplementedError('readStatusUsb() has not been implemented.');
   }
+
+  Future<PrinterStatus> queryStatusUsb(
+      {List<PrinterStatusQuery> queries = PrinterStatusQuery.values}) {
+    throw UnimplementedError('queryStatusUsb() has not been implemented.');
+  }
+
+  Future<UsbPortStatus?> readUsbPortStatus() {
+    throw UnimplementedError('readUsbPortStatus() has not been implemented.');
+  }
+
+  Future<PrinterCapabilities?> getUsbCapabilities({bool refresh = false}) {
+    throw UnimplementedError('getUsbCapabilities() has not been implemented.');
+  }
+
+  Future<bool> openTcpPort(String host, {int port = 9100}) {
+    throw UnimplementedError('openTcpPort() has not been implemented.');
+  }
+
+  Future<bool> closeTcpPort() {
+    throw UnimplementedError('closeTcpPort() has not been implemented.');
+  }
+
+  Future<bool> sendCommandToTcp(Uint8List command) {
+    throw UnimplementedError('sendCommandToTcp() has not been implemented.');
+  }
+
+  Future<Uint8List> readStatusTcp(Uint8List command) {
+    throw UnimplementedError('readStatusTcp() has not been implemented.');
+  }
+
+  Future<PrinterStatus> queryStatusTcp(
+      {List<PrinterStatusQuery> queries = PrinterStatusQuery.values}) {
+    throw UnimplementedError('queryStatusTcp() has not been implemented.');
+  }
+
+  Future<int> resumePendingJobs() {
+    throw UnimplementedError('resumePendingJobs() has not been implemented.');
+  }
+
+  Future<bool> discardPendingJobs() {
+    throw UnimplementedError('discardPendingJobs() has not been implemented.');
+  }
+
+  Future<bool> registerPrinter(String deviceId, {String group = ''}) {
+    throw UnimplementedError('registerPrinter() has not been implemented.');
+  }
+
+  Future<bool> unregisterPrinter(String deviceId) {
+    throw UnimplementedError('unregisterPrinter() has not been implemented.');
+  }
+
+  Future<int> submitJob(String target, Uint8List data,
+      {PrintJobPriority priority = PrintJobPriority.normal}) {
+    throw UnimplementedError('submitJob() has not been implemented.');
+  }
+
+  Future<List<PrinterQueueStats>> getSchedulerStats() {
+    throw UnimplementedError('getSchedulerStats() has not been implemented.');
+  }
+
+  Future<Uint8List> encodeColumnImage(Uint8List pixels,
+      {required int width, required int height, int bitsPerPixel = 8}) {
+    throw UnimplementedError('encodeColumnImage() has not been implemented.');
+  }
+
+  Future<bool> printImageUsb(Uint8List pixels,
+      {required int width,
+      required int height,
+      int channels = 4,
+      bool dither = true}) {
+    throw UnimplementedError('printImageUsb() has not been implemented.');
+  }
+
+  Future<Uint8List> rasterizeImage(Uint8List encoded,
+      {required int width,
+      bool dither = true,
+      bool ordered = false,
+      bool graphics = false,
+      bool star = false,
+      int density = 0}) {
+    throw UnimplementedError('rasterizeImage() has not been implemented.');
+  }
+
+  Future<bool> clearRasterCache() {
+    throw UnimplementedError('clearRasterCache() has not been implemented.');
+  }
+
+  Future<EscPosOptimizeResult> optimizeEscPos(Uint8List data) {
+    throw UnimplementedError('optimizeEscPos() has not been implemented.');
+  }
+
+  Future<Uint8List> renderEscPos(Uint8List data,
+      {int width = 576,
+      EscPosPreviewFormat format = EscPosPreviewFormat.png}) {
+    throw UnimplementedError('renderEscPos() has not been implemented.');
+  }
+
+  Future<int> compileReceiptTemplate(String source) {
+    throw UnimplementedError(
+        'compileReceiptTemplate() has not been implemented.');
+  }
+
+  Future<Uint8List> renderReceipt(int template, Map<String, Object?> data) {
+    throw UnimplementedError('renderReceipt() has not been implemented.');
+  }
+
+  Future<bool> releaseReceiptTemplate(int template) {
+    throw UnimplementedError(
+        'releaseReceiptTemplate() has not been implemented.');
+  }
+
+  Future<Uint8List> layoutRow(List<EscPosRowColumn> columns,
+      {int lineChars = 48,
+      bool fontB = false,
+      int codeTable = 0,
+      bool utf8 = false}) {
+    throw UnimplementedError('layoutRow() has not been implemented.');
+  }
+
+  Future<Uint8List> rasterizeText(String text,
+      {required List<String> fonts,
+      int size = 24,
+      int width = 576,
+      EscPosRowAlign align = EscPosRowAlign.left}) {
+    throw UnimplementedError('rasterizeText() has not been implemented.');
+  }
+
+  Future<bool> sendFile(String path,
+      {SendFileTarget target = SendFileTarget.usb}) {
+    throw UnimplementedError('sendFile() has not been implemented.');
+  }
+
+  Stream<SendFileProgress> get sendFileProgress {
+    throw UnimplementedError('sendFileProgress has not been implemented.');
+  }
+
+  Future<Uint8List> encodeLabelImage(Uint8List encoded,
+      {required int width,
+      required LabelImageFormat format,
+      bool dither = true,
+      bool ordered = false,
+      int x = 0,
+      int y = 0}) {
+    throw UnimplementedError('encodeLabelImage() has not been implemented.');
+  }
 }
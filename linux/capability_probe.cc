@@ -0,0 +1,215 @@
+#include "capability_probe.h"
+
+#include <glib.h>
+
+#include <algorithm>
+#include <ctime>
+
+namespace
+{
+
+constexpr uint8_t GS = 0x1D;
+
+// Espera de cada consulta. Una impresora que no conoce el comando no
+// contesta nada, así que es lo que tarda el probe en darse por vencido.
+constexpr int kProbeTimeoutMs = 300;
+
+// Respuestas "de bloque" de GS I 65-69: 5Fh datos 00h.
+constexpr uint8_t kBlockHeader = 0x5F;
+
+// Encabezado de las respuestas de función de GS ( L / GS ( k.
+constexpr uint8_t kFunctionHeader = 0x37;
+
+std::vector<uint8_t> gs_i(uint8_t n)
+{
+  return {GS, 'I', n};
+}
+
+// Texto entre 5Fh y 00h, sólo caracteres imprimibles. Vacío si no hay
+// encabezado (sin respuesta o bytes de otra consulta).
+std::string block_text(const std::vector<uint8_t> &reply)
+{
+  auto it = std::find(reply.begin(), reply.end(), kBlockHeader);
+  if (it == reply.end())
+    return "";
+  std::string text;
+  for (++it; it != reply.end() && *it != 0x00; ++it)
+  {
+    if (*it >= 0x20 && *it < 0x7F)
+      text.push_back(static_cast<char>(*it));
+  }
+  return text;
+}
+
+// true si 'reply' tiene una respuesta de función de GS ( L / GS ( k: 37h,
+// identificador, datos y 00h. El identificador cambia entre modelos y
+// funciones; basta con que la impresora haya contestado con ese formato.
+bool function_reply(const std::vector<uint8_t> &reply)
+{
+  auto header = std::find(reply.begin(), reply.end(), kFunctionHeader);
+  return header != reply.end() && std::find(header, reply.end(), 0x00) != reply.end();
+}
+
+// Primer byte de un ASB: bits 0, 1 y 7 en 0, bit 4 en 1.
+bool asb_first_byte(uint8_t value)
+{
+  return (value & 0x93) == 0x10;
+}
+
+} // namespace
+
+PrinterCapabilities probe_printer_capabilities(const ProbeTransact &transact)
+{
+  PrinterCapabilities caps;
+  caps.probed_at = static_cast<int64_t>(std::time(nullptr));
+
+  // GS I 1, 2 y 3 contestan un byte cada uno: van juntos, como DLE EOT.
+  std::vector<uint8_t> ids = gs_i(1);
+  for (uint8_t n : {2, 3})
+  {
+    const std::vector<uint8_t> next = gs_i(n);
+    ids.insert(ids.end(), next.begin(), next.end());
+  }
+  std::vector<uint8_t> reply = transact(ids, 3, kProbeTimeoutMs);
+  if (reply.size() > 3)
+    reply.erase(reply.begin(), reply.end() - 3); // lo anterior es viejo
+  if (reply.size() > 0)
+    caps.model_id = reply[0];
+  if (reply.size() > 1)
+    caps.type_id = reply[1];
+  if (reply.size() > 2)
+    caps.rom_version = reply[2];
+  caps.answered = !reply.empty();
+
+  // Sin GS I no es una ESC/POS que conteste: no vale la pena esperar el
+  // timeout de cada consulta que sigue.
+  if (!caps.answered)
+    return caps;
+
+  caps.firmware = block_text(transact(gs_i(65), 0, kProbeTimeoutMs));
+  caps.maker = block_text(transact(gs_i(66), 0, kProbeTimeoutMs));
+  caps.model = block_text(transact(gs_i(67), 0, kProbeTimeoutMs));
+
+  // GS ( L fn 48: capacidad de la memoria NV de gráficos.
+  caps.graphics =
+      function_reply(transact({GS, '(', 'L', 0x02, 0x00, 0x30, 0x30}, 0, kProbeTimeoutMs));
+
+  // GS ( k cn 49 fn 82: tamaño del QR guardado.
+  caps.symbols = function_reply(
+      transact({GS, '(', 'k', 0x03, 0x00, 0x31, 0x52, 0x30}, 0, kProbeTimeoutMs));
+
+  // GS a: al activar ASB la impresora manda enseguida los 4 bytes de estado.
+  reply = transact({GS, 'a', 0xFF}, 4, kProbeTimeoutMs);
+  caps.auto_status_back =
+      std::any_of(reply.begin(), reply.end(), [](uint8_t b) { return asb_first_byte(b); });
+  if (caps.auto_status_back)
+    transact({GS, 'a', 0x00}, 0, 0);
+  return caps;
+}
+
+RasterCommand capability_raster_command(const PrinterCapabilities &caps)
+{
+  return caps.graphics ? RasterCommand::kGraphics : RasterCommand::kBitImage;
+}
+
+CapabilityCache::~CapabilityCache()
+{
+  if (file_)
+    g_key_file_free(file_);
+}
+
+bool CapabilityCache::open(const std::string &path)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  path_ = path;
+  if (file_)
+    g_key_file_free(file_);
+  file_ = g_key_file_new();
+
+  g_autoptr(GError) error = nullptr;
+  if (!g_key_file_load_from_file(file_, path.c_str(), G_KEY_FILE_KEEP_COMMENTS, &error) &&
+      !g_error_matches(error, G_FILE_ERROR, G_FILE_ERROR_NOENT))
+  {
+    g_printerr("No se pudo leer %s: %s\n", path.c_str(), error->message);
+    return false;
+  }
+  return true;
+}
+
+bool CapabilityCache::lookup(const std::string &key, PrinterCapabilities &out)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  const char *group = key.c_str();
+  if (!file_ || !g_key_file_has_group(file_, group))
+    return false;
+
+  // Una clave que falta (archivo de una versión anterior) queda en su valor
+  // por defecto.
+  auto get_int = [&](const char *name, int fallback) {
+    g_autoptr(GError) error = nullptr;
+    const int value = g_key_file_get_integer(file_, group, name, &error);
+    return error ? fallback : value;
+  };
+  auto get_bool = [&](const char *name) {
+    return g_key_file_get_boolean(file_, group, name, nullptr) != FALSE;
+  };
+  auto get_string = [&](const char *name) {
+    g_autofree gchar *value = g_key_file_get_string(file_, group, name, nullptr);
+    return std::string(value ? value : "");
+  };
+
+  PrinterCapabilities caps;
+  caps.answered = get_bool("answered");
+  caps.model_id = get_int("model_id", -1);
+  caps.type_id = get_int("type_id", -1);
+  caps.rom_version = get_int("rom_version", -1);
+  caps.firmware = get_string("firmware");
+  caps.maker = get_string("maker");
+  caps.model = get_string("model");
+  caps.graphics = get_bool("graphics");
+  caps.symbols = get_bool("symbols");
+  caps.auto_status_back = get_bool("auto_status_back");
+  caps.probed_at = g_key_file_get_int64(file_, group, "probed_at", nullptr);
+  out = caps;
+  return true;
+}
+
+void CapabilityCache::store(const std::string &key, const PrinterCapabilities &caps)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!file_)
+    file_ = g_key_file_new();
+
+  const char *group = key.c_str();
+  g_key_file_remove_group(file_, group, nullptr);
+  g_key_file_set_boolean(file_, group, "answered", caps.answered);
+  g_key_file_set_integer(file_, group, "model_id", caps.model_id);
+  g_key_file_set_integer(file_, group, "type_id", caps.type_id);
+  g_key_file_set_integer(file_, group, "rom_version", caps.rom_version);
+  g_key_file_set_string(file_, group, "firmware", caps.firmware.c_str());
+  g_key_file_set_string(file_, group, "maker", caps.maker.c_str());
+  g_key_file_set_string(file_, group, "model", caps.model.c_str());
+  g_key_file_set_boolean(file_, group, "graphics", caps.graphics);
+  g_key_file_set_boolean(file_, group, "symbols", caps.symbols);
+  g_key_file_set_boolean(file_, group, "auto_status_back", caps.auto_status_back);
+  g_key_file_set_int64(file_, group, "probed_at", caps.probed_at);
+  save_locked();
+}
+
+void CapabilityCache::forget(const std::string &key)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (file_ && g_key_file_remove_group(file_, key.c_str(), nullptr))
+    save_locked();
+}
+
+// Se escribe a un temporal y se renombra (g_file_set_contents): un corte
+// de luz deja el archivo viejo o el nuevo, nunca uno a medias.
+void CapabilityCache::save_locked()
+{
+  if (path_.empty())
+    return;
+  g_autoptr(GError) error = nullptr;
+  if (!g_key_file_save_to_file(file_, path_.c_str(), &error))
+    g_printerr("No se pudo guardar %s: %s\n", path_.c_str(), error->message);
+}
@@ -0,0 +1,88 @@
+#ifndef FLUTTER_PLUGIN_TI_PRINTER_CAPABILITY_PROBE_H_
+#define FLUTTER_PLUGIN_TI_PRINTER_CAPABILITY_PROBE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "escpos_image.h"
+
+// Qué sabe hacer una impresora, preguntándole a ella.
+//
+// El probe corre una vez por dispositivo nuevo: GS I (modelo, tipo, ROM,
+// firmware, fabricante, nombre) y, con timeouts cortos, si contesta a
+// consultas de GS ( L, GS ( k y Automatic Status Back. El resultado queda
+// en disco por identidad USB (VID/PID + serial, UsbDeviceIdentity::key())
+// y las sesiones siguientes lo usan sin volver a preguntar.
+//
+// Las consultas sólo leen: ninguna imprime ni cambia la configuración
+// guardada de la impresora. La de ASB la activa y la vuelve a apagar.
+
+struct PrinterCapabilities
+{
+  bool answered = false; // contestó al menos a GS I
+
+  int model_id = -1;    // GS I 1 (-1 sin respuesta)
+  int type_id = -1;     // GS I 2: bit 1 = cortador, bit 2 = sensor de marca
+  int rom_version = -1; // GS I 3
+  std::string firmware; // GS I 65
+  std::string maker;    // GS I 66
+  std::string model;    // GS I 67
+
+  bool graphics = false;         // contesta GS ( L (imágenes por GS ( L)
+  bool symbols = false;          // contesta GS ( k (QR/PDF417 nativos)
+  bool auto_status_back = false; // envía ASB con GS a
+
+  int64_t probed_at = 0; // segundos desde epoch
+};
+
+// Escribe 'command' y devuelve lo que contestó la impresora en
+// 'timeout_ms' (con 'expected' > 0, hasta juntar esa cantidad de bytes;
+// ver device_transact). Vacío si no contestó.
+using ProbeTransact = std::function<std::vector<uint8_t>(
+    const std::vector<uint8_t> &command, size_t expected, int timeout_ms)>;
+
+// Corre todas las consultas. Tarda como mucho unos segundos con una
+// impresora que no contesta nada; con una ESC/POS completa, pocas decenas
+// de ms.
+PrinterCapabilities probe_printer_capabilities(const ProbeTransact &transact);
+
+// Comando de imagen más rápido que soporta: GS ( L si lo contestó (la
+// impresora recibe la banda entera en su buffer de gráficos), si no GS v 0.
+RasterCommand capability_raster_command(const PrinterCapabilities &caps);
+
+// Perfiles ya medidos, en un archivo de texto (GKeyFile) con un grupo por
+// dispositivo. Se puede usar desde cualquier hilo.
+class CapabilityCache
+{
+public:
+  CapabilityCache() = default;
+  ~CapabilityCache();
+
+  CapabilityCache(const CapabilityCache &) = delete;
+  CapabilityCache &operator=(const CapabilityCache &) = delete;
+
+  // Carga 'path' si existe; store() lo crea. false si existe pero no se
+  // pudo leer (se empieza vacío igual).
+  bool open(const std::string &path);
+
+  bool lookup(const std::string &key, PrinterCapabilities &out);
+
+  // Guarda (o reemplaza) el perfil de 'key' y reescribe el archivo.
+  void store(const std::string &key, const PrinterCapabilities &caps);
+
+  // Borra el perfil de 'key' (p. ej. después de actualizar el firmware).
+  void forget(const std::string &key);
+
+private:
+  void save_locked();
+
+  std::mutex mutex_;
+  std::string path_;
+  struct _GKeyFile *file_ = nullptr;
+};
+
+#endif // FLUTTER_PLUGIN_TI_PRINTER_CAPABILITY_PROBE_H_
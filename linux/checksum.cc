@@ -0,0 +1,69 @@
+#include "checksum.h"
+
+namespace
+{
+
+// Slicing-by-8: ocho tablas para consumir 8 bytes por iteración.
+struct Crc32Table
+{
+  uint32_t entries[8][256];
+
+  Crc32Table()
+  {
+    for (uint32_t i = 0; i < 256; i++)
+    {
+      uint32_t c = i;
+      for (int k = 0; k < 8; k++)
+        c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+      entries[0][i] = c;
+    }
+    for (uint32_t i = 0; i < 256; i++)
+    {
+      for (int t = 1; t < 8; t++)
+        entries[t][i] = entries[0][entries[t - 1][i] & 0xFF] ^ (entries[t - 1][i] >> 8);
+    }
+  }
+};
+
+} // namespace
+
+uint32_t crc32(const uint8_t *data, size_t length)
+{
+  // Static local: se inicializa una sola vez aunque se llame desde varios hilos.
+  static const Crc32Table table;
+  const auto &t = table.entries;
+
+  uint32_t crc = 0xFFFFFFFFu;
+  while (length >= 8)
+  {
+    const uint32_t lo = crc ^ (static_cast<uint32_t>(data[0]) |
+                               static_cast<uint32_t>(data[1]) << 8 |
+                               static_cast<uint32_t>(data[2]) << 16 |
+                               static_cast<uint32_t>(data[3]) << 24);
+    crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^
+          t[4][lo >> 24] ^ t[3][data[4]] ^ t[2][data[5]] ^ t[1][data[6]] ^
+          t[0][data[7]];
+    data += 8;
+    length -= 8;
+  }
+  while (length-- > 0)
+    crc = t[0][(crc ^ *data++) & 0xFF] ^ (crc >> 8);
+  return crc ^ 0xFFFFFFFFu;
+}
+
+uint64_t hash64(const uint8_t *data, size_t length, uint64_t seed)
+{
+  uint64_t h = 0xCBF29CE484222325ULL ^ seed;
+  for (size_t i = 0; i < length; i++)
+  {
+    h ^= data[i];
+    h *= 0x100000001B3ULL;
+  }
+  // Mezcla final (splitmix64) para repartir bien los bits bajos.
+  h ^= h >> 30;
+  h *= 0xBF58476D1CE4E5B9ULL;
+  h ^= h >> 27;
+  h *= 0x94D049BB133111EBULL;
+  h ^= h >> 31;
+  return h;
+}
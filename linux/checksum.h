@@ -0,0 +1,14 @@
+#ifndef FLUTTER_PLUGIN_TI_PRINTER_CHECKSUM_H_
+#define FLUTTER_PLUGIN_TI_PRINTER_CHECKSUM_H_
+
+#include <cstddef>
+#include <cstdint>
+
+// CRC-32 (IEEE 802.3) para validar registros en disco.
+uint32_t crc32(const uint8_t *data, size_t length);
+
+// Hash de 64 bits para indexar contenido (FNV-1a con mezcla final). No es
+// criptográfico: quien lo usa como clave también compara el largo.
+uint64_t hash64(const uint8_t *data, size_t length, uint64_t seed = 0);
+
+#endif // FLUTTER_PLUGIN_TI_PRINTER_CHECKSUM_H_
@@ -0,0 +1,47 @@
+#include "core_log.h"
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+#include "include/ti_printer_core/ti_printer_core.h"
+
+namespace
+{
+
+std::mutex log_mutex;
+TiPrinterLogHandler log_handler = nullptr;
+void *log_context = nullptr;
+
+} // namespace
+
+void core_log(const char *format, ...)
+{
+  char message[512];
+  va_list args;
+  va_start(args, format);
+  std::vsnprintf(message, sizeof(message), format, args);
+  va_end(args);
+
+  std::lock_guard<std::mutex> lock(log_mutex);
+  if (log_handler)
+    log_handler(message, log_context);
+  else
+    std::fputs(message, stderr);
+}
+
+const char *core_strerror(int error)
+{
+  // strerror() comparte un buffer entre hilos para los valores que no
+  // conoce; la variante GNU de strerror_r usa el de cada hilo.
+  thread_local char buffer[128];
+  return strerror_r(error, buffer, sizeof(buffer));
+}
+
+void ti_printer_set_log_handler(TiPrinterLogHandler handler, void *context)
+{
+  std::lock_guard<std::mutex> lock(log_mutex);
+  log_handler = handler;
+  log_context = context;
+}
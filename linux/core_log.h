@@ -0,0 +1,14 @@
+#ifndef FLUTTER_PLUGIN_TI_PRINTER_CORE_LOG_H_
+#define FLUTTER_PLUGIN_TI_PRINTER_CORE_LOG_H_
+
+// Mensajes de diagnóstico del núcleo (ti_printer_core). Por defecto van a
+// stderr, como g_printerr en el plugin; quien embebe el núcleo puede
+// mandarlos a su propio log con ti_printer_set_log_handler.
+//
+// Se puede llamar desde cualquier hilo.
+void core_log(const char *format, ...) __attribute__((format(printf, 1, 2)));
+
+// Texto de un errno (strerror seguro entre hilos).
+const char *core_strerror(int error);
+
+#endif // FLUTTER_PLUGIN_TI_PRINTER_CORE_LOG_H_
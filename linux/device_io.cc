@@ -0,0 +1,104 @@
+#include "device_io.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+
+namespace
+{
+
+// Lo más que se lee de una vez en una respuesta de estado (ESC u, ASB,
+// GS I...).
+constexpr size_t kReplyBytes = 256;
+
+using Deadline = std::chrono::steady_clock::time_point;
+
+// Milisegundos que faltan para 'deadline' (0 si ya pasó).
+int remaining_ms(Deadline deadline)
+{
+  const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+      deadline - std::chrono::steady_clock::now());
+  return std::max(0, static_cast<int>(left.count()));
+}
+
+// true si con 'reply' ya está la respuesta completa.
+bool reply_complete(const std::vector<uint8_t> &reply, size_t expected)
+{
+  return expected == 0 ? !reply.empty() : reply.size() >= expected;
+}
+
+// Agrega a 'reply' lo que llegue hasta completar 'expected' bytes (o la
+// primera lectura con datos) o hasta 'deadline'.
+void read_until(int fd, size_t expected, Deadline deadline, std::vector<uint8_t> &reply)
+{
+  while (!reply_complete(reply, expected))
+  {
+    struct pollfd pfd = {fd, POLLIN, 0};
+    int ret;
+    do
+    {
+      ret = poll(&pfd, 1, remaining_ms(deadline));
+    } while (ret < 0 && errno == EINTR);
+    if (ret <= 0 || !(pfd.revents & POLLIN))
+      return;
+
+    uint8_t buffer[kReplyBytes];
+    ssize_t n = read(fd, buffer, sizeof(buffer));
+    if (n <= 0)
+      return;
+    reply.insert(reply.end(), buffer, buffer + n);
+  }
+}
+
+} // namespace
+
+bool device_write_all(int fd, const uint8_t *data, size_t length, bool sync, int *error,
+                      int stall_ms)
+{
+  while (length > 0)
+  {
+    ssize_t written = write(fd, data, length);
+    if (written < 0)
+    {
+      if (errno == EINTR)
+        continue;
+      if (errno == EAGAIN)
+      {
+        // fd O_NONBLOCK: se espera a que el dispositivo acepte más.
+        struct pollfd pfd = {fd, POLLOUT, 0};
+        int ret;
+        do
+        {
+          ret = poll(&pfd, 1, stall_ms);
+        } while (ret < 0 && errno == EINTR);
+        if (ret > 0)
+          continue;
+        *error = ret == 0 ? ETIMEDOUT : errno;
+        return false;
+      }
+      *error = errno;
+      return false;
+    }
+    data += written;
+    length -= static_cast<size_t>(written);
+  }
+  // Forzar a que los datos se envíen al dispositivo (usblp no implementa
+  // fsync: el resultado no importa).
+  if (sync)
+    fsync(fd);
+  return true;
+}
+
+std::vector<uint8_t> device_transact(int fd, const uint8_t *command, size_t length,
+                                     int timeout_ms, size_t expected, int *error)
+{
+  if (!device_write_all(fd, command, length, false, error))
+    return {};
+  std::vector<uint8_t> reply;
+  read_until(fd, expected,
+             std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms), reply);
+  return reply;
+}
@@ -0,0 +1,26 @@
+#ifndef FLUTTER_PLUGIN_TI_PRINTER_DEVICE_IO_H_
+#define FLUTTER_PLUGIN_TI_PRINTER_DEVICE_IO_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// E/S de los fds de impresora (USB y serie) que usa LaneWriter: write(),
+// fsync(), poll() y read() sobre el fd, desde el hilo de cada dispositivo.
+
+// Escribe 'length' bytes completos. Con 'sync' además hace fsync al final.
+// 'error' recibe el errno si falla. Con 'stall_ms' >= 0 (fd O_NONBLOCK)
+// falla con ETIMEDOUT si el dispositivo pasa ese tiempo sin aceptar bytes;
+// sin él, una impresora sin papel deja a usblp bloqueado para siempre.
+bool device_write_all(int fd, const uint8_t *data, size_t length, bool sync, int *error,
+                      int stall_ms = -1);
+
+// Escribe 'command' y espera hasta 'timeout_ms' la respuesta. Con
+// 'expected' en 0 devuelve los bytes de la primera lectura que trae algo;
+// si no, sigue leyendo hasta juntar 'expected' bytes y vuelve apenas los
+// tiene. Vacío (o lo que llegó) si se cumple el tiempo. 'error' recibe el
+// errno si falló la escritura.
+std::vector<uint8_t> device_transact(int fd, const uint8_t *command, size_t length,
+                                     int timeout_ms, size_t expected, int *error);
+
+#endif // FLUTTER_PLUGIN_TI_PRINTER_DEVICE_IO_H_
@@ -0,0 +1,509 @@
+#include "escpos_font.h"
+
+// Tablas generadas rasterizando DejaVu Sans Mono Bold (licencia Bitstream
+// Vera / dominio público) con FreeType en modo monocromo: 20 px en celdas
+// de 12x24 con la línea base en la fila 19 (fuente A) y 15 px en celdas de
+// 9x17 con la base en la fila 13 (fuente B). Orden de glifos: U+0020..U+007E
+// y luego U+00A0..U+00FF.
+
+namespace
+{
+
+const uint16_t kEscPosFontA[kEscPosGlyphCount][24] = {
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0020
+    {0x0000,0x0000,0x0000,0x0000,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0000,0x0000,0x0700,0x0700,0x0700,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0021
+    {0x0000,0x0000,0x0000,0x0000,0x38e0,0x38e0,0x38e0,0x38e0,0x38e0,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0022
+    {0x0000,0x0000,0x0000,0x0000,0x0660,0x0e60,0x0cc0,0x0cc0,0x7ff0,0x7ff0,0x1980,0x1980,0x1980,0xffe0,0xffe0,0x3300,0x3300,0x7300,0x6700,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0023
+    {0x0000,0x0000,0x0000,0x0000,0x0400,0x0400,0x1f00,0x3f80,0x7580,0x7400,0x7400,0x7c00,0x3f80,0x0780,0x05c0,0x45c0,0x65c0,0x7f80,0x3f00,0x0400,0x0400,0x0400,0x0000,0x0000}, // U+0024
+    {0x0000,0x0000,0x0000,0x0000,0x7800,0xfc00,0xcc00,0xcc00,0xfc20,0x78e0,0x0180,0x0600,0x1800,0x61e0,0x43f0,0x0330,0x0330,0x03f0,0x01e0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0025
+    {0x0000,0x0000,0x0000,0x0000,0x0780,0x1fc0,0x1c40,0x1c00,0x1e00,0x0e00,0x1f00,0x3f10,0x7390,0x71d0,0x71f0,0x70f0,0x78f0,0x3ff0,0x0fb0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0026
+    {0x0000,0x0000,0x0000,0x0000,0x0700,0x0700,0x0700,0x0700,0x0700,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0027
+    {0x0000,0x0000,0x0000,0x0000,0x0180,0x0300,0x0300,0x0700,0x0700,0x0e00,0x0e00,0x0e00,0x0e00,0x0e00,0x0e00,0x0e00,0x0e00,0x0700,0x0700,0x0300,0x0300,0x0180,0x0000,0x0000}, // U+0028
+    {0x0000,0x0000,0x0000,0x0000,0x0c00,0x0600,0x0600,0x0700,0x0700,0x0380,0x0380,0x0380,0x0380,0x0380,0x0380,0x0380,0x0380,0x0700,0x0700,0x0600,0x0600,0x0c00,0x0000,0x0000}, // U+0029
+    {0x0000,0x0000,0x0000,0x0000,0x0600,0x0600,0x6660,0x7fe0,0x1f80,0x1f80,0x7fe0,0x6660,0x0600,0x0600,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+002A
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0600,0x0600,0x0600,0x0600,0x7fe0,0x7fe0,0x0600,0x0600,0x0600,0x0600,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+002B
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0700,0x0700,0x0700,0x0600,0x0e00,0x0c00,0x0000,0x0000,0x0000}, // U+002C
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x1f80,0x1f80,0x1f80,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+002D
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0e00,0x0e00,0x0e00,0x0e00,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+002E
+    {0x0000,0x0000,0x0000,0x0000,0x0060,0x00c0,0x00c0,0x0180,0x0180,0x0300,0x0300,0x0600,0x0600,0x0c00,0x0c00,0x1800,0x1800,0x3000,0x3000,0x6000,0x0000,0x0000,0x0000,0x0000}, // U+002F
+    {0x0000,0x0000,0x0000,0x0000,0x0f00,0x1f80,0x39c0,0x30e0,0x70e0,0x70e0,0x76e0,0x76e0,0x70e0,0x70e0,0x70e0,0x30e0,0x39c0,0x1f80,0x0f00,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0030
+    {0x0000,0x0000,0x0000,0x0000,0x0f00,0x3f00,0x3700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x3fe0,0x3fe0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0031
+    {0x0000,0x0000,0x0000,0x0000,0x3f00,0x7fc0,0x61e0,0x40e0,0x00e0,0x00e0,0x01c0,0x0380,0x0780,0x0f00,0x1e00,0x3c00,0x3800,0x7fe0,0x7fe0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0032
+    {0x0000,0x0000,0x0000,0x0000,0x3f80,0x7fc0,0x61e0,0x40e0,0x00e0,0x01e0,0x0f80,0x0f80,0x01c0,0x00e0,0x00e0,0x40e0,0x61e0,0x7fc0,0x3f80,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0033
+    {0x0000,0x0000,0x0000,0x0000,0x0380,0x0780,0x0780,0x0f80,0x1f80,0x1b80,0x3380,0x3380,0x6380,0x7fe0,0x7fe0,0x0380,0x0380,0x0380,0x0380,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0034
+    {0x0000,0x0000,0x0000,0x0000,0x7fc0,0x7fc0,0x7000,0x7000,0x7000,0x7f00,0x7fc0,0x41c0,0x00e0,0x00e0,0x00e0,0x00e0,0x61c0,0x7fc0,0x3f00,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0035
+    {0x0000,0x0000,0x0000,0x0000,0x0f80,0x1fc0,0x3840,0x3800,0x7000,0x7780,0x7fc0,0x79e0,0x70e0,0x70e0,0x70e0,0x70e0,0x39c0,0x3fc0,0x0f80,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0036
+    {0x0000,0x0000,0x0000,0x0000,0x7fe0,0x7fe0,0x00e0,0x01c0,0x01c0,0x0380,0x0380,0x0780,0x0700,0x0f00,0x0e00,0x0e00,0x1c00,0x1c00,0x3800,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0037
+    {0x0000,0x0000,0x0000,0x0000,0x1f80,0x3fc0,0x79e0,0x70e0,0x70e0,0x39c0,0x1f80,0x1f80,0x39c0,0x70e0,0x70e0,0x70e0,0x79e0,0x3fc0,0x1f80,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0038
+    {0x0000,0x0000,0x0000,0x0000,0x1f00,0x3fc0,0x79c0,0x70e0,0x70e0,0x70e0,0x70e0,0x79e0,0x3fe0,0x1ee0,0x00e0,0x01c0,0x21c0,0x3f80,0x1f00,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0039
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0e00,0x0e00,0x0e00,0x0e00,0x0000,0x0000,0x0e00,0x0e00,0x0e00,0x0e00,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+003A
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0e00,0x0e00,0x0e00,0x0e00,0x0000,0x0000,0x0e00,0x0e00,0x0e00,0x0c00,0x1c00,0x1800,0x0000,0x0000,0x0000}, // U+003B
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0020,0x01e0,0x07e0,0x3f00,0x7800,0x7800,0x3f00,0x07e0,0x01e0,0x0020,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+003C
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x7fe0,0x7fe0,0x0000,0x0000,0x7fe0,0x7fe0,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+003D
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x4000,0x7800,0x7e00,0x0fc0,0x01e0,0x01e0,0x0fc0,0x7e00,0x7800,0x4000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+003E
+    {0x0000,0x0000,0x0000,0x0000,0x1f00,0x3fc0,0x21c0,0x01c0,0x01c0,0x0380,0x0700,0x0e00,0x0e00,0x0e00,0x0e00,0x0000,0x0e00,0x0e00,0x0e00,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+003F
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0f80,0x1fc0,0x38e0,0x6060,0x63e0,0xc7e0,0xcee0,0xcc60,0xcc60,0xcc60,0xcee0,0xc7e0,0x63e0,0x7000,0x3840,0x1fe0,0x0fc0,0x0000,0x0000}, // U+0040
+    {0x0000,0x0000,0x0000,0x0000,0x0f00,0x0f00,0x0f00,0x0f00,0x1f80,0x1f80,0x1980,0x1980,0x39c0,0x3fc0,0x3fc0,0x39c0,0x31c0,0x70e0,0x70e0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0041
+    {0x0000,0x0000,0x0000,0x0000,0x7f00,0x7f80,0x71c0,0x71c0,0x71c0,0x71c0,0x7f80,0x7f80,0x71c0,0x70e0,0x70e0,0x70e0,0x71e0,0x7fc0,0x7f80,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0042
+    {0x0000,0x0000,0x0000,0x0000,0x07c0,0x1fe0,0x3c60,0x3800,0x7000,0x7000,0x7000,0x7000,0x7000,0x7000,0x7000,0x3800,0x3c60,0x1fe0,0x07c0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0043
+    {0x0000,0x0000,0x0000,0x0000,0x7e00,0x7f80,0x71c0,0x71c0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x71c0,0x71c0,0x7f80,0x7e00,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0044
+    {0x0000,0x0000,0x0000,0x0000,0x7fe0,0x7fe0,0x7000,0x7000,0x7000,0x7000,0x7fc0,0x7fc0,0x7000,0x7000,0x7000,0x7000,0x7000,0x7fe0,0x7fe0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0045
+    {0x0000,0x0000,0x0000,0x0000,0x7fe0,0x7fe0,0x7000,0x7000,0x7000,0x7000,0x7fc0,0x7fc0,0x7000,0x7000,0x7000,0x7000,0x7000,0x7000,0x7000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0046
+    {0x0000,0x0000,0x0000,0x0000,0x0f80,0x1fc0,0x3840,0x3800,0x7000,0x7000,0x7000,0x73e0,0x73e0,0x70e0,0x70e0,0x38e0,0x38e0,0x1fe0,0x0fc0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0047
+    {0x0000,0x0000,0x0000,0x0000,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x7fe0,0x7fe0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0048
+    {0x0000,0x0000,0x0000,0x0000,0x3fe0,0x3fe0,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x3fe0,0x3fe0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0049
+    {0x0000,0x0000,0x0000,0x0000,0x0fe0,0x0fe0,0x00e0,0x00e0,0x00e0,0x00e0,0x00e0,0x00e0,0x00e0,0x00e0,0x00e0,0x40e0,0x61e0,0x7fc0,0x3f80,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+004A
+    {0x0000,0x0000,0x0000,0x0000,0x70e0,0x71e0,0x71c0,0x7380,0x7700,0x7e00,0x7e00,0x7f00,0x7f80,0x7380,0x73c0,0x71c0,0x71e0,0x70e0,0x70f0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+004B
+    {0x0000,0x0000,0x0000,0x0000,0x7000,0x7000,0x7000,0x7000,0x7000,0x7000,0x7000,0x7000,0x7000,0x7000,0x7000,0x7000,0x7000,0x7fe0,0x7fe0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+004C
+    {0x0000,0x0000,0x0000,0x0000,0x70e0,0x70e0,0x79e0,0x79e0,0x79e0,0x7fe0,0x76e0,0x76e0,0x76e0,0x76e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+004D
+    {0x0000,0x0000,0x0000,0x0000,0x78e0,0x78e0,0x78e0,0x7ce0,0x7ce0,0x7ce0,0x76e0,0x76e0,0x76e0,0x73e0,0x73e0,0x73e0,0x71e0,0x71e0,0x71e0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+004E
+    {0x0000,0x0000,0x0000,0x0000,0x0f00,0x1f80,0x39c0,0x30c0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x30c0,0x39c0,0x1f80,0x0f00,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+004F
+    {0x0000,0x0000,0x0000,0x0000,0x7f80,0x7fc0,0x71e0,0x70e0,0x70e0,0x70e0,0x71e0,0x7fc0,0x7f80,0x7000,0x7000,0x7000,0x7000,0x7000,0x7000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0050
+    {0x0000,0x0000,0x0000,0x0000,0x0f00,0x1f80,0x39c0,0x30c0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x30e0,0x39c0,0x1fc0,0x0f80,0x01c0,0x0080,0x0000,0x0000,0x0000}, // U+0051
+    {0x0000,0x0000,0x0000,0x0000,0x7f80,0x7fc0,0x71e0,0x70e0,0x70e0,0x70e0,0x71e0,0x7fc0,0x7f80,0x73c0,0x71c0,0x70e0,0x70e0,0x70e0,0x7070,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0052
+    {0x0000,0x0000,0x0000,0x0000,0x1f80,0x3fc0,0x78c0,0x7040,0x7000,0x7800,0x3f00,0x1fc0,0x07c0,0x01e0,0x00e0,0x40e0,0x61e0,0x7fc0,0x3f80,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0053
+    {0x0000,0x0000,0x0000,0x0000,0x7ff0,0x7ff0,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0054
+    {0x0000,0x0000,0x0000,0x0000,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x79e0,0x3fc0,0x1f80,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0055
+    {0x0000,0x0000,0x0000,0x0000,0x70e0,0x70e0,0x30c0,0x39c0,0x39c0,0x39c0,0x39c0,0x1980,0x1980,0x1f80,0x1f80,0x1f80,0x0f00,0x0f00,0x0f00,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0056
+    {0x0000,0x0000,0x0000,0x0000,0xe070,0xe070,0xe070,0xe070,0x6660,0x6660,0x6f60,0x6f60,0x6f60,0x6f60,0x79e0,0x79e0,0x79e0,0x39c0,0x38c0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0057
+    {0x0000,0x0000,0x0000,0x0000,0x70e0,0x39c0,0x39c0,0x1f80,0x1f80,0x0f00,0x0f00,0x0600,0x0f00,0x0f00,0x1f80,0x1b80,0x39c0,0x39c0,0x70e0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0058
+    {0x0000,0x0000,0x0000,0x0000,0xe030,0x7070,0x7070,0x38e0,0x3de0,0x1dc0,0x0f80,0x0f80,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0059
+    {0x0000,0x0000,0x0000,0x0000,0x7fe0,0x7fe0,0x00e0,0x01c0,0x03c0,0x0380,0x0700,0x0f00,0x0e00,0x1c00,0x3c00,0x3800,0x7000,0x7fe0,0x7fe0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+005A
+    {0x0000,0x0000,0x0000,0x0000,0x0f80,0x0f80,0x0e00,0x0e00,0x0e00,0x0e00,0x0e00,0x0e00,0x0e00,0x0e00,0x0e00,0x0e00,0x0e00,0x0e00,0x0e00,0x0e00,0x0f80,0x0f80,0x0000,0x0000}, // U+005B
+    {0x0000,0x0000,0x0000,0x0000,0x6000,0x3000,0x3000,0x1800,0x1800,0x0c00,0x0c00,0x0600,0x0600,0x0300,0x0300,0x0180,0x0180,0x00c0,0x00c0,0x0060,0x0000,0x0000,0x0000,0x0000}, // U+005C
+    {0x0000,0x0000,0x0000,0x0000,0x1f00,0x1f00,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x1f00,0x1f00,0x0000,0x0000}, // U+005D
+    {0x0000,0x0000,0x0000,0x0000,0x0700,0x0f80,0x1dc0,0x38e0,0x7070,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+005E
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0xfff0,0xfff0}, // U+005F
+    {0x0000,0x0000,0x0000,0x3800,0x1c00,0x0e00,0x0700,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0060
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x1f80,0x3fc0,0x20e0,0x00e0,0x1fe0,0x3fe0,0x70e0,0x70e0,0x71e0,0x3fe0,0x1ee0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0061
+    {0x0000,0x0000,0x0000,0x0000,0x7000,0x7000,0x7000,0x7000,0x7780,0x7fc0,0x79e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x79e0,0x7fc0,0x7780,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0062
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0fc0,0x1fe0,0x3820,0x7000,0x7000,0x7000,0x7000,0x7000,0x3820,0x1fe0,0x0fc0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0063
+    {0x0000,0x0000,0x0000,0x0000,0x00e0,0x00e0,0x00e0,0x00e0,0x1ee0,0x3fe0,0x79e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x79e0,0x3fe0,0x1ee0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0064
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0f80,0x3fc0,0x39e0,0x70e0,0x7fe0,0x7fe0,0x7000,0x7000,0x3820,0x3fe0,0x0fc0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0065
+    {0x0000,0x0000,0x0000,0x0000,0x07c0,0x0fc0,0x0e00,0x0e00,0x7fc0,0x7fc0,0x0e00,0x0e00,0x0e00,0x0e00,0x0e00,0x0e00,0x0e00,0x0e00,0x0e00,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0066
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x1ee0,0x3fe0,0x39e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x39e0,0x3fe0,0x1ee0,0x00e0,0x21e0,0x3fc0,0x1f80,0x0000}, // U+0067
+    {0x0000,0x0000,0x0000,0x0000,0x7000,0x7000,0x7000,0x7000,0x7780,0x7fc0,0x78e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0068
+    {0x0000,0x0000,0x0000,0x0700,0x0700,0x0700,0x0000,0x0000,0x3f00,0x3f00,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x7ff0,0x7ff0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0069
+    {0x0000,0x0000,0x0000,0x0700,0x0700,0x0700,0x0000,0x0000,0x3f00,0x3f00,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x7e00,0x7c00,0x0000}, // U+006A
+    {0x0000,0x0000,0x0000,0x0000,0x7000,0x7000,0x7000,0x7000,0x71c0,0x7380,0x7700,0x7e00,0x7e00,0x7f00,0x7700,0x7380,0x7380,0x71c0,0x70e0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+006B
+    {0x0000,0x0000,0x0000,0x0000,0x7e00,0x7e00,0x0e00,0x0e00,0x0e00,0x0e00,0x0e00,0x0e00,0x0e00,0x0e00,0x0e00,0x0e00,0x0e00,0x07e0,0x03e0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+006C
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x7dc0,0x7fe0,0x6660,0x6660,0x6660,0x6660,0x6660,0x6660,0x6660,0x6660,0x6660,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+006D
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x7780,0x7fc0,0x78e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+006E
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0f00,0x3fc0,0x39c0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x39c0,0x3fc0,0x0f00,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+006F
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x7780,0x7fc0,0x79e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x79e0,0x7fc0,0x7780,0x7000,0x7000,0x7000,0x7000,0x0000}, // U+0070
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x1ee0,0x3fe0,0x79e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x79e0,0x3fe0,0x1ee0,0x00e0,0x00e0,0x00e0,0x00e0,0x0000}, // U+0071
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x1dc0,0x1fe0,0x1e20,0x1c00,0x1c00,0x1c00,0x1c00,0x1c00,0x1c00,0x1c00,0x1c00,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0072
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x1f80,0x3fc0,0x7040,0x7000,0x7f00,0x3fc0,0x07e0,0x00e0,0x40e0,0x7fc0,0x3f80,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0073
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0e00,0x0e00,0x0e00,0x7fe0,0x7fe0,0x0e00,0x0e00,0x0e00,0x0e00,0x0e00,0x0e00,0x0e00,0x0fe0,0x07e0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0074
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x71e0,0x3fe0,0x1ee0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0075
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x70e0,0x70e0,0x39c0,0x39c0,0x39c0,0x1980,0x1f80,0x1f80,0x0f00,0x0f00,0x0f00,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0076
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0xc030,0xe070,0xe070,0x6660,0x6660,0x6f60,0x6f60,0x7fe0,0x39c0,0x39c0,0x39c0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0077
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x79e0,0x39c0,0x1f80,0x1f80,0x0f00,0x0f00,0x0f00,0x1f80,0x1980,0x39c0,0x79e0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0078
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x70e0,0x38e0,0x39c0,0x39c0,0x1dc0,0x1d80,0x1f80,0x0f80,0x0f00,0x0700,0x0700,0x0600,0x0e00,0x3c00,0x3c00,0x0000}, // U+0079
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x7fe0,0x7fe0,0x01e0,0x03c0,0x0780,0x0f00,0x1e00,0x3c00,0x7800,0x7fe0,0x7fe0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+007A
+    {0x0000,0x0000,0x0000,0x0000,0x03e0,0x07e0,0x0700,0x0700,0x0700,0x0700,0x0700,0x0f00,0x3e00,0x3e00,0x0f00,0x0700,0x0700,0x0700,0x0700,0x0700,0x07e0,0x03e0,0x0000,0x0000}, // U+007B
+    {0x0000,0x0000,0x0000,0x0000,0x0600,0x0600,0x0600,0x0600,0x0600,0x0600,0x0600,0x0600,0x0600,0x0600,0x0600,0x0600,0x0600,0x0600,0x0600,0x0600,0x0600,0x0600,0x0600,0x0600}, // U+007C
+    {0x0000,0x0000,0x0000,0x0000,0x3e00,0x3f00,0x0700,0x0700,0x0700,0x0700,0x0700,0x0780,0x03e0,0x03e0,0x0780,0x0700,0x0700,0x0700,0x0700,0x0700,0x3f00,0x3e00,0x0000,0x0000}, // U+007D
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x3c20,0x7fe0,0x43c0,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+007E
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00A0
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0700,0x0700,0x0700,0x0000,0x0000,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0000}, // U+00A1
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0100,0x0100,0x0100,0x0f80,0x1fc0,0x3940,0x7100,0x7100,0x7100,0x7100,0x7100,0x3940,0x1fc0,0x0780,0x0100,0x0100,0x0100,0x0000,0x0000}, // U+00A2
+    {0x0000,0x0000,0x0000,0x0000,0x07c0,0x0fe0,0x1e20,0x1c00,0x1c00,0x1c00,0x1c00,0x7f80,0x7f80,0x1c00,0x1c00,0x1c00,0x1c00,0x7fe0,0x7fe0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00A3
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x1040,0x3fe0,0x1fc0,0x18c0,0x18c0,0x18c0,0x1fc0,0x3fe0,0x1040,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00A4
+    {0x0000,0x0000,0x0000,0x0000,0xe030,0x7070,0x38e0,0x38e0,0x1dc0,0x7df0,0x7ff0,0x0700,0x7ff0,0x7ff0,0x0700,0x0700,0x0700,0x0700,0x0700,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00A5
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0600,0x0600,0x0600,0x0600,0x0600,0x0600,0x0600,0x0000,0x0000,0x0000,0x0600,0x0600,0x0600,0x0600,0x0600,0x0600,0x0600,0x0000,0x0000}, // U+00A6
+    {0x0000,0x0000,0x0000,0x0000,0x0780,0x1fc0,0x1c40,0x1c00,0x1c00,0x0e00,0x1f80,0x39e0,0x38e0,0x1ce0,0x0fc0,0x0380,0x01c0,0x01c0,0x11c0,0x1fc0,0x0f80,0x0000,0x0000,0x0000}, // U+00A7
+    {0x0000,0x0000,0x0000,0x0000,0x1980,0x1980,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00A8
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0f00,0x30c0,0x4020,0x4f20,0x9810,0x9810,0x9810,0x9810,0x4f20,0x4020,0x30c0,0x0f00,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00A9
+    {0x0000,0x0000,0x0000,0x0000,0x0f80,0x0fc0,0x00c0,0x0fc0,0x18c0,0x19c0,0x1fc0,0x0ec0,0x0000,0x0fc0,0x0fc0,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00AA
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0420,0x0c60,0x1ce0,0x7380,0x6300,0x7380,0x1ce0,0x0c60,0x0420,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00AB
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x7fe0,0x7fe0,0x0060,0x0060,0x0060,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00AC
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x1f80,0x1f80,0x1f80,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00AD
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0f00,0x30c0,0x4020,0x5f20,0x9990,0x9990,0x9f10,0x9b90,0x59a0,0x4020,0x30c0,0x0f00,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00AE
+    {0x0000,0x0000,0x0000,0x0000,0x1f80,0x1f80,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00AF
+    {0x0000,0x0000,0x0000,0x0000,0x0700,0x0f80,0x18c0,0x18c0,0x18c0,0x0f80,0x0700,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00B0
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0600,0x0600,0x0600,0x7fe0,0x7fe0,0x0600,0x0600,0x0600,0x0000,0x0000,0x7fe0,0x7fe0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00B1
+    {0x0000,0x0000,0x0000,0x0000,0x0f00,0x1180,0x0180,0x0380,0x0700,0x0600,0x0800,0x1f80,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00B2
+    {0x0000,0x0000,0x0000,0x0000,0x0f80,0x10c0,0x00c0,0x0700,0x00c0,0x00c0,0x10c0,0x0f80,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00B3
+    {0x0000,0x0000,0x0000,0x00e0,0x01c0,0x0380,0x0700,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00B4
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x79e0,0x7ff0,0x7f70,0x7000,0x7000,0x7000,0x7000,0x0000}, // U+00B5
+    {0x0000,0x0000,0x0000,0x0000,0x1fe0,0x3e60,0x7e60,0x7e60,0x7e60,0x7e60,0x3e60,0x1e60,0x0660,0x0660,0x0660,0x0660,0x0660,0x0660,0x0660,0x0660,0x0660,0x0000,0x0000,0x0000}, // U+00B6
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0e00,0x0e00,0x0e00,0x0e00,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00B7
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0200,0x0300,0x1f00,0x1e00,0x0000}, // U+00B8
+    {0x0000,0x0000,0x0000,0x0000,0x1e00,0x0600,0x0600,0x0600,0x0600,0x0600,0x0600,0x1f80,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00B9
+    {0x0000,0x0000,0x0000,0x0000,0x0700,0x0f80,0x18c0,0x18c0,0x18c0,0x18c0,0x0f80,0x0700,0x0000,0x1fc0,0x1fc0,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00BA
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x2100,0x3180,0x39c0,0x0e70,0x0630,0x0e70,0x39c0,0x3180,0x2100,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00BB
+    {0x0000,0x0000,0xf000,0x3000,0x3000,0x3000,0x3000,0x3000,0x3000,0xfc00,0x0060,0x0780,0x3c00,0xc1c0,0x03c0,0x02c0,0x04c0,0x08c0,0x0fe0,0x00c0,0x00c0,0x0000,0x0000,0x0000}, // U+00BC
+    {0x0000,0x0000,0xf000,0x3000,0x3000,0x3000,0x3000,0x3000,0x3000,0xfc00,0x0060,0x0780,0x3c00,0xc3c0,0x0460,0x0060,0x00c0,0x01c0,0x0380,0x0600,0x07e0,0x0000,0x0000,0x0000}, // U+00BD
+    {0x0000,0x0000,0x3e00,0x4300,0x0300,0x1c00,0x0700,0x0300,0x4700,0x3e00,0x0060,0x0780,0x3c00,0xc1c0,0x03c0,0x02c0,0x04c0,0x08c0,0x0fe0,0x00c0,0x00c0,0x0000,0x0000,0x0000}, // U+00BE
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0700,0x0700,0x0700,0x0000,0x0700,0x0700,0x0700,0x0700,0x0e00,0x1c00,0x3800,0x3800,0x3840,0x3fc0,0x0f80,0x0000}, // U+00BF
+    {0x1c00,0x0e00,0x0700,0x0000,0x0f00,0x0f00,0x0f00,0x0f00,0x1f80,0x1f80,0x1980,0x1980,0x39c0,0x3fc0,0x3fc0,0x39c0,0x31c0,0x70e0,0x70e0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00C0
+    {0x01c0,0x0380,0x0700,0x0000,0x0f00,0x0f00,0x0f00,0x0f00,0x1f80,0x1f80,0x1980,0x1980,0x39c0,0x3fc0,0x3fc0,0x39c0,0x31c0,0x70e0,0x70e0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00C1
+    {0x0f00,0x0f00,0x1980,0x0000,0x0f00,0x0f00,0x0f00,0x0f00,0x1f80,0x1f80,0x1980,0x1980,0x39c0,0x3fc0,0x3fc0,0x39c0,0x31c0,0x70e0,0x70e0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00C2
+    {0x0c80,0x1f80,0x1300,0x0000,0x0f00,0x0f00,0x0f00,0x0f00,0x1f80,0x1f80,0x1980,0x1980,0x39c0,0x3fc0,0x3fc0,0x39c0,0x31c0,0x70e0,0x70e0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00C3
+    {0x1980,0x1980,0x0000,0x0000,0x0f00,0x0f00,0x0f00,0x0f00,0x1f80,0x1f80,0x1980,0x1980,0x39c0,0x3fc0,0x3fc0,0x39c0,0x31c0,0x70e0,0x70e0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00C4
+    {0x0600,0x0900,0x0900,0x0900,0x0600,0x0600,0x0600,0x0f00,0x0f00,0x0f00,0x1f80,0x1980,0x1980,0x1f80,0x3fc0,0x39c0,0x39c0,0x70e0,0x70e0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00C5
+    {0x0000,0x0000,0x0000,0x0000,0x1ff0,0x1ff0,0x1b80,0x1b80,0x3b80,0x3b80,0x33f0,0x33f0,0x3380,0x7f80,0x7f80,0x6380,0x6380,0xe3f0,0xe3f0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00C6
+    {0x0000,0x0000,0x0000,0x0000,0x07c0,0x1fe0,0x3c60,0x3800,0x7000,0x7000,0x7000,0x7000,0x7000,0x7000,0x7000,0x3800,0x3c60,0x1fe0,0x07c0,0x0180,0x0180,0x0f80,0x0f80,0x0000}, // U+00C7
+    {0x0e00,0x0600,0x0300,0x0000,0x7fe0,0x7fe0,0x7000,0x7000,0x7000,0x7000,0x7fc0,0x7fc0,0x7000,0x7000,0x7000,0x7000,0x7000,0x7fe0,0x7fe0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00C8
+    {0x01c0,0x0380,0x0300,0x0000,0x7fe0,0x7fe0,0x7000,0x7000,0x7000,0x7000,0x7fc0,0x7fc0,0x7000,0x7000,0x7000,0x7000,0x7000,0x7fe0,0x7fe0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00C9
+    {0x0f00,0x1b00,0x1180,0x0000,0x7fe0,0x7fe0,0x7000,0x7000,0x7000,0x7000,0x7fc0,0x7fc0,0x7000,0x7000,0x7000,0x7000,0x7000,0x7fe0,0x7fe0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00CA
+    {0x1980,0x1980,0x0000,0x0000,0x7fe0,0x7fe0,0x7000,0x7000,0x7000,0x7000,0x7fc0,0x7fc0,0x7000,0x7000,0x7000,0x7000,0x7000,0x7fe0,0x7fe0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00CB
+    {0x1c00,0x0e00,0x0700,0x0000,0x3fe0,0x3fe0,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x3fe0,0x3fe0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00CC
+    {0x01c0,0x0380,0x0700,0x0000,0x3fe0,0x3fe0,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x3fe0,0x3fe0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00CD
+    {0x0700,0x0d80,0x18c0,0x0000,0x3fe0,0x3fe0,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x3fe0,0x3fe0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00CE
+    {0x0d80,0x0d80,0x0000,0x0000,0x3fe0,0x3fe0,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x3fe0,0x3fe0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00CF
+    {0x0000,0x0000,0x0000,0x0000,0x7e00,0x7f80,0x71c0,0x71c0,0x70e0,0x70e0,0xfce0,0xfce0,0x70e0,0x70e0,0x70e0,0x71c0,0x71c0,0x7f80,0x7e00,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00D0
+    {0x0c80,0x1f80,0x1300,0x0000,0x78e0,0x78e0,0x78e0,0x7ce0,0x7ce0,0x7ce0,0x76e0,0x76e0,0x76e0,0x73e0,0x73e0,0x73e0,0x71e0,0x71e0,0x71e0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00D1
+    {0x1c00,0x0e00,0x0700,0x0000,0x0f00,0x1f80,0x39c0,0x30c0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x30c0,0x39c0,0x1f80,0x0f00,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00D2
+    {0x01c0,0x0380,0x0700,0x0000,0x0f00,0x1f80,0x39c0,0x30c0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x30c0,0x39c0,0x1f80,0x0f00,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00D3
+    {0x0f00,0x0f00,0x1980,0x0000,0x0f00,0x1f80,0x39c0,0x30c0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x30c0,0x39c0,0x1f80,0x0f00,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00D4
+    {0x0c80,0x1f80,0x1300,0x0000,0x0f00,0x1f80,0x39c0,0x30c0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x30c0,0x39c0,0x1f80,0x0f00,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00D5
+    {0x1980,0x1980,0x0000,0x0000,0x0f00,0x1f80,0x39c0,0x30c0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x30c0,0x39c0,0x1f80,0x0f00,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00D6
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x2040,0x70e0,0x39c0,0x1f80,0x0f00,0x0f00,0x1f80,0x39c0,0x70e0,0x2040,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00D7
+    {0x0000,0x0000,0x0000,0x0000,0x0f70,0x1fe0,0x39c0,0x31e0,0x71e0,0x73e0,0x77e0,0x76e0,0x7ce0,0x7ce0,0x78e0,0x78c0,0x39c0,0x7f80,0xcf00,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00D8
+    {0x1c00,0x0e00,0x0700,0x0000,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x79e0,0x3fc0,0x1f80,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00D9
+    {0x01c0,0x0380,0x0700,0x0000,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x79e0,0x3fc0,0x1f80,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00DA
+    {0x0f00,0x0f00,0x1980,0x0000,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x79e0,0x3fc0,0x1f80,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00DB
+    {0x1980,0x1980,0x0000,0x0000,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x79e0,0x3fc0,0x1f80,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00DC
+    {0x01c0,0x0380,0x0700,0x0000,0xe030,0x7070,0x7070,0x38e0,0x3de0,0x1dc0,0x0f80,0x0f80,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00DD
+    {0x0000,0x0000,0x0000,0x0000,0x7000,0x7000,0x7f80,0x7fc0,0x71e0,0x70e0,0x70e0,0x70e0,0x71e0,0x7fc0,0x7f80,0x7000,0x7000,0x7000,0x7000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00DE
+    {0x0000,0x0000,0x0000,0x0000,0x1f00,0x3f80,0x78c0,0x70c0,0x73c0,0x7700,0x7700,0x7700,0x7780,0x73c0,0x70e0,0x70e0,0x70e0,0x77e0,0x77c0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00DF
+    {0x0000,0x0000,0x0000,0x3800,0x1c00,0x0e00,0x0700,0x0000,0x1f80,0x3fc0,0x20e0,0x00e0,0x1fe0,0x3fe0,0x70e0,0x70e0,0x71e0,0x3fe0,0x1ee0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00E0
+    {0x0000,0x0000,0x0000,0x00e0,0x01c0,0x0380,0x0700,0x0000,0x1f80,0x3fc0,0x20e0,0x00e0,0x1fe0,0x3fe0,0x70e0,0x70e0,0x71e0,0x3fe0,0x1ee0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00E1
+    {0x0000,0x0000,0x0000,0x0e00,0x1f00,0x1b00,0x3180,0x0000,0x1f80,0x3fc0,0x20e0,0x00e0,0x1fe0,0x3fe0,0x70e0,0x70e0,0x71e0,0x3fe0,0x1ee0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00E2
+    {0x0000,0x0000,0x0000,0x0e40,0x1fc0,0x1380,0x0000,0x0000,0x1f80,0x3fc0,0x20e0,0x00e0,0x1fe0,0x3fe0,0x70e0,0x70e0,0x71e0,0x3fe0,0x1ee0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00E3
+    {0x0000,0x0000,0x0000,0x0000,0x1980,0x1980,0x0000,0x0000,0x1f80,0x3fc0,0x20e0,0x00e0,0x1fe0,0x3fe0,0x70e0,0x70e0,0x71e0,0x3fe0,0x1ee0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00E4
+    {0x0000,0x0f00,0x1f80,0x1980,0x1980,0x1f80,0x0f00,0x0000,0x1f80,0x3fc0,0x20e0,0x00e0,0x1fe0,0x3fe0,0x70e0,0x70e0,0x71e0,0x3fe0,0x1ee0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00E5
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x7bc0,0xffe0,0x8e60,0x0e60,0x7fe0,0xffe0,0x8e00,0x8e00,0x8f20,0xfbe0,0xf9c0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00E6
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0fc0,0x1fe0,0x3820,0x7000,0x7000,0x7000,0x7000,0x7000,0x3820,0x1fe0,0x0fc0,0x0100,0x0180,0x0f80,0x0f00,0x0000}, // U+00E7
+    {0x0000,0x0000,0x0000,0x1c00,0x0e00,0x0600,0x0300,0x0000,0x0f80,0x3fc0,0x39e0,0x70e0,0x7fe0,0x7fe0,0x7000,0x7000,0x3820,0x3fe0,0x0fc0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00E8
+    {0x0000,0x0000,0x0000,0x00e0,0x01c0,0x0380,0x0300,0x0000,0x0f80,0x3fc0,0x39e0,0x70e0,0x7fe0,0x7fe0,0x7000,0x7000,0x3820,0x3fe0,0x0fc0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00E9
+    {0x0000,0x0000,0x0000,0x0e00,0x0f00,0x1900,0x1180,0x0000,0x0f80,0x3fc0,0x39e0,0x70e0,0x7fe0,0x7fe0,0x7000,0x7000,0x3820,0x3fe0,0x0fc0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00EA
+    {0x0000,0x0000,0x0000,0x0000,0x1980,0x1980,0x0000,0x0000,0x0f80,0x3fc0,0x39e0,0x70e0,0x7fe0,0x7fe0,0x7000,0x7000,0x3820,0x3fe0,0x0fc0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00EB
+    {0x0000,0x0000,0x0000,0x3800,0x1c00,0x0e00,0x0700,0x0000,0x3f00,0x3f00,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x7ff0,0x7ff0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00EC
+    {0x0000,0x0000,0x0000,0x00e0,0x01c0,0x0380,0x0700,0x0000,0x3f00,0x3f00,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x7ff0,0x7ff0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00ED
+    {0x0000,0x0000,0x0000,0x0e00,0x1f00,0x1b00,0x3180,0x0000,0x3f00,0x3f00,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x7ff0,0x7ff0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00EE
+    {0x0000,0x0000,0x0000,0x0000,0x1980,0x1980,0x0000,0x0000,0x3f00,0x3f00,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x0700,0x7ff0,0x7ff0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00EF
+    {0x0000,0x0000,0x0000,0x0000,0x1cc0,0x0f80,0x1f00,0x3300,0x0380,0x1fc0,0x3fc0,0x78e0,0x70e0,0x70e0,0x70e0,0x70e0,0x39c0,0x3fc0,0x0f00,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00F0
+    {0x0000,0x0000,0x0000,0x0e40,0x1fc0,0x1380,0x0000,0x0000,0x7780,0x7fc0,0x78e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00F1
+    {0x0000,0x0000,0x0000,0x3800,0x1c00,0x0e00,0x0700,0x0000,0x0f00,0x3fc0,0x39c0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x39c0,0x3fc0,0x0f00,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00F2
+    {0x0000,0x0000,0x0000,0x00e0,0x01c0,0x0380,0x0700,0x0000,0x0f00,0x3fc0,0x39c0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x39c0,0x3fc0,0x0f00,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00F3
+    {0x0000,0x0000,0x0000,0x0600,0x0f00,0x0900,0x1980,0x0000,0x0f00,0x3fc0,0x39c0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x39c0,0x3fc0,0x0f00,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00F4
+    {0x0000,0x0000,0x0000,0x0c80,0x1f80,0x1300,0x0000,0x0000,0x0f00,0x3fc0,0x39c0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x39c0,0x3fc0,0x0f00,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00F5
+    {0x0000,0x0000,0x0000,0x0000,0x1980,0x1980,0x0000,0x0000,0x0f00,0x3fc0,0x39c0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x39c0,0x3fc0,0x0f00,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00F6
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0700,0x0700,0x0700,0x0000,0x7ff0,0x7ff0,0x0000,0x0700,0x0700,0x0700,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00F7
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0020,0x0f60,0x3fc0,0x39c0,0x73e0,0x73e0,0x76e0,0x7ce0,0x7ce0,0x39c0,0x3fc0,0x6f00,0x4000,0x0000,0x0000,0x0000,0x0000}, // U+00F8
+    {0x0000,0x0000,0x0000,0x3800,0x1c00,0x0e00,0x0700,0x0000,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x71e0,0x3fe0,0x1ee0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00F9
+    {0x0000,0x0000,0x0000,0x00e0,0x01c0,0x0380,0x0700,0x0000,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x71e0,0x3fe0,0x1ee0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00FA
+    {0x0000,0x0000,0x0000,0x0600,0x0f00,0x0900,0x1980,0x0000,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x71e0,0x3fe0,0x1ee0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00FB
+    {0x0000,0x0000,0x0000,0x0000,0x1980,0x1980,0x0000,0x0000,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x71e0,0x3fe0,0x1ee0,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00FC
+    {0x0000,0x0000,0x0000,0x00e0,0x01c0,0x0380,0x0700,0x0000,0x70e0,0x38e0,0x39c0,0x39c0,0x1dc0,0x1d80,0x1f80,0x0f80,0x0f00,0x0700,0x0700,0x0600,0x0e00,0x3c00,0x3c00,0x0000}, // U+00FD
+    {0x0000,0x0000,0x0000,0x0000,0x7000,0x7000,0x7000,0x7000,0x7780,0x7fc0,0x79e0,0x70e0,0x70e0,0x70e0,0x70e0,0x70e0,0x79e0,0x7fc0,0x7780,0x7000,0x7000,0x7000,0x7000,0x0000}, // U+00FE
+    {0x0000,0x0000,0x0000,0x0000,0x1980,0x1980,0x0000,0x0000,0x70e0,0x38e0,0x39c0,0x39c0,0x1dc0,0x1d80,0x1f80,0x0f80,0x0f00,0x0700,0x0700,0x0600,0x0e00,0x3c00,0x3c00,0x0000}, // U+00FF
+};
+
+const uint16_t kEscPosFontB[kEscPosGlyphCount][17] = {
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0020
+    {0x0000,0x0000,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0000,0x0c00,0x0c00,0x0000,0x0000,0x0000,0x0000}, // U+0021
+    {0x0000,0x0000,0x3300,0x3300,0x3300,0x3300,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0022
+    {0x0000,0x0000,0x1900,0x1b00,0x1b00,0x7f80,0x3600,0x3600,0x3600,0xff00,0x6400,0x6c00,0x6c00,0x0000,0x0000,0x0000,0x0000}, // U+0023
+    {0x0000,0x0800,0x0800,0x3e00,0x6a00,0x6800,0x7800,0x3e00,0x0f00,0x0b00,0x0b00,0x6b00,0x3e00,0x0800,0x0800,0x0000,0x0000}, // U+0024
+    {0x0000,0x0000,0x7000,0x8800,0x8800,0x8800,0x7180,0x1e00,0xe700,0x0880,0x0880,0x0880,0x0700,0x0000,0x0000,0x0000,0x0000}, // U+0025
+    {0x0000,0x0000,0x1c00,0x3000,0x3000,0x1000,0x3800,0x3b00,0x6f00,0x6f00,0x6e00,0x7600,0x3f00,0x0000,0x0000,0x0000,0x0000}, // U+0026
+    {0x0000,0x0000,0x0c00,0x0c00,0x0c00,0x0c00,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0027
+    {0x0000,0x0000,0x0600,0x0c00,0x0c00,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x0c00,0x0c00,0x0600,0x0000,0x0000}, // U+0028
+    {0x0000,0x0000,0x3000,0x1800,0x1800,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x1800,0x1800,0x3000,0x0000,0x0000}, // U+0029
+    {0x0000,0x0000,0x0800,0x6b00,0x3e00,0x3e00,0x6b00,0x0800,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+002A
+    {0x0000,0x0000,0x0000,0x0000,0x0c00,0x0c00,0x0c00,0x7f80,0x7f80,0x0c00,0x0c00,0x0c00,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+002B
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x1800,0x1800,0x1800,0x1800,0x3000,0x0000,0x0000}, // U+002C
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x3e00,0x3e00,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+002D
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x1800,0x1800,0x1800,0x0000,0x0000,0x0000,0x0000}, // U+002E
+    {0x0000,0x0000,0x0180,0x0300,0x0300,0x0600,0x0600,0x0c00,0x0c00,0x1800,0x1800,0x3000,0x3000,0x6000,0x0000,0x0000,0x0000}, // U+002F
+    {0x0000,0x0000,0x1c00,0x3600,0x6300,0x6300,0x6b00,0x6b00,0x6300,0x6300,0x6300,0x3600,0x1c00,0x0000,0x0000,0x0000,0x0000}, // U+0030
+    {0x0000,0x0000,0x1c00,0x2c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x3f00,0x0000,0x0000,0x0000,0x0000}, // U+0031
+    {0x0000,0x0000,0x3c00,0x4300,0x0300,0x0300,0x0700,0x0600,0x0e00,0x1c00,0x3800,0x7000,0x7f00,0x0000,0x0000,0x0000,0x0000}, // U+0032
+    {0x0000,0x0000,0x3e00,0x4300,0x0300,0x0300,0x1c00,0x0600,0x0300,0x0300,0x0300,0x4700,0x3c00,0x0000,0x0000,0x0000,0x0000}, // U+0033
+    {0x0000,0x0000,0x0600,0x0e00,0x1e00,0x1600,0x3600,0x6600,0x4600,0x7f00,0x0600,0x0600,0x0600,0x0000,0x0000,0x0000,0x0000}, // U+0034
+    {0x0000,0x0000,0x7e00,0x6000,0x6000,0x6000,0x7c00,0x4600,0x0300,0x0300,0x0300,0x4600,0x3c00,0x0000,0x0000,0x0000,0x0000}, // U+0035
+    {0x0000,0x0000,0x1c00,0x3200,0x6000,0x6000,0x7e00,0x6300,0x6300,0x6300,0x6300,0x2300,0x1e00,0x0000,0x0000,0x0000,0x0000}, // U+0036
+    {0x0000,0x0000,0x7f00,0x0300,0x0700,0x0600,0x0600,0x0c00,0x0c00,0x1c00,0x1800,0x1800,0x3000,0x0000,0x0000,0x0000,0x0000}, // U+0037
+    {0x0000,0x0000,0x3e00,0x6300,0x6300,0x6300,0x1c00,0x3600,0x6300,0x6300,0x6300,0x7700,0x3e00,0x0000,0x0000,0x0000,0x0000}, // U+0038
+    {0x0000,0x0000,0x3c00,0x6200,0x6300,0x6300,0x6300,0x6300,0x3f00,0x0300,0x0300,0x2600,0x1c00,0x0000,0x0000,0x0000,0x0000}, // U+0039
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x1800,0x1800,0x1800,0x0000,0x0000,0x1800,0x1800,0x1800,0x0000,0x0000,0x0000,0x0000}, // U+003A
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x1800,0x1800,0x1800,0x0000,0x0000,0x1800,0x1800,0x1800,0x1800,0x3000,0x0000,0x0000}, // U+003B
+    {0x0000,0x0000,0x0000,0x0000,0x0080,0x0780,0x1e00,0x7000,0x7000,0x1e00,0x0780,0x0080,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+003C
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x7f80,0x7f80,0x0000,0x0000,0x7f80,0x7f80,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+003D
+    {0x0000,0x0000,0x0000,0x0000,0x4000,0x7800,0x1e00,0x0380,0x0380,0x1e00,0x7800,0x4000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+003E
+    {0x0000,0x0000,0x3c00,0x4600,0x0600,0x0e00,0x1c00,0x1800,0x1800,0x1800,0x0000,0x1800,0x1800,0x0000,0x0000,0x0000,0x0000}, // U+003F
+    {0x0000,0x0000,0x0000,0x1e00,0x2300,0x6300,0xcf00,0xdb00,0xdb00,0xdb00,0xdb00,0xdb00,0xcf00,0x6000,0x3200,0x1f00,0x0000}, // U+0040
+    {0x0000,0x0000,0x1c00,0x1c00,0x1c00,0x1c00,0x3600,0x3600,0x3600,0x3e00,0x3600,0x7700,0x6300,0x0000,0x0000,0x0000,0x0000}, // U+0041
+    {0x0000,0x0000,0x7e00,0x6300,0x6300,0x6300,0x6300,0x7c00,0x6300,0x6300,0x6300,0x6300,0x7e00,0x0000,0x0000,0x0000,0x0000}, // U+0042
+    {0x0000,0x0000,0x1e00,0x3100,0x2000,0x6000,0x6000,0x6000,0x6000,0x6000,0x2000,0x3100,0x1e00,0x0000,0x0000,0x0000,0x0000}, // U+0043
+    {0x0000,0x0000,0x7c00,0x6600,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x6600,0x7c00,0x0000,0x0000,0x0000,0x0000}, // U+0044
+    {0x0000,0x0000,0x7f00,0x6000,0x6000,0x6000,0x6000,0x7e00,0x6000,0x6000,0x6000,0x6000,0x7f00,0x0000,0x0000,0x0000,0x0000}, // U+0045
+    {0x0000,0x0000,0x7f00,0x6000,0x6000,0x6000,0x6000,0x7e00,0x6000,0x6000,0x6000,0x6000,0x6000,0x0000,0x0000,0x0000,0x0000}, // U+0046
+    {0x0000,0x0000,0x1e00,0x3100,0x2000,0x6000,0x6000,0x6000,0x6700,0x6300,0x6300,0x3300,0x1f00,0x0000,0x0000,0x0000,0x0000}, // U+0047
+    {0x0000,0x0000,0x6300,0x6300,0x6300,0x6300,0x6300,0x7f00,0x6300,0x6300,0x6300,0x6300,0x6300,0x0000,0x0000,0x0000,0x0000}, // U+0048
+    {0x0000,0x0000,0x7e00,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x7e00,0x0000,0x0000,0x0000,0x0000}, // U+0049
+    {0x0000,0x0000,0x1f00,0x0300,0x0300,0x0300,0x0300,0x0300,0x0300,0x0300,0x0300,0x4300,0x3e00,0x0000,0x0000,0x0000,0x0000}, // U+004A
+    {0x0000,0x0000,0x6300,0x6700,0x6e00,0x6c00,0x7800,0x7c00,0x7e00,0x6600,0x6700,0x6300,0x6380,0x0000,0x0000,0x0000,0x0000}, // U+004B
+    {0x0000,0x0000,0x6000,0x6000,0x6000,0x6000,0x6000,0x6000,0x6000,0x6000,0x6000,0x6000,0x7f00,0x0000,0x0000,0x0000,0x0000}, // U+004C
+    {0x0000,0x0000,0x7700,0x7700,0x7700,0x7700,0x7700,0x7f00,0x6b00,0x6300,0x6300,0x6300,0x6300,0x0000,0x0000,0x0000,0x0000}, // U+004D
+    {0x0000,0x0000,0x7300,0x7300,0x7300,0x7b00,0x7b00,0x6b00,0x6f00,0x6f00,0x6700,0x6700,0x6700,0x0000,0x0000,0x0000,0x0000}, // U+004E
+    {0x0000,0x0000,0x1c00,0x3600,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x3600,0x1c00,0x0000,0x0000,0x0000,0x0000}, // U+004F
+    {0x0000,0x0000,0x7e00,0x6700,0x6300,0x6300,0x6300,0x6700,0x7e00,0x6000,0x6000,0x6000,0x6000,0x0000,0x0000,0x0000,0x0000}, // U+0050
+    {0x0000,0x0000,0x1c00,0x3600,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x3600,0x1e00,0x0600,0x0200,0x0000,0x0000}, // U+0051
+    {0x0000,0x0000,0x7e00,0x6300,0x6300,0x6300,0x6300,0x6300,0x7c00,0x6600,0x6700,0x6300,0x6380,0x0000,0x0000,0x0000,0x0000}, // U+0052
+    {0x0000,0x0000,0x1e00,0x6100,0x6000,0x6000,0x7800,0x3e00,0x0f00,0x0300,0x0300,0x4300,0x3e00,0x0000,0x0000,0x0000,0x0000}, // U+0053
+    {0x0000,0x0000,0xff00,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x0000,0x0000,0x0000,0x0000}, // U+0054
+    {0x0000,0x0000,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x3e00,0x0000,0x0000,0x0000,0x0000}, // U+0055
+    {0x0000,0x0000,0x6300,0x6300,0x3600,0x3600,0x3600,0x3600,0x3600,0x1400,0x1c00,0x1c00,0x1c00,0x0000,0x0000,0x0000,0x0000}, // U+0056
+    {0x0000,0x0000,0xc180,0xc180,0xc180,0xdd80,0xdd80,0x5d00,0x5500,0x5500,0x7700,0x6300,0x6300,0x0000,0x0000,0x0000,0x0000}, // U+0057
+    {0x0000,0x0000,0x6300,0x3600,0x3600,0x1c00,0x1c00,0x0800,0x1c00,0x1c00,0x3600,0x3600,0x6300,0x0000,0x0000,0x0000,0x0000}, // U+0058
+    {0x0000,0x0000,0xe700,0x6600,0x6600,0x3c00,0x3c00,0x3c00,0x1800,0x1800,0x1800,0x1800,0x1800,0x0000,0x0000,0x0000,0x0000}, // U+0059
+    {0x0000,0x0000,0x7f00,0x0300,0x0700,0x0e00,0x0c00,0x1c00,0x1800,0x3000,0x7000,0x6000,0x7f00,0x0000,0x0000,0x0000,0x0000}, // U+005A
+    {0x0000,0x0000,0x1e00,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x1e00,0x0000,0x0000}, // U+005B
+    {0x0000,0x0000,0x6000,0x2000,0x3000,0x1000,0x1800,0x1800,0x0c00,0x0c00,0x0400,0x0600,0x0200,0x0300,0x0000,0x0000,0x0000}, // U+005C
+    {0x0000,0x0000,0x3c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x3c00,0x0000,0x0000}, // U+005D
+    {0x0000,0x0000,0x1800,0x3c00,0x6600,0xc300,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+005E
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0xff80}, // U+005F
+    {0x0000,0x6000,0x3000,0x1800,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+0060
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x1e00,0x2300,0x0300,0x3f00,0x6300,0x6300,0x6700,0x3f00,0x0000,0x0000,0x0000,0x0000}, // U+0061
+    {0x0000,0x0000,0x6000,0x6000,0x6000,0x7e00,0x7700,0x6300,0x6300,0x6300,0x6300,0x7700,0x7e00,0x0000,0x0000,0x0000,0x0000}, // U+0062
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x1e00,0x3100,0x6000,0x6000,0x6000,0x6000,0x3100,0x1e00,0x0000,0x0000,0x0000,0x0000}, // U+0063
+    {0x0000,0x0000,0x0300,0x0300,0x0300,0x3f00,0x7700,0x6300,0x6300,0x6300,0x6300,0x7700,0x3f00,0x0000,0x0000,0x0000,0x0000}, // U+0064
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x1e00,0x2300,0x6300,0x7f00,0x6000,0x6000,0x3100,0x1e00,0x0000,0x0000,0x0000,0x0000}, // U+0065
+    {0x0000,0x0000,0x0f00,0x1800,0x1800,0x7f00,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x0000,0x0000,0x0000,0x0000}, // U+0066
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x3f00,0x3700,0x6300,0x6300,0x6300,0x6300,0x3700,0x3f00,0x0300,0x2300,0x1e00,0x0000}, // U+0067
+    {0x0000,0x0000,0x6000,0x6000,0x6000,0x7e00,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x0000,0x0000,0x0000,0x0000}, // U+0068
+    {0x0000,0x0c00,0x0c00,0x0c00,0x0000,0x3c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x7f80,0x0000,0x0000,0x0000,0x0000}, // U+0069
+    {0x0000,0x0c00,0x0c00,0x0c00,0x0000,0x3c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x7800,0x0000}, // U+006A
+    {0x0000,0x0000,0x6000,0x6000,0x6000,0x6600,0x6c00,0x7800,0x7800,0x6c00,0x6c00,0x6600,0x6700,0x0000,0x0000,0x0000,0x0000}, // U+006B
+    {0x0000,0x0000,0x7800,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x0f00,0x0000,0x0000,0x0000,0x0000}, // U+006C
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x7f80,0x6d80,0x6d80,0x6d80,0x6d80,0x6d80,0x6d80,0x6d80,0x0000,0x0000,0x0000,0x0000}, // U+006D
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x7e00,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x0000,0x0000,0x0000,0x0000}, // U+006E
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x1c00,0x3600,0x6300,0x6300,0x6300,0x6300,0x3600,0x1c00,0x0000,0x0000,0x0000,0x0000}, // U+006F
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x7e00,0x7700,0x6300,0x6300,0x6300,0x6300,0x7700,0x7e00,0x6000,0x6000,0x6000,0x0000}, // U+0070
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x3f00,0x7700,0x6300,0x6300,0x6300,0x6300,0x7700,0x3f00,0x0300,0x0300,0x0300,0x0000}, // U+0071
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x3f00,0x3800,0x3000,0x3000,0x3000,0x3000,0x3000,0x3000,0x0000,0x0000,0x0000,0x0000}, // U+0072
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x3e00,0x6100,0x6000,0x7c00,0x1f00,0x0300,0x4300,0x3e00,0x0000,0x0000,0x0000,0x0000}, // U+0073
+    {0x0000,0x0000,0x0000,0x1800,0x1800,0x7f00,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x0f00,0x0000,0x0000,0x0000,0x0000}, // U+0074
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x3f00,0x0000,0x0000,0x0000,0x0000}, // U+0075
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x6300,0x7700,0x3600,0x3600,0x3600,0x1400,0x1c00,0x1c00,0x0000,0x0000,0x0000,0x0000}, // U+0076
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0xc180,0xc180,0xc980,0x5d00,0x7700,0x7700,0x6300,0x6300,0x0000,0x0000,0x0000,0x0000}, // U+0077
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x7700,0x3600,0x1c00,0x1c00,0x1c00,0x1e00,0x3600,0x7700,0x0000,0x0000,0x0000,0x0000}, // U+0078
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x6300,0x3700,0x3600,0x3600,0x1e00,0x1c00,0x0c00,0x0c00,0x0c00,0x1800,0x3800,0x0000}, // U+0079
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x7f00,0x0300,0x0600,0x0c00,0x1800,0x3000,0x6000,0x7f00,0x0000,0x0000,0x0000,0x0000}, // U+007A
+    {0x0000,0x0000,0x0700,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x3000,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0700,0x0000}, // U+007B
+    {0x0000,0x0000,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00}, // U+007C
+    {0x0000,0x0000,0x3800,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0300,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x3800,0x0000}, // U+007D
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x3880,0x7f80,0x4700,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+007E
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00A0
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0c00,0x0c00,0x0000,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0000}, // U+00A1
+    {0x0000,0x0000,0x0000,0x0400,0x0400,0x1e00,0x3500,0x6400,0x6400,0x6400,0x6400,0x3500,0x1e00,0x0400,0x0400,0x0000,0x0000}, // U+00A2
+    {0x0000,0x0000,0x0e00,0x1900,0x1800,0x1800,0x1800,0x3e00,0x1800,0x1800,0x1800,0x1800,0x7f80,0x0000,0x0000,0x0000,0x0000}, // U+00A3
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x4200,0x3f00,0x2200,0x2200,0x2200,0x3e00,0x4300,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00A4
+    {0x0000,0x0000,0xe700,0x6600,0x6600,0x7e00,0xff00,0x1800,0xff00,0x1800,0x1800,0x1800,0x1800,0x0000,0x0000,0x0000,0x0000}, // U+00A5
+    {0x0000,0x0000,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0000,0x0000,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0000}, // U+00A6
+    {0x0000,0x0000,0x3e00,0x6000,0x7000,0x1c00,0x6e00,0x6700,0x7300,0x3b00,0x1e00,0x0700,0x0300,0x3e00,0x0000,0x0000,0x0000}, // U+00A7
+    {0x0000,0x3600,0x3600,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00A8
+    {0x0000,0x0000,0x0000,0x3e00,0x6300,0xdd80,0xa080,0xa080,0xa080,0xdd80,0x6300,0x3e00,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00A9
+    {0x0000,0x0000,0x1c00,0x0600,0x1e00,0x3600,0x3600,0x3e00,0x0000,0x1e00,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00AA
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x1200,0x3600,0x6c00,0x4800,0x6c00,0x3600,0x1200,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00AB
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x7f80,0x7f80,0x0180,0x0180,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00AC
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x3e00,0x3e00,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00AD
+    {0x0000,0x0000,0x0000,0x3e00,0x6300,0xff80,0xa280,0xbc80,0xa680,0xe380,0x6300,0x3e00,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00AE
+    {0x0000,0x0000,0x3e00,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00AF
+    {0x0000,0x0000,0x1c00,0x2200,0x2200,0x2200,0x1c00,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00B0
+    {0x0000,0x0000,0x0000,0x0c00,0x0c00,0x0c00,0x7f80,0x7f80,0x0c00,0x0c00,0x0c00,0x7f80,0x7f80,0x0000,0x0000,0x0000,0x0000}, // U+00B1
+    {0x0000,0x0000,0x3c00,0x0200,0x0600,0x0c00,0x1800,0x3e00,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00B2
+    {0x0000,0x0000,0x3e00,0x0200,0x1c00,0x0200,0x0200,0x3c00,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00B3
+    {0x0000,0x0600,0x0c00,0x1800,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00B4
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x7d80,0x6000,0x6000,0x6000,0x0000}, // U+00B5
+    {0x0000,0x0000,0x1f00,0x7d00,0x7d00,0x7d00,0x7d00,0x1d00,0x0500,0x0500,0x0500,0x0500,0x0500,0x0500,0x0000,0x0000,0x0000}, // U+00B6
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x1800,0x1800,0x1800,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00B7
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0800,0x0400,0x1c00,0x0000}, // U+00B8
+    {0x0000,0x0000,0x3800,0x0800,0x0800,0x0800,0x0800,0x3e00,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00B9
+    {0x0000,0x0000,0x1c00,0x3600,0x3600,0x3600,0x3600,0x1c00,0x0000,0x3e00,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00BA
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x4800,0x6c00,0x3600,0x1200,0x3600,0x6c00,0x4800,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00BB
+    {0x0000,0xe000,0x2000,0x2000,0x2000,0x2000,0xf800,0x0300,0x3c00,0xc200,0x0600,0x0a00,0x0a00,0x1f00,0x0200,0x0000,0x0000}, // U+00BC
+    {0x0000,0xe000,0x2000,0x2000,0x2000,0x2000,0xf800,0x0300,0x3c00,0xdf00,0x0100,0x0100,0x0200,0x0c00,0x1f00,0x0000,0x0000}, // U+00BD
+    {0x0000,0xf800,0x0800,0x7000,0x0800,0x0800,0xf800,0x0300,0x3c00,0xc200,0x0600,0x0a00,0x0a00,0x1f00,0x0200,0x0000,0x0000}, // U+00BE
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x0c00,0x0c00,0x0000,0x0c00,0x0c00,0x0c00,0x1c00,0x3800,0x3000,0x3100,0x1e00,0x0000}, // U+00BF
+    {0x0c00,0x0000,0x1c00,0x1c00,0x1c00,0x1c00,0x3600,0x3600,0x3600,0x3e00,0x3600,0x7700,0x6300,0x0000,0x0000,0x0000,0x0000}, // U+00C0
+    {0x1800,0x0000,0x1c00,0x1c00,0x1c00,0x1c00,0x3600,0x3600,0x3600,0x3e00,0x3600,0x7700,0x6300,0x0000,0x0000,0x0000,0x0000}, // U+00C1
+    {0x3600,0x0000,0x1c00,0x1c00,0x1c00,0x1c00,0x3600,0x3600,0x3600,0x3e00,0x3600,0x7700,0x6300,0x0000,0x0000,0x0000,0x0000}, // U+00C2
+    {0x2e00,0x0000,0x1c00,0x1c00,0x1c00,0x1c00,0x3600,0x3600,0x3600,0x3e00,0x3600,0x7700,0x6300,0x0000,0x0000,0x0000,0x0000}, // U+00C3
+    {0x3600,0x0000,0x1c00,0x1c00,0x1c00,0x1c00,0x3600,0x3600,0x3600,0x3e00,0x3600,0x7700,0x6300,0x0000,0x0000,0x0000,0x0000}, // U+00C4
+    {0x1400,0x1400,0x0800,0x1c00,0x1c00,0x1c00,0x1400,0x3600,0x3600,0x3e00,0x3600,0x7700,0x6300,0x0000,0x0000,0x0000,0x0000}, // U+00C5
+    {0x0000,0x0000,0x1f80,0x1600,0x3600,0x3600,0x2600,0x6780,0x6600,0x7e00,0x4600,0xc600,0xc780,0x0000,0x0000,0x0000,0x0000}, // U+00C6
+    {0x0000,0x0000,0x1e00,0x3100,0x2000,0x6000,0x6000,0x6000,0x6000,0x6000,0x2000,0x3100,0x1e00,0x0400,0x0200,0x0e00,0x0000}, // U+00C7
+    {0x0c00,0x0000,0x7f00,0x6000,0x6000,0x6000,0x6000,0x7e00,0x6000,0x6000,0x6000,0x6000,0x7f00,0x0000,0x0000,0x0000,0x0000}, // U+00C8
+    {0x0800,0x0000,0x7f00,0x6000,0x6000,0x6000,0x6000,0x7e00,0x6000,0x6000,0x6000,0x6000,0x7f00,0x0000,0x0000,0x0000,0x0000}, // U+00C9
+    {0x1300,0x0000,0x7f00,0x6000,0x6000,0x6000,0x6000,0x7e00,0x6000,0x6000,0x6000,0x6000,0x7f00,0x0000,0x0000,0x0000,0x0000}, // U+00CA
+    {0x3600,0x0000,0x7f00,0x6000,0x6000,0x6000,0x6000,0x7e00,0x6000,0x6000,0x6000,0x6000,0x7f00,0x0000,0x0000,0x0000,0x0000}, // U+00CB
+    {0x0c00,0x0000,0x7e00,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x7e00,0x0000,0x0000,0x0000,0x0000}, // U+00CC
+    {0x1800,0x0000,0x7e00,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x7e00,0x0000,0x0000,0x0000,0x0000}, // U+00CD
+    {0x6600,0x0000,0x7e00,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x7e00,0x0000,0x0000,0x0000,0x0000}, // U+00CE
+    {0x6600,0x0000,0x7e00,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x1800,0x7e00,0x0000,0x0000,0x0000,0x0000}, // U+00CF
+    {0x0000,0x0000,0x7c00,0x6600,0x6300,0x6300,0xfb00,0x6300,0x6300,0x6300,0x6300,0x6600,0x7c00,0x0000,0x0000,0x0000,0x0000}, // U+00D0
+    {0x2e00,0x0000,0x7300,0x7300,0x7300,0x7b00,0x7b00,0x6b00,0x6f00,0x6f00,0x6700,0x6700,0x6700,0x0000,0x0000,0x0000,0x0000}, // U+00D1
+    {0x0c00,0x0000,0x1c00,0x3600,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x3600,0x1c00,0x0000,0x0000,0x0000,0x0000}, // U+00D2
+    {0x1800,0x0000,0x1c00,0x3600,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x3600,0x1c00,0x0000,0x0000,0x0000,0x0000}, // U+00D3
+    {0x3600,0x0000,0x1c00,0x3600,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x3600,0x1c00,0x0000,0x0000,0x0000,0x0000}, // U+00D4
+    {0x2e00,0x0000,0x1c00,0x3600,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x3600,0x1c00,0x0000,0x0000,0x0000,0x0000}, // U+00D5
+    {0x3600,0x0000,0x1c00,0x3600,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x3600,0x1c00,0x0000,0x0000,0x0000,0x0000}, // U+00D6
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x2200,0x7700,0x3e00,0x1c00,0x3e00,0x7700,0x2200,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00D7
+    {0x0000,0x0000,0x1f00,0x3700,0x6700,0x6700,0x6f00,0x6b00,0x7b00,0x7300,0x7300,0x7600,0xfc00,0x0000,0x0000,0x0000,0x0000}, // U+00D8
+    {0x0c00,0x0000,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x3e00,0x0000,0x0000,0x0000,0x0000}, // U+00D9
+    {0x1800,0x0000,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x3e00,0x0000,0x0000,0x0000,0x0000}, // U+00DA
+    {0x3600,0x0000,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x3e00,0x0000,0x0000,0x0000,0x0000}, // U+00DB
+    {0x3600,0x0000,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x3e00,0x0000,0x0000,0x0000,0x0000}, // U+00DC
+    {0x1800,0x0000,0xe700,0x6600,0x6600,0x3c00,0x3c00,0x3c00,0x1800,0x1800,0x1800,0x1800,0x1800,0x0000,0x0000,0x0000,0x0000}, // U+00DD
+    {0x0000,0x0000,0x6000,0x6000,0x7e00,0x6700,0x6300,0x6300,0x6300,0x6700,0x7e00,0x6000,0x6000,0x0000,0x0000,0x0000,0x0000}, // U+00DE
+    {0x0000,0x0000,0x3c00,0x6600,0x6600,0x6c00,0x6c00,0x6c00,0x6c00,0x6700,0x6300,0x6300,0x6e00,0x0000,0x0000,0x0000,0x0000}, // U+00DF
+    {0x0000,0x6000,0x3000,0x1800,0x0000,0x1e00,0x2300,0x0300,0x3f00,0x6300,0x6300,0x6700,0x3f00,0x0000,0x0000,0x0000,0x0000}, // U+00E0
+    {0x0000,0x0600,0x0c00,0x1800,0x0000,0x1e00,0x2300,0x0300,0x3f00,0x6300,0x6300,0x6700,0x3f00,0x0000,0x0000,0x0000,0x0000}, // U+00E1
+    {0x0000,0x0c00,0x1e00,0x3300,0x0000,0x1e00,0x2300,0x0300,0x3f00,0x6300,0x6300,0x6700,0x3f00,0x0000,0x0000,0x0000,0x0000}, // U+00E2
+    {0x0000,0x3a00,0x2e00,0x0000,0x0000,0x1e00,0x2300,0x0300,0x3f00,0x6300,0x6300,0x6700,0x3f00,0x0000,0x0000,0x0000,0x0000}, // U+00E3
+    {0x0000,0x3600,0x3600,0x0000,0x0000,0x1e00,0x2300,0x0300,0x3f00,0x6300,0x6300,0x6700,0x3f00,0x0000,0x0000,0x0000,0x0000}, // U+00E4
+    {0x1800,0x2400,0x2400,0x1800,0x0000,0x1e00,0x2300,0x0300,0x3f00,0x6300,0x6300,0x6700,0x3f00,0x0000,0x0000,0x0000,0x0000}, // U+00E5
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x7e00,0x1b00,0x1b00,0x7f00,0xd800,0xd800,0xd800,0x7f00,0x0000,0x0000,0x0000,0x0000}, // U+00E6
+    {0x0000,0x0000,0x0000,0x0000,0x0000,0x1e00,0x3100,0x6000,0x6000,0x6000,0x6000,0x3100,0x1e00,0x0400,0x0200,0x0c00,0x0000}, // U+00E7
+    {0x0000,0x3000,0x1000,0x1800,0x0000,0x1e00,0x2300,0x6300,0x7f00,0x6000,0x6000,0x3100,0x1e00,0x0000,0x0000,0x0000,0x0000}, // U+00E8
+    {0x0000,0x0600,0x0c00,0x0800,0x0000,0x1e00,0x2300,0x6300,0x7f00,0x6000,0x6000,0x3100,0x1e00,0x0000,0x0000,0x0000,0x0000}, // U+00E9
+    {0x0000,0x0e00,0x1a00,0x1300,0x0000,0x1e00,0x2300,0x6300,0x7f00,0x6000,0x6000,0x3100,0x1e00,0x0000,0x0000,0x0000,0x0000}, // U+00EA
+    {0x0000,0x3600,0x3600,0x0000,0x0000,0x1e00,0x2300,0x6300,0x7f00,0x6000,0x6000,0x3100,0x1e00,0x0000,0x0000,0x0000,0x0000}, // U+00EB
+    {0x0000,0x6000,0x3000,0x1800,0x0000,0x3c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x7f80,0x0000,0x0000,0x0000,0x0000}, // U+00EC
+    {0x0000,0x0600,0x0c00,0x1800,0x0000,0x3c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x7f80,0x0000,0x0000,0x0000,0x0000}, // U+00ED
+    {0x0000,0x0c00,0x1e00,0x3300,0x0000,0x3c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x7f80,0x0000,0x0000,0x0000,0x0000}, // U+00EE
+    {0x0000,0x3600,0x3600,0x0000,0x0000,0x3c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x0c00,0x7f80,0x0000,0x0000,0x0000,0x0000}, // U+00EF
+    {0x0000,0x0000,0x1e00,0x1c00,0x2e00,0x3e00,0x3300,0x6300,0x6300,0x6300,0x6300,0x3600,0x1c00,0x0000,0x0000,0x0000,0x0000}, // U+00F0
+    {0x0000,0x3a00,0x2e00,0x0000,0x0000,0x7e00,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x0000,0x0000,0x0000,0x0000}, // U+00F1
+    {0x0000,0x6000,0x3000,0x1800,0x0000,0x1c00,0x3600,0x6300,0x6300,0x6300,0x6300,0x3600,0x1c00,0x0000,0x0000,0x0000,0x0000}, // U+00F2
+    {0x0000,0x0600,0x0c00,0x1800,0x0000,0x1c00,0x3600,0x6300,0x6300,0x6300,0x6300,0x3600,0x1c00,0x0000,0x0000,0x0000,0x0000}, // U+00F3
+    {0x0000,0x1c00,0x1400,0x3600,0x0000,0x1c00,0x3600,0x6300,0x6300,0x6300,0x6300,0x3600,0x1c00,0x0000,0x0000,0x0000,0x0000}, // U+00F4
+    {0x0000,0x3a00,0x2e00,0x0000,0x0000,0x1c00,0x3600,0x6300,0x6300,0x6300,0x6300,0x3600,0x1c00,0x0000,0x0000,0x0000,0x0000}, // U+00F5
+    {0x0000,0x3600,0x3600,0x0000,0x0000,0x1c00,0x3600,0x6300,0x6300,0x6300,0x6300,0x3600,0x1c00,0x0000,0x0000,0x0000,0x0000}, // U+00F6
+    {0x0000,0x0000,0x0000,0x0000,0x1800,0x1800,0x0000,0xff00,0xff00,0x0000,0x1800,0x1800,0x0000,0x0000,0x0000,0x0000,0x0000}, // U+00F7
+    {0x0000,0x0000,0x0000,0x0000,0x0100,0x1f00,0x3700,0x6700,0x6f00,0x7b00,0x7300,0x7600,0x7c00,0x4000,0x0000,0x0000,0x0000}, // U+00F8
+    {0x0000,0x6000,0x3000,0x1800,0x0000,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x3f00,0x0000,0x0000,0x0000,0x0000}, // U+00F9
+    {0x0000,0x0600,0x0c00,0x1800,0x0000,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x3f00,0x0000,0x0000,0x0000,0x0000}, // U+00FA
+    {0x0000,0x1c00,0x1400,0x3600,0x0000,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x3f00,0x0000,0x0000,0x0000,0x0000}, // U+00FB
+    {0x0000,0x3600,0x3600,0x0000,0x0000,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x6300,0x3f00,0x0000,0x0000,0x0000,0x0000}, // U+00FC
+    {0x0000,0x0600,0x0c00,0x1800,0x0000,0x6300,0x3700,0x3600,0x3600,0x1e00,0x1c00,0x0c00,0x0c00,0x0c00,0x1800,0x3800,0x0000}, // U+00FD
+    {0x0000,0x0000,0x6000,0x6000,0x6000,0x7e00,0x7700,0x6300,0x6300,0x6300,0x6300,0x7700,0x7e00,0x6000,0x6000,0x6000,0x0000}, // U+00FE
+    {0x0000,0x3600,0x3600,0x0000,0x0000,0x6300,0x3700,0x3600,0x3600,0x1e00,0x1c00,0x0c00,0x0c00,0x0c00,0x1800,0x3800,0x0000}, // U+00FF
+};
+
+// Byte 0x80..0xFF de cada tabla → índice de glifo (0xff: sin glifo).
+
+const uint8_t kCodePagePc437[128] = {
+    0x86, 0xbb, 0xa8, 0xa1, 0xa3, 0x9f, 0xa4, 0xa6, 0xa9, 0xaa, 0xa7, 0xae, 0xad, 0xab, 0x83, 0x84,
+    0x88, 0xa5, 0x85, 0xb3, 0xb5, 0xb1, 0xba, 0xb8, 0xbe, 0x95, 0x9b, 0x61, 0x62, 0x64, 0xff, 0xff,
+    0xa0, 0xac, 0xb2, 0xb9, 0xb0, 0x90, 0x69, 0x79, 0x7e, 0xff, 0x6b, 0x7c, 0x7b, 0x60, 0x6a, 0x7a,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0x9e, 0xff, 0xff, 0xff, 0xff, 0x74, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0x70, 0xff, 0xff, 0xff, 0xff, 0xb6, 0xff, 0x6f, 0xff, 0x76, 0xff, 0xff, 0x71, 0xff, 0x5f,
+};
+
+const uint8_t kCodePagePc850[128] = {
+    0x86, 0xbb, 0xa8, 0xa1, 0xa3, 0x9f, 0xa4, 0xa6, 0xa9, 0xaa, 0xa7, 0xae, 0xad, 0xab, 0x83, 0x84,
+    0x88, 0xa5, 0x85, 0xb3, 0xb5, 0xb1, 0xba, 0xb8, 0xbe, 0x95, 0x9b, 0xb7, 0x62, 0x97, 0x96, 0xff,
+    0xa0, 0xac, 0xb2, 0xb9, 0xb0, 0x90, 0x69, 0x79, 0x7e, 0x6d, 0x6b, 0x7c, 0x7b, 0x60, 0x6a, 0x7a,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0x80, 0x81, 0x7f, 0x68, 0xff, 0xff, 0xff, 0xff, 0x61, 0x64, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xa2, 0x82, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x63,
+    0xaf, 0x8f, 0x89, 0x8a, 0x87, 0xff, 0x8c, 0x8d, 0x8e, 0xff, 0xff, 0xff, 0xff, 0x65, 0x8b, 0xff,
+    0x92, 0x9e, 0x93, 0x91, 0xb4, 0x94, 0x74, 0xbd, 0x9d, 0x99, 0x9a, 0x98, 0xbc, 0x9c, 0x6e, 0x73,
+    0x6c, 0x70, 0xff, 0x7d, 0x75, 0x66, 0xb6, 0x77, 0x6f, 0x67, 0x76, 0x78, 0x72, 0x71, 0xff, 0x5f,
+};
+
+const uint8_t kCodePagePc858[128] = {
+    0x86, 0xbb, 0xa8, 0xa1, 0xa3, 0x9f, 0xa4, 0xa6, 0xa9, 0xaa, 0xa7, 0xae, 0xad, 0xab, 0x83, 0x84,
+    0x88, 0xa5, 0x85, 0xb3, 0xb5, 0xb1, 0xba, 0xb8, 0xbe, 0x95, 0x9b, 0xb7, 0x62, 0x97, 0x96, 0xff,
+    0xa0, 0xac, 0xb2, 0xb9, 0xb0, 0x90, 0x69, 0x79, 0x7e, 0x6d, 0x6b, 0x7c, 0x7b, 0x60, 0x6a, 0x7a,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0x80, 0x81, 0x7f, 0x68, 0xff, 0xff, 0xff, 0xff, 0x61, 0x64, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xa2, 0x82, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x63,
+    0xaf, 0x8f, 0x89, 0x8a, 0x87, 0xff, 0x8c, 0x8d, 0x8e, 0xff, 0xff, 0xff, 0xff, 0x65, 0x8b, 0xff,
+    0x92, 0x9e, 0x93, 0x91, 0xb4, 0x94, 0x74, 0xbd, 0x9d, 0x99, 0x9a, 0x98, 0xbc, 0x9c, 0x6e, 0x73,
+    0x6c, 0x70, 0xff, 0x7d, 0x75, 0x66, 0xb6, 0x77, 0x6f, 0x67, 0x76, 0x78, 0x72, 0x71, 0xff, 0x5f,
+};
+
+const uint8_t kCodePageWpc1252[128] = {
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0x5f, 0x60, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x6b, 0x6c, 0x6d, 0x6e,
+    0x6f, 0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x7b, 0x7c, 0x7d, 0x7e,
+    0x7f, 0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8a, 0x8b, 0x8c, 0x8d, 0x8e,
+    0x8f, 0x90, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0x9b, 0x9c, 0x9d, 0x9e,
+    0x9f, 0xa0, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xab, 0xac, 0xad, 0xae,
+    0xaf, 0xb0, 0xb1, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xbb, 0xbc, 0xbd, 0xbe,
+};
+constexpr int kQuestionMark = '?' - 0x20;
+
+const EscPosFont kFontA = {12, 24, &kEscPosFontA[0][0]};
+const EscPosFont kFontB = {9, 17, &kEscPosFontB[0][0]};
+
+// Tabla 0x80..0xFF de 'code_table', o nullptr si se toma como Latin-1.
+const uint8_t *code_page(int code_table)
+{
+  switch (code_table)
+  {
+  case 0:
+    return kCodePagePc437;
+  case 2:
+    return kCodePagePc850;
+  case 16:
+    return kCodePageWpc1252;
+  case 19:
+    return kCodePagePc858;
+  default:
+    return nullptr;
+  }
+}
+
+} // namespace
+
+const EscPosFont &escpos_font(int font)
+{
+  return font == 1 ? kFontB : kFontA;
+}
+
+int escpos_glyph_index(uint8_t c, int code_table)
+{
+  if (c >= 0x20 && c <= 0x7E)
+    return c - 0x20;
+  if (c < 0x80)
+    return kQuestionMark;
+
+  const uint8_t *table = code_page(code_table);
+  if (!table)
+    return c >= 0xA0 ? 95 + (c - 0xA0) : kQuestionMark;
+  const uint8_t index = table[c - 0x80];
+  return index == 0xFF ? kQuestionMark : index;
+}
+
+int escpos_encode_char(uint32_t codepoint, int code_table)
+{
+  if (codepoint >= 0x20 && codepoint <= 0x7E)
+    return static_cast<int>(codepoint);
+  // El euro no tiene glifo en las fuentes, pero sí lugar en estas tablas.
+  if (codepoint == 0x20AC)
+    return code_table == 16 ? 0x80 : code_table == 19 ? 0xD5 : -1;
+  if (codepoint < 0xA0 || codepoint > 0xFF)
+    return -1;
+
+  const uint8_t *table = code_page(code_table);
+  if (!table)
+    return static_cast<int>(codepoint);
+  const uint8_t glyph = static_cast<uint8_t>(95 + (codepoint - 0xA0));
+  for (int i = 0; i < 128; i++)
+  {
+    if (table[i] == glyph)
+      return 0x80 + i;
+  }
+  return -1;
+}
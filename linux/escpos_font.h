@@ -0,0 +1,33 @@
+#ifndef FLUTTER_PLUGIN_TI_PRINTER_ESCPOS_FONT_H_
+#define FLUTTER_PLUGIN_TI_PRINTER_ESCPOS_FONT_H_
+
+#include <cstdint>
+
+// Fuentes de mapa de bits que imitan las residentes de una térmica de
+// 80 mm: A de 12x24 puntos y B de 9x17. Cubren ASCII imprimible y Latin-1
+// (U+00A0..U+00FF); el resto de cada tabla de caracteres se dibuja como '?'.
+//
+// Cada fila es un uint16_t con el píxel de más a la izquierda en el bit 15.
+
+constexpr int kEscPosGlyphCount = 191;
+
+struct EscPosFont
+{
+  int width;
+  int height;
+  const uint16_t *rows; // kEscPosGlyphCount * height filas
+};
+
+// 0 = fuente A, 1 = fuente B (cualquier otro valor → A).
+const EscPosFont &escpos_font(int font);
+
+// Glifo para el byte 'c' con la tabla de caracteres 'code_table' (n de
+// ESC t: 0 PC437, 2 PC850, 16 WPC1252, 19 PC858; las demás se toman como
+// Latin-1). Los bytes sin glifo devuelven el de '?'.
+int escpos_glyph_index(uint8_t c, int code_table);
+
+// Inverso de escpos_glyph_index: byte que imprime 'codepoint' con la tabla
+// 'code_table', o -1 si la tabla no lo tiene.
+int escpos_encode_char(uint32_t codepoint, int code_table);
+
+#endif // FLUTTER_PLUGIN_TI_PRINTER_ESCPOS_FONT_H_
@@ -0,0 +1,96 @@
+#ifndef FLUTTER_PLUGIN_TI_PRINTER_ESCPOS_IMAGE_H_
+#define FLUTTER_PLUGIN_TI_PRINTER_ESCPOS_IMAGE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Conversión de imágenes a bit image ESC * (formato columna).
+//
+// Cada banda de 24 filas se arma directamente desde la imagen origen: las
+// filas se empaquetan a 1 bit y cada bloque de 8×8 bits se traspone en un
+// registro de 64 bits. No hay imagen rotada ni copias intermedias; la
+// memoria extra es una banda (24 filas empaquetadas).
+
+// Alto en puntos de una banda ESC * m=33 (24 puntos, doble densidad).
+constexpr int kColumnBandDots = 24;
+
+// Empaqueta una fila de grises (0 = negro, 255 = blanco) a 1 bit por punto,
+// MSB primero, 1 = punto negro (gris < 128). 'out' tiene (width + 7) / 8
+// bytes.
+void escpos_pack_row(const uint8_t *gray, int width, uint8_t *out);
+
+// Traspone una banda de hasta 24 filas empaquetadas ('stride' bytes por
+// fila) a datos de columna ESC *: 3 bytes por columna, MSB = punto de
+// arriba. 'out' tiene width * 3 bytes; las filas que faltan van en blanco.
+void escpos_column_band(const uint8_t *rows, size_t stride, int row_count,
+                        int width, uint8_t *out);
+
+// Filas por comando GS v 0 en las imágenes que se arman por bandas.
+constexpr int kRasterBandRows = 32;
+
+// Lleva una fila de grises a 0/255 con umbral fijo en 128.
+void escpos_threshold_row(uint8_t *row, int width);
+
+// Lleva una fila de grises a 0/255 con trama ordenada (Bayer 8x8). Sólo
+// depende de 'y' (la fila en la imagen): cada banda se puede tramar por
+// separado sin costuras.
+void escpos_ordered_row(uint8_t *row, int width, int y);
+
+enum class RasterDither
+{
+  kThreshold,      // umbral fijo en 128
+  kFloydSteinberg, // difusión de error (el error pasa de una banda a la otra)
+  kOrdered,        // Bayer 8x8: cada banda es independiente
+};
+
+// Difusión de error Floyd-Steinberg fila por fila. Conserva el error entre
+// llamadas, así una imagen procesada por bandas no muestra costuras.
+class ErrorDiffuser
+{
+public:
+  explicit ErrorDiffuser(int width);
+
+  // Lleva 'row' (width puntos) a 0/255 y arrastra el error a la siguiente.
+  void dither_row(uint8_t *row);
+
+private:
+  int width_;
+  // Error de la fila actual y la siguiente, con un punto de margen a cada lado.
+  std::vector<int> current_;
+  std::vector<int> next_;
+};
+
+// Comando con el que se imprime cada banda de una imagen raster.
+enum class RasterCommand : uint8_t
+{
+  kBitImage = 0, // GS v 0
+  kGraphics = 1, // GS ( L fn 112 (guardar) + fn 50 (imprimir)
+  kStarRaster = 2, // modo raster de Star, fila por fila (star_raster.h)
+};
+
+// Encabezado de una banda de 'rows' filas de 'width' puntos, y lo que va
+// después de los datos (GS ( L necesita la orden de imprimir).
+void escpos_raster_band_header(RasterCommand command, int width, int rows, int density,
+                               std::vector<uint8_t> &out);
+void escpos_raster_band_footer(RasterCommand command, std::vector<uint8_t> &out);
+
+// Imagen en grises → comandos por bandas de kRasterBandRows filas, con
+// Floyd-Steinberg ('dither') o umbral. kStarRaster no va por bandas: devuelve
+// vacío (ver star_raster_image). 'density' es el m de GS v 0 (bit 0
+// doble ancho, bit 1 doble alto); en GS ( L se traduce a bx/by.
+std::vector<uint8_t> escpos_raster_image(const uint8_t *gray, int width,
+                                         int height, bool dither,
+                                         RasterCommand command = RasterCommand::kBitImage,
+                                         int density = 0);
+
+// Comandos completos para imprimir la imagen con ESC * m=33, igual que
+// Generator.image (ESC 3 16, una banda + LF por cada 24 filas, ESC 2).
+// 'bits_per_pixel' es 8 (grises, 1 byte por punto) o 1 (filas ya
+// empaquetadas como en GS v 0). Devuelve vacío si los parámetros no son
+// válidos.
+std::vector<uint8_t> escpos_column_image(const uint8_t *pixels, size_t length,
+                                         int width, int height,
+                                         int bits_per_pixel);
+
+#endif // FLUTTER_PLUGIN_TI_PRINTER_ESCPOS_IMAGE_H_
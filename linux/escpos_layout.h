@@ -0,0 +1,97 @@
+#ifndef FLUTTER_PLUGIN_TI_PRINTER_ESCPOS_LAYOUT_H_
+#define FLUTTER_PLUGIN_TI_PRINTER_ESCPOS_LAYOUT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Filas en columnas para texto ESC/POS, medidas en celdas de pantalla y no
+// en bytes: los caracteres anchos de Asia oriental (UAX #11 W/F) ocupan dos
+// celdas, las marcas combinantes ninguna, y nunca se corta un carácter por
+// la mitad. El texto que no entra sigue en la línea de abajo, cortando en
+// espacios o entre ideogramas.
+//
+// Los anchos de columna van en doceavos, como PosColumn; las posiciones se
+// calculan con una suma acumulada. Cada columna puede tener su propio
+// tamaño (GS !): su texto se mide con el multiplicador de ancho.
+
+enum class EscPosAlign : uint8_t
+{
+  kLeft,
+  kCenter,
+  kRight,
+};
+
+struct EscPosColumn
+{
+  std::string_view text; // UTF-8
+  int width = 12;        // doceavos (1..12)
+  EscPosAlign align = EscPosAlign::kLeft;
+  int size = -1;         // n de GS ! para esta columna; -1 = el de la fila
+};
+
+struct EscPosRowOptions
+{
+  int line_cells = 48; // celdas de la fuente vigente (48 para A en 80 mm)
+  int cell_dots = 12;  // puntos por celda (12 fuente A, 9 fuente B)
+  int size = 0;        // GS ! vigente antes de la fila; se restaura al final
+  int code_table = 0;  // ESC t vigente
+  bool utf8 = false;   // la impresora recibe UTF-8 (FS ( C), no una tabla
+};
+
+// Lee un carácter UTF-8 de [p, end). Devuelve los bytes consumidos (al
+// menos 1); una secuencia inválida da U+FFFD.
+size_t escpos_decode_utf8(const uint8_t *p, const uint8_t *end, uint32_t &cp);
+
+// Celdas que ocupa 'codepoint': 0, 1 o 2.
+int escpos_display_width(uint32_t codepoint);
+
+// UTF-8 → bytes para la impresora: la tabla 'code_table' ('?' para lo que
+// no tiene) o UTF-8 tal cual si 'utf8'. Los caracteres de control se
+// descartan, así un dato no puede inyectar comandos.
+void escpos_encode_text(std::string_view text, int code_table, bool utf8,
+                        std::vector<uint8_t> &out);
+
+// Arma filas reutilizando sus buffers: después de la primera no reserva
+// memoria. No es thread-safe.
+class EscPosRowLayout
+{
+public:
+  // Agrega a 'out' la fila (una o más líneas terminadas en LF).
+  void layout(const EscPosColumn *columns, size_t count,
+              const EscPosRowOptions &options, std::vector<uint8_t> &out);
+
+private:
+  struct Unit
+  {
+    uint32_t offset; // en encoded_
+    uint8_t length;  // bytes codificados
+    uint8_t cells;   // 0, 1 o 2
+    bool space;
+    bool wide;
+  };
+
+  // begin/end/pos son índices en units_ si 'units'; si no, offsets en
+  // encoded_ (un byte por celda).
+  struct ColumnState
+  {
+    bool units;
+    size_t begin;
+    size_t end;
+    size_t pos;   // siguiente carácter a imprimir
+    int start;    // primera celda (de la fila)
+    int capacity; // celdas de texto, ya divididas por el multiplicador
+    int scale;
+    int size;
+  };
+
+  bool measure(const EscPosColumn &column, int code_table, bool utf8);
+  void fill(const ColumnState &column, size_t &stop, size_t &next, int &cells) const;
+
+  std::vector<Unit> units_;
+  std::vector<uint8_t> encoded_;
+  std::vector<ColumnState> columns_;
+};
+
+#endif // FLUTTER_PLUGIN_TI_PRINTER_ESCPOS_LAYOUT_H_
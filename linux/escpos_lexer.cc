@@ -0,0 +1,402 @@
+#include "escpos_lexer.h"
+
+namespace
+{
+
+constexpr uint8_t LF = 0x0A;
+constexpr uint8_t FF = 0x0C;
+constexpr uint8_t CR = 0x0D;
+constexpr uint8_t DLE = 0x10;
+constexpr uint8_t ESC = 0x1B;
+constexpr uint8_t FS = 0x1C;
+constexpr uint8_t GS = 0x1D;
+
+constexpr size_t kUnknown = static_cast<size_t>(-1);
+
+size_t u16(const uint8_t *p)
+{
+  return static_cast<size_t>(p[0]) | (static_cast<size_t>(p[1]) << 8);
+}
+
+// Longitud total de un comando que termina en NUL (ESC D, GS k m=0..6).
+size_t until_nul(const uint8_t *data, size_t length, size_t start, size_t from)
+{
+  for (size_t i = from; i < length; i++)
+  {
+    if (data[i] == 0x00)
+      return i + 1 - start;
+  }
+  return kUnknown;
+}
+
+// Longitud de un comando ESC c ... (incluyendo ESC y c). kUnknown si falta
+// el encabezado para poder calcularla.
+size_t esc_length(const uint8_t *d, size_t len, size_t pos)
+{
+  const size_t avail = len - pos;
+  if (avail < 2)
+    return kUnknown;
+  const uint8_t c = d[pos + 1];
+  switch (c)
+  {
+  case '@': case '2': case '<': case 'L': case 'S': case 'i': case 'm':
+  case 'v': case 'F':
+    return 2;
+  case '!': case '%': case '-': case '3': case '=': case '?': case 'E':
+  case 'G': case 'J': case 'M': case 'R': case 'T': case 'V': case 'a':
+  case 'd': case 'e': case 'r': case 't': case 'u': case '{': case ' ':
+  case 'K': case 'U':
+    return 3;
+  case '$': case '\\': case 'c': case 'B':
+    return 4;
+  case 'p':
+    return 5;
+  case 'W':
+    return 10;
+  case 'D':
+    return until_nul(d, len, pos, pos + 2);
+  case '*':
+  {
+    if (avail < 5)
+      return kUnknown;
+    const uint8_t m = d[pos + 2];
+    const size_t columns = u16(d + pos + 3);
+    const size_t bytes_per_col = (m == 0 || m == 1) ? 1 : 3;
+    return 5 + columns * bytes_per_col;
+  }
+  case '&':
+  {
+    // ESC & y c1 c2 [x d1...d(y*x)]k
+    if (avail < 5)
+      return kUnknown;
+    const size_t y = d[pos + 2];
+    const size_t count = d[pos + 4] >= d[pos + 3] ? d[pos + 4] - d[pos + 3] + 1 : 0;
+    size_t at = pos + 5;
+    for (size_t k = 0; k < count; k++)
+    {
+      if (at >= len)
+        return kUnknown;
+      at += 1 + y * d[at];
+    }
+    return at - pos;
+  }
+  default:
+    return 2;
+  }
+}
+
+size_t gs_length(const uint8_t *d, size_t len, size_t pos)
+{
+  const size_t avail = len - pos;
+  if (avail < 2)
+    return kUnknown;
+  const uint8_t c = d[pos + 1];
+  switch (c)
+  {
+  case ':': case 'c':
+    return 2;
+  case '!': case '/': case 'B': case 'H': case 'I': case 'T': case 'a':
+  case 'b': case 'f': case 'h': case 'r': case 'w': case 'x': case 'E':
+    return 3;
+  case '$': case 'L': case 'P': case 'W': case '\\':
+    return 4;
+  case '^':
+    return 5;
+  case 'V':
+    if (avail < 3)
+      return kUnknown;
+    return (d[pos + 2] == 0 || d[pos + 2] == 1 || d[pos + 2] == '0' ||
+            d[pos + 2] == '1')
+               ? 3
+               : 4;
+  case '(':
+    if (avail < 5)
+      return kUnknown;
+    return 5 + u16(d + pos + 3);
+  case '8':
+    // GS 8 L p1 p2 p3 p4 m fn ... (longitud de 32 bits)
+    if (avail < 7)
+      return kUnknown;
+    return 7 + (static_cast<size_t>(d[pos + 3]) |
+                (static_cast<size_t>(d[pos + 4]) << 8) |
+                (static_cast<size_t>(d[pos + 5]) << 16) |
+                (static_cast<size_t>(d[pos + 6]) << 24));
+  case '*':
+    if (avail < 4)
+      return kUnknown;
+    return 4 + static_cast<size_t>(d[pos + 2]) * d[pos + 3] * 8;
+  case 'v':
+  case 'Q':
+    // GS v 0 m xL xH yL yH d1...dk / GS Q 0 (mismo layout)
+    if (avail < 8)
+      return kUnknown;
+    return 8 + u16(d + pos + 4) * u16(d + pos + 6);
+  case 'k':
+  {
+    if (avail < 3)
+      return kUnknown;
+    const uint8_t m = d[pos + 2];
+    if (m <= 6)
+      return until_nul(d, len, pos, pos + 3);
+    if (avail < 4)
+      return kUnknown;
+    return 4 + d[pos + 3];
+  }
+  case 'g':
+    return 5;
+  default:
+    return 2;
+  }
+}
+
+size_t fs_length(const uint8_t *d, size_t len, size_t pos)
+{
+  const size_t avail = len - pos;
+  if (avail < 2)
+    return kUnknown;
+  switch (d[pos + 1])
+  {
+  case '&': case '.':
+    return 2;
+  case '!': case '-': case 'C': case 'W':
+    return 3;
+  case 'S': case 'p':
+    return 4;
+  case '(':
+    if (avail < 5)
+      return kUnknown;
+    return 5 + u16(d + pos + 3);
+  default:
+    return 2;
+  }
+}
+
+size_t dle_length(const uint8_t *d, size_t len, size_t pos)
+{
+  if (len - pos < 2)
+    return kUnknown;
+  switch (d[pos + 1])
+  {
+  case 0x04: // DLE EOT n
+  case 0x05: // DLE ENQ n
+    return 3;
+  case 0x14: // DLE DC4 fn a b
+    return 5;
+  default:
+    return 1;
+  }
+}
+
+bool is_control(uint8_t b)
+{
+  return b < 0x20 || b == 0x7F;
+}
+
+} // namespace
+
+EscPosToken escpos_next_token(const uint8_t *data, size_t length, size_t pos)
+{
+  EscPosToken token{pos, 0, EscPosTokenKind::kText};
+  if (pos >= length)
+    return token;
+
+  const uint8_t b = data[pos];
+  if (!is_control(b))
+  {
+    size_t end = pos + 1;
+    while (end < length && !is_control(data[end]))
+      end++;
+    token.length = end - pos;
+    return token;
+  }
+
+  size_t cmd_len = 1;
+  switch (b)
+  {
+  case LF:
+  case CR:
+  case FF:
+    token.kind = EscPosTokenKind::kLineFeed;
+    token.length = 1;
+    return token;
+  case ESC:
+    cmd_len = esc_length(data, length, pos);
+    break;
+  case GS:
+    cmd_len = gs_length(data, length, pos);
+    break;
+  case FS:
+    cmd_len = fs_length(data, length, pos);
+    break;
+  case DLE:
+    cmd_len = dle_length(data, length, pos);
+    break;
+  default: // HT, CAN y otros de un byte
+    cmd_len = 1;
+    break;
+  }
+
+  if (cmd_len == kUnknown || pos + cmd_len > length)
+  {
+    token.kind = EscPosTokenKind::kIncomplete;
+    token.length = length - pos;
+    return token;
+  }
+
+  token.kind = EscPosTokenKind::kCommand;
+  token.length = cmd_len;
+  return token;
+}
+
+bool escpos_token_is_modal(const uint8_t *data, const EscPosToken &token)
+{
+  if (token.kind != EscPosTokenKind::kCommand || token.length < 2)
+    return false;
+
+  const uint8_t *p = data + token.offset;
+  if (p[0] == ESC)
+  {
+    switch (p[1])
+    {
+    case '@': case '!': case '-': case '2': case '3': case 'E': case 'G':
+    case 'M': case 'R': case 'a': case 't': case ' ': case 'V': case '{':
+    case 'T': case 'L': case 'S': case 'W': case 'D': case '%': case 'c':
+      return true;
+    default:
+      return false;
+    }
+  }
+  if (p[0] == GS)
+  {
+    switch (p[1])
+    {
+    case '!': case 'B': case 'H': case 'L': case 'W': case 'f': case 'h':
+    case 'w': case 'P': case 'b': case 'E':
+      return true;
+    case '(':
+      // GS ( k: sólo las funciones de configuración/almacenamiento (no la
+      // 81 "imprimir símbolo"). GS ( L: sólo configuración (fn 48/49).
+      if (token.length >= 7 && p[2] == 'k')
+        return p[6] != 81;
+      if (token.length >= 7 && p[2] == 'L')
+        return p[6] == 48 || p[6] == 49;
+      return false;
+    default:
+      return false;
+    }
+  }
+  if (p[0] == FS)
+  {
+    return p[1] == '!' || p[1] == '-' || p[1] == '&' || p[1] == '.' ||
+           p[1] == 'C' || p[1] == 'S' || p[1] == 'W';
+  }
+  return false;
+}
+
+bool escpos_token_ends_line(const uint8_t *data, const EscPosToken &token)
+{
+  if (token.kind == EscPosTokenKind::kLineFeed)
+    return data[token.offset] != CR;
+  if (token.kind != EscPosTokenKind::kCommand || token.length < 2)
+    return false;
+
+  const uint8_t *p = data + token.offset;
+  if (p[0] == ESC)
+    return p[1] == 'd' || p[1] == 'J' || p[1] == 'i' || p[1] == 'm';
+  if (p[0] == GS)
+  {
+    switch (p[1])
+    {
+    case 'v': case 'Q': case 'V': case 'k': case '/':
+      return true;
+    case '(':
+      // GS ( L fn 2 / 50: imprimir el gráfico del buffer (fn 112 sólo lo
+      // guarda). GS ( k fn 81: imprimir el símbolo.
+      if (token.length >= 7 && p[2] == 'L')
+        return p[6] == 50 || p[6] == 2;
+      if (token.length >= 7 && p[2] == 'k')
+        return p[6] == 81;
+      return false;
+    case '8':
+      return token.length >= 9 && p[2] == 'L' && p[8] == 50;
+    default:
+      return false;
+    }
+  }
+  return false;
+}
+
+size_t escpos_safe_boundary(const uint8_t *data, size_t length, size_t limit)
+{
+  if (limit > length)
+    limit = length;
+
+  size_t boundary = 0;
+  size_t pos = 0;
+  while (pos < limit)
+  {
+    EscPosToken token = escpos_next_token(data, length, pos);
+    if (token.kind == EscPosTokenKind::kIncomplete || token.length == 0)
+      break;
+    const size_t end = pos + token.length;
+    if (end > limit)
+      break;
+    if (escpos_token_ends_line(data, token))
+      boundary = end;
+    pos = end;
+  }
+  return boundary;
+}
+
+size_t escpos_command_boundary(const uint8_t *data, size_t length,
+                               size_t from, size_t target)
+{
+  if (target >= length)
+    return length;
+
+  size_t pos = from;
+  while (pos < target)
+  {
+    EscPosToken token = escpos_next_token(data, length, pos);
+    if (token.length == 0 || token.kind == EscPosTokenKind::kIncomplete)
+      return length;
+    const size_t end = pos + token.length;
+    if (end > target)
+      return token.kind == EscPosTokenKind::kText ? target : end;
+    pos = end;
+  }
+  return pos;
+}
+
+bool escpos_is_realtime(const uint8_t *data, size_t length)
+{
+  if (!data || length == 0)
+    return false;
+
+  size_t pos = 0;
+  while (pos < length)
+  {
+    EscPosToken token = escpos_next_token(data, length, pos);
+    if (token.kind != EscPosTokenKind::kCommand || token.length < 3 ||
+        data[pos] != DLE)
+      return false;
+    pos += token.length;
+  }
+  return true;
+}
+
+std::vector<uint8_t> escpos_modal_prefix(const uint8_t *data, size_t boundary)
+{
+  std::vector<uint8_t> prefix;
+  size_t pos = 0;
+  while (pos < boundary)
+  {
+    EscPosToken token = escpos_next_token(data, boundary, pos);
+    if (token.length == 0 || token.kind == EscPosTokenKind::kIncomplete)
+      break;
+    if (escpos_token_is_modal(data, token))
+      prefix.insert(prefix.end(), data + pos, data + pos + token.length);
+    pos += token.length;
+  }
+  return prefix;
+}
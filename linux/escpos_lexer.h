@@ -0,0 +1,59 @@
+#ifndef FLUTTER_PLUGIN_TI_PRINTER_ESCPOS_LEXER_H_
+#define FLUTTER_PLUGIN_TI_PRINTER_ESCPOS_LEXER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Lexer mínimo de ESC/POS: separa un stream en texto y comandos completos
+// usando la tabla de longitudes de parámetros de cada comando. No interpreta
+// los comandos; sólo sabe dónde empieza y termina cada uno, si imprime
+// (avanza papel / genera salida) y si deja el cabezal al inicio de línea.
+
+enum class EscPosTokenKind
+{
+  kText,       // run de bytes imprimibles (sin comandos intercalados)
+  kLineFeed,   // LF / CR / FF
+  kCommand,    // ESC, GS, FS, DLE u otro byte de control con sus parámetros
+  kIncomplete, // comando truncado al final del buffer
+};
+
+struct EscPosToken
+{
+  size_t offset;
+  size_t length;
+  EscPosTokenKind kind;
+};
+
+// Devuelve el token que empieza en 'pos'. Los runs de texto terminan en el
+// primer byte de control.
+EscPosToken escpos_next_token(const uint8_t *data, size_t length, size_t pos);
+
+// true si el comando sólo cambia estado modal (estilos, alineación, tabla de
+// caracteres, interlineado...) y puede re-enviarse sin producir salida.
+bool escpos_token_is_modal(const uint8_t *data, const EscPosToken &token);
+
+// true si después del token el cabezal queda al inicio de una línea y no hay
+// ninguna imagen/código a medio transferir: es seguro cortar el stream ahí.
+bool escpos_token_ends_line(const uint8_t *data, const EscPosToken &token);
+
+// Mayor offset <= 'limit' que cae en un límite seguro de línea/banda.
+size_t escpos_safe_boundary(const uint8_t *data, size_t length, size_t limit);
+
+// Primer offset >= 'target' donde se puede intercalar otro comando sin
+// partir uno en curso (dentro de un run de texto vale cualquier byte).
+// 'from' debe ser el inicio de un token; si 'target' cae dentro de un
+// comando (ej. una banda GS v 0), devuelve el final de ese comando.
+size_t escpos_command_boundary(const uint8_t *data, size_t length,
+                               size_t from, size_t target);
+
+// true si el buffer contiene sólo comandos de tiempo real (DLE EOT, DLE ENQ,
+// DLE DC4): la impresora los atiende aunque tenga el buffer de recepción
+// lleno, así que no tiene sentido encolarlos detrás de un trabajo.
+bool escpos_is_realtime(const uint8_t *data, size_t length);
+
+// Comandos modales de data[0, boundary) en orden, para restaurar estilos y
+// alineación antes de retomar un trabajo a partir de 'boundary'.
+std::vector<uint8_t> escpos_modal_prefix(const uint8_t *data, size_t boundary);
+
+#endif // FLUTTER_PLUGIN_TI_PRINTER_ESCPOS_LEXER_H_
@@ -0,0 +1,374 @@
+#include "escpos_optimizer.h"
+
+#include <algorithm>
+
+#include "escpos_lexer.h"
+
+namespace
+{
+
+constexpr uint8_t LF = 0x0A;
+constexpr uint8_t FF = 0x0C;
+constexpr uint8_t DLE = 0x10;
+constexpr uint8_t ESC = 0x1B;
+constexpr uint8_t FS = 0x1C;
+constexpr uint8_t GS = 0x1D;
+
+constexpr int kUnknown = -1;
+
+// Estados modales que se siguen. El orden es el de emisión al vaciar los
+// pendientes; son independientes entre sí, así que cualquiera sirve.
+enum Slot
+{
+  kAlign,
+  kUpsideDown,
+  kRotate,
+  kLineSpacing,
+  kCodeTable,
+  kCharset,
+  kKanji,
+  kFont,
+  kSize,
+  kBold,
+  kDoubleStrike,
+  kUnderline,
+  kReverse,
+  kCharSpacing,
+  kSlotCount,
+};
+
+struct ModalCommand
+{
+  Slot slot;
+  int value;
+  bool line_start_only; // la impresora lo ignora fuera de inicio de línea
+};
+
+// n en {0,1,2} o {'0','1','2'} → 0..2; cualquier otro valor no se modela.
+int small_param(uint8_t n)
+{
+  if (n <= 2)
+    return n;
+  if (n >= '0' && n <= '2')
+    return n - '0';
+  return kUnknown;
+}
+
+// Reconoce los comandos modales que el optimizador sabe comparar y
+// normaliza su parámetro (ESC E 1 y ESC E 3 son la misma negrita).
+bool classify(const uint8_t *p, size_t length, ModalCommand &out)
+{
+  if (length == 2 && p[0] == ESC && p[1] == '2')
+  {
+    out = {kLineSpacing, 0x100, false}; // interlineado por defecto
+    return true;
+  }
+  if (length == 2 && p[0] == FS && (p[1] == '&' || p[1] == '.'))
+  {
+    out = {kKanji, p[1] == '&' ? 1 : 0, false};
+    return true;
+  }
+  if (length != 3)
+    return false;
+
+  const uint8_t n = p[2];
+  if (p[0] == ESC)
+  {
+    switch (p[1])
+    {
+    case 'a':
+      out = {kAlign, small_param(n), true};
+      break;
+    case '{':
+      out = {kUpsideDown, n & 1, true};
+      break;
+    case 'V':
+      out = {kRotate, small_param(n), true};
+      break;
+    case '3':
+      out = {kLineSpacing, n, false};
+      break;
+    case 't':
+      out = {kCodeTable, n, false};
+      break;
+    case 'R':
+      out = {kCharset, n, false};
+      break;
+    case 'M':
+      out = {kFont, small_param(n), false};
+      break;
+    case 'E':
+      out = {kBold, n & 1, false};
+      break;
+    case 'G':
+      out = {kDoubleStrike, n & 1, false};
+      break;
+    case '-':
+      out = {kUnderline, small_param(n), false};
+      break;
+    case ' ':
+      out = {kCharSpacing, n, false};
+      break;
+    default:
+      return false;
+    }
+    return out.value != kUnknown;
+  }
+  if (p[0] == GS)
+  {
+    if (p[1] == '!')
+      out = {kSize, n, false};
+    else if (p[1] == 'B')
+      out = {kReverse, n & 1, false};
+    else
+      return false;
+    return true;
+  }
+  return false;
+}
+
+// true si el comando no imprime ni mueve la posición horizontal: después
+// de él la impresora sigue en inicio de línea si lo estaba.
+bool keeps_line_position(const uint8_t *data, const EscPosToken &token)
+{
+  const uint8_t *p = data + token.offset;
+  if (p[0] == DLE)
+    return true;
+  // ESC $ 0 0: posición absoluta al margen izquierdo (Generator lo manda
+  // antes de cada texto).
+  if (token.length == 4 && p[0] == ESC && p[1] == '$' && p[2] == 0 && p[3] == 0)
+    return true;
+  return escpos_token_is_modal(data, token);
+}
+
+class Optimizer
+{
+public:
+  Optimizer(const uint8_t *data, size_t length) : data_(data), length_(length)
+  {
+    std::fill(emitted_, emitted_ + kSlotCount, kUnknown);
+    std::fill(desired_, desired_ + kSlotCount, kUnknown);
+    out_.reserve(length);
+  }
+
+  std::vector<uint8_t> run(EscPosOptimizeStats &stats)
+  {
+    size_t pos = 0;
+    while (pos < length_)
+    {
+      const EscPosToken token = escpos_next_token(data_, length_, pos);
+      if (token.length == 0)
+        break;
+      handle(token);
+      pos += token.length;
+    }
+    flush_feeds();
+    flush_modal();
+
+    stats.input_bytes = length_;
+    stats.output_bytes = out_.size();
+    stats.dropped_commands = modal_seen_ - modal_emitted_;
+    stats.merged_feeds = merged_feeds_;
+    return std::move(out_);
+  }
+
+private:
+  void handle(const EscPosToken &token)
+  {
+    const uint8_t *p = data_ + token.offset;
+    switch (token.kind)
+    {
+    case EscPosTokenKind::kText:
+      emit_barrier(token);
+      line_start_ = false;
+      return;
+    case EscPosTokenKind::kIncomplete:
+      emit_barrier(token);
+      return;
+    case EscPosTokenKind::kLineFeed:
+      if (p[0] == LF)
+        feed(1);
+      else
+      {
+        // CR depende de la configuración (ignorado o avance): no se toca.
+        emit_barrier(token);
+        if (p[0] == FF)
+          line_start_ = true;
+      }
+      return;
+    case EscPosTokenKind::kCommand:
+      break;
+    }
+
+    ModalCommand cmd;
+    if (classify(p, token.length, cmd))
+    {
+      modal(token, cmd);
+      return;
+    }
+
+    if (token.length == 3 && p[0] == ESC && p[1] == 'd' && p[2] > 0)
+    {
+      feed(p[2]);
+      return;
+    }
+
+    if (token.length == 2 && p[0] == ESC && p[1] == '@')
+    {
+      // ESC @ vuelve todo a los valores de encendido: lo pendiente no
+      // llega a tener efecto. Esos valores dependen de los memory switches,
+      // así que después del reset el estado queda desconocido.
+      flush_feeds();
+      append(p, token.length);
+      std::fill(emitted_, emitted_ + kSlotCount, kUnknown);
+      std::fill(desired_, desired_ + kSlotCount, kUnknown);
+      line_start_ = true;
+      return;
+    }
+
+    emit_barrier(token);
+    if (p[0] == ESC && p[1] == '!')
+    {
+      // ESC ! pisa fuente, negrita, subrayado y doble alto/ancho a la vez.
+      for (Slot slot : {kFont, kBold, kUnderline, kSize, kDoubleStrike})
+        emitted_[slot] = desired_[slot] = kUnknown;
+    }
+    // ESC d 0 también cae acá: imprime la línea con su alto pero no avanza,
+    // así que no se puede sumar a los avances de al lado.
+    if (escpos_token_ends_line(data_, token))
+      line_start_ = true;
+    else if (!keeps_line_position(data_, token))
+      line_start_ = false;
+  }
+
+  void modal(const EscPosToken &token, const ModalCommand &cmd)
+  {
+    modal_seen_++;
+    if (cmd.line_start_only && !line_start_)
+    {
+      // Fuera de inicio de línea algunas impresoras lo ignoran y otras lo
+      // aplican a la línea siguiente: si cambia algo se envía tal cual y el
+      // estado pasa a desconocido.
+      if (emitted_[cmd.slot] == cmd.value && desired_[cmd.slot] == cmd.value)
+        return;
+      flush_feeds();
+      flush_modal();
+      append(data_ + token.offset, token.length);
+      modal_emitted_++;
+      emitted_[cmd.slot] = desired_[cmd.slot] = kUnknown;
+      return;
+    }
+
+    desired_[cmd.slot] = cmd.value;
+    desired_offset_[cmd.slot] = token.offset;
+    desired_length_[cmd.slot] = token.length;
+  }
+
+  void feed(size_t lines)
+  {
+    // El interlineado y el tamaño afectan al avance: un cambio pendiente
+    // corta la racha.
+    if (modal_pending())
+    {
+      flush_feeds();
+      flush_modal();
+    }
+    if (feed_tokens_ > 0)
+      merged_feeds_++;
+    feed_tokens_++;
+    feed_lines_ += lines;
+    line_start_ = true;
+  }
+
+  void emit_barrier(const EscPosToken &token)
+  {
+    flush_feeds();
+    flush_modal();
+    append(data_ + token.offset, token.length);
+  }
+
+  bool modal_pending() const
+  {
+    for (int slot = 0; slot < kSlotCount; slot++)
+    {
+      if (desired_[slot] != emitted_[slot])
+        return true;
+    }
+    return false;
+  }
+
+  void flush_modal()
+  {
+    for (int slot = 0; slot < kSlotCount; slot++)
+    {
+      if (desired_[slot] == emitted_[slot])
+        continue;
+      append(data_ + desired_offset_[slot], desired_length_[slot]);
+      emitted_[slot] = desired_[slot];
+      modal_emitted_++;
+    }
+  }
+
+  // LF y ESC d n (n > 0) imprimen el buffer y avanzan n líneas: k avances
+  // seguidos equivalen a ESC d k. Hasta 3 líneas LF sueltos son más cortos.
+  void flush_feeds()
+  {
+    if (feed_tokens_ == 0)
+      return;
+    while (feed_lines_ > 0)
+    {
+      const size_t chunk = std::min<size_t>(feed_lines_, 255);
+      if (chunk <= 3)
+        out_.insert(out_.end(), chunk, LF);
+      else
+      {
+        const uint8_t cmd[] = {ESC, 'd', static_cast<uint8_t>(chunk)};
+        append(cmd, sizeof(cmd));
+      }
+      feed_lines_ -= chunk;
+    }
+    feed_tokens_ = 0;
+  }
+
+  void append(const uint8_t *p, size_t length)
+  {
+    out_.insert(out_.end(), p, p + length);
+  }
+
+  const uint8_t *data_;
+  const size_t length_;
+  std::vector<uint8_t> out_;
+
+  int emitted_[kSlotCount];  // lo que la impresora tiene (según lo enviado)
+  int desired_[kSlotCount];  // lo que pide el stream hasta acá
+  size_t desired_offset_[kSlotCount] = {};
+  size_t desired_length_[kSlotCount] = {};
+  bool line_start_ = true; // se asume que el stream empieza en una línea nueva
+
+  size_t feed_tokens_ = 0;
+  size_t feed_lines_ = 0;
+
+  size_t modal_seen_ = 0;
+  size_t modal_emitted_ = 0;
+  size_t merged_feeds_ = 0;
+};
+
+} // namespace
+
+std::vector<uint8_t> escpos_optimize(const uint8_t *data, size_t length,
+                                     EscPosOptimizeStats *stats)
+{
+  EscPosOptimizeStats local;
+  if (!data || length == 0)
+  {
+    if (stats)
+      *stats = local;
+    return {};
+  }
+
+  Optimizer optimizer(data, length);
+  std::vector<uint8_t> out = optimizer.run(local);
+  if (stats)
+    *stats = local;
+  return out;
+}
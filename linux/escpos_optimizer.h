@@ -0,0 +1,38 @@
+#ifndef FLUTTER_PLUGIN_TI_PRINTER_ESCPOS_OPTIMIZER_H_
+#define FLUTTER_PLUGIN_TI_PRINTER_ESCPOS_OPTIMIZER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Pasada peephole sobre un stream ESC/POS que conserva lo impreso.
+//
+// Sigue el estado modal de la impresora (alineación, negrita, subrayado,
+// fuente, tamaño, tabla de caracteres, interlineado...) y difiere cada
+// cambio hasta que algo imprime. Así:
+//   - un comando que deja el estado como estaba no se envía;
+//   - pares on/off sin nada impreso en medio desaparecen;
+//   - LF / ESC d seguidos se juntan en un solo ESC d n;
+//   - los runs de texto separados sólo por comandos eliminados quedan
+//     contiguos.
+//
+// Supuestos conservadores: el estado inicial es desconocido (el primer
+// comando de cada tipo siempre sale), cualquier comando no modelado es una
+// barrera que recibe el estado pendiente antes de ejecutarse, y ESC a /
+// ESC { / ESC V fuera de inicio de línea se envían tal cual y dejan su
+// estado como desconocido.
+
+struct EscPosOptimizeStats
+{
+  size_t input_bytes = 0;
+  size_t output_bytes = 0;
+  size_t dropped_commands = 0; // comandos modales que no llegaron a la salida
+  size_t merged_feeds = 0;     // LF / ESC d absorbidos por otro avance
+
+  size_t saved_bytes() const { return input_bytes - output_bytes; }
+};
+
+std::vector<uint8_t> escpos_optimize(const uint8_t *data, size_t length,
+                                     EscPosOptimizeStats *stats = nullptr);
+
+#endif // FLUTTER_PLUGIN_TI_PRINTER_ESCPOS_OPTIMIZER_H_
@@ -0,0 +1,767 @@
+#include "escpos_render.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include "checksum.h"
+#include "escpos_font.h"
+#include "escpos_lexer.h"
+
+namespace
+{
+
+constexpr uint8_t HT = 0x09;
+constexpr uint8_t LF = 0x0A;
+constexpr uint8_t FF = 0x0C;
+constexpr uint8_t ESC = 0x1B;
+constexpr uint8_t GS = 0x1D;
+
+// ESC 2: 3,75 mm a 203 dpi, el valor de fábrica de las térmicas de 80 mm.
+constexpr int kDefaultLineSpacing = 30;
+constexpr int kDefaultTabColumns = 8;
+
+size_t u16(const uint8_t *p)
+{
+  return static_cast<size_t>(p[0]) | (static_cast<size_t>(p[1]) << 8);
+}
+
+int small_param(uint8_t n)
+{
+  return n >= '0' ? n - '0' : n;
+}
+
+class Renderer
+{
+public:
+  Renderer(const EscPosRenderOptions &options, EscPosPage &page)
+      : page_(page),
+        width_(std::max(options.width, 8)),
+        stride_((static_cast<size_t>(width_) + 7) / 8),
+        max_height_(std::max(options.max_height, 1))
+  {
+    page_ = EscPosPage();
+    page_.width = width_;
+    page_.bits.reserve(stride_ * 2048);
+    reset();
+  }
+
+  void run(const uint8_t *data, size_t length)
+  {
+    size_t pos = 0;
+    while (pos < length && !page_.truncated)
+    {
+      const EscPosToken token = escpos_next_token(data, length, pos);
+      if (token.length == 0 || token.kind == EscPosTokenKind::kIncomplete)
+        break;
+      const uint8_t *p = data + pos;
+      if (token.kind == EscPosTokenKind::kText)
+      {
+        for (size_t i = 0; i < token.length; i++)
+          add_char(p[i]);
+      }
+      else if (token.kind == EscPosTokenKind::kLineFeed)
+      {
+        if (p[0] == LF || p[0] == FF)
+          print_line(line_spacing_);
+        // CR: ignorado, como en la configuración por defecto.
+      }
+      else
+      {
+        command(p, token.length);
+      }
+      pos += token.length;
+    }
+  }
+
+  void finish()
+  {
+    // Texto sin LF final: una impresora lo dejaría en el buffer; en la
+    // vista previa se muestra igual.
+    if (!items_.empty())
+      print_line(0);
+    page_.height = std::min(std::max(page_y_, 1), max_height_);
+    page_.bits.resize(stride_ * static_cast<size_t>(page_.height), 0);
+  }
+
+private:
+  struct Style
+  {
+    int font = 0;
+    bool bold = false;
+    int underline = 0; // grosor en puntos
+    int wmul = 1;
+    int hmul = 1;
+    bool reverse = false;
+  };
+
+  struct Item
+  {
+    int x;
+    int width;
+    int height;
+    bool image; // ESC * en línea
+    int glyph;
+    Style style;
+    size_t data_offset; // en line_data_ (imágenes)
+    int columns;
+    int dots;
+    int xscale;
+    int yscale;
+  };
+
+  // ===================== Estado =====================
+
+  void reset()
+  {
+    style_ = Style();
+    char_spacing_ = 0;
+    align_ = 0;
+    upside_down_ = false;
+    line_spacing_ = kDefaultLineSpacing;
+    code_table_ = 0;
+    left_margin_ = 0;
+    print_width_ = 0;
+    tabs_.clear();
+    items_.clear();
+    line_data_.clear();
+    line_x_ = 0;
+  }
+
+  int area_width() const
+  {
+    const int available = std::max(width_ - left_margin_, 0);
+    return print_width_ > 0 ? std::min(print_width_, available) : available;
+  }
+
+  // ===================== Página =====================
+
+  uint8_t *row(int y)
+  {
+    if (y < 0)
+      return nullptr;
+    if (y >= max_height_)
+    {
+      page_.truncated = true;
+      return nullptr;
+    }
+    const size_t needed = stride_ * (static_cast<size_t>(y) + 1);
+    if (page_.bits.size() < needed)
+      page_.bits.resize(std::max(needed, page_.bits.size() * 2), 0);
+    return page_.bits.data() + stride_ * static_cast<size_t>(y);
+  }
+
+  // ORea 16 píxeles (bit 15 = x) recortando al ancho de la página.
+  void or_bits16(uint8_t *r, int x, uint16_t bits)
+  {
+    if (x < 0 || x >= width_ || bits == 0)
+      return;
+    if (width_ - x < 16)
+      bits &= static_cast<uint16_t>(0xFFFF << (16 - (width_ - x)));
+    const size_t b = static_cast<size_t>(x) >> 3;
+    const uint32_t v = (static_cast<uint32_t>(bits) << 8) >> (x & 7);
+    r[b] |= static_cast<uint8_t>(v >> 16);
+    if (b + 1 < stride_)
+      r[b + 1] |= static_cast<uint8_t>(v >> 8);
+    if (b + 2 < stride_)
+      r[b + 2] |= static_cast<uint8_t>(v);
+  }
+
+  void span(uint8_t *r, int x0, int x1, bool invert)
+  {
+    x0 = std::max(x0, 0);
+    x1 = std::min(x1, width_);
+    for (int x = x0; x < x1; x++)
+    {
+      const uint8_t mask = static_cast<uint8_t>(0x80 >> (x & 7));
+      if (invert)
+        r[x >> 3] ^= mask;
+      else
+        r[x >> 3] |= mask;
+    }
+  }
+
+  void fill_rect(int x, int y, int w, int h, bool invert)
+  {
+    for (int yy = y; yy < y + h; yy++)
+    {
+      uint8_t *r = row(yy);
+      if (!r)
+        return;
+      span(r, x, x + w, invert);
+    }
+  }
+
+  // Bits empaquetados (MSB primero) de 'columns' puntos por fila, escalados.
+  void blit_raster(const uint8_t *data, int columns, int rows, int xs, int ys,
+                   int x0, int y0)
+  {
+    const size_t src_stride = (static_cast<size_t>(columns) + 7) / 8;
+    for (int sy = 0; sy < rows; sy++)
+    {
+      const uint8_t *src = data + src_stride * static_cast<size_t>(sy);
+      for (int k = 0; k < ys; k++)
+      {
+        uint8_t *r = row(y0 + sy * ys + k);
+        if (!r)
+          return;
+        if (xs == 1)
+        {
+          for (size_t b = 0; b < src_stride; b++)
+          {
+            uint8_t byte = src[b];
+            if (b == src_stride - 1 && (columns & 7))
+              byte &= static_cast<uint8_t>(0xFF << (8 - (columns & 7)));
+            or_bits16(r, x0 + static_cast<int>(b) * 8, static_cast<uint16_t>(byte << 8));
+          }
+        }
+        else
+        {
+          for (int sx = 0; sx < columns; sx++)
+          {
+            if (src[sx >> 3] & (0x80 >> (sx & 7)))
+              span(r, x0 + sx * xs, x0 + (sx + 1) * xs, false);
+          }
+        }
+      }
+    }
+  }
+
+  void draw_glyph(const Item &item, int x0, int y0)
+  {
+    const EscPosFont &font = escpos_font(item.style.font);
+    const uint16_t *glyph = font.rows + static_cast<size_t>(item.glyph) * font.height;
+    const int wmul = item.style.wmul;
+    const int hmul = item.style.hmul;
+    for (int gy = 0; gy < font.height; gy++)
+    {
+      uint16_t bits = glyph[gy];
+      if (item.style.bold)
+        bits |= static_cast<uint16_t>(bits >> 1);
+      if (bits == 0)
+        continue;
+      for (int k = 0; k < hmul; k++)
+      {
+        uint8_t *r = row(y0 + gy * hmul + k);
+        if (!r)
+          return;
+        if (wmul == 1)
+        {
+          or_bits16(r, x0, bits);
+          continue;
+        }
+        for (int px = 0; px < 16; px++)
+        {
+          if (bits & (0x8000 >> px))
+            span(r, x0 + px * wmul, x0 + (px + 1) * wmul, false);
+        }
+      }
+    }
+
+    if (item.style.underline > 0)
+      fill_rect(x0, y0 + item.height - item.style.underline, item.width,
+                item.style.underline, false);
+    if (item.style.reverse)
+      fill_rect(x0, y0, item.width, item.height, true);
+  }
+
+  void draw_bit_image(const Item &item, int x0, int y0)
+  {
+    // ESC *: columnas de 'dots' puntos, cada una de arriba hacia abajo.
+    const int bytes_per_column = item.dots / 8;
+    const uint8_t *data = line_data_.data() + item.data_offset;
+    for (int c = 0; c < item.columns; c++)
+    {
+      for (int d = 0; d < item.dots; d++)
+      {
+        const uint8_t byte = data[c * bytes_per_column + d / 8];
+        if (byte & (0x80 >> (d & 7)))
+          fill_rect(x0 + c * item.xscale, y0 + d * item.yscale, item.xscale,
+                    item.yscale, false);
+      }
+    }
+  }
+
+  // Rota 180° las filas [y0, y0 + h) (ESC {).
+  void rotate_rows(int y0, int h)
+  {
+    std::vector<uint8_t> flipped(stride_);
+    for (int y = y0; y < y0 + h; y++)
+    {
+      uint8_t *r = row(y);
+      if (!r)
+        return;
+      std::fill(flipped.begin(), flipped.end(), 0);
+      for (int x = 0; x < width_; x++)
+      {
+        if (r[x >> 3] & (0x80 >> (x & 7)))
+        {
+          const int fx = width_ - 1 - x;
+          flipped[fx >> 3] |= static_cast<uint8_t>(0x80 >> (fx & 7));
+        }
+      }
+      std::memcpy(r, flipped.data(), stride_);
+    }
+    for (int top = y0, bottom = y0 + h - 1; top < bottom; top++, bottom--)
+    {
+      uint8_t *b = row(bottom); // primero la mayor: row() puede crecer la página
+      uint8_t *a = row(top);
+      if (!a || !b)
+        return;
+      std::swap_ranges(a, a + stride_, b);
+    }
+  }
+
+  // ===================== Línea =====================
+
+  void add_item(Item item)
+  {
+    if (items_.empty())
+    {
+      // Alineación e inversión se toman al empezar la línea.
+      line_align_ = align_;
+      line_upside_down_ = upside_down_;
+    }
+    else if (line_x_ + item.width > area_width())
+    {
+      print_line(line_spacing_);
+      line_align_ = align_;
+      line_upside_down_ = upside_down_;
+    }
+    item.x = line_x_;
+    line_x_ += item.width;
+    items_.push_back(item);
+  }
+
+  void add_char(uint8_t c)
+  {
+    const EscPosFont &font = escpos_font(style_.font);
+    Item item{};
+    item.glyph = escpos_glyph_index(c, code_table_);
+    item.style = style_;
+    item.width = (font.width + char_spacing_) * style_.wmul;
+    item.height = font.height * style_.hmul;
+    add_item(item);
+  }
+
+  // Imprime la línea en curso y avanza max(feed, alto de la línea).
+  void print_line(int feed)
+  {
+    int height = 0;
+    if (!items_.empty())
+    {
+      int right = 0;
+      for (const Item &item : items_)
+      {
+        height = std::max(height, item.height);
+        right = std::max(right, item.x + item.width);
+      }
+      const int shift = aligned_offset(right, line_align_);
+      for (const Item &item : items_)
+      {
+        const int x0 = left_margin_ + shift + item.x;
+        const int y0 = page_y_ + height - item.height;
+        if (item.image)
+          draw_bit_image(item, x0, y0);
+        else
+          draw_glyph(item, x0, y0);
+      }
+      if (line_upside_down_)
+        rotate_rows(page_y_, height);
+    }
+    advance(std::max(feed, height));
+    items_.clear();
+    line_data_.clear();
+    line_x_ = 0;
+  }
+
+  int aligned_offset(int content_width, int align) const
+  {
+    const int free = area_width() - content_width;
+    if (free <= 0)
+      return 0;
+    if (align == 1)
+      return free / 2;
+    if (align == 2)
+      return free;
+    return 0;
+  }
+
+  void advance(int dots)
+  {
+    page_y_ += std::max(dots, 0);
+    if (page_y_ >= max_height_)
+    {
+      page_y_ = max_height_;
+      page_.truncated = true;
+    }
+  }
+
+  void flush_for_block()
+  {
+    if (!items_.empty())
+      print_line(0);
+  }
+
+  // Imagen de bloque (GS v 0, GS ( L): ocupa sus propias filas.
+  void print_raster(const uint8_t *data, int columns, int rows, int xs, int ys)
+  {
+    flush_for_block();
+    const int x0 = left_margin_ + aligned_offset(columns * xs, align_);
+    blit_raster(data, columns, rows, xs, ys, x0, page_y_);
+    advance(rows * ys);
+  }
+
+  void cut(int feed)
+  {
+    flush_for_block();
+    advance(feed);
+    if (uint8_t *r = row(page_y_))
+    {
+      for (int x = 0; x < width_; x += 8)
+        span(r, x, x + 4, false);
+      page_.cuts.push_back(page_y_);
+      advance(1);
+    }
+  }
+
+  void tab()
+  {
+    const EscPosFont &font = escpos_font(style_.font);
+    const int column = (font.width + char_spacing_) * style_.wmul;
+    if (tabs_.empty())
+    {
+      line_x_ = (line_x_ / (column * kDefaultTabColumns) + 1) * column * kDefaultTabColumns;
+      return;
+    }
+    for (int stop : tabs_)
+    {
+      if (stop * column > line_x_)
+      {
+        line_x_ = stop * column;
+        return;
+      }
+    }
+  }
+
+  // ===================== Comandos =====================
+
+  void command(const uint8_t *p, size_t length)
+  {
+    if (p[0] == HT)
+    {
+      tab();
+      return;
+    }
+    if (length < 2)
+      return;
+
+    if (p[0] == ESC)
+      esc_command(p, length);
+    else if (p[0] == GS)
+      gs_command(p, length);
+  }
+
+  void esc_command(const uint8_t *p, size_t length)
+  {
+    const uint8_t n = length >= 3 ? p[2] : 0;
+    switch (p[1])
+    {
+    case '@':
+      reset();
+      break;
+    case '!':
+      style_.font = n & 0x01;
+      style_.bold = (n & 0x08) != 0;
+      style_.hmul = (n & 0x10) ? 2 : 1;
+      style_.wmul = (n & 0x20) ? 2 : 1;
+      style_.underline = (n & 0x80) ? 1 : 0;
+      break;
+    case 'E':
+    case 'G':
+      style_.bold = (n & 1) != 0;
+      break;
+    case '-':
+      style_.underline = std::min(small_param(n), 2);
+      break;
+    case 'M':
+      style_.font = small_param(n) == 1 ? 1 : 0;
+      break;
+    case 'a':
+      align_ = std::min(small_param(n), 2);
+      break;
+    case '{':
+      upside_down_ = (n & 1) != 0;
+      break;
+    case ' ':
+      char_spacing_ = n;
+      break;
+    case 't':
+      code_table_ = n;
+      break;
+    case '2':
+      line_spacing_ = kDefaultLineSpacing;
+      break;
+    case '3':
+      line_spacing_ = n;
+      break;
+    case 'd':
+      print_line(n > 0 ? line_spacing_ : 0);
+      if (n > 1)
+        advance((n - 1) * line_spacing_);
+      break;
+    case 'J':
+      print_line(n);
+      break;
+    case '$':
+      line_x_ = static_cast<int>(u16(p + 2));
+      break;
+    case '\\':
+      line_x_ = std::max(line_x_ + static_cast<int16_t>(u16(p + 2)), 0);
+      break;
+    case 'D':
+      tabs_.clear();
+      for (size_t i = 2; i + 1 < length; i++)
+        tabs_.push_back(p[i]);
+      break;
+    case '*':
+      bit_image(p, length);
+      break;
+    default:
+      break;
+    }
+  }
+
+  void bit_image(const uint8_t *p, size_t length)
+  {
+    const uint8_t m = p[2];
+    Item item{};
+    item.image = true;
+    item.columns = static_cast<int>(u16(p + 3));
+    item.dots = (m == 0 || m == 1) ? 8 : 24;
+    item.xscale = (m == 0 || m == 32) ? 2 : 1;
+    // Los modos de 8 puntos tienen un tercio de la densidad vertical.
+    item.yscale = item.dots == 8 ? 3 : 1;
+    item.width = item.columns * item.xscale;
+    item.height = item.dots * item.yscale;
+    if (length < 5 + static_cast<size_t>(item.columns) * (item.dots / 8))
+      return;
+    item.data_offset = line_data_.size();
+    line_data_.insert(line_data_.end(), p + 5, p + length);
+    add_item(item);
+  }
+
+  void gs_command(const uint8_t *p, size_t length)
+  {
+    const uint8_t n = length >= 3 ? p[2] : 0;
+    switch (p[1])
+    {
+    case '!':
+      style_.wmul = ((n >> 4) & 7) + 1;
+      style_.hmul = (n & 7) + 1;
+      break;
+    case 'B':
+      style_.reverse = (n & 1) != 0;
+      break;
+    case 'L':
+      left_margin_ = std::min(static_cast<int>(u16(p + 2)), width_ - 1);
+      break;
+    case 'W':
+      print_width_ = static_cast<int>(u16(p + 2));
+      break;
+    case 'V':
+      cut((n == 65 || n == 66) && length >= 4 ? p[3] : 0);
+      break;
+    case 'v':
+    {
+      // GS v 0 m xL xH yL yH d1...dk
+      const int columns = static_cast<int>(u16(p + 4)) * 8;
+      const int rows = static_cast<int>(u16(p + 6));
+      const uint8_t m = p[3];
+      print_raster(p + 8, columns, rows, (m & 1) ? 2 : 1, (m & 2) ? 2 : 1);
+      break;
+    }
+    case '(':
+      if (n == 'L' && length >= 7)
+        graphics(p + 5, length - 5);
+      break;
+    case '8':
+      if (n == 'L' && length >= 9)
+        graphics(p + 7, length - 7);
+      break;
+    default:
+      break;
+    }
+  }
+
+  // GS ( L / GS 8 L a partir de "m fn ...".
+  void graphics(const uint8_t *p, size_t length)
+  {
+    const uint8_t fn = p[1];
+    if (fn == 112 && length >= 10)
+    {
+      // m fn a bx by c xL xH yL yH d1...dk
+      const int columns = static_cast<int>(u16(p + 6));
+      const int rows = static_cast<int>(u16(p + 8));
+      const size_t stride = (static_cast<size_t>(columns) + 7) / 8;
+      if (p[5] != 49 || stride * rows > length - 10)
+        return; // sólo el primer color, y datos completos
+      graphics_columns_ = columns;
+      graphics_rows_ = rows;
+      graphics_xs_ = p[3] == 2 ? 2 : 1;
+      graphics_ys_ = p[4] == 2 ? 2 : 1;
+      graphics_.assign(p + 10, p + 10 + stride * rows);
+    }
+    else if ((fn == 50 || fn == 2) && !graphics_.empty())
+    {
+      print_raster(graphics_.data(), graphics_columns_, graphics_rows_,
+                   graphics_xs_, graphics_ys_);
+    }
+  }
+
+  EscPosPage &page_;
+  const int width_;
+  const size_t stride_;
+  const int max_height_;
+  int page_y_ = 0;
+
+  Style style_;
+  int char_spacing_ = 0;
+  int align_ = 0;
+  bool upside_down_ = false;
+  int line_spacing_ = kDefaultLineSpacing;
+  int code_table_ = 0;
+  int left_margin_ = 0;
+  int print_width_ = 0;
+  std::vector<int> tabs_;
+
+  std::vector<Item> items_;
+  std::vector<uint8_t> line_data_;
+  int line_x_ = 0;
+  int line_align_ = 0;
+  bool line_upside_down_ = false;
+
+  std::vector<uint8_t> graphics_;
+  int graphics_columns_ = 0;
+  int graphics_rows_ = 0;
+  int graphics_xs_ = 1;
+  int graphics_ys_ = 1;
+};
+
+void put_u32be(std::vector<uint8_t> &out, uint32_t v)
+{
+  out.push_back(static_cast<uint8_t>(v >> 24));
+  out.push_back(static_cast<uint8_t>(v >> 16));
+  out.push_back(static_cast<uint8_t>(v >> 8));
+  out.push_back(static_cast<uint8_t>(v));
+}
+
+void png_chunk(std::vector<uint8_t> &out, const char *type,
+               const uint8_t *data, size_t length)
+{
+  put_u32be(out, static_cast<uint32_t>(length));
+  const size_t start = out.size();
+  out.insert(out.end(), type, type + 4);
+  if (length > 0)
+    out.insert(out.end(), data, data + length);
+  put_u32be(out, crc32(out.data() + start, 4 + length));
+}
+
+uint32_t adler32(const uint8_t *data, size_t length)
+{
+  uint32_t a = 1;
+  uint32_t b = 0;
+  while (length > 0)
+  {
+    // 5552: máximo de bytes antes de que b pueda desbordar 32 bits.
+    const size_t n = std::min<size_t>(length, 5552);
+    for (size_t i = 0; i < n; i++)
+    {
+      a += data[i];
+      b += a;
+    }
+    a %= 65521;
+    b %= 65521;
+    data += n;
+    length -= n;
+  }
+  return (b << 16) | a;
+}
+
+} // namespace
+
+void escpos_render(const uint8_t *data, size_t length,
+                   const EscPosRenderOptions &options, EscPosPage &page)
+{
+  Renderer renderer(options, page);
+  if (data && length > 0)
+    renderer.run(data, length);
+  renderer.finish();
+}
+
+std::vector<uint8_t> escpos_page_to_pbm(const EscPosPage &page)
+{
+  const std::string header =
+      "P4\n" + std::to_string(page.width) + " " + std::to_string(page.height) + "\n";
+  std::vector<uint8_t> out(header.begin(), header.end());
+  out.insert(out.end(), page.bits.begin(), page.bits.end());
+  return out;
+}
+
+std::vector<uint8_t> escpos_page_to_png(const EscPosPage &page)
+{
+  static const uint8_t kSignature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+  const size_t stride = (static_cast<size_t>(page.width) + 7) / 8;
+
+  std::vector<uint8_t> out(kSignature, kSignature + sizeof(kSignature));
+  out.reserve((stride + 1) * static_cast<size_t>(page.height) + 128);
+
+  // IHDR: ancho, alto, 1 bit, escala de grises, sin entrelazado.
+  uint8_t ihdr[13] = {};
+  for (int i = 0; i < 4; i++)
+  {
+    ihdr[i] = static_cast<uint8_t>(page.width >> (24 - 8 * i));
+    ihdr[4 + i] = static_cast<uint8_t>(page.height >> (24 - 8 * i));
+  }
+  ihdr[8] = 1;
+  png_chunk(out, "IHDR", ihdr, sizeof(ihdr));
+
+  // Filas con filtro 0 y bits invertidos (en PNG 0 es negro).
+  const size_t raw_stride = stride + 1;
+  std::vector<uint8_t> raw(raw_stride * static_cast<size_t>(page.height));
+  for (int y = 0; y < page.height; y++)
+  {
+    const uint8_t *src = page.bits.data() + stride * static_cast<size_t>(y);
+    uint8_t *dst = raw.data() + raw_stride * static_cast<size_t>(y);
+    dst[0] = 0;
+    for (size_t b = 0; b < stride; b++)
+      dst[b + 1] = static_cast<uint8_t>(~src[b]);
+  }
+
+  // zlib con bloques "stored" de hasta 65535 bytes.
+  const size_t blocks = std::max<size_t>((raw.size() + 65534) / 65535, 1);
+  std::vector<uint8_t> idat(2 + blocks * 5 + raw.size() + 4);
+  uint8_t *w = idat.data();
+  *w++ = 0x78;
+  *w++ = 0x01;
+  size_t offset = 0;
+  for (size_t i = 0; i < blocks; i++)
+  {
+    const size_t n = std::min<size_t>(raw.size() - offset, 65535);
+    *w++ = i + 1 == blocks ? 1 : 0;
+    *w++ = static_cast<uint8_t>(n);
+    *w++ = static_cast<uint8_t>(n >> 8);
+    *w++ = static_cast<uint8_t>(~n);
+    *w++ = static_cast<uint8_t>(~n >> 8);
+    std::memcpy(w, raw.data() + offset, n);
+    w += n;
+    offset += n;
+  }
+  const uint32_t adler = adler32(raw.data(), raw.size());
+  for (int i = 0; i < 4; i++)
+    *w++ = static_cast<uint8_t>(adler >> (24 - 8 * i));
+  png_chunk(out, "IDAT", idat.data(), idat.size());
+
+  png_chunk(out, "IEND", nullptr, 0);
+  return out;
+}
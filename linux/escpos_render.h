@@ -0,0 +1,49 @@
+#ifndef FLUTTER_PLUGIN_TI_PRINTER_ESCPOS_RENDER_H_
+#define FLUTTER_PLUGIN_TI_PRINTER_ESCPOS_RENDER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Intérprete ESC/POS que ejecuta un stream sobre una página de 1 bit, para
+// vista previa y para comparar tickets en tests sin gastar papel.
+//
+// Soporta: texto con las fuentes A/B (escpos_font.h) y tablas de
+// caracteres ESC t, ESC ! / GS ! / ESC E / ESC G / ESC - / GS B / ESC { /
+// ESC M / ESC SP, alineación ESC a, márgenes GS L / GS W, posición ESC $ /
+// ESC \ / HT, interlineado ESC 2 / ESC 3, avances LF / ESC d / ESC J,
+// imágenes GS v 0, ESC * y GS ( L / GS 8 L (fn 112 + fn 50), ESC @ y
+// cortes GS V (marcados con una línea punteada).
+//
+// Los códigos de barras, QR y el resto de comandos se saltean sin dibujar.
+
+struct EscPosRenderOptions
+{
+  int width = 576;         // puntos del área imprimible (384 para 58 mm)
+  int max_height = 1 << 16; // corta la página si un stream no termina nunca
+};
+
+struct EscPosPage
+{
+  int width = 0;
+  int height = 0;
+  // Filas de (width + 7) / 8 bytes, MSB primero, 1 = negro (como GS v 0).
+  std::vector<uint8_t> bits;
+  std::vector<int> cuts; // filas donde hubo un GS V
+  bool truncated = false; // se llegó a max_height
+};
+
+// Ejecuta 'data' y deja el resultado en 'page'. Un comando truncado al
+// final se ignora.
+void escpos_render(const uint8_t *data, size_t length,
+                   const EscPosRenderOptions &options, EscPosPage &page);
+
+// PBM binario (P4): mismo layout de bits que la página.
+std::vector<uint8_t> escpos_page_to_pbm(const EscPosPage &page);
+
+// PNG en grises de 1 bit. El IDAT va en bloques deflate sin comprimir: la
+// salida es idéntica byte a byte en cualquier máquina, que es lo que
+// necesita un test golden.
+std::vector<uint8_t> escpos_page_to_png(const EscPosPage &page);
+
+#endif // FLUTTER_PLUGIN_TI_PRINTER_ESCPOS_RENDER_H_
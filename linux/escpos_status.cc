@@ -0,0 +1,82 @@
+#include "escpos_status.h"
+
+#include <algorithm>
+
+namespace
+{
+
+constexpr uint8_t DLE = 0x10;
+constexpr uint8_t EOT = 0x04;
+
+// Bits fijos de toda respuesta a DLE EOT: 0 en el 0 y el 7, 1 en el 1 y
+// el 4.
+constexpr uint8_t kFixedMask = 0x93;
+constexpr uint8_t kFixedValue = 0x12;
+
+} // namespace
+
+const EscPosStatusBit kEscPosStatusBits[] = {
+    // DLE EOT 1: estado de la impresora
+    {1, 0x04, "drawerOpen"}, // pin 3 del conector del cajón en alto
+    {1, 0x08, "offline"},
+    {1, 0x20, "waitingOnlineRecovery"},
+    {1, 0x40, "feedButtonPressed"},
+    // DLE EOT 2: causa de offline
+    {2, 0x04, "coverOpen"},
+    {2, 0x08, "feedingByButton"},
+    {2, 0x20, "paperEndStop"},
+    {2, 0x40, "errorOccurred"},
+    // DLE EOT 3: causa de error
+    {3, 0x04, "recoverableError"},
+    {3, 0x08, "cutterError"},
+    {3, 0x20, "unrecoverableError"},
+    {3, 0x40, "autoRecoverableError"},
+    // DLE EOT 4: sensor de papel (cada estado son dos bits en 1)
+    {4, 0x0C, "paperNearEnd"},
+    {4, 0x60, "paperEnd"},
+};
+
+const size_t kEscPosStatusBitCount = sizeof(kEscPosStatusBits) / sizeof(kEscPosStatusBits[0]);
+
+bool escpos_status_query_valid(int query)
+{
+  return query >= 1 && query <= 4;
+}
+
+std::vector<uint8_t> escpos_status_request(const std::vector<int> &queries)
+{
+  std::vector<uint8_t> request;
+  request.reserve(queries.size() * 3);
+  for (int query : queries)
+  {
+    request.push_back(DLE);
+    request.push_back(EOT);
+    request.push_back(static_cast<uint8_t>(query));
+  }
+  return request;
+}
+
+bool escpos_status_reply_byte(uint8_t value)
+{
+  return (value & kFixedMask) == kFixedValue;
+}
+
+std::vector<int> escpos_status_match(const std::vector<int> &queries,
+                                     const std::vector<uint8_t> &reply)
+{
+  std::vector<int> replies(queries.size(), -1);
+  std::vector<uint8_t> valid;
+  for (uint8_t value : reply)
+  {
+    if (escpos_status_reply_byte(value))
+      valid.push_back(value);
+  }
+
+  // Si faltan respuestas, las que llegaron son de las primeras consultas:
+  // la impresora contesta en orden.
+  const size_t count = std::min(valid.size(), queries.size());
+  const size_t first = valid.size() - count;
+  for (size_t i = 0; i < count; i++)
+    replies[i] = valid[first + i];
+  return replies;
+}
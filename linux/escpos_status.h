@@ -0,0 +1,50 @@
+#ifndef FLUTTER_PLUGIN_TI_PRINTER_ESCPOS_STATUS_H_
+#define FLUTTER_PLUGIN_TI_PRINTER_ESCPOS_STATUS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Consultas DLE EOT n en una sola escritura.
+//
+// Cada DLE EOT contesta exactamente un byte, en el orden en que llegaron
+// las consultas, así que se pueden mandar todas juntas y leer hasta tener
+// tantos bytes como consultas: un solo viaje de ida y vuelta en lugar de
+// uno (más una pausa) por consulta.
+//
+//   n = 1  estado de la impresora
+//   n = 2  causa de offline
+//   n = 3  causa de error
+//   n = 4  sensor de papel
+
+// Un bit (o grupo de bits, todos en 1) de la respuesta a DLE EOT 'query'.
+struct EscPosStatusBit
+{
+  int query;
+  uint8_t mask;
+  const char *name; // clave en el mapa que recibe Dart
+};
+
+// Bits decodificados, en el orden de las consultas 1 a 4.
+extern const EscPosStatusBit kEscPosStatusBits[];
+extern const size_t kEscPosStatusBitCount;
+
+// true si 'query' es un DLE EOT n que este módulo sabe decodificar.
+bool escpos_status_query_valid(int query);
+
+// DLE EOT n de cada consulta, uno detrás del otro.
+std::vector<uint8_t> escpos_status_request(const std::vector<int> &queries);
+
+// true si 'value' tiene los bits fijos de una respuesta a DLE EOT (bits 1
+// y 4 en 1, bits 0 y 7 en 0). Sirve para descartar bytes de Auto Status
+// Back u otros que se colaron en la lectura.
+bool escpos_status_reply_byte(uint8_t value);
+
+// Asigna las respuestas a las consultas, en orden. Si sobran bytes válidos
+// se usan los últimos (lo anterior es de lecturas viejas); si faltan, los
+// que llegaron son de las primeras consultas. replies[i] es el byte de la
+// consulta i, o -1 si no tuvo respuesta.
+std::vector<int> escpos_status_match(const std::vector<int> &queries,
+                                     const std::vector<uint8_t> &reply);
+
+#endif // FLUTTER_PLUGIN_TI_PRINTER_ESCPOS_STATUS_H_
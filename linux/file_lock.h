@@ -0,0 +1,28 @@
+#ifndef FLUTTER_PLUGIN_TI_PRINTER_FILE_LOCK_H_
+#define FLUTTER_PLUGIN_TI_PRINTER_FILE_LOCK_H_
+
+#include <errno.h>
+#include <sys/file.h>
+
+// flock() sobre un archivo que comparten todos los procesos del usuario
+// (spool, caché de imágenes) mientras dura el objeto. Exclusivo por defecto;
+// 'shared' para los que sólo leen.
+class FileLock
+{
+public:
+  explicit FileLock(int fd, bool shared = false) : fd_(fd)
+  {
+    while (flock(fd_, shared ? LOCK_SH : LOCK_EX) != 0 && errno == EINTR)
+    {
+    }
+  }
+  ~FileLock() { flock(fd_, LOCK_UN); }
+
+  FileLock(const FileLock &) = delete;
+  FileLock &operator=(const FileLock &) = delete;
+
+private:
+  int fd_;
+};
+
+#endif // FLUTTER_PLUGIN_TI_PRINTER_FILE_LOCK_H_
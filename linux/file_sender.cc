@@ -0,0 +1,95 @@
+#include "file_sender.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+
+// Las páginas ya escritas se devuelven de a tramos: una llamada a madvise
+// por bloque de 4 KiB del escritor costaría más que la memoria que libera.
+constexpr size_t kReleaseBytes = 1024 * 1024;
+
+} // namespace
+
+MappedFile::~MappedFile()
+{
+  if (data_ != nullptr)
+    munmap(data_, size_);
+  if (fd_ >= 0)
+    close(fd_);
+}
+
+bool MappedFile::open(const std::string &path, bool map, int *error)
+{
+  const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+  {
+    if (error)
+      *error = errno;
+    return false;
+  }
+  return adopt(fd, map, error);
+}
+
+bool MappedFile::adopt(int fd, bool map, int *error)
+{
+  int err = 0;
+  fd_ = fd;
+
+  struct stat st{};
+  if (fstat(fd_, &st) != 0)
+    err = errno;
+  else if (err == 0 && !S_ISREG(st.st_mode))
+    err = EINVAL;
+  else if (err == 0 && st.st_size == 0)
+    err = ENODATA;
+
+  if (err == 0)
+  {
+    size_ = static_cast<size_t>(st.st_size);
+    posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+  }
+
+  // Sin el sello, un truncate() de otro proceso convierte el mapeo en un
+  // SIGBUS: el archivo se lee con pread().
+  const int seals = err == 0 && map ? fcntl(fd_, F_GET_SEALS) : -1;
+  if (seals >= 0 && (seals & F_SEAL_SHRINK) != 0)
+  {
+    void *addr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+    if (addr == MAP_FAILED)
+      err = errno;
+    else
+    {
+      data_ = static_cast<uint8_t *>(addr);
+      madvise(data_, size_, MADV_SEQUENTIAL);
+    }
+  }
+
+  if (err != 0)
+  {
+    if (fd_ >= 0)
+      close(fd_);
+    fd_ = -1;
+    size_ = 0;
+    if (error)
+      *error = err;
+    return false;
+  }
+  return true;
+}
+
+void MappedFile::release(size_t offset)
+{
+  if (data_ == nullptr)
+    return;
+  const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  offset = offset / page * page;
+  if (offset < released_ + kReleaseBytes && offset < size_ / page * page)
+    return;
+  madvise(data_ + released_, offset - released_, MADV_DONTNEED);
+  released_ = offset;
+}
@@ -0,0 +1,53 @@
+#ifndef FLUTTER_PLUGIN_TI_PRINTER_FILE_SENDER_H_
+#define FLUTTER_PLUGIN_TI_PRINTER_FILE_SENDER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Archivo ya renderizado (cierre del día, lote de etiquetas) abierto para
+// enviarlo a la impresora sin leerlo a un buffer.
+//
+// Por TCP el socket acepta sendfile(): los bytes van de la page cache al
+// socket sin pasar por el proceso (tcp_send_file). El driver usblp no
+// implementa splice, así que por USB el escritor lo recorre en bloques como
+// cualquier trabajo: leyéndolo con pread() (BulkJob::file) o, si nadie lo
+// puede achicar (memfd sellado), mapeado; release() devuelve al kernel lo
+// ya escrito para que la memoria residente no crezca con el archivo.
+//
+// Un archivo común no se mapea: si otro proceso lo trunca mientras se
+// imprime, leer las páginas que ya no existen mata al proceso con SIGBUS.
+class MappedFile
+{
+public:
+  MappedFile() = default;
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  // Abre un archivo regular no vacío. Con 'map' además lo mapea (sólo
+  // lectura, acceso secuencial) si tiene F_SEAL_SHRINK; si no, data() queda
+  // en nullptr y se lee por fd(). 'error' recibe el errno si falla.
+  bool open(const std::string &path, bool map, int *error);
+
+  // Igual que open() con un fd ya abierto (p. ej. recibido por un socket),
+  // que pasa a ser de este objeto aunque falle.
+  bool adopt(int fd, bool map, int *error);
+
+  int fd() const { return fd_; }
+  size_t size() const { return size_; }
+  const uint8_t *data() const { return data_; }
+
+  // Descarta las páginas mapeadas antes de 'offset' (ya enviadas). Se
+  // llama desde un solo hilo, con offsets crecientes.
+  void release(size_t offset);
+
+private:
+  int fd_ = -1;
+  uint8_t *data_ = nullptr;
+  size_t size_ = 0;
+  size_t released_ = 0;
+};
+
+#endif // FLUTTER_PLUGIN_TI_PRINTER_FILE_SENDER_H_
@@ -0,0 +1,139 @@
+#include "image_decode.h"
+
+#include <gtk/gtk.h>
+
+#include <algorithm>
+
+namespace
+{
+
+// Tramo de puntos origen que cubre un punto destino, con el peso de cada
+// uno medido en unidades de 1/dst (el total de un tramo es 'src').
+struct Span
+{
+  int first;
+  std::vector<uint32_t> weights;
+};
+
+// Para escalar n → m, el punto origen i ocupa [i·m, (i+1)·m) y el destino
+// j ocupa [j·n, (j+1)·n): el peso es el largo de la intersección.
+std::vector<Span> build_spans(int src, int dst)
+{
+  std::vector<Span> spans(dst);
+  for (int j = 0; j < dst; j++)
+  {
+    const uint64_t lo = static_cast<uint64_t>(j) * src;
+    const uint64_t hi = lo + src;
+    Span &span = spans[j];
+    span.first = static_cast<int>(lo / dst);
+    for (uint64_t i = span.first; i * dst < hi && i < static_cast<uint64_t>(src); i++)
+    {
+      const uint64_t a = std::max(lo, i * dst);
+      const uint64_t b = std::min(hi, (i + 1) * dst);
+      span.weights.push_back(static_cast<uint32_t>(b - a));
+    }
+  }
+  return spans;
+}
+
+// Luma BT.601 en enteros, con el alfa compuesto sobre blanco.
+inline uint32_t gray_of(const uint8_t *p, int channels)
+{
+  uint32_t g = (p[0] * 77 + p[1] * 150 + p[2] * 29) >> 8;
+  if (channels == 4)
+    g = (g * p[3] + 255 * (255 - p[3])) / 255;
+  return g;
+}
+
+} // namespace
+
+void scale_to_gray(const uint8_t *src, int src_w, int src_h, size_t stride,
+                   int channels, int dst_w, int dst_h, uint8_t *dst)
+{
+  const std::vector<Span> xs = build_spans(src_w, dst_w);
+  const std::vector<Span> ys = build_spans(src_h, dst_h);
+
+  // Fila origen ya en grises y reducida en horizontal, en punto fijo ×256.
+  std::vector<uint32_t> row_gray(src_w);
+  std::vector<uint32_t> row_h(dst_w);
+  std::vector<uint64_t> acc(dst_w);
+  const uint64_t x_total = static_cast<uint64_t>(src_w);
+  const uint64_t y_total = static_cast<uint64_t>(src_h);
+
+  for (int oy = 0; oy < dst_h; oy++)
+  {
+    std::fill(acc.begin(), acc.end(), 0);
+    const Span &sy = ys[oy];
+    for (size_t k = 0; k < sy.weights.size(); k++)
+    {
+      const uint8_t *line = src + static_cast<size_t>(sy.first + k) * stride;
+      for (int x = 0; x < src_w; x++)
+        row_gray[x] = gray_of(line + static_cast<size_t>(x) * channels, channels);
+
+      for (int ox = 0; ox < dst_w; ox++)
+      {
+        const Span &sx = xs[ox];
+        uint64_t sum = 0;
+        for (size_t i = 0; i < sx.weights.size(); i++)
+          sum += static_cast<uint64_t>(row_gray[sx.first + i]) * sx.weights[i];
+        row_h[ox] = static_cast<uint32_t>((sum * 256 + x_total / 2) / x_total);
+      }
+
+      const uint32_t wy = sy.weights[k];
+      for (int ox = 0; ox < dst_w; ox++)
+        acc[ox] += static_cast<uint64_t>(row_h[ox]) * wy;
+    }
+
+    uint8_t *out = dst + static_cast<size_t>(oy) * dst_w;
+    const uint64_t div = y_total * 256;
+    for (int ox = 0; ox < dst_w; ox++)
+      out[ox] = static_cast<uint8_t>(std::min<uint64_t>(255, (acc[ox] + div / 2) / div));
+  }
+}
+
+bool decode_image_gray(const uint8_t *data, size_t length, int max_width,
+                       GrayImage &out)
+{
+  if (!data || length == 0 || max_width <= 0)
+    return false;
+
+  GdkPixbufLoader *loader = gdk_pixbuf_loader_new();
+  GError *error = nullptr;
+  gboolean ok = gdk_pixbuf_loader_write(loader, data, length, &error);
+  // Cerrar siempre, aunque write haya fallado (si no, el loader avisa al
+  // destruirse).
+  ok = gdk_pixbuf_loader_close(loader, ok ? &error : nullptr) && ok;
+  if (!ok)
+  {
+    g_printerr("No se pudo decodificar la imagen: %s\n",
+               error ? error->message : "formato desconocido");
+    g_clear_error(&error);
+    g_object_unref(loader);
+    return false;
+  }
+
+  // El pixbuf pertenece al loader: se usa antes de liberarlo.
+  GdkPixbuf *pixbuf = gdk_pixbuf_loader_get_pixbuf(loader);
+  bool decoded = false;
+  if (pixbuf != nullptr && gdk_pixbuf_get_bits_per_sample(pixbuf) == 8 &&
+      gdk_pixbuf_get_n_channels(pixbuf) >= 3)
+  {
+    const int src_w = gdk_pixbuf_get_width(pixbuf);
+    const int src_h = gdk_pixbuf_get_height(pixbuf);
+    const int dst_w = std::min(src_w, max_width);
+    const int dst_h = std::max(1, static_cast<int>(
+                                      (static_cast<int64_t>(src_h) * dst_w + src_w / 2) / src_w));
+
+    out.width = dst_w;
+    out.height = dst_h;
+    out.pixels.resize(static_cast<size_t>(dst_w) * dst_h);
+    scale_to_gray(gdk_pixbuf_read_pixels(pixbuf), src_w, src_h,
+                  static_cast<size_t>(gdk_pixbuf_get_rowstride(pixbuf)),
+                  gdk_pixbuf_get_n_channels(pixbuf), dst_w, dst_h,
+                  out.pixels.data());
+    decoded = true;
+  }
+
+  g_object_unref(loader);
+  return decoded;
+}
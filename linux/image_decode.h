@@ -0,0 +1,31 @@
+#ifndef FLUTTER_PLUGIN_TI_PRINTER_IMAGE_DECODE_H_
+#define FLUTTER_PLUGIN_TI_PRINTER_IMAGE_DECODE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Decodificación de PNG/JPEG (vía gdk-pixbuf, que ya viene con GTK) y
+// reducción al ancho de la impresora en un solo paso con la conversión a
+// grises, para no pasar por el paquete `image` de Dart.
+
+struct GrayImage
+{
+  int width = 0;
+  int height = 0;
+  std::vector<uint8_t> pixels; // width * height, 0 = negro
+};
+
+// Reduce 'src' (RGB/RGBA de 8 bits, 'stride' bytes por fila) a dst_w ×
+// dst_h en grises promediando el área que cubre cada punto destino (box
+// filter exacto con pesos fraccionarios). El alfa se compone sobre blanco.
+// Sólo reduce: dst_w <= src_w y dst_h <= src_h.
+void scale_to_gray(const uint8_t *src, int src_w, int src_h, size_t stride,
+                   int channels, int dst_w, int dst_h, uint8_t *dst);
+
+// Decodifica 'data' y, si es más ancha que 'max_width', la reduce
+// manteniendo la proporción. Las imágenes más angostas no se agrandan.
+bool decode_image_gray(const uint8_t *data, size_t length, int max_width,
+                       GrayImage &out);
+
+#endif // FLUTTER_PLUGIN_TI_PRINTER_IMAGE_DECODE_H_
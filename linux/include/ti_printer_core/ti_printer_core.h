@@ -0,0 +1,136 @@
+#ifndef TI_PRINTER_CORE_H_
+#define TI_PRINTER_CORE_H_
+
+// API C de ti_printer_core: la parte del plugin que habla con las
+// impresoras (enumeración, apertura, escritura, estado) sin GTK, Flutter ni
+// GLib. La usa el plugin de Linux y se puede enlazar desde otros programas
+// (un servicio, una app Qt, un binding de otro lenguaje).
+//
+// Convenciones:
+//   - Las funciones que devuelven int devuelven 0 si salió bien o un errno
+//     (positivo) si falló, salvo que se indique otra cosa.
+//   - Un TiPrinter se puede usar desde varios hilos: las consultas de
+//     estado salen entre bloque y bloque de una escritura larga (USB) o
+//     esperan a que termine (TCP y transportes propios).
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TI_PRINTER_CORE_EXPORT __attribute__((visibility("default")))
+
+// Impresora abierta. Se libera con ti_printer_close.
+typedef struct TiPrinter TiPrinter;
+
+// Una impresora candidata de ti_printer_enumerate. Los textos terminan
+// siempre en NUL; si no entran, se cortan.
+typedef struct
+{
+  char path[256];         // nodo /dev/... para ti_printer_open_usb
+  char display_name[128]; // "MFG MDL" del device ID, o VID/PID, o el nodo
+  char manufacturer[64];  // IEEE 1284 MFG (vacío si no hay)
+  char model[64];         // IEEE 1284 MDL
+  char protocol[32];      // "escpos", "starprnt", "zpl"... separados por '/'
+  int vid;                // 0 si no se pudo leer sysfs
+  int pid;
+} TiPrinterInfo;
+
+// Transporte propio (Bluetooth, un puerto serie con otra configuración, un
+// mock en tests...). Las llamadas se serializan: nunca hay dos a la vez
+// sobre el mismo 'context'.
+typedef struct
+{
+  void *context;
+
+  // Escribe todo 'data'. 0 o errno.
+  int (*write)(void *context, const uint8_t *data, size_t length);
+
+  // Escribe 'command' y copia en 'reply' lo que conteste la impresora en
+  // 'timeout_ms' (con 'expected' > 0 puede volver apenas junta esa
+  // cantidad). Devuelve los bytes copiados (0 si no contestó) o -errno.
+  // Puede ser NULL si el transporte no lee: las consultas devuelven vacío.
+  int (*transact)(void *context, const uint8_t *command, size_t length,
+                  int timeout_ms, size_t expected, uint8_t *reply,
+                  size_t capacity);
+
+  // Libera 'context'. Puede ser NULL.
+  void (*close)(void *context);
+} TiPrinterTransport;
+
+// Llena hasta 'capacity' entradas de 'out' (puede ser NULL con capacidad
+// 0) y devuelve cuántas impresoras hay en total. No abre ningún nodo.
+TI_PRINTER_CORE_EXPORT size_t ti_printer_enumerate(TiPrinterInfo *out,
+                                                   size_t capacity);
+
+// Abre un nodo /dev/usb/lp*, /dev/ttyUSB* o /dev/ttyACM*. NULL si falló
+// (con el errno en 'error', que puede ser NULL).
+TI_PRINTER_CORE_EXPORT TiPrinter *ti_printer_open_usb(const char *path,
+                                                      int *error);
+
+// Conecta a una impresora de red (raw TCP; 'port' 0 = 9100).
+TI_PRINTER_CORE_EXPORT TiPrinter *ti_printer_open_tcp(const char *host,
+                                                      int port, int *error);
+
+// Usa 'transport'. El TiPrinter queda dueño de 'transport->context' y lo
+// libera con transport->close al cerrar.
+TI_PRINTER_CORE_EXPORT TiPrinter *ti_printer_open_transport(
+    const TiPrinterTransport *transport, int *error);
+
+// Escribe 'data' completo; vuelve cuando salió (o falló).
+TI_PRINTER_CORE_EXPORT int ti_printer_write(TiPrinter *printer,
+                                            const uint8_t *data,
+                                            size_t length);
+
+// Avance de ti_printer_send_file: bytes ya enviados. Devolver 0 cancela.
+typedef int (*TiPrinterProgress)(uint64_t sent, void *context);
+
+// Envía los primeros 'length' bytes del archivo 'fd' (un trabajo ya
+// renderizado); vuelve cuando salieron. En TCP van con sendfile() sin pasar
+// por el proceso. 'progress' puede ser NULL. 0, errno, o ECANCELED si
+// 'progress' canceló.
+TI_PRINTER_CORE_EXPORT int ti_printer_send_file(TiPrinter *printer, int fd,
+                                                uint64_t length,
+                                                TiPrinterProgress progress,
+                                                void *context);
+
+// Comando con respuesta (ver TiPrinterTransport.transact). Bytes copiados,
+// 0 sin respuesta o -errno.
+TI_PRINTER_CORE_EXPORT int ti_printer_transact(TiPrinter *printer,
+                                               const uint8_t *command,
+                                               size_t length, int timeout_ms,
+                                               size_t expected,
+                                               uint8_t *reply,
+                                               size_t capacity);
+
+// DLE EOT n para cada n de 'queries' (1 a 4), en una sola escritura. En
+// 'replies[i]' queda el byte de estado de queries[i], o -1 si no contestó.
+// Devuelve cuántas contestaron, o -errno (-EINVAL si alguna n no es
+// válida).
+TI_PRINTER_CORE_EXPORT int ti_printer_query_status(TiPrinter *printer,
+                                                   const int *queries,
+                                                   size_t count,
+                                                   int timeout_ms,
+                                                   int *replies);
+
+// Byte de LPGETSTATUS del driver usblp (ver usblp.h), sin tocar el stream.
+// ENOTTY en nodos que no son usblp, ENOTSUP en TCP y transportes propios.
+TI_PRINTER_CORE_EXPORT int ti_printer_port_status(TiPrinter *printer,
+                                                  int *raw);
+
+// Espera lo que falte escribir y cierra. Acepta NULL.
+TI_PRINTER_CORE_EXPORT void ti_printer_close(TiPrinter *printer);
+
+// Mensajes de diagnóstico del núcleo. Por defecto van a stderr; NULL
+// vuelve a eso. 'handler' se puede llamar desde cualquier hilo.
+typedef void (*TiPrinterLogHandler)(const char *message, void *context);
+TI_PRINTER_CORE_EXPORT void ti_printer_set_log_handler(
+    TiPrinterLogHandler handler, void *context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TI_PRINTER_CORE_H_
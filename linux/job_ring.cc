@@ -0,0 +1,321 @@
+#include "job_ring.h"
+
+#include <algorithm>
+
+#include <errno.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "escpos_lexer.h"
+#include "lane_writer.h"
+
+namespace
+{
+
+constexpr size_t kMinCapacity = 64 * 1024;
+constexpr size_t kMaxCapacity = 64 * 1024 * 1024;
+
+// Tamaño de cada trabajo que el hilo pasa al escritor: cada uno informa su
+// avance y libera su espacio al terminar, así que Dart no espera a que se
+// escriba todo lo publicado para seguir llenando.
+constexpr size_t kSegmentBytes = 64 * 1024;
+
+// Mapea 'capacity' bytes de un memfd dos veces seguidas. nullptr si falla.
+uint8_t *map_mirrored(size_t capacity, int *error)
+{
+  const int fd = memfd_create("ti_printer_job_ring", MFD_CLOEXEC);
+  if (fd < 0)
+  {
+    *error = errno;
+    return nullptr;
+  }
+  if (ftruncate(fd, static_cast<off_t>(capacity)) != 0)
+  {
+    *error = errno;
+    close(fd);
+    return nullptr;
+  }
+
+  // Primero se reserva el rango entero y después se pisan sus dos mitades.
+  void *base = mmap(nullptr, 2 * capacity, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (base == MAP_FAILED)
+  {
+    *error = errno;
+    close(fd);
+    return nullptr;
+  }
+  auto *data = static_cast<uint8_t *>(base);
+  for (int half = 0; half < 2; half++)
+  {
+    void *mapped = mmap(data + half * capacity, capacity, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_FIXED, fd, 0);
+    if (mapped == MAP_FAILED)
+    {
+      *error = errno;
+      munmap(base, 2 * capacity);
+      close(fd);
+      return nullptr;
+    }
+  }
+  close(fd); // los mapeos mantienen vivo el memfd
+  return data;
+}
+
+// Largo del tramo que empieza en 'data': hasta el primer límite de token
+// >= 'target' (un comando que cruza 'target' va entero). Un comando que
+// todavía no está completo en 'length' no entra: se queda en el ring hasta
+// que Dart publique el resto, así cada tramo empieza y termina en un límite
+// y el lexer del escritor nunca arranca a mitad de una imagen. 0 si el
+// primer token está incompleto.
+size_t complete_prefix(const uint8_t *data, size_t length, size_t target)
+{
+  size_t pos = 0;
+  while (pos < target)
+  {
+    const EscPosToken token = escpos_next_token(data, length, pos);
+    if (token.length == 0 || token.kind == EscPosTokenKind::kIncomplete)
+      return pos;
+    const size_t end = pos + token.length;
+    if (end > target)
+      return token.kind == EscPosTokenKind::kText ? target : end;
+    pos = end;
+  }
+  return pos;
+}
+
+} // namespace
+
+// Estado que comparten el hilo del ring, los trabajos en el escritor y
+// Dart. Los trabajos tienen una referencia: el mapeo vive hasta que termina
+// el último, aunque el JobRing ya no esté.
+struct JobRing::Shared
+{
+  uint8_t *data = nullptr;
+  size_t capacity = 0;
+  int doorbell = -1; // eventfd: Dart publicó bytes o stop()
+
+  // Cabeza (sólo la escribe Dart) y cola (sólo el escritor), en líneas de
+  // caché distintas para que productor y consumidor no se pisen.
+  alignas(64) std::atomic<uint64_t> head{0};
+  alignas(64) std::atomic<uint64_t> tail{0};
+  std::atomic<int> error{0};
+  // El hilo está por dormir: commit() tiene que tocar el eventfd.
+  std::atomic<bool> sleeping{false};
+
+  ~Shared()
+  {
+    if (data)
+      munmap(data, 2 * capacity);
+    if (doorbell >= 0)
+      close(doorbell);
+  }
+};
+
+JobRing::~JobRing()
+{
+  stop(0);
+}
+
+bool JobRing::start(size_t capacity, LaneWriter *writer, ProgressCallback progress,
+                    int *error)
+{
+  stop(0);
+
+  const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  capacity = std::clamp(capacity, kMinCapacity, kMaxCapacity);
+  capacity = (capacity + page - 1) / page * page;
+
+  auto shared = std::make_shared<Shared>();
+  shared->doorbell = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if (shared->doorbell < 0)
+  {
+    *error = errno;
+    return false;
+  }
+  shared->data = map_mirrored(capacity, error);
+  if (!shared->data)
+    return false;
+  shared->capacity = capacity;
+
+  shared_ = std::move(shared);
+  stopping_ = false;
+  thread_ = std::thread(&JobRing::run, this, writer, std::move(progress));
+  return true;
+}
+
+void JobRing::stop(int error)
+{
+  if (!shared_)
+    return;
+  if (error != 0)
+  {
+    int expected = 0;
+    shared_->error.compare_exchange_strong(expected, error);
+  }
+  if (thread_.joinable())
+  {
+    stopping_ = true;
+    const uint64_t one = 1;
+    ssize_t ignored = write(shared_->doorbell, &one, sizeof(one));
+    (void)ignored;
+    thread_.join();
+  }
+}
+
+void JobRing::run(LaneWriter *writer, ProgressCallback progress)
+{
+  const std::shared_ptr<Shared> shared = shared_;
+  uint64_t sent = shared->tail.load(std::memory_order_relaxed);
+  // Cabeza con la que ya se armó todo lo posible: hasta que Dart publique
+  // más no hay nada nuevo que mirar.
+  uint64_t seen = sent;
+
+  while (!stopping_)
+  {
+    uint64_t head = shared->head.load(std::memory_order_acquire);
+    if (head == seen || shared->error.load() != 0)
+    {
+      // Se anuncia antes de volver a mirar la cabeza: o commit() ve
+      // 'sleeping' y toca el eventfd, o acá se ve su cabeza nueva. Es un
+      // store → load contra el store → load de commit(): los cuatro
+      // accesos son seq_cst (con release/acquire los dos lados podrían
+      // leer el valor viejo y el hilo dormiría con bytes publicados).
+      shared->sleeping.store(true, std::memory_order_seq_cst);
+      head = shared->head.load(std::memory_order_seq_cst);
+      if ((head == seen || shared->error.load() != 0) && !stopping_)
+      {
+        struct pollfd pfd = {shared->doorbell, POLLIN, 0};
+        if (poll(&pfd, 1, -1) > 0)
+        {
+          uint64_t count;
+          ssize_t ignored = read(shared->doorbell, &count, sizeof(count));
+          (void)ignored;
+        }
+      }
+      shared->sleeping.store(false);
+      continue;
+    }
+
+    // Se corta en un límite de comando para que los de tiempo real que el
+    // escritor intercala entre trabajos no caigan dentro de una imagen.
+    const uint8_t *view = shared->data + sent % shared->capacity;
+    const size_t available = static_cast<size_t>(head - sent);
+    const size_t length = complete_prefix(view, available, std::min(available, kSegmentBytes));
+    if (length == 0)
+    {
+      // Un comando más grande que el ring nunca va a estar entero.
+      if (available >= shared->capacity)
+      {
+        int expected = 0;
+        shared->error.compare_exchange_strong(expected, EMSGSIZE);
+        if (progress)
+          progress(shared->tail.load(std::memory_order_acquire), shared->error.load());
+      }
+      seen = head;
+      continue;
+    }
+
+    LaneWriter::BulkJob job;
+    job.view = view;
+    job.view_length = length;
+    job.owner = shared;
+    const uint64_t end = sent + length;
+    job.done = [shared, progress, end](bool ok, int error) {
+      if (ok)
+      {
+        shared->tail.store(end, std::memory_order_release);
+      }
+      else
+      {
+        int expected = 0;
+        shared->error.compare_exchange_strong(expected, error != 0 ? error : EIO);
+      }
+      if (progress)
+        progress(shared->tail.load(std::memory_order_acquire), shared->error.load());
+    };
+    writer->submit(std::move(job));
+    sent = end;
+    seen = sent;
+  }
+}
+
+uint8_t *JobRing::data() const
+{
+  return shared_ ? shared_->data : nullptr;
+}
+
+uint64_t JobRing::capacity() const
+{
+  return shared_ ? shared_->capacity : 0;
+}
+
+uint64_t JobRing::writable() const
+{
+  if (!shared_)
+    return 0;
+  const uint64_t tail = shared_->tail.load(std::memory_order_acquire);
+  return shared_->capacity - (shared_->head.load(std::memory_order_relaxed) - tail);
+}
+
+uint64_t JobRing::consumed() const
+{
+  return shared_ ? shared_->tail.load(std::memory_order_acquire) : 0;
+}
+
+int JobRing::error() const
+{
+  return shared_ ? shared_->error.load() : EBADF;
+}
+
+int JobRing::commit(uint64_t length)
+{
+  if (!shared_)
+    return EBADF;
+  // Publicar más de lo libre pisaría bytes que el escritor todavía no
+  // mandó; recortarlo dejaría la cabeza de Dart adelantada a la nuestra.
+  if (length > writable())
+    return EINVAL;
+  if (length == 0)
+    return 0;
+  // seq_cst, no release: ver el par sleeping/head en run().
+  shared_->head.fetch_add(length, std::memory_order_seq_cst);
+  if (shared_->sleeping.load(std::memory_order_seq_cst))
+  {
+    const uint64_t one = 1;
+    ssize_t ignored = write(shared_->doorbell, &one, sizeof(one));
+    (void)ignored;
+  }
+  return 0;
+}
+
+uint8_t *ti_job_ring_data(JobRing *ring)
+{
+  return ring->data();
+}
+
+uint64_t ti_job_ring_capacity(JobRing *ring)
+{
+  return ring->capacity();
+}
+
+uint64_t ti_job_ring_writable(JobRing *ring)
+{
+  return ring->writable();
+}
+
+uint64_t ti_job_ring_consumed(JobRing *ring)
+{
+  return ring->consumed();
+}
+
+int32_t ti_job_ring_error(JobRing *ring)
+{
+  return ring->error();
+}
+
+int32_t ti_job_ring_commit(JobRing *ring, uint64_t length)
+{
+  return ring->commit(length);
+}
@@ -0,0 +1,85 @@
+#ifndef FLUTTER_PLUGIN_TI_PRINTER_JOB_RING_H_
+#define FLUTTER_PLUGIN_TI_PRINTER_JOB_RING_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+
+class LaneWriter;
+
+// Ring de bytes en memoria nativa que Dart llena directamente por FFI, sin
+// pasar por el MethodChannel: un productor (el isolate de Dart) y un
+// consumidor (el hilo del ring), sin locks.
+//
+// Dart escribe en data() a partir de su cabeza y publica los bytes con
+// ti_job_ring_commit(), que además toca el eventfd si el hilo duerme. El
+// hilo pasa los bytes publicados al LaneWriter de la impresora como vistas
+// sobre el ring (sin copiarlos) y avanza la cola cuando se escribieron; el
+// espacio vuelve a estar libre para Dart. Cada avance se informa a
+// 'progress' desde el hilo del escritor.
+//
+// Los tramos empiezan y terminan en límites de comando ESC/POS: un comando
+// publicado a medias espera en el ring hasta que llegue el resto. Un
+// comando más grande que el ring deja el ring en error (EMSGSIZE).
+//
+// El ring está mapeado dos veces seguidas: data()[i] y data()[i + capacity]
+// son el mismo byte, así que cualquier tramo de hasta 'capacity' bytes es
+// contiguo aunque dé la vuelta.
+class JobRing
+{
+public:
+  // 'consumed' es el total de bytes ya escritos en el dispositivo; 'error'
+  // el errno del fallo (0 si ok). Después de un error el ring no avanza más.
+  using ProgressCallback = std::function<void(uint64_t consumed, int error)>;
+
+  JobRing() = default;
+  ~JobRing();
+
+  JobRing(const JobRing &) = delete;
+  JobRing &operator=(const JobRing &) = delete;
+
+  // Reserva el ring (redondeado a páginas) y arranca el hilo que vacía en
+  // 'writer'. El writer debe vivir hasta stop().
+  bool start(size_t capacity, LaneWriter *writer, ProgressCallback progress, int *error);
+
+  // Deja de pasar bytes al escritor; lo ya enviado termina (o se cancela)
+  // en el LaneWriter. El ring sigue mapeado hasta destruir el objeto, para
+  // que Dart no escriba en memoria liberada; si 'error' no es 0 queda como
+  // error del ring y Dart deja de escribir.
+  void stop(int error);
+
+  uint8_t *data() const;
+  uint64_t capacity() const;
+  uint64_t writable() const;
+  uint64_t consumed() const;
+  int error() const;
+  // Publica 'length' bytes ya escritos en data(). 0, o EINVAL (sin
+  // publicar nada) si son más que writable().
+  int commit(uint64_t length);
+
+private:
+  struct Shared;
+
+  void run(LaneWriter *writer, ProgressCallback progress);
+
+  std::shared_ptr<Shared> shared_;
+  std::atomic<bool> stopping_{false};
+  std::thread thread_;
+};
+
+// Funciones que Dart busca con DynamicLibrary.process() (llamadas "leaf":
+// no pasan por el event loop ni reservan memoria). 'ring' es el puntero que
+// devuelve openUsbJobRing.
+#define TI_PRINTER_FFI_EXPORT extern "C" __attribute__((visibility("default")))
+
+TI_PRINTER_FFI_EXPORT uint8_t *ti_job_ring_data(JobRing *ring);
+TI_PRINTER_FFI_EXPORT uint64_t ti_job_ring_capacity(JobRing *ring);
+TI_PRINTER_FFI_EXPORT uint64_t ti_job_ring_writable(JobRing *ring);
+TI_PRINTER_FFI_EXPORT uint64_t ti_job_ring_consumed(JobRing *ring);
+TI_PRINTER_FFI_EXPORT int32_t ti_job_ring_error(JobRing *ring);
+TI_PRINTER_FFI_EXPORT int32_t ti_job_ring_commit(JobRing *ring, uint64_t length);
+
+#endif // FLUTTER_PLUGIN_TI_PRINTER_JOB_RING_H_
@@ -0,0 +1,489 @@
+#include "job_scheduler.h"
+
+#include <glib.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <future>
+#include <thread>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "escpos_lexer.h"
+#include "lane_writer.h"
+#include "tcp_transport.h"
+#include "usblp.h"
+
+namespace
+{
+
+// Estimación inicial antes de tener mediciones (~ impresora de 250 mm/s
+// imprimiendo raster a 576 dots).
+constexpr double kInitialThroughput = 32.0 * 1024;
+constexpr double kThroughputAlpha = 0.3;
+// Trabajos más chicos están dominados por latencia; no se usan para medir.
+constexpr size_t kMinSampleBytes = 1024;
+constexpr size_t kWriteChunk = 16 * 1024;
+constexpr auto kReopenInterval = std::chrono::seconds(1);
+// Una impresora USB que pasa esto sin aceptar bytes (sin papel, tapa
+// abierta) se da por caída y sus trabajos pasan al resto del grupo.
+constexpr int kUsbStallMs = 10000;
+
+// Enlace de I/O de un dispositivo del scheduler (USB o red).
+class DeviceLink
+{
+public:
+  virtual ~DeviceLink() = default;
+  virtual bool open() = 0;
+  virtual bool write(const uint8_t *data, size_t length) = 0;
+  virtual bool flush() = 0;
+  virtual void close() = 0;
+  // true si mientras está abierto nadie más puede abrir el dispositivo: el
+  // scheduler lo suelta cuando no tiene trabajos.
+  virtual bool exclusive() const { return false; }
+};
+
+// USB: el mismo LaneWriter que el resto del plugin, sobre un fd
+// O_NONBLOCK con límite de espera: usblp bloquea write() para siempre si la
+// impresora se queda sin papel, y el miembro nunca pasaría a offline.
+class UsbLink : public DeviceLink
+{
+public:
+  explicit UsbLink(std::string path) : path_(std::move(path)) {}
+  ~UsbLink() override { close(); }
+
+  bool open() override
+  {
+    close();
+    fd_ = ::open(path_.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (fd_ < 0)
+      return false;
+    // Después de un corte por falta de papel el nodo se sigue abriendo:
+    // LPGETSTATUS dice si ya se puede imprimir (ttyUSB/ttyACM no lo tienen).
+    UsblpStatus status;
+    int err = 0;
+    if (usblp_get_status(fd_, status, &err) && (status.paper_out || status.error))
+    {
+      close();
+      return false;
+    }
+    writer_.start(fd_, kUsbStallMs);
+    return true;
+  }
+
+  bool write(const uint8_t *data, size_t length) override
+  {
+    std::promise<int> result;
+    LaneWriter::BulkJob job;
+    job.view = data;
+    job.view_length = length;
+    job.done = [&result](bool ok, int error) {
+      result.set_value(ok ? 0 : (error != 0 ? error : EIO));
+    };
+    writer_.submit(std::move(job));
+    const int error = result.get_future().get();
+    if (error == 0)
+      return true;
+    g_printerr("Error escribiendo en %s: %s\n", path_.c_str(), g_strerror(error));
+    return false;
+  }
+
+  // El último bloque de cada write() ya lleva su fsync.
+  bool flush() override { return fd_ >= 0; }
+
+  void close() override
+  {
+    writer_.stop(false);
+    if (fd_ >= 0)
+    {
+      ::close(fd_);
+      fd_ = -1;
+    }
+  }
+
+  // usblp admite un solo open: openUsbPort o ti_printer_daemon lo
+  // necesitan cuando el scheduler no está imprimiendo.
+  bool exclusive() const override { return true; }
+
+private:
+  std::string path_;
+  int fd_ = -1;
+  LaneWriter writer_;
+};
+
+class TcpLink : public DeviceLink
+{
+public:
+  TcpLink(std::string host, int port) : host_(std::move(host)), port_(port) {}
+  ~TcpLink() override { close(); }
+
+  bool open() override { return tcp_open(conn_, host_, port_); }
+  bool write(const uint8_t *data, size_t length) override
+  {
+    return tcp_send(conn_, data, length);
+  }
+  bool flush() override { return conn_.fd >= 0; }
+  void close() override { tcp_close(conn_); }
+
+private:
+  std::string host_;
+  int port_;
+  TcpConnection conn_;
+};
+
+// "tcp://host[:puerto]" → TcpLink; cualquier otra cosa es una ruta de nodo.
+std::unique_ptr<DeviceLink> make_link(const std::string &id)
+{
+  static const std::string kTcpScheme = "tcp://";
+  if (id.compare(0, kTcpScheme.size(), kTcpScheme) != 0)
+    return std::make_unique<UsbLink>(id);
+
+  std::string rest = id.substr(kTcpScheme.size());
+  int port = kTcpDefaultPort;
+  auto colon = rest.rfind(':');
+  if (colon != std::string::npos && rest.find(']') == std::string::npos)
+  {
+    port = std::atoi(rest.c_str() + colon + 1);
+    rest = rest.substr(0, colon);
+  }
+  return std::make_unique<TcpLink>(rest, port);
+}
+
+} // namespace
+
+struct JobScheduler::Device
+{
+  std::string id;
+  std::string group;
+  std::unique_ptr<DeviceLink> link;
+  bool link_open = false;
+  bool online = true; // optimista hasta el primer fallo de apertura/escritura
+  bool stopping = false;
+
+  std::deque<Job> queues[kJobPriorityCount];
+  uint64_t queued_bytes[kJobPriorityCount] = {};
+  uint64_t inflight_remaining = 0;
+
+  double throughput = kInitialThroughput;
+  uint64_t completed = 0;
+
+  std::condition_variable cv;
+  std::thread thread;
+
+  bool has_jobs() const
+  {
+    for (const auto &q : queues)
+    {
+      if (!q.empty())
+        return true;
+    }
+    return false;
+  }
+
+  // Segundos estimados hasta terminar un trabajo nuevo de 'length' bytes con
+  // prioridad 'priority' (sólo cuentan los encolados delante de él).
+  double estimate(JobPriority priority, size_t length) const
+  {
+    uint64_t ahead = inflight_remaining + length;
+    for (int p = 0; p <= static_cast<int>(priority); p++)
+      ahead += queued_bytes[p];
+    return static_cast<double>(ahead) / throughput;
+  }
+};
+
+JobScheduler::JobScheduler() = default;
+
+JobScheduler::~JobScheduler()
+{
+  shutdown();
+}
+
+bool JobScheduler::add_device(const std::string &id, const std::string &group)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (id.empty() || devices_.count(id) > 0)
+    return false;
+
+  auto device = std::make_unique<Device>();
+  device->id = id;
+  device->group = group;
+  device->link = make_link(id);
+  Device *raw = device.get();
+  devices_[id] = std::move(device);
+  raw->thread = std::thread(&JobScheduler::run, this, raw);
+  return true;
+}
+
+bool JobScheduler::remove_device(const std::string &id)
+{
+  std::unique_ptr<Device> device;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = devices_.find(id);
+    if (it == devices_.end())
+      return false;
+    it->second->stopping = true;
+    fail_over_locked(it->second.get());
+    device = std::move(it->second);
+    devices_.erase(it);
+    device->cv.notify_all();
+  }
+  device->thread.join();
+  return true;
+}
+
+void JobScheduler::shutdown()
+{
+  std::map<std::string, std::unique_ptr<Device>> devices;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    devices.swap(devices_);
+    for (auto &entry : devices)
+    {
+      entry.second->stopping = true;
+      entry.second->cv.notify_all();
+    }
+  }
+  for (auto &entry : devices)
+  {
+    if (entry.second->thread.joinable())
+      entry.second->thread.join();
+  }
+}
+
+JobScheduler::Device *JobScheduler::pick_locked(const std::string &target,
+                                                JobPriority priority,
+                                                size_t length,
+                                                const Device *exclude)
+{
+  auto direct = devices_.find(target);
+  if (direct != devices_.end())
+  {
+    Device *d = direct->second.get();
+    return (d == exclude || d->stopping) ? nullptr : d;
+  }
+
+  // Preferir miembros en línea; si no hay ninguno, encolar igual en el de
+  // menor carga para que imprima apenas vuelva.
+  Device *best = nullptr;
+  Device *best_offline = nullptr;
+  for (auto &entry : devices_)
+  {
+    Device *d = entry.second.get();
+    if (d == exclude || d->stopping || d->group.empty() || d->group != target)
+      continue;
+    Device *&slot = d->online ? best : best_offline;
+    if (!slot || d->estimate(priority, length) < slot->estimate(priority, length))
+      slot = d;
+  }
+  return best ? best : best_offline;
+}
+
+void JobScheduler::enqueue_locked(Device *device, Job job, bool front)
+{
+  const int p = static_cast<int>(job.priority);
+  device->queued_bytes[p] += job.data.size();
+  if (front)
+    device->queues[p].push_front(std::move(job));
+  else
+    device->queues[p].push_back(std::move(job));
+  device->cv.notify_one();
+}
+
+uint64_t JobScheduler::submit(const std::string &target, JobPriority priority,
+                              std::vector<uint8_t> data)
+{
+  if (data.empty())
+    return 0;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  Device *device = pick_locked(target, priority, data.size(), nullptr);
+  if (!device)
+    return 0;
+
+  Job job{next_id_++, priority, device->id == target, std::move(data)};
+  const uint64_t id = job.id;
+  enqueue_locked(device, std::move(job), false);
+  return id;
+}
+
+// Mueve los trabajos no fijados de 'device' a otros miembros en línea de su
+// grupo. Los que no tienen destino se quedan esperando la reconexión.
+void JobScheduler::fail_over_locked(Device *device)
+{
+  if (device->group.empty())
+    return;
+
+  for (int p = 0; p < kJobPriorityCount; p++)
+  {
+    std::deque<Job> keep;
+    while (!device->queues[p].empty())
+    {
+      Job job = std::move(device->queues[p].front());
+      device->queues[p].pop_front();
+      device->queued_bytes[p] -= job.data.size();
+
+      Device *dest = job.pinned ? nullptr
+                                : pick_locked(device->group, job.priority,
+                                              job.data.size(), device);
+      if (dest && dest->online)
+      {
+        enqueue_locked(dest, std::move(job), false);
+      }
+      else
+      {
+        device->queued_bytes[p] += job.data.size();
+        keep.push_back(std::move(job));
+      }
+    }
+    device->queues[p].swap(keep);
+  }
+}
+
+void JobScheduler::run(Device *device)
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!device->stopping)
+  {
+    const bool has_jobs = device->has_jobs();
+
+    // Abrir el enlace cuando hay trabajo, o re-sondear si está offline para
+    // volver a recibir trabajos del grupo en cuanto se reconecte.
+    if (!device->link_open && (has_jobs || !device->online))
+    {
+      lock.unlock();
+      bool ok = device->link->open();
+      lock.lock();
+      if (device->stopping)
+        break;
+      if (!ok)
+      {
+        if (device->online)
+        {
+          device->online = false;
+          fail_over_locked(device);
+        }
+        device->cv.wait_for(lock, kReopenInterval);
+        continue;
+      }
+      device->online = true;
+      if (!device->has_jobs() && device->link->exclusive())
+      {
+        // Era sólo un sondeo: el nodo queda libre hasta el próximo trabajo.
+        lock.unlock();
+        device->link->close();
+        lock.lock();
+        continue;
+      }
+      device->link_open = true;
+      continue;
+    }
+
+    if (!has_jobs)
+    {
+      device->cv.wait(lock);
+      continue;
+    }
+
+    int p = 0;
+    while (device->queues[p].empty())
+      p++;
+    Job job = std::move(device->queues[p].front());
+    device->queues[p].pop_front();
+    device->queued_bytes[p] -= job.data.size();
+    device->inflight_remaining = job.data.size();
+    lock.unlock();
+
+    const auto start = std::chrono::steady_clock::now();
+    const uint8_t *data = job.data.data();
+    const size_t length = job.data.size();
+    bool ok = true;
+    size_t offset = 0;
+    while (ok && offset < length)
+    {
+      // Bloques en límites de comando: 'offset' es siempre lo que la
+      // impresora ya aceptó entero.
+      const size_t end =
+          escpos_command_boundary(data, length, offset, std::min(offset + kWriteChunk, length));
+      ok = device->link->write(data + offset, end - offset);
+      if (ok)
+        offset = end;
+      lock.lock();
+      device->inflight_remaining = length - offset;
+      lock.unlock();
+    }
+    ok = ok && device->link->flush();
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    lock.lock();
+    device->inflight_remaining = 0;
+    if (ok)
+    {
+      device->completed++;
+      if (length >= kMinSampleBytes && seconds > 0)
+      {
+        const double sample = static_cast<double>(length) / seconds;
+        device->throughput = kThroughputAlpha * sample +
+                             (1.0 - kThroughputAlpha) * device->throughput;
+      }
+      if (!device->has_jobs() && device->link->exclusive())
+      {
+        device->link_open = false;
+        lock.unlock();
+        device->link->close();
+        lock.lock();
+      }
+      continue;
+    }
+
+    // Falló la escritura: el trabajo vuelve al frente de la cola y, si el
+    // dispositivo está en un grupo, todo lo pendiente migra a otro miembro.
+    // Uno que ya salió en parte se queda: se retoma en la misma impresora
+    // desde el último fin de línea/banda, con los comandos modales previos
+    // (como el spool); en otra saldría un ticket partido en dos.
+    if (offset > 0)
+    {
+      const size_t boundary = escpos_safe_boundary(data, length, offset);
+      std::vector<uint8_t> rest = escpos_modal_prefix(data, boundary);
+      rest.insert(rest.end(), data + boundary, data + length);
+      job.data = std::move(rest);
+      job.pinned = true;
+    }
+    device->link_open = false;
+    device->online = false;
+    enqueue_locked(device, std::move(job), true);
+    fail_over_locked(device);
+    // Cerrar puede esperar al escritor (o a usblp): sin el lock, como arriba.
+    lock.unlock();
+    device->link->close();
+    lock.lock();
+  }
+
+  lock.unlock();
+  device->link->close();
+}
+
+std::vector<SchedulerDeviceStats> JobScheduler::stats()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<SchedulerDeviceStats> out;
+  for (auto &entry : devices_)
+  {
+    const Device *d = entry.second.get();
+    SchedulerDeviceStats s{d->id, d->group, d->online, 0, d->inflight_remaining,
+                           d->throughput, d->completed};
+    for (int p = 0; p < kJobPriorityCount; p++)
+    {
+      s.queued_jobs += d->queues[p].size();
+      s.queued_bytes += d->queued_bytes[p];
+    }
+    out.push_back(s);
+  }
+  return out;
+}
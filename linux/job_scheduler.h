@@ -0,0 +1,92 @@
+#ifndef FLUTTER_PLUGIN_TI_PRINTER_JOB_SCHEDULER_H_
+#define FLUTTER_PLUGIN_TI_PRINTER_JOB_SCHEDULER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Scheduler de trabajos para varias impresoras.
+//
+// Cada dispositivo registrado tiene su propio hilo de I/O y una cola por
+// clase de prioridad (urgente > normal > baja). Los dispositivos pueden
+// agruparse (ej. "mostrador" con dos impresoras idénticas): un trabajo
+// enviado al grupo va al miembro con menor tiempo estimado de finalización,
+// calculado con los bytes encolados delante del trabajo y el throughput
+// medido de cada impresora. Si un miembro se desconecta o deja de aceptar
+// datos, sus trabajos pendientes pasan a los miembros que siguen en línea;
+// el que quedó a medias se retoma en la misma impresora.
+//
+// Los ids de dispositivo son rutas de nodo (/dev/usb/lp0) o
+// "tcp://host[:puerto]" para impresoras de red.
+
+enum class JobPriority
+{
+  kUrgent = 0, // comandas de cocina
+  kNormal = 1, // tickets
+  kLow = 2,    // reimpresiones, reportes
+};
+
+constexpr int kJobPriorityCount = 3;
+
+struct SchedulerDeviceStats
+{
+  std::string id;
+  std::string group;
+  bool online;
+  size_t queued_jobs;
+  uint64_t queued_bytes;
+  double throughput; // bytes/s (EWMA)
+  uint64_t completed_jobs;
+};
+
+class JobScheduler
+{
+public:
+  JobScheduler();
+  ~JobScheduler();
+
+  JobScheduler(const JobScheduler &) = delete;
+  JobScheduler &operator=(const JobScheduler &) = delete;
+
+  // Registra un dispositivo (opcionalmente en un grupo) y arranca su hilo.
+  bool add_device(const std::string &id, const std::string &group);
+
+  // Detiene el dispositivo; sus trabajos pendientes se reasignan al grupo.
+  bool remove_device(const std::string &id);
+
+  // Encola 'data' en 'target' (id de dispositivo o nombre de grupo).
+  // Devuelve el id del trabajo, o 0 si no hay destino.
+  uint64_t submit(const std::string &target, JobPriority priority,
+                  std::vector<uint8_t> data);
+
+  std::vector<SchedulerDeviceStats> stats();
+
+  // Detiene todos los hilos (los trabajos en cola se descartan).
+  void shutdown();
+
+private:
+  struct Job
+  {
+    uint64_t id;
+    JobPriority priority;
+    bool pinned; // enviado a un id concreto o ya empezado: no migra en failover
+    std::vector<uint8_t> data;
+  };
+  struct Device;
+
+  Device *pick_locked(const std::string &target, JobPriority priority,
+                      size_t length, const Device *exclude);
+  void enqueue_locked(Device *device, Job job, bool front);
+  void fail_over_locked(Device *device);
+  void run(Device *device);
+
+  std::mutex mutex_;
+  std::map<std::string, std::unique_ptr<Device>> devices_;
+  uint64_t next_id_ = 1;
+};
+
+#endif // FLUTTER_PLUGIN_TI_PRINTER_JOB_SCHEDULER_H_
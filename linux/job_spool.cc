@@ -0,0 +1,444 @@
+#include "job_spool.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "checksum.h"
+#include "file_lock.h"
+
+namespace
+{
+
+constexpr char kMagic[8] = {'T', 'I', 'S', 'P', 'O', 'O', 'L', '2'};
+constexpr uint32_t kRecordMagic = 0x314A4F42; // "BOJ1"
+constexpr uint32_t kStatePending = 0;
+constexpr uint32_t kStateDone = 1;
+
+constexpr size_t kInitialCapacity = 64 * 1024;
+// Si el journal creció por encima de esto, al compactar se trunca.
+constexpr size_t kShrinkThreshold = 4 * 1024 * 1024;
+
+size_t align8(size_t n)
+{
+  return (n + 7) & ~static_cast<size_t>(7);
+}
+
+// Arranque del sistema actual: un pid de otro arranque ya no existe.
+uint32_t boot_tag()
+{
+  std::ifstream file("/proc/sys/kernel/random/boot_id");
+  std::string id;
+  std::getline(file, id);
+  return crc32(reinterpret_cast<const uint8_t *>(id.data()), id.size());
+}
+
+// Inicio del proceso 'pid' en ticks desde el arranque (campo 22 de
+// /proc/<pid>/stat), 0 si no existe. Junto con el pid distingue a un
+// proceso nuevo que heredó el número.
+uint64_t process_start(uint32_t pid)
+{
+  std::ifstream file("/proc/" + std::to_string(pid) + "/stat");
+  std::string stat;
+  std::getline(file, stat);
+  // El nombre (campo 2) puede tener espacios y paréntesis: se cuenta desde
+  // el último ')'.
+  const size_t close = stat.rfind(')');
+  if (close == std::string::npos)
+    return 0;
+  unsigned long long start = 0;
+  if (std::sscanf(stat.c_str() + close + 1,
+                  " %*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %*u %*u %*d %*d %*d %*d "
+                  "%*d %*d %llu",
+                  &start) != 1)
+    return 0;
+  return start;
+}
+
+struct Owner
+{
+  uint32_t pid;
+  uint32_t boot;
+  uint64_t start;
+};
+
+const Owner &self_owner()
+{
+  static const Owner owner = [] {
+    const auto pid = static_cast<uint32_t>(getpid());
+    return Owner{pid, boot_tag(), process_start(pid)};
+  }();
+  return owner;
+}
+
+} // namespace
+
+struct JobSpool::FileHeader
+{
+  char magic[8];
+  uint64_t used;
+  uint64_t next_id;
+  uint64_t reserved;
+};
+
+struct JobSpool::Record
+{
+  uint32_t magic;
+  uint32_t state;
+  uint64_t id;
+  uint64_t length;
+  uint64_t acked;
+  uint32_t device_len;
+  uint32_t crc;
+  // Proceso que lo envía (ver pending()).
+  uint32_t owner_pid;
+  uint32_t owner_boot;
+  uint64_t owner_start;
+
+  size_t total_size() const
+  {
+    return align8(sizeof(Record) + device_len + length);
+  }
+  const char *device() const
+  {
+    return reinterpret_cast<const char *>(this + 1);
+  }
+  const uint8_t *payload() const
+  {
+    return reinterpret_cast<const uint8_t *>(this + 1) + device_len;
+  }
+};
+
+JobSpool::~JobSpool()
+{
+  close();
+}
+
+bool JobSpool::remap(size_t capacity)
+{
+  if (ftruncate(fd_, static_cast<off_t>(capacity)) != 0)
+    return false;
+
+  void *mem = base_
+                  ? mremap(base_, capacity_, capacity, MREMAP_MAYMOVE)
+                  : mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+  if (mem == MAP_FAILED)
+    return false;
+
+  base_ = static_cast<uint8_t *>(mem);
+  capacity_ = capacity;
+  return true;
+}
+
+bool JobSpool::open(const std::string &path)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (fd_ >= 0)
+    return true;
+
+  const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+  if (fd < 0)
+    return false;
+
+  bool ok;
+  {
+    FileLock file_lock(fd);
+    fd_ = fd;
+    struct stat st{};
+    fstat(fd_, &st);
+    const size_t size = static_cast<size_t>(st.st_size);
+    ok = remap(size < kInitialCapacity ? kInitialCapacity : size);
+    if (ok)
+      validate_locked(size);
+  }
+  if (!ok)
+  {
+    ::close(fd);
+    fd_ = -1;
+    return false;
+  }
+  path_ = path;
+  return true;
+}
+
+// Con el archivo recién abierto (y bloqueado): lo inicializa si es nuevo o
+// irreconocible y descarta lo que quedó a medio escribir.
+void JobSpool::validate_locked(size_t size)
+{
+  auto *hdr = reinterpret_cast<FileHeader *>(base_);
+  if (size < sizeof(FileHeader) || std::memcmp(hdr->magic, kMagic, sizeof(kMagic)) != 0 ||
+      hdr->used < sizeof(FileHeader) || hdr->used > capacity_)
+  {
+    // Journal nuevo o irreconocible: empezar de cero.
+    std::memset(base_, 0, sizeof(FileHeader));
+    std::memcpy(hdr->magic, kMagic, sizeof(kMagic));
+    hdr->used = sizeof(FileHeader);
+    hdr->next_id = 1;
+    sync_range(0, sizeof(FileHeader));
+    return;
+  }
+
+  // Validar registros: corta en el primero corrupto y descarta pendientes
+  // cuyo payload no coincide con el CRC (escritura interrumpida).
+  size_t pos = sizeof(FileHeader);
+  while (pos + sizeof(Record) <= hdr->used)
+  {
+    auto *rec = reinterpret_cast<Record *>(base_ + pos);
+    if (rec->magic != kRecordMagic || pos + rec->total_size() > hdr->used)
+    {
+      hdr->used = pos;
+      break;
+    }
+    if (rec->state == kStatePending &&
+        crc32(rec->payload(), rec->length) != rec->crc)
+    {
+      rec->state = kStateDone;
+    }
+    pos += rec->total_size();
+  }
+}
+
+// Otro proceso pudo agrandar el archivo o achicarlo al compactar: el mapeo
+// se ajusta a su tamaño antes de leerlo (más allá del final, SIGBUS).
+bool JobSpool::refresh_locked()
+{
+  struct stat st{};
+  if (fstat(fd_, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(FileHeader))
+    return false;
+  const size_t size = static_cast<size_t>(st.st_size);
+  if (size != capacity_)
+  {
+    void *mem = mremap(base_, capacity_, size, MREMAP_MAYMOVE);
+    if (mem == MAP_FAILED)
+      return false;
+    base_ = static_cast<uint8_t *>(mem);
+    capacity_ = size;
+  }
+  const auto *hdr = reinterpret_cast<const FileHeader *>(base_);
+  return std::memcmp(hdr->magic, kMagic, sizeof(kMagic)) == 0 &&
+         hdr->used >= sizeof(FileHeader) && hdr->used <= capacity_;
+}
+
+// true si el trabajo es de este proceso o de uno que ya no existe (y desde
+// ahora es de este). Uno vivo lo sigue enviando él: retomarlo acá lo
+// imprimiría dos veces.
+bool JobSpool::claim_locked(Record *rec)
+{
+  const Owner &self = self_owner();
+  if (rec->owner_pid == self.pid && rec->owner_boot == self.boot &&
+      rec->owner_start == self.start)
+    return true;
+  if (rec->owner_boot == self.boot && rec->owner_pid != 0 &&
+      process_start(rec->owner_pid) == rec->owner_start)
+    return false;
+  rec->owner_pid = self.pid;
+  rec->owner_boot = self.boot;
+  rec->owner_start = self.start;
+  return true;
+}
+
+void JobSpool::close()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (base_)
+  {
+    msync(base_, capacity_, MS_SYNC);
+    munmap(base_, capacity_);
+    base_ = nullptr;
+    capacity_ = 0;
+  }
+  if (fd_ >= 0)
+  {
+    ::close(fd_);
+    fd_ = -1;
+  }
+}
+
+void JobSpool::sync_range(size_t offset, size_t length)
+{
+  // msync exige direcciones alineadas a página.
+  const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  const size_t start = offset & ~(page - 1);
+  msync(base_ + start, offset + length - start, MS_SYNC);
+}
+
+bool JobSpool::ensure_capacity(size_t bytes)
+{
+  auto *hdr = reinterpret_cast<FileHeader *>(base_);
+  if (hdr->used + bytes <= capacity_)
+    return true;
+
+  size_t capacity = capacity_;
+  while (hdr->used + bytes > capacity)
+    capacity *= 2;
+  return remap(capacity);
+}
+
+JobSpool::Record *JobSpool::find(uint64_t id)
+{
+  auto *hdr = reinterpret_cast<FileHeader *>(base_);
+  size_t pos = sizeof(FileHeader);
+  while (pos < hdr->used)
+  {
+    auto *rec = reinterpret_cast<Record *>(base_ + pos);
+    if (rec->id == id)
+      return rec;
+    pos += rec->total_size();
+  }
+  return nullptr;
+}
+
+uint64_t JobSpool::append(const std::string &device, const uint8_t *data, size_t length)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (fd_ < 0 || !data || length == 0)
+    return 0;
+  FileLock file_lock(fd_);
+  if (!refresh_locked())
+    return 0;
+
+  const size_t total = align8(sizeof(Record) + device.size() + length);
+  if (!ensure_capacity(total))
+    return 0;
+
+  auto *hdr = reinterpret_cast<FileHeader *>(base_);
+  const size_t offset = hdr->used;
+  auto *rec = reinterpret_cast<Record *>(base_ + offset);
+  const Owner &owner = self_owner();
+  rec->magic = kRecordMagic;
+  rec->state = kStatePending;
+  rec->id = hdr->next_id;
+  rec->length = length;
+  rec->acked = 0;
+  rec->device_len = static_cast<uint32_t>(device.size());
+  rec->crc = crc32(data, length);
+  rec->owner_pid = owner.pid;
+  rec->owner_boot = owner.boot;
+  rec->owner_start = owner.start;
+  uint8_t *body = reinterpret_cast<uint8_t *>(rec + 1);
+  std::memcpy(body, device.data(), device.size());
+  std::memcpy(body + device.size(), data, length);
+  sync_range(offset, total);
+
+  // Commit: recién ahora el registro es visible para una recuperación.
+  hdr->used = offset + total;
+  hdr->next_id++;
+  sync_range(0, sizeof(FileHeader));
+  return rec->id;
+}
+
+void JobSpool::ack(uint64_t id, uint64_t offset)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (fd_ < 0 || id == 0)
+    return;
+  FileLock file_lock(fd_);
+  if (!refresh_locked())
+    return;
+  Record *rec = find(id);
+  // Sin msync: MAP_SHARED sobrevive a un crash del proceso; el kernel lo
+  // escribe a disco por su cuenta.
+  if (rec && offset > rec->acked)
+    rec->acked = offset;
+}
+
+void JobSpool::complete(uint64_t id)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (fd_ < 0 || id == 0)
+    return;
+  FileLock file_lock(fd_);
+  if (!refresh_locked())
+    return;
+  Record *rec = find(id);
+  if (!rec)
+    return;
+  rec->acked = rec->length;
+  rec->state = kStateDone;
+  maybe_compact();
+}
+
+// Pendientes de cualquier proceso cuentan: sólo se vacía cuando nadie tiene
+// trabajos en el journal.
+void JobSpool::maybe_compact()
+{
+  auto *hdr = reinterpret_cast<FileHeader *>(base_);
+  size_t pos = sizeof(FileHeader);
+  while (pos < hdr->used)
+  {
+    auto *rec = reinterpret_cast<Record *>(base_ + pos);
+    if (rec->state == kStatePending)
+      return;
+    pos += rec->total_size();
+  }
+
+  hdr->used = sizeof(FileHeader);
+  sync_range(0, sizeof(FileHeader));
+  if (capacity_ > kShrinkThreshold)
+    remap(kInitialCapacity);
+}
+
+std::vector<SpooledJob> JobSpool::pending(const std::string &device)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<SpooledJob> jobs;
+  if (fd_ < 0)
+    return jobs;
+  FileLock file_lock(fd_);
+  if (!refresh_locked())
+    return jobs;
+
+  auto *hdr = reinterpret_cast<FileHeader *>(base_);
+  size_t pos = sizeof(FileHeader);
+  while (pos < hdr->used)
+  {
+    auto *rec = reinterpret_cast<Record *>(base_ + pos);
+    std::string rec_device(rec->device(), rec->device_len);
+    if (rec->state == kStatePending && (device.empty() || rec_device == device) &&
+        claim_locked(rec))
+    {
+      SpooledJob job;
+      job.id = rec->id;
+      job.device = rec_device;
+      job.acked = rec->acked;
+      job.data.assign(rec->payload(), rec->payload() + rec->length);
+      jobs.push_back(std::move(job));
+    }
+    pos += rec->total_size();
+  }
+  return jobs;
+}
+
+size_t JobSpool::discard(const std::string &device)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (fd_ < 0)
+    return 0;
+  FileLock file_lock(fd_);
+  if (!refresh_locked())
+    return 0;
+
+  size_t count = 0;
+  auto *hdr = reinterpret_cast<FileHeader *>(base_);
+  size_t pos = sizeof(FileHeader);
+  while (pos < hdr->used)
+  {
+    auto *rec = reinterpret_cast<Record *>(base_ + pos);
+    if (rec->state == kStatePending &&
+        (device.empty() || std::string(rec->device(), rec->device_len) == device) &&
+        claim_locked(rec))
+    {
+      rec->state = kStateDone;
+      count++;
+    }
+    pos += rec->total_size();
+  }
+  maybe_compact();
+  return count;
+}
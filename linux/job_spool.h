@@ -0,0 +1,90 @@
+#ifndef FLUTTER_PLUGIN_TI_PRINTER_JOB_SPOOL_H_
+#define FLUTTER_PLUGIN_TI_PRINTER_JOB_SPOOL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Spool de trabajos en disco, a prueba de crashes.
+//
+// Es un journal append-only mapeado en memoria (MAP_SHARED). Cada trabajo se
+// persiste completo (msync) antes de empezar a escribirlo en el dispositivo
+// y se actualiza en el lugar el offset de bytes ya escritos. Si la app muere
+// o la impresora se desconecta a mitad de un ticket, el trabajo queda
+// pendiente y puede retomarse desde un límite seguro (fin de línea/banda).
+//
+// Layout del archivo:
+//   FileHeader | Record | device | payload | padding(8) | Record | ...
+// 'used' en el header es el punto de commit: un registro a medio escribir
+// más allá de 'used' se ignora al abrir.
+//
+// El archivo es uno por usuario y lo abren todos los procesos con el plugin
+// (la caja y la pantalla de cocina): cada operación toma flock() exclusivo
+// y, como otro proceso pudo agrandar o achicar el archivo, ajusta el mapeo
+// antes de tocarlo. Cada registro lleva el proceso que lo creó (pid, inicio
+// y arranque del sistema): pending() y discard() no tocan los trabajos de
+// otro proceso vivo y se quedan con los de uno que murió.
+
+struct SpooledJob
+{
+  uint64_t id;
+  std::string device;
+  uint64_t acked; // bytes ya entregados al dispositivo
+  std::vector<uint8_t> data;
+};
+
+class JobSpool
+{
+public:
+  JobSpool() = default;
+  ~JobSpool();
+
+  JobSpool(const JobSpool &) = delete;
+  JobSpool &operator=(const JobSpool &) = delete;
+
+  // Abre (o crea) el journal. Valida los registros existentes por CRC.
+  bool open(const std::string &path);
+  void close();
+  bool is_open() const { return fd_ >= 0; }
+
+  // Persiste un trabajo nuevo y devuelve su id (0 si no se pudo).
+  uint64_t append(const std::string &device, const uint8_t *data, size_t length);
+
+  // Registra que ya se escribieron 'offset' bytes del trabajo.
+  void ack(uint64_t id, uint64_t offset);
+
+  // Marca el trabajo como terminado. Si no quedan pendientes, el journal se
+  // compacta (vuelve a quedar vacío).
+  void complete(uint64_t id);
+
+  // Trabajos pendientes de 'device' (todos si device está vacío), en orden,
+  // de este proceso o de uno que ya no existe (pasan a ser de este).
+  std::vector<SpooledJob> pending(const std::string &device);
+
+  // Marca como terminados los pendientes de 'device' (o todos) que
+  // pending() devolvería.
+  size_t discard(const std::string &device);
+
+private:
+  struct FileHeader;
+  struct Record;
+
+  bool ensure_capacity(size_t bytes);
+  bool remap(size_t capacity);
+  void validate_locked(size_t size);
+  bool refresh_locked();
+  bool claim_locked(Record *rec);
+  Record *find(uint64_t id);
+  void maybe_compact();
+  void sync_range(size_t offset, size_t length);
+
+  mutable std::mutex mutex_;
+  int fd_ = -1;
+  uint8_t *base_ = nullptr;
+  size_t capacity_ = 0;
+  std::string path_;
+};
+
+#endif // FLUTTER_PLUGIN_TI_PRINTER_JOB_SPOOL_H_
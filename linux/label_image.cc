@@ -0,0 +1,217 @@
+#include "label_image.h"
+
+#include <glib.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#ifdef TI_PRINTER_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace
+{
+
+const char kHexDigits[] = "0123456789ABCDEF";
+
+// Un contador de ZPL cubre hasta 400 + 19 dígitos iguales.
+constexpr int kMaxZplRun = 419;
+
+// Dígito hex 'i' (0 = nibble alto del primer byte) de una fila.
+inline int row_nibble(const uint8_t *row, size_t i)
+{
+  return (i & 1) ? row[i >> 1] & 0x0F : row[i >> 1] >> 4;
+}
+
+// Un run de 'count' dígitos 'nibble'. Con 1 o 2 repeticiones el contador
+// no ahorra nada.
+void append_run(std::string &out, int nibble, size_t count)
+{
+  const char digit = kHexDigits[nibble];
+  while (count > 0)
+  {
+    const int run = static_cast<int>(std::min<size_t>(count, kMaxZplRun));
+    count -= static_cast<size_t>(run);
+    if (run <= 2)
+    {
+      out.append(static_cast<size_t>(run), digit);
+      continue;
+    }
+    if (run >= 20)
+      out.push_back(static_cast<char>('g' + run / 20 - 1));
+    if (run % 20 != 0)
+      out.push_back(static_cast<char>('G' + run % 20 - 1));
+    out.push_back(digit);
+  }
+}
+
+void append_zpl_row(const uint8_t *row, size_t stride, std::string &out)
+{
+  const size_t nibbles = stride * 2;
+
+  // Cola de ceros o de F: se reemplaza por ',' o '!'.
+  size_t end = nibbles;
+  while (end > 0 && row_nibble(row, end - 1) == 0)
+    end--;
+  char tail = ',';
+  if (end == nibbles)
+  {
+    while (end > 0 && row_nibble(row, end - 1) == 0x0F)
+      end--;
+    tail = '!';
+  }
+
+  size_t i = 0;
+  while (i < end)
+  {
+    const int nibble = row_nibble(row, i);
+    size_t j = i + 1;
+    while (j < end && row_nibble(row, j) == nibble)
+      j++;
+    append_run(out, nibble, j - i);
+    i = j;
+  }
+  if (end < nibbles)
+    out.push_back(tail);
+}
+
+// Grises → filas de 1 bit (1 = negro) con el dither pedido.
+std::vector<uint8_t> pack_image(const uint8_t *gray, int width, int height,
+                                RasterDither dither)
+{
+  const size_t stride = static_cast<size_t>(width + 7) / 8;
+  std::vector<uint8_t> packed(stride * height);
+  std::vector<uint8_t> row(width);
+  ErrorDiffuser diffuser(width);
+  for (int y = 0; y < height; y++)
+  {
+    std::copy_n(gray + static_cast<size_t>(y) * width, width, row.begin());
+    if (dither == RasterDither::kFloydSteinberg)
+      diffuser.dither_row(row.data());
+    else if (dither == RasterDither::kOrdered)
+      escpos_ordered_row(row.data(), width, y);
+    escpos_pack_row(row.data(), width, packed.data() + static_cast<size_t>(y) * stride);
+  }
+  return packed;
+}
+
+void append_text(std::vector<uint8_t> &out, const std::string &text)
+{
+  out.insert(out.end(), text.begin(), text.end());
+}
+
+// Campo Z64: la imagen con deflate (formato zlib) en base64 y el CRC-16 de
+// ese texto. false si el plugin no tiene zlib.
+bool encode_z64(const std::vector<uint8_t> &packed, std::string &data)
+{
+#ifdef TI_PRINTER_HAVE_ZLIB
+  uLongf length = compressBound(static_cast<uLong>(packed.size()));
+  std::vector<uint8_t> deflated(length);
+  if (compress2(deflated.data(), &length, packed.data(), static_cast<uLong>(packed.size()),
+                Z_DEFAULT_COMPRESSION) != Z_OK)
+    return false;
+
+  gchar *base64 = g_base64_encode(deflated.data(), length);
+  const size_t base64_length = std::strlen(base64);
+  char crc[8];
+  snprintf(crc, sizeof(crc), ":%04x", zpl_crc16(base64, base64_length));
+  data.reserve(base64_length + 10);
+  data.append(":Z64:");
+  data.append(base64, base64_length);
+  data.append(crc);
+  g_free(base64);
+  return true;
+#else
+  (void)packed;
+  (void)data;
+  return false;
+#endif
+}
+
+void append_zpl(std::vector<uint8_t> &out, const std::vector<uint8_t> &packed,
+                size_t stride, int height, LabelImageFormat format, int x, int y)
+{
+  const size_t total = packed.size();
+  char header[96];
+  snprintf(header, sizeof(header), "^XA\n^FO%d,%d^GFA,%zu,%zu,%zu,", x, y, total, total,
+           stride);
+  append_text(out, header);
+
+  std::string data;
+  if (format != LabelImageFormat::kZplZ64 || !encode_z64(packed, data))
+  {
+    data.reserve(packed.size() / 4);
+    zpl_ascii_compress(packed.data(), stride, height, data);
+  }
+  append_text(out, data);
+  append_text(out, "^FS\n^XZ\n");
+}
+
+void append_tspl(std::vector<uint8_t> &out, const std::vector<uint8_t> &packed,
+                 size_t stride, int height, int x, int y)
+{
+  char header[80];
+  snprintf(header, sizeof(header), "CLS\r\nBITMAP %d,%d,%zu,%d,0,", x, y, stride, height);
+  append_text(out, header);
+  // En TSPL un bit en 0 es un punto negro.
+  const size_t offset = out.size();
+  out.resize(offset + packed.size());
+  for (size_t i = 0; i < packed.size(); i++)
+    out[offset + i] = static_cast<uint8_t>(~packed[i]);
+  append_text(out, "\r\nPRINT 1\r\n");
+}
+
+} // namespace
+
+bool label_z64_available()
+{
+#ifdef TI_PRINTER_HAVE_ZLIB
+  return true;
+#else
+  return false;
+#endif
+}
+
+void zpl_ascii_compress(const uint8_t *rows, size_t stride, int height, std::string &out)
+{
+  for (int r = 0; r < height; r++)
+  {
+    const uint8_t *row = rows + static_cast<size_t>(r) * stride;
+    if (r > 0 && std::memcmp(row, row - stride, stride) == 0)
+      out.push_back(':');
+    else
+      append_zpl_row(row, stride, out);
+  }
+}
+
+uint16_t zpl_crc16(const char *data, size_t length)
+{
+  uint16_t crc = 0;
+  for (size_t i = 0; i < length; i++)
+  {
+    crc ^= static_cast<uint16_t>(static_cast<uint8_t>(data[i]) << 8);
+    for (int bit = 0; bit < 8; bit++)
+      crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x1021)
+                           : static_cast<uint16_t>(crc << 1);
+  }
+  return crc;
+}
+
+std::vector<uint8_t> label_image(const uint8_t *gray, int width, int height,
+                                 RasterDither dither, LabelImageFormat format,
+                                 int x, int y)
+{
+  std::vector<uint8_t> out;
+  if (!gray || width <= 0 || height <= 0 || x < 0 || y < 0 ||
+      format > LabelImageFormat::kTsplBitmap)
+    return out;
+
+  const size_t stride = static_cast<size_t>(width + 7) / 8;
+  const std::vector<uint8_t> packed = pack_image(gray, width, height, dither);
+  if (format == LabelImageFormat::kTsplBitmap)
+    append_tspl(out, packed, stride, height, x, y);
+  else
+    append_zpl(out, packed, stride, height, format, x, y);
+  return out;
+}
@@ -0,0 +1,52 @@
+#ifndef FLUTTER_PLUGIN_TI_PRINTER_LABEL_IMAGE_H_
+#define FLUTTER_PLUGIN_TI_PRINTER_LABEL_IMAGE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "escpos_image.h"
+
+// Imágenes para impresoras de etiquetas (Zebra ZPL, TSC/Gprinter TSPL).
+//
+// El ^GFA sin comprimir manda cada byte como dos dígitos hex: el doble que
+// la imagen. Las etiquetas son casi todo blanco con runs largos (texto,
+// códigos de barras), así que comprimir las filas baja mucho los bytes:
+//
+//   - ZPL ASCII: runs de un mismo dígito con un contador en letras
+//     (G..Y = 1..19, g..z = 20..400), ',' para completar la fila con 0,
+//     '!' para completarla con F y ':' para repetir la fila anterior. Lo
+//     entiende cualquier firmware ZPL II.
+//   - Z64: la imagen comprimida con deflate (zlib) en base64, con un CRC-16
+//     al final. Comprime mejor las imágenes con trama, pero sólo la
+//     entienden los firmwares más nuevos.
+//   - TSPL BITMAP: los bytes en binario (0 = punto negro); no tiene
+//     compresión, pero ya es la mitad que el hex.
+
+enum class LabelImageFormat : uint8_t
+{
+  kZplAscii = 0,
+  kZplZ64 = 1,
+  kTsplBitmap = 2,
+};
+
+// true si el plugin se compiló con zlib (sin zlib, Z64 sale como ZPL ASCII).
+bool label_z64_available();
+
+// Filas de 1 bit ('stride' bytes por fila, MSB primero, 1 = negro) como
+// datos de ^GF con compresión ASCII de ZPL.
+void zpl_ascii_compress(const uint8_t *rows, size_t stride, int height, std::string &out);
+
+// CRC-16/CCITT (polinomio 0x1021, inicial 0) que va al final de un campo Z64.
+uint16_t zpl_crc16(const char *data, size_t length);
+
+// Etiqueta completa que imprime la imagen con la esquina en (x, y):
+// ^XA ^FO ^GF ^FS ^XZ en ZPL; CLS, BITMAP y PRINT en TSPL. 'gray' son
+// grises de 8 bits (0 = negro) que se llevan a 1 bit con 'dither'. Vacío si
+// los parámetros no son válidos.
+std::vector<uint8_t> label_image(const uint8_t *gray, int width, int height,
+                                 RasterDither dither, LabelImageFormat format,
+                                 int x, int y);
+
+#endif // FLUTTER_PLUGIN_TI_PRINTER_LABEL_IMAGE_H_
@@ -0,0 +1,389 @@
+#include "lane_writer.h"
+
+#include "core_log.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include <errno.h>
+#include <unistd.h>
+
+#include "device_io.h"
+#include "escpos_lexer.h"
+
+namespace
+{
+
+// Tamaño de bloque del carril de trabajos: a ~40 KB/s de una térmica USB
+// son ~100 ms, que es la latencia máxima de una consulta de estado salvo
+// que un solo comando (una banda GS v 0) sea más grande.
+constexpr size_t kChunkBytes = 4096;
+
+// Margen sobre el timeout de respuesta para esperar a que el hilo libere el
+// fd; si la impresora no acepta datos (sin papel) write() puede bloquear.
+constexpr auto kRealtimeQueueWait = std::chrono::seconds(2);
+
+// Lectura de un trabajo de archivo (BulkJob::file): varios bloques por
+// pread(); crece si un comando no entra.
+constexpr size_t kFileWindowBytes = 16 * kChunkBytes;
+
+// Bytes [start, start + bytes.size()) de un trabajo de archivo.
+struct FileWindow
+{
+  std::vector<uint8_t> bytes;
+  size_t start = 0;
+};
+
+bool read_window(int fd, size_t from, size_t count, FileWindow &window, int *error)
+{
+  window.bytes.resize(count);
+  window.start = from;
+  size_t got = 0;
+  while (got < count)
+  {
+    const ssize_t n = pread(fd, window.bytes.data() + got, count - got,
+                            static_cast<off_t>(from + got));
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+    {
+      *error = n < 0 ? errno : EIO; // 0: el archivo se achicó
+      return false;
+    }
+    got += static_cast<size_t>(n);
+  }
+  return true;
+}
+
+// Final del bloque que empieza en 'offset' (un límite de comando, como con
+// un trabajo en memoria), leyendo del archivo lo que haga falta.
+bool file_chunk(int fd, size_t length, size_t offset, FileWindow &window, size_t *end,
+                int *error)
+{
+  size_t need = std::min(offset + kChunkBytes, length);
+  for (;;)
+  {
+    if (offset < window.start || window.start + window.bytes.size() < need)
+    {
+      const size_t count = std::min(std::max(kFileWindowBytes, need - offset), length - offset);
+      if (!read_window(fd, offset, count, window, error))
+        return false;
+    }
+    const size_t from = offset - window.start;
+    const size_t size = window.bytes.size();
+    const size_t boundary = escpos_command_boundary(window.bytes.data(), size, from,
+                                                    std::min(from + kChunkBytes, size));
+    // En el borde de la ventana puede haber un comando cortado: se relee
+    // con el doble de lo que quedaba.
+    if (boundary < size || window.start + size == length)
+    {
+      *end = window.start + boundary;
+      return true;
+    }
+    need = std::min(offset + 2 * (size - from), length);
+  }
+}
+
+} // namespace
+
+struct LaneWriter::RealtimeRequest
+{
+  std::vector<uint8_t> command;
+  bool read_reply;
+  int timeout_ms;
+  size_t expected;
+  std::vector<uint8_t> reply;
+  int error = 0;
+  bool done = false;
+};
+
+LaneWriter::~LaneWriter()
+{
+  stop(false);
+}
+
+bool LaneWriter::start(int fd, int stall_ms)
+{
+  stop(false);
+  if (fd < 0)
+    return false;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  fd_ = fd;
+  stall_ms_ = stall_ms;
+  failed_ = 0;
+  busy_ = false;
+  stopping_ = false;
+  draining_ = false;
+  thread_ = std::thread(&LaneWriter::run, this);
+  return true;
+}
+
+void LaneWriter::stop(bool drain)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!thread_.joinable())
+    {
+      fd_ = -1;
+      return;
+    }
+    stopping_ = true;
+    draining_ = drain;
+    cv_.notify_all();
+  }
+  thread_.join();
+
+  std::deque<BulkJob> cancelled;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cancelled.swap(jobs_);
+    for (auto &request : realtime_)
+    {
+      request->error = ECANCELED;
+      request->done = true;
+    }
+    realtime_.clear();
+    cv_.notify_all();
+    fd_ = -1;
+    stopping_ = false;
+  }
+  for (BulkJob &job : cancelled)
+  {
+    if (job.done)
+      job.done(false, ECANCELED);
+  }
+}
+
+void LaneWriter::submit(BulkJob job)
+{
+  int error = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fd_ < 0 || stopping_)
+      error = EBADF;
+    else if (failed_ != 0)
+      error = failed_;
+    else
+    {
+      jobs_.push_back(std::move(job));
+      cv_.notify_all();
+      return;
+    }
+  }
+  if (job.done)
+    job.done(false, error);
+}
+
+void LaneWriter::clear_error()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  failed_ = 0;
+}
+
+std::vector<uint8_t> LaneWriter::realtime(const uint8_t *command, size_t length,
+                                          bool read_reply, int timeout_ms,
+                                          int *error, size_t expected)
+{
+  auto request = std::make_shared<RealtimeRequest>();
+  request->command.assign(command, command + length);
+  request->read_reply = read_reply;
+  request->timeout_ms = timeout_ms;
+  request->expected = expected;
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (fd_ < 0 || failed_ != 0)
+  {
+    if (error)
+      *error = failed_ != 0 ? failed_ : EBADF;
+    return {};
+  }
+
+  if (!busy_ && jobs_.empty())
+  {
+    // Nada en curso: escribir directo sin pasar por el hilo.
+    busy_ = true;
+    lock.unlock();
+    execute(*request, request->reply, request->error);
+    lock.lock();
+    busy_ = false;
+    cv_.notify_all();
+  }
+  else
+  {
+    realtime_.push_back(request);
+    cv_.notify_all();
+    const auto deadline = std::chrono::steady_clock::now() + kRealtimeQueueWait +
+                          std::chrono::milliseconds(timeout_ms);
+    if (!cv_.wait_until(lock, deadline, [&] { return request->done; }))
+    {
+      // No llegó a salir: que no se envíe tarde, cuando ya nadie espera.
+      // Si el hilo ya lo tomó, 'done' le avisa que descarte el resultado.
+      auto it = std::find(realtime_.begin(), realtime_.end(), request);
+      if (it != realtime_.end())
+        realtime_.erase(it);
+      request->reply.clear();
+      request->error = ETIMEDOUT;
+      request->done = true;
+    }
+  }
+
+  if (error)
+    *error = request->error;
+  return request->reply;
+}
+
+bool LaneWriter::write_all(const uint8_t *data, size_t length, bool sync, int *error)
+{
+  if (device_write_all(fd_, data, length, sync, error, stall_ms_))
+    return true;
+  core_log("Error escribiendo en USB: %s\n", core_strerror(*error));
+  return false;
+}
+
+void LaneWriter::execute(const RealtimeRequest &request, std::vector<uint8_t> &reply,
+                         int &error)
+{
+  if (!request.read_reply)
+  {
+    write_all(request.command.data(), request.command.size(), false, &error);
+    return;
+  }
+
+  reply = device_transact(fd_, request.command.data(), request.command.size(),
+                          request.timeout_ms, request.expected, &error);
+  if (error != 0)
+    core_log("Error escribiendo en USB: %s\n", core_strerror(error));
+}
+
+// Atiende los comandos de tiempo real encolados. Se llama con el lock
+// tomado y con el fd ya reservado por el hilo (busy_). El resultado se
+// arma fuera del lock y se publica con él: si el que llamó ya se fue por
+// timeout ('done' en true), se descarta.
+void LaneWriter::serve_realtime_locked(std::unique_lock<std::mutex> &lock)
+{
+  while (!realtime_.empty())
+  {
+    std::shared_ptr<RealtimeRequest> request = realtime_.front();
+    realtime_.pop_front();
+    lock.unlock();
+    std::vector<uint8_t> reply;
+    int error = 0;
+    execute(*request, reply, error);
+    lock.lock();
+    if (!request->done)
+    {
+      request->reply = std::move(reply);
+      request->error = error;
+      request->done = true;
+    }
+    cv_.notify_all();
+  }
+}
+
+void LaneWriter::fail_queued_locked(int error)
+{
+  failed_ = error;
+  for (auto &request : realtime_)
+  {
+    request->error = error;
+    request->done = true;
+  }
+  realtime_.clear();
+  cv_.notify_all();
+}
+
+void LaneWriter::run()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;)
+  {
+    cv_.wait(lock, [&] {
+      return !busy_ && (stopping_ || !realtime_.empty() || !jobs_.empty());
+    });
+
+    busy_ = true;
+    serve_realtime_locked(lock);
+    if (jobs_.empty() || failed_ != 0 || (stopping_ && !draining_))
+    {
+      busy_ = false;
+      if (stopping_)
+        break;
+      continue;
+    }
+
+    BulkJob job = std::move(jobs_.front());
+    jobs_.pop_front();
+    lock.unlock();
+
+    const bool from_file = job.file >= 0;
+    const uint8_t *data = job.view ? job.view : job.data.data();
+    const size_t length = job.view || from_file ? job.view_length : job.data.size();
+    FileWindow window;
+    size_t offset = 0;
+    int error = 0;
+    bool ok = true;
+    while (ok && offset < length)
+    {
+      size_t end;
+      const uint8_t *chunk;
+      if (from_file)
+      {
+        ok = file_chunk(job.file, length, offset, window, &end, &error);
+        if (!ok)
+          break;
+        chunk = window.bytes.data() + (offset - window.start);
+      }
+      else
+      {
+        end = escpos_command_boundary(data, length, offset,
+                                      std::min(offset + kChunkBytes, length));
+        chunk = data + offset;
+      }
+      // El último bloque lleva el fsync que fuerza a que los datos se
+      // envíen al dispositivo.
+      ok = write_all(chunk, end - offset, end == length, &error);
+      if (!ok)
+        break;
+      offset = end;
+      if (job.progress && offset > job.skip)
+        job.progress(offset - job.skip);
+
+      // Límite de bloque: acá se intercalan los comandos de tiempo real.
+      lock.lock();
+      serve_realtime_locked(lock);
+      if (offset < length && stopping_ && !draining_)
+      {
+        ok = false;
+        error = ECANCELED;
+      }
+      lock.unlock();
+    }
+
+    if (job.done)
+      job.done(ok, error);
+
+    std::deque<BulkJob> failed;
+    lock.lock();
+    busy_ = false;
+    if (!ok && error != ECANCELED)
+    {
+      // El dispositivo desapareció o dio error: el resto de la cola falla
+      // igual; el dueño decide si cerrar y reconectar.
+      fail_queued_locked(error);
+      failed.swap(jobs_);
+    }
+    cv_.notify_all();
+    if (!failed.empty())
+    {
+      lock.unlock();
+      for (BulkJob &pending : failed)
+      {
+        if (pending.done)
+          pending.done(false, error);
+      }
+      lock.lock();
+    }
+  }
+  busy_ = false;
+}
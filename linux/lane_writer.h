@@ -0,0 +1,103 @@
+#ifndef FLUTTER_PLUGIN_TI_PRINTER_LANE_WRITER_H_
+#define FLUTTER_PLUGIN_TI_PRINTER_LANE_WRITER_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Escritor con dos carriles sobre el fd de una impresora.
+//
+// El carril de trabajos escribe en un hilo propio, en bloques que terminan
+// en un límite de comando ESC/POS. Entre bloque y bloque atiende el carril
+// de tiempo real (DLE EOT, DLE ENQ, pulso de cajón): una consulta de estado
+// espera como mucho un bloque, no el trabajo entero ni su fsync.
+//
+// El fd sigue siendo del dueño: stop() debe llamarse antes de cerrarlo.
+class LaneWriter
+{
+public:
+  // Bytes del trabajo ya escritos (sin contar 'skip'). Se invoca desde el
+  // hilo del escritor.
+  using ProgressCallback = std::function<void(size_t written)>;
+  // Resultado final; 'error' es el errno del fallo (0 si ok). Se invoca
+  // desde el hilo del escritor, o desde stop() para los cancelados.
+  using DoneCallback = std::function<void(bool ok, int error)>;
+
+  struct BulkJob
+  {
+    std::vector<uint8_t> data;
+    // En lugar de 'data': bytes de otro dueño (un archivo mapeado) que
+    // 'owner' mantiene vivos hasta que el trabajo termina.
+    const uint8_t *view = nullptr;
+    size_t view_length = 0;
+    // En lugar de 'data' o 'view': 'view_length' bytes que se leen con
+    // pread() de este fd ('owner' lo mantiene abierto). Para archivos que
+    // otro proceso puede achicar: se corta con EIO en lugar de SIGBUS.
+    int file = -1;
+    std::shared_ptr<const void> owner;
+    size_t skip = 0; // bytes iniciales que no cuentan como progreso (prefijo modal)
+    ProgressCallback progress;
+    DoneCallback done;
+  };
+
+  LaneWriter() = default;
+  ~LaneWriter();
+
+  LaneWriter(const LaneWriter &) = delete;
+  LaneWriter &operator=(const LaneWriter &) = delete;
+
+  // Empieza a escribir en 'fd' (reinicia si ya estaba corriendo). Con
+  // 'stall_ms' >= 0 ('fd' O_NONBLOCK) un trabajo falla con ETIMEDOUT si el
+  // dispositivo pasa ese tiempo sin aceptar bytes (device_write_all).
+  bool start(int fd, int stall_ms = -1);
+
+  // Detiene el hilo. Con 'drain' espera a que se escriban los trabajos en
+  // cola; si no, termina el bloque en curso y cancela el resto (ECANCELED).
+  void stop(bool drain);
+
+  // Encola un trabajo. Si el escritor no está corriendo o ya falló, 'done'
+  // se invoca enseguida con error.
+  void submit(BulkJob job);
+
+  // Vuelve a aceptar trabajos después de un error que no cerró el fd.
+  void clear_error();
+
+  // Escribe un comando de tiempo real por delante de los trabajos y, si
+  // 'read_reply', espera la respuesta hasta 'timeout_ms' (con 'expected',
+  // hasta juntar esa cantidad de bytes; ver device_transact). Bloquea al
+  // que llama; si hay un trabajo en curso, el comando sale en el próximo
+  // límite de bloque. 'error' (opcional) recibe el errno si la escritura
+  // falló.
+  std::vector<uint8_t> realtime(const uint8_t *command, size_t length,
+                                bool read_reply, int timeout_ms,
+                                int *error = nullptr, size_t expected = 0);
+
+private:
+  struct RealtimeRequest;
+
+  void run();
+  bool write_all(const uint8_t *data, size_t length, bool sync, int *error);
+  void serve_realtime_locked(std::unique_lock<std::mutex> &lock);
+  void execute(const RealtimeRequest &request, std::vector<uint8_t> &reply, int &error);
+  void fail_queued_locked(int error);
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<BulkJob> jobs_;
+  std::deque<std::shared_ptr<RealtimeRequest>> realtime_;
+  std::thread thread_;
+  int fd_ = -1;
+  int stall_ms_ = -1;
+  int failed_ = 0;    // errno del último fallo; no se escribe más hasta start()
+  bool busy_ = false; // alguien tiene el fd (hilo o realtime() directo)
+  bool stopping_ = false;
+  bool draining_ = false;
+};
+
+#endif // FLUTTER_PLUGIN_TI_PRINTER_LANE_WRITER_H_
@@ -0,0 +1,876 @@
+#include "print_daemon.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <future>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "file_sender.h"
+#include "lane_writer.h"
+#include "usblp.h"
+
+namespace
+{
+
+constexpr size_t kMaxMessage = sizeof(DaemonHeader) + kDaemonMaxPath + kDaemonInlineBytes;
+
+// Tope de espera de un kStatus: el hilo de consultas del dispositivo queda
+// tomado hasta entonces.
+constexpr uint32_t kMaxStatusTimeoutMs = 5000;
+
+// Consultas en cola por dispositivo; las que no entran reciben EBUSY.
+constexpr size_t kMaxQueuedQueries = 8;
+
+// Sólo nodos de impresora, los mismos que lista listUsbPrinters: si el
+// servicio corre con más permisos que los clientes, no se le puede pedir
+// que escriba en cualquier dispositivo.
+const char *const kDevicePrefixes[] = {"/dev/usb/lp", "/dev/ttyUSB", "/dev/ttyACM"};
+
+bool allowed_device(const std::string &path)
+{
+  if (path.find("..") != std::string::npos)
+    return false;
+  for (const char *prefix : kDevicePrefixes)
+  {
+    if (path.compare(0, std::strlen(prefix), prefix) == 0)
+      return true;
+  }
+  return false;
+}
+
+// Errores de escritura que significan que el dispositivo ya no está (o el
+// fd no sirve): se cierra y el próximo pedido lo vuelve a abrir.
+bool device_gone(int error)
+{
+  return error == ENODEV || error == EIO || error == EBADF;
+}
+
+bool fill_address(const std::string &path, sockaddr_un &address)
+{
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  if (path.empty() || path.size() >= sizeof(address.sun_path))
+    return false;
+  std::memcpy(address.sun_path, path.data(), path.size());
+  return true;
+}
+
+// Un mensaje completo, con un fd adjunto opcional. 'flags' se suma a
+// MSG_NOSIGNAL.
+bool send_message(int socket, const DaemonHeader &header, const std::string &path,
+                  const uint8_t *data, size_t length, int fd, int flags = 0)
+{
+  iovec parts[3] = {
+      {const_cast<DaemonHeader *>(&header), sizeof(header)},
+      {const_cast<char *>(path.data()), path.size()},
+      {const_cast<uint8_t *>(data), length},
+  };
+  msghdr message{};
+  message.msg_iov = parts;
+  message.msg_iovlen = 3;
+
+  alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+  if (fd >= 0)
+  {
+    std::memset(control, 0, sizeof(control));
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+    cmsghdr *cmsg = CMSG_FIRSTHDR(&message);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+    std::memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+  }
+
+  ssize_t sent;
+  do
+  {
+    sent = sendmsg(socket, &message, MSG_NOSIGNAL | flags);
+  } while (sent < 0 && errno == EINTR);
+  return sent == static_cast<ssize_t>(sizeof(header) + path.size() + length);
+}
+
+// Recibe un mensaje. Devuelve los bytes leídos (0 = la otra punta cerró,
+// -1 = error); 'fd' recibe el fd adjunto o -1. Un mensaje más grande que
+// 'buffer' se descarta entero (MSG_TRUNC) y se informa como -1 con EMSGSIZE.
+ssize_t receive_message(int socket, std::vector<uint8_t> &buffer, int *fd)
+{
+  *fd = -1;
+  iovec part = {buffer.data(), buffer.size()};
+  msghdr message{};
+  message.msg_iov = &part;
+  message.msg_iovlen = 1;
+  alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))];
+  message.msg_control = control;
+  message.msg_controllen = sizeof(control);
+
+  ssize_t received;
+  do
+  {
+    received = recvmsg(socket, &message, MSG_CMSG_CLOEXEC);
+  } while (received < 0 && errno == EINTR);
+  if (received < 0)
+    return -1;
+
+  for (cmsghdr *cmsg = CMSG_FIRSTHDR(&message); cmsg != nullptr;
+       cmsg = CMSG_NXTHDR(&message, cmsg))
+  {
+    if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS)
+    {
+      const size_t count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+      for (size_t i = 0; i < count; i++)
+      {
+        int received_fd;
+        std::memcpy(&received_fd, CMSG_DATA(cmsg) + i * sizeof(int), sizeof(int));
+        if (*fd < 0)
+          *fd = received_fd;
+        else
+          ::close(received_fd);
+      }
+    }
+  }
+
+  if ((message.msg_flags & (MSG_TRUNC | MSG_CTRUNC)) != 0)
+  {
+    if (*fd >= 0)
+      ::close(*fd);
+    *fd = -1;
+    errno = EMSGSIZE;
+    return -1;
+  }
+  return received;
+}
+
+// Copia los datos a un memfd sellado: el servicio lo puede mapear sin que
+// el cliente lo cambie ni lo achique mientras se imprime.
+int sealed_memfd(const uint8_t *data, size_t length)
+{
+  const int fd = memfd_create("ti_printer_job", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+  if (fd < 0)
+    return -1;
+  size_t written = 0;
+  while (written < length)
+  {
+    const ssize_t n = write(fd, data + written, length - written);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+    {
+      ::close(fd);
+      return -1;
+    }
+    written += static_cast<size_t>(n);
+  }
+  if (fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) != 0)
+  {
+    ::close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+} // namespace
+
+std::string print_daemon_socket_path()
+{
+  const char *custom = std::getenv("TI_PRINTER_DAEMON_SOCKET");
+  if (custom != nullptr && *custom != '\0')
+    return custom;
+  const char *runtime = std::getenv("XDG_RUNTIME_DIR");
+  if (runtime != nullptr && *runtime != '\0')
+    return std::string(runtime) + "/ti_printer_daemon.sock";
+  return "/tmp/ti_printer_daemon-" + std::to_string(getuid()) + ".sock";
+}
+
+// ===================== Servicio =====================
+
+struct PrintDaemon::Client
+{
+  int fd = -1;
+  std::mutex send_mutex;
+  bool closed = false; // bajo send_mutex
+
+  ~Client()
+  {
+    if (fd >= 0)
+      ::close(fd);
+  }
+
+  // Se llama desde cualquier hilo (escritores, consultas de estado). No
+  // espera: a un cliente que no lee sus respuestas se le descartan, así no
+  // frena al escritor del dispositivo.
+  void reply(uint32_t id, int error, const std::vector<uint8_t> &data = {})
+  {
+    DaemonHeader header{kDaemonMagic, static_cast<uint16_t>(DaemonMessage::kResult), 0, id,
+                        static_cast<uint32_t>(error), 0,
+                        static_cast<uint32_t>(data.size())};
+    std::lock_guard<std::mutex> lock(send_mutex);
+    if (!closed)
+      send_message(fd, header, std::string(), data.data(), data.size(), -1, MSG_DONTWAIT);
+  }
+};
+
+struct PrintDaemon::Device
+{
+  // Consulta de estado (kStatus, kPortStatus). Corre en el hilo de
+  // consultas con el dispositivo, o con nullptr si se cerró antes de
+  // atenderla: las consultas no guardan punteros al Device.
+  using Query = std::function<void(Device *device)>;
+
+  int fd = -1;
+  LaneWriter writer;
+  // errno del último trabajo fallido. Compartido con los 'done' de los
+  // trabajos, que pueden correr mientras el Device se destruye.
+  std::shared_ptr<std::atomic<int>> error = std::make_shared<std::atomic<int>>(0);
+
+  // Las consultas bloquean hasta la respuesta (o el ioctl): las atiende un
+  // hilo por dispositivo, en orden, y no el hilo del servicio.
+  std::mutex query_mutex;
+  std::condition_variable query_cv;
+  std::deque<Query> queries; // bajo query_mutex
+  bool closing = false;      // bajo query_mutex
+  std::thread query_thread;
+
+  ~Device()
+  {
+    {
+      std::lock_guard<std::mutex> lock(query_mutex);
+      closing = true;
+    }
+    query_cv.notify_all();
+    // Primero el escritor: un realtime() en curso vuelve enseguida.
+    writer.stop(false);
+    if (query_thread.joinable())
+      query_thread.join();
+    for (Query &pending : queries)
+      pending(nullptr);
+    if (fd >= 0)
+      ::close(fd);
+  }
+
+  // false si ya hay kMaxQueuedQueries esperando.
+  bool query(Query run)
+  {
+    std::lock_guard<std::mutex> lock(query_mutex);
+    if (closing || queries.size() >= kMaxQueuedQueries)
+      return false;
+    if (!query_thread.joinable())
+      query_thread = std::thread(&Device::run_queries, this);
+    queries.push_back(std::move(run));
+    query_cv.notify_one();
+    return true;
+  }
+
+  void run_queries()
+  {
+    std::unique_lock<std::mutex> lock(query_mutex);
+    for (;;)
+    {
+      query_cv.wait(lock, [&] { return closing || !queries.empty(); });
+      if (closing)
+        return;
+      Query next = std::move(queries.front());
+      queries.pop_front();
+      lock.unlock();
+      next(this);
+      lock.lock();
+    }
+  }
+};
+
+PrintDaemon::~PrintDaemon()
+{
+  stop();
+}
+
+bool PrintDaemon::start(const std::string &socket_path, int *error)
+{
+  stop();
+
+  int err = 0;
+  sockaddr_un address;
+  if (!fill_address(socket_path, address))
+    err = ENAMETOOLONG;
+
+  // Un socket que quedó de un servicio caído se reemplaza; uno que
+  // contesta es de otro servicio vivo.
+  if (err == 0)
+  {
+    const int probe = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (probe >= 0)
+    {
+      if (::connect(probe, reinterpret_cast<sockaddr *>(&address), sizeof(address)) == 0)
+        err = EADDRINUSE;
+      ::close(probe);
+    }
+    if (err == 0)
+      unlink(socket_path.c_str());
+  }
+
+  if (err == 0)
+  {
+    listen_fd_ = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+    if (listen_fd_ < 0 ||
+        bind(listen_fd_, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 ||
+        chmod(socket_path.c_str(), 0600) != 0 || listen(listen_fd_, 16) != 0)
+      err = errno;
+  }
+
+  if (err == 0)
+  {
+    stop_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    epoll_event listen_event{};
+    listen_event.events = EPOLLIN;
+    listen_event.data.fd = listen_fd_;
+    epoll_event stop_event{};
+    stop_event.events = EPOLLIN;
+    stop_event.data.fd = stop_fd_;
+    if (stop_fd_ < 0 || epoll_fd_ < 0 ||
+        epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, listen_fd_, &listen_event) != 0 ||
+        epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, stop_fd_, &stop_event) != 0)
+      err = errno;
+  }
+
+  if (err != 0)
+  {
+    // Los fds creados se cierran en stop(); el socket sólo se borra si es
+    // nuestro.
+    if (err != EADDRINUSE && listen_fd_ >= 0)
+      socket_path_ = socket_path;
+    stop();
+    if (error)
+      *error = err;
+    return false;
+  }
+
+  socket_path_ = socket_path;
+  thread_ = std::thread(&PrintDaemon::run, this);
+  return true;
+}
+
+void PrintDaemon::stop()
+{
+  if (thread_.joinable())
+  {
+    const uint64_t one = 1;
+    (void)!write(stop_fd_, &one, sizeof(one));
+    thread_.join();
+  }
+  clients_.clear();
+  std::map<std::string, std::shared_ptr<Device>> devices;
+  {
+    std::lock_guard<std::mutex> lock(devices_mutex_);
+    devices.swap(devices_);
+  }
+  devices.clear();
+  for (int *fd : {&epoll_fd_, &stop_fd_, &listen_fd_})
+  {
+    if (*fd >= 0)
+      ::close(*fd);
+    *fd = -1;
+  }
+  if (!socket_path_.empty())
+    unlink(socket_path_.c_str());
+  socket_path_.clear();
+}
+
+void PrintDaemon::run()
+{
+  epoll_event events[16];
+  for (;;)
+  {
+    const int ready = epoll_wait(epoll_fd_, events, 16, -1);
+    if (ready < 0)
+    {
+      if (errno == EINTR)
+        continue;
+      break;
+    }
+
+    bool stopping = false;
+    for (int i = 0; i < ready; i++)
+    {
+      const int fd = events[i].data.fd;
+      if (fd == stop_fd_)
+      {
+        stopping = true;
+      }
+      else if (fd == listen_fd_)
+      {
+        accept_clients();
+      }
+      else
+      {
+        auto it = clients_.find(fd);
+        if (it == clients_.end())
+          continue;
+        std::shared_ptr<Client> client = it->second;
+        if ((events[i].events & EPOLLIN) == 0 || !serve(client))
+        {
+          // Los trabajos del cliente que se fue se imprimen igual; sólo se
+          // descarta la respuesta.
+          epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+          {
+            std::lock_guard<std::mutex> lock(client->send_mutex);
+            client->closed = true;
+          }
+          clients_.erase(it);
+        }
+      }
+    }
+    if (stopping)
+      break;
+  }
+
+  for (auto &entry : clients_)
+  {
+    std::lock_guard<std::mutex> lock(entry.second->send_mutex);
+    entry.second->closed = true;
+  }
+}
+
+void PrintDaemon::accept_clients()
+{
+  for (;;)
+  {
+    const int fd = accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+    if (fd < 0)
+      return;
+    auto client = std::make_shared<Client>();
+    client->fd = fd;
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) != 0)
+      continue; // 'client' cierra el fd
+    clients_[fd] = std::move(client);
+  }
+}
+
+// Atiende un mensaje del cliente. false si la conexión hay que cerrarla.
+bool PrintDaemon::serve(const std::shared_ptr<Client> &client)
+{
+  std::vector<uint8_t> buffer(kMaxMessage);
+  int attached = -1;
+  const ssize_t received = receive_message(client->fd, buffer, &attached);
+  if (received < 0 && errno == EMSGSIZE)
+    return true; // mensaje descartado; sin id no hay a quién responder
+  if (received <= 0)
+    return false;
+
+  // Dueño del fd adjunto hasta que se lo pase a un MappedFile.
+  std::unique_ptr<int, void (*)(int *)> attached_guard(&attached, [](int *fd) {
+    if (*fd >= 0)
+      ::close(*fd);
+  });
+
+  DaemonHeader header;
+  if (static_cast<size_t>(received) < sizeof(header))
+    return false;
+  std::memcpy(&header, buffer.data(), sizeof(header));
+  if (header.magic != kDaemonMagic || header.path_length > kDaemonMaxPath ||
+      sizeof(header) + header.path_length + header.data_length !=
+          static_cast<size_t>(received))
+    return false;
+
+  const char *path_start = reinterpret_cast<const char *>(buffer.data() + sizeof(header));
+  const std::string path(path_start, header.path_length);
+  const uint8_t *data = buffer.data() + sizeof(header) + header.path_length;
+  const size_t length = header.data_length;
+  const uint32_t id = header.id;
+
+  int err = 0;
+  std::shared_ptr<Device> target = device(path, &err);
+  if (!target)
+  {
+    client->reply(id, err);
+    return true;
+  }
+
+  switch (static_cast<DaemonMessage>(header.type))
+  {
+  case DaemonMessage::kOpen:
+    client->reply(id, 0);
+    break;
+
+  case DaemonMessage::kPrint:
+  {
+    LaneWriter::BulkJob job;
+    if ((header.flags & kDaemonFlagFd) != 0)
+    {
+      // Un memfd sellado se mapea; el archivo de un cliente (print_fd) se
+      // lee con pread(): si lo truncan, el trabajo falla con EIO en lugar
+      // de tirar abajo el servicio con SIGBUS.
+      auto file = std::make_shared<MappedFile>();
+      const int fd = attached;
+      attached = -1;
+      if (fd < 0 || !file->adopt(fd, true, &err))
+      {
+        client->reply(id, fd < 0 ? EINVAL : err);
+        break;
+      }
+      job.view = file->data();
+      if (job.view == nullptr)
+        job.file = file->fd();
+      job.view_length = file->size();
+      MappedFile *mapped = file.get();
+      job.progress = [mapped](size_t written) { mapped->release(written); };
+      job.owner = std::move(file);
+    }
+    else if (length > 0)
+    {
+      job.data.assign(data, data + length);
+    }
+    else
+    {
+      client->reply(id, EINVAL);
+      break;
+    }
+
+    job.done = [client, id, failed = target->error](bool ok, int error) {
+      if (!ok && error != ECANCELED)
+        *failed = error != 0 ? error : EIO;
+      client->reply(id, ok ? 0 : (error != 0 ? error : EIO));
+    };
+    target->writer.submit(std::move(job));
+    break;
+  }
+
+  case DaemonMessage::kStatus:
+  {
+    if (length == 0)
+    {
+      client->reply(id, EINVAL);
+      break;
+    }
+    // realtime() bloquea hasta la respuesta: se espera en el hilo de
+    // consultas para no frenar al resto de los clientes.
+    const int timeout =
+        static_cast<int>(std::min(header.arg & kDaemonStatusTimeoutMask, kMaxStatusTimeoutMs));
+    const size_t expected = header.arg >> kDaemonStatusExpectedShift;
+    std::vector<uint8_t> command(data, data + length);
+    const bool queued = target->query(
+        [client, id, timeout, expected, command = std::move(command)](Device *device) {
+          if (!device)
+          {
+            client->reply(id, ECANCELED);
+            return;
+          }
+          int error = 0;
+          std::vector<uint8_t> reply = device->writer.realtime(
+              command.data(), command.size(), timeout > 0, timeout, &error, expected);
+          if (error != 0 && error != ETIMEDOUT)
+            *device->error = error;
+          client->reply(id, error, reply);
+        });
+    if (!queued)
+      client->reply(id, EBUSY);
+    break;
+  }
+
+  case DaemonMessage::kPortStatus:
+  {
+    // Es un control transfer, no pasa por el escritor: se contesta aunque
+    // haya un trabajo escribiéndose. El ioctl puede tardar lo que el USB,
+    // así que tampoco corre en el hilo del servicio.
+    const bool queued = target->query([client, id](Device *device) {
+      int error = ECANCELED;
+      UsblpStatus status;
+      if (device && usblp_get_status(device->fd, status, &error))
+        client->reply(id, 0, {static_cast<uint8_t>(status.raw)});
+      else
+        client->reply(id, error);
+    });
+    if (!queued)
+      client->reply(id, EBUSY);
+    break;
+  }
+
+  default:
+    client->reply(id, EINVAL);
+    break;
+  }
+  return true;
+}
+
+// Destruir un Device detiene su escritor y espera a su hilo de consultas,
+// que puede estar en un ioctl o esperando una respuesta (hasta
+// kMaxStatusTimeoutMs): eso pasa en un hilo aparte y no en el del servicio
+// ni con devices_mutex_ tomado.
+void PrintDaemon::retire(std::shared_ptr<Device> device)
+{
+  std::thread([device = std::move(device)]() mutable { device.reset(); }).detach();
+}
+
+// Dispositivo abierto para 'path', abriéndolo si hace falta. Uno que falló
+// se reabre (se fue) o vuelve a aceptar trabajos (error pasajero).
+std::shared_ptr<PrintDaemon::Device> PrintDaemon::device(const std::string &path,
+                                                          int *error)
+{
+  if (!allowed_device(path))
+  {
+    *error = EACCES;
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(devices_mutex_);
+  auto it = devices_.find(path);
+  if (it != devices_.end())
+  {
+    const int failed = it->second->error->exchange(0);
+    if (failed == 0)
+      return it->second;
+    if (!device_gone(failed))
+    {
+      it->second->writer.clear_error();
+      return it->second;
+    }
+    retire(std::move(it->second));
+    devices_.erase(it);
+  }
+
+  auto opened = std::make_shared<Device>();
+  opened->fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+  if (opened->fd < 0)
+  {
+    *error = errno;
+    return nullptr;
+  }
+  opened->writer.start(opened->fd);
+  devices_[path] = opened;
+  return opened;
+}
+
+// ===================== Cliente =====================
+
+PrintDaemonClient::~PrintDaemonClient()
+{
+  close();
+}
+
+bool PrintDaemonClient::connect(const std::string &socket_path)
+{
+  close();
+
+  sockaddr_un address;
+  if (!fill_address(socket_path, address))
+    return false;
+  const int fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+  if (fd < 0)
+    return false;
+  if (::connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0)
+  {
+    ::close(fd);
+    return false;
+  }
+
+  fd_ = fd;
+  connected_ = true;
+  reader_ = std::thread(&PrintDaemonClient::run_reader, this);
+  return true;
+}
+
+void PrintDaemonClient::close()
+{
+  if (fd_ >= 0)
+    shutdown(fd_, SHUT_RDWR); // despierta al lector
+  if (reader_.joinable())
+    reader_.join();
+  if (fd_ >= 0)
+    ::close(fd_);
+  fd_ = -1;
+  connected_ = false;
+  fail_pending(EPIPE);
+}
+
+void PrintDaemonClient::open(const std::string &device, ReplyCallback done)
+{
+  request(DaemonMessage::kOpen, device, nullptr, 0, -1, 0, std::move(done));
+}
+
+void PrintDaemonClient::print(const std::string &device, const uint8_t *data, size_t length,
+                              ReplyCallback done)
+{
+  if (length <= kDaemonInlineBytes)
+  {
+    request(DaemonMessage::kPrint, device, data, length, -1, 0, std::move(done));
+    return;
+  }
+  const int fd = sealed_memfd(data, length);
+  if (fd < 0)
+  {
+    done(errno != 0 ? errno : ENOMEM, {});
+    return;
+  }
+  request(DaemonMessage::kPrint, device, nullptr, 0, fd, 0, std::move(done));
+  ::close(fd);
+}
+
+void PrintDaemonClient::print_fd(const std::string &device, int fd, ReplyCallback done)
+{
+  request(DaemonMessage::kPrint, device, nullptr, 0, fd, 0, std::move(done));
+}
+
+void PrintDaemonClient::status(const std::string &device, const uint8_t *command,
+                               size_t length, int timeout_ms, size_t expected,
+                               ReplyCallback done)
+{
+  const uint32_t timeout =
+      std::min(static_cast<uint32_t>(std::max(timeout_ms, 0)), kDaemonStatusTimeoutMask);
+  const uint32_t count = static_cast<uint32_t>(std::min<size_t>(expected, 0xFFFF));
+  request(DaemonMessage::kStatus, device, command, length, -1,
+          timeout | count << kDaemonStatusExpectedShift, std::move(done));
+}
+
+int PrintDaemonClient::open_sync(const std::string &device, int timeout_ms)
+{
+  auto result = std::make_shared<std::promise<int>>();
+  std::future<int> future = result->get_future();
+  open(device, [result](int error, std::vector<uint8_t>) { result->set_value(error); });
+  if (future.wait_for(std::chrono::milliseconds(timeout_ms)) != std::future_status::ready)
+    return ETIMEDOUT;
+  return future.get();
+}
+
+int PrintDaemonClient::status_sync(const std::string &device, const uint8_t *command,
+                                   size_t length, int timeout_ms, size_t expected,
+                                   std::vector<uint8_t> &reply)
+{
+  using Reply = std::pair<int, std::vector<uint8_t>>;
+  auto result = std::make_shared<std::promise<Reply>>();
+  std::future<Reply> future = result->get_future();
+  status(device, command, length, timeout_ms, expected,
+         [result](int error, std::vector<uint8_t> bytes) {
+           result->set_value(Reply(error, std::move(bytes)));
+         });
+  // El servicio puede tener que esperar a que termine el bloque en curso.
+  if (future.wait_for(std::chrono::milliseconds(timeout_ms + 1000)) !=
+      std::future_status::ready)
+    return ETIMEDOUT;
+  Reply value = future.get();
+  reply = std::move(value.second);
+  return value.first;
+}
+
+int PrintDaemonClient::port_status_sync(const std::string &device, int timeout_ms, int &raw)
+{
+  using Reply = std::pair<int, std::vector<uint8_t>>;
+  auto result = std::make_shared<std::promise<Reply>>();
+  std::future<Reply> future = result->get_future();
+  request(DaemonMessage::kPortStatus, device, nullptr, 0, -1, 0,
+          [result](int error, std::vector<uint8_t> bytes) {
+            result->set_value(Reply(error, std::move(bytes)));
+          });
+  if (future.wait_for(std::chrono::milliseconds(timeout_ms)) != std::future_status::ready)
+    return ETIMEDOUT;
+  Reply value = future.get();
+  if (value.first == 0 && value.second.size() != 1)
+    return EPROTO;
+  if (value.first == 0)
+    raw = value.second[0];
+  return value.first;
+}
+
+void PrintDaemonClient::request(DaemonMessage type, const std::string &device,
+                                const uint8_t *data, size_t length, int fd, uint32_t arg,
+                                ReplyCallback done)
+{
+  if (device.size() > kDaemonMaxPath || length > kDaemonInlineBytes)
+  {
+    done(EINVAL, {});
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (!connected_)
+  {
+    lock.unlock();
+    done(EPIPE, {});
+    return;
+  }
+
+  const uint32_t id = next_id_++;
+  DaemonHeader header{kDaemonMagic, static_cast<uint16_t>(type),
+                      static_cast<uint16_t>(fd >= 0 ? kDaemonFlagFd : 0), id, arg,
+                      static_cast<uint32_t>(device.size()), static_cast<uint32_t>(length)};
+  pending_[id] = std::move(done);
+  if (!send_message(fd_, header, device, data, length, fd))
+  {
+    ReplyCallback failed = std::move(pending_[id]);
+    pending_.erase(id);
+    lock.unlock();
+    failed(EPIPE, {});
+  }
+}
+
+void PrintDaemonClient::run_reader()
+{
+  std::vector<uint8_t> buffer(kMaxMessage);
+  for (;;)
+  {
+    int attached = -1;
+    const ssize_t received = receive_message(fd_, buffer, &attached);
+    if (attached >= 0)
+      ::close(attached);
+    if (received < 0 && errno == EMSGSIZE)
+      continue;
+    if (received <= 0)
+      break;
+
+    DaemonHeader header;
+    if (static_cast<size_t>(received) < sizeof(header))
+      break;
+    std::memcpy(&header, buffer.data(), sizeof(header));
+    if (header.magic != kDaemonMagic ||
+        header.type != static_cast<uint16_t>(DaemonMessage::kResult) ||
+        sizeof(header) + header.path_length + header.data_length !=
+            static_cast<size_t>(received))
+      break;
+
+    ReplyCallback done;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = pending_.find(header.id);
+      if (it == pending_.end())
+        continue;
+      done = std::move(it->second);
+      pending_.erase(it);
+    }
+    const uint8_t *data = buffer.data() + sizeof(header) + header.path_length;
+    done(static_cast<int>(header.arg),
+         std::vector<uint8_t>(data, data + header.data_length));
+  }
+
+  // El servicio se cerró (o se reinicia): lo pendiente falla y la próxima
+  // apertura decide si vuelve a conectarse.
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    connected_ = false;
+  }
+  fail_pending(EPIPE);
+}
+
+void PrintDaemonClient::fail_pending(int error)
+{
+  std::map<uint32_t, ReplyCallback> failed;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    failed.swap(pending_);
+  }
+  for (auto &entry : failed)
+    entry.second(error, {});
+}
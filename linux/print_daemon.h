@@ -0,0 +1,158 @@
+#ifndef FLUTTER_PLUGIN_TI_PRINTER_PRINT_DAEMON_H_
+#define FLUTTER_PLUGIN_TI_PRINTER_PRINT_DAEMON_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Servicio local dueño de las impresoras USB.
+//
+// Sin servicio, cada proceso que carga el plugin abre /dev/usb/lp* por su
+// cuenta: dos apps en la misma terminal (caja y pantalla de cocina) se
+// pisan el dispositivo. ti_printer_daemon abre cada impresora una sola vez,
+// la deja abierta entre trabajos y serializa a todos los clientes con un
+// LaneWriter por dispositivo (los comandos de tiempo real siguen pasando
+// por delante de los trabajos).
+//
+// Protocolo: socket Unix SOCK_SEQPACKET (cada mensaje llega entero). Un
+// mensaje es DaemonHeader + ruta del dispositivo + datos. Los datos de más
+// de kDaemonInlineBytes no van en el mensaje: el cliente los deja en un
+// memfd sellado (o pasa el fd de un archivo) con SCM_RIGHTS, sin copiarlos
+// por el socket. El servicio mapea el memfd; un archivo, que el cliente
+// podría truncar, lo lee con pread().
+
+constexpr uint32_t kDaemonMagic = 0x44504954; // "TIPD"
+constexpr size_t kDaemonInlineBytes = 16 * 1024;
+constexpr size_t kDaemonMaxPath = 256;
+
+enum class DaemonMessage : uint16_t
+{
+  kOpen = 1,       // abrir (o reusar) el dispositivo; sin datos
+  kPrint = 2,      // trabajo por bloques; responde al terminar de escribirse
+  kStatus = 3,     // comando de tiempo real; 'arg': ver kDaemonStatusExpectedShift
+  kPortStatus = 4, // LPGETSTATUS de usblp; la respuesta es el byte crudo
+  kResult = 0x80,
+};
+
+constexpr uint16_t kDaemonFlagFd = 1; // los datos vienen en el fd adjunto
+
+// 'arg' de kStatus: ms de espera de la respuesta en los 16 bits bajos (0 =
+// no leer) y bytes de respuesta esperados en los altos (0 = la primera
+// lectura con datos).
+constexpr uint32_t kDaemonStatusExpectedShift = 16;
+constexpr uint32_t kDaemonStatusTimeoutMask = 0xFFFF;
+
+struct DaemonHeader
+{
+  uint32_t magic;
+  uint16_t type;  // DaemonMessage
+  uint16_t flags;
+  uint32_t id;    // del pedido; la respuesta lo repite
+  uint32_t arg;   // kStatus: timeout; kResult: errno (0 = ok)
+  uint32_t path_length;
+  uint32_t data_length; // bytes después de la ruta (0 si vienen en un fd)
+};
+
+// $TI_PRINTER_DAEMON_SOCKET, o $XDG_RUNTIME_DIR/ti_printer_daemon.sock, o
+// /tmp/ti_printer_daemon-<uid>.sock.
+std::string print_daemon_socket_path();
+
+// El servicio. Atiende los sockets en un hilo propio; cada dispositivo
+// tiene su hilo de escritura.
+class PrintDaemon
+{
+public:
+  PrintDaemon() = default;
+  ~PrintDaemon();
+
+  PrintDaemon(const PrintDaemon &) = delete;
+  PrintDaemon &operator=(const PrintDaemon &) = delete;
+
+  // Crea el socket (0600) y empieza a atender. Falla con EADDRINUSE si ya
+  // hay otro servicio escuchando en 'socket_path'.
+  bool start(const std::string &socket_path, int *error);
+
+  // Deja de atender, cancela lo que quedó en cola y cierra los dispositivos.
+  void stop();
+
+private:
+  struct Client;
+  struct Device;
+
+  void run();
+  void accept_clients();
+  bool serve(const std::shared_ptr<Client> &client);
+  std::shared_ptr<Device> device(const std::string &path, int *error);
+  static void retire(std::shared_ptr<Device> device);
+
+  int listen_fd_ = -1;
+  int stop_fd_ = -1; // eventfd que despierta al hilo en stop()
+  int epoll_fd_ = -1;
+  std::string socket_path_;
+  std::thread thread_;
+  std::map<int, std::shared_ptr<Client>> clients_; // sólo hilo del servicio
+  std::mutex devices_mutex_;
+  std::map<std::string, std::shared_ptr<Device>> devices_;
+};
+
+// Conexión del plugin con el servicio. Los pedidos no bloquean: la
+// respuesta llega a 'done' desde el hilo lector de la conexión.
+class PrintDaemonClient
+{
+public:
+  // 'error' es el errno del servicio (o EPIPE si se cortó la conexión);
+  // 'reply' trae la respuesta de kStatus.
+  using ReplyCallback = std::function<void(int error, std::vector<uint8_t> reply)>;
+
+  PrintDaemonClient() = default;
+  ~PrintDaemonClient();
+
+  PrintDaemonClient(const PrintDaemonClient &) = delete;
+  PrintDaemonClient &operator=(const PrintDaemonClient &) = delete;
+
+  // false si no hay servicio escuchando.
+  bool connect(const std::string &socket_path);
+  bool connected() const { return connected_; }
+
+  // Los pedidos pendientes terminan con EPIPE.
+  void close();
+
+  void open(const std::string &device, ReplyCallback done);
+  void print(const std::string &device, const uint8_t *data, size_t length,
+             ReplyCallback done);
+  // El servicio recibe una copia de 'fd' (un archivo regular) y lo lee por
+  // bloques; el que llama sigue siendo dueño del suyo.
+  void print_fd(const std::string &device, int fd, ReplyCallback done);
+  void status(const std::string &device, const uint8_t *command, size_t length,
+              int timeout_ms, size_t expected, ReplyCallback done);
+
+  // Versiones que esperan la respuesta (hasta 'timeout_ms'; ETIMEDOUT si no
+  // llega).
+  int open_sync(const std::string &device, int timeout_ms);
+  int status_sync(const std::string &device, const uint8_t *command, size_t length,
+                  int timeout_ms, size_t expected, std::vector<uint8_t> &reply);
+  // Estado del puerto (LPGETSTATUS) en 'raw'; ENOTTY si no es usblp.
+  int port_status_sync(const std::string &device, int timeout_ms, int &raw);
+
+private:
+  void request(DaemonMessage type, const std::string &device, const uint8_t *data,
+               size_t length, int fd, uint32_t arg, ReplyCallback done);
+  void run_reader();
+  void fail_pending(int error);
+
+  int fd_ = -1;
+  std::atomic<bool> connected_{false};
+  std::thread reader_;
+  std::mutex mutex_; // envío y 'pending_'
+  std::map<uint32_t, ReplyCallback> pending_;
+  uint32_t next_id_ = 1;
+};
+
+#endif // FLUTTER_PLUGIN_TI_PRINTER_PRINT_DAEMON_H_
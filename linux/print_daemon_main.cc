@@ -0,0 +1,46 @@
+// ti_printer_daemon: dueño de las impresoras USB de la terminal. Los
+// procesos con el plugin lo usan si está corriendo (ver print_daemon.h).
+//
+//   ti_printer_daemon [ruta del socket]
+//
+// Sin argumento escucha en print_daemon_socket_path(). Termina con SIGINT o
+// SIGTERM.
+
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+
+#include <pthread.h>
+
+#include "print_daemon.h"
+
+int main(int argc, char **argv)
+{
+  const std::string socket_path = argc > 1 ? argv[1] : print_daemon_socket_path();
+
+  // Las señales se esperan con sigwait; los hilos del servicio las heredan
+  // bloqueadas. SIGPIPE nunca: las escrituras a sockets usan MSG_NOSIGNAL.
+  sigset_t signals;
+  sigemptyset(&signals);
+  sigaddset(&signals, SIGINT);
+  sigaddset(&signals, SIGTERM);
+  sigaddset(&signals, SIGPIPE);
+  pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+  PrintDaemon daemon;
+  int error = 0;
+  if (!daemon.start(socket_path, &error))
+  {
+    std::fprintf(stderr, "ti_printer_daemon: %s: %s\n", socket_path.c_str(),
+                 std::strerror(error));
+    return 1;
+  }
+  std::fprintf(stderr, "ti_printer_daemon: escuchando en %s\n", socket_path.c_str());
+
+  sigdelset(&signals, SIGPIPE);
+  int received = 0;
+  sigwait(&signals, &received);
+
+  daemon.stop();
+  return 0;
+}
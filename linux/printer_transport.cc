@@ -0,0 +1,263 @@
+#include "printer_transport.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/types.h>
+
+#include <algorithm>
+#include <future>
+#include <mutex>
+
+#include "core_log.h"
+#include "lane_writer.h"
+#include "tcp_transport.h"
+#include "usblp.h"
+
+namespace
+{
+
+// Nodo USB (o serie) abierto con el mismo LaneWriter que usa el plugin: una
+// consulta de estado sale en el próximo límite de bloque aunque haya un
+// write() largo en curso desde otro hilo.
+class UsbTransport : public PrinterTransport
+{
+public:
+  explicit UsbTransport(int fd) : fd_(fd) { writer_.start(fd); }
+  ~UsbTransport() override { close(); }
+
+  int write(const uint8_t *data, size_t length) override
+  {
+    if (length == 0)
+      return 0;
+    std::promise<int> result;
+    LaneWriter::BulkJob job;
+    job.data.assign(data, data + length);
+    job.done = [&result](bool ok, int error) { result.set_value(ok ? 0 : (error ? error : EIO)); };
+    std::future<int> done = result.get_future();
+    writer_.submit(std::move(job));
+    const int error = done.get();
+    // Sin carril de trabajos no hay cola que cuidar: el próximo write()
+    // vuelve a intentar (si el fd se perdió, falla de nuevo con ENODEV).
+    if (error != 0 && error != ENODEV)
+      writer_.clear_error();
+    return error;
+  }
+
+  std::vector<uint8_t> transact(const uint8_t *command, size_t length,
+                                int timeout_ms, size_t expected, int &error) override
+  {
+    error = 0;
+    return writer_.realtime(command, length, timeout_ms > 0, timeout_ms, &error, expected);
+  }
+
+  int port_status(int &raw) override
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    UsblpStatus status;
+    int error = 0;
+    if (!usblp_get_status(fd_, status, &error))
+      return error;
+    raw = status.raw;
+    return 0;
+  }
+
+  void close() override
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fd_ < 0)
+      return;
+    writer_.stop(true);
+    fsync(fd_);
+    ::close(fd_);
+    fd_ = -1;
+  }
+
+private:
+  LaneWriter writer_;
+  std::mutex mutex_; // fd_ frente a close()
+  int fd_;
+};
+
+// TcpConnection no es segura entre hilos: una operación a la vez.
+class TcpTransport : public PrinterTransport
+{
+public:
+  explicit TcpTransport(const TcpConnection &conn) : conn_(conn) {}
+  ~TcpTransport() override { close(); }
+
+  int write(const uint8_t *data, size_t length) override
+  {
+    if (length == 0)
+      return 0;
+    std::lock_guard<std::mutex> lock(mutex_);
+    errno = 0;
+    if (tcp_send(conn_, data, length))
+      return 0;
+    return errno ? errno : EIO;
+  }
+
+  int send_file(int file_fd, size_t length,
+                const std::function<bool(size_t sent)> &progress) override
+  {
+    if (length == 0)
+      return 0;
+    std::lock_guard<std::mutex> lock(mutex_);
+    bool canceled = false;
+    errno = 0;
+    if (tcp_send_file(conn_, file_fd, length, [&](size_t sent) {
+          canceled = progress && !progress(sent);
+          return !canceled;
+        }))
+      return 0;
+    if (canceled)
+      return ECANCELED;
+    return errno ? errno : EIO;
+  }
+
+  std::vector<uint8_t> transact(const uint8_t *command, size_t length,
+                                int timeout_ms, size_t expected, int &error) override
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    error = conn_.fd < 0 ? ENOTCONN : 0;
+    if (error)
+      return {};
+    return tcp_read_status(conn_, std::vector<uint8_t>(command, command + length), expected,
+                           timeout_ms);
+  }
+
+  void close() override
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tcp_close(conn_);
+  }
+
+private:
+  std::mutex mutex_;
+  TcpConnection conn_;
+};
+
+// Lo que se lee del archivo por vez en send_file() sin sendfile().
+constexpr size_t kFileChunk = 64 * 1024;
+
+// Respuestas de estado y de GS I: con esto sobra.
+constexpr size_t kMaxReply = 512;
+
+class ForeignTransport : public PrinterTransport
+{
+public:
+  explicit ForeignTransport(const TiPrinterTransport &transport) : transport_(transport) {}
+  ~ForeignTransport() override { close(); }
+
+  int write(const uint8_t *data, size_t length) override
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (closed_)
+      return EBADF;
+    return length == 0 ? 0 : transport_.write(transport_.context, data, length);
+  }
+
+  std::vector<uint8_t> transact(const uint8_t *command, size_t length,
+                                int timeout_ms, size_t expected, int &error) override
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    error = closed_ ? EBADF : 0;
+    if (error || !transport_.transact)
+      return {};
+    std::vector<uint8_t> reply(kMaxReply);
+    const int n = transport_.transact(transport_.context, command, length, timeout_ms,
+                                      expected, reply.data(), reply.size());
+    if (n < 0)
+    {
+      error = -n;
+      return {};
+    }
+    reply.resize(std::min(static_cast<size_t>(n), reply.size()));
+    return reply;
+  }
+
+  void close() override
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (closed_)
+      return;
+    closed_ = true;
+    if (transport_.close)
+      transport_.close(transport_.context);
+  }
+
+private:
+  std::mutex mutex_;
+  TiPrinterTransport transport_;
+  bool closed_ = false;
+};
+
+} // namespace
+
+int PrinterTransport::send_file(int file_fd, size_t length,
+                                const std::function<bool(size_t sent)> &progress)
+{
+  std::vector<uint8_t> chunk(std::min(length, kFileChunk));
+  size_t sent = 0;
+  while (sent < length)
+  {
+    const ssize_t n = pread(file_fd, chunk.data(), std::min(chunk.size(), length - sent),
+                            static_cast<off_t>(sent));
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return n == 0 ? EIO : errno; // el archivo se achicó
+    const int error = write(chunk.data(), static_cast<size_t>(n));
+    if (error != 0)
+      return error;
+    sent += static_cast<size_t>(n);
+    if (progress && !progress(sent))
+      return ECANCELED;
+  }
+  return 0;
+}
+
+int PrinterTransport::port_status(int &raw)
+{
+  (void)raw;
+  return ENOTSUP;
+}
+
+std::unique_ptr<PrinterTransport> open_usb_transport(const std::string &path, int &error)
+{
+  int fd = open(path.c_str(), O_RDWR);
+  if (fd < 0)
+  {
+    error = errno;
+    core_log("No se pudo abrir %s: %s\n", path.c_str(), core_strerror(error));
+    return nullptr;
+  }
+  error = 0;
+  return std::make_unique<UsbTransport>(fd);
+}
+
+std::unique_ptr<PrinterTransport> open_tcp_transport(const std::string &host, int port,
+                                                     int &error)
+{
+  TcpConnection conn;
+  errno = 0;
+  if (!tcp_open(conn, host, port > 0 ? port : kTcpDefaultPort))
+  {
+    error = errno ? errno : EHOSTUNREACH;
+    return nullptr;
+  }
+  error = 0;
+  return std::make_unique<TcpTransport>(conn);
+}
+
+std::unique_ptr<PrinterTransport> adopt_transport(const TiPrinterTransport &transport,
+                                                  int &error)
+{
+  if (!transport.write)
+  {
+    error = EINVAL;
+    return nullptr;
+  }
+  error = 0;
+  return std::make_unique<ForeignTransport>(transport);
+}
@@ -0,0 +1,61 @@
+#ifndef FLUTTER_PLUGIN_TI_PRINTER_PRINTER_TRANSPORT_H_
+#define FLUTTER_PLUGIN_TI_PRINTER_PRINTER_TRANSPORT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "include/ti_printer_core/ti_printer_core.h"
+
+// Por dónde le llegan los bytes a una impresora abierta con la API C de
+// ti_printer_core (include/ti_printer_core/ti_printer_core.h).
+//
+// Hay tres: USB (nodo /dev/... con LaneWriter, así el estado no espera al
+// trabajo), TCP (TcpConnection) y el de quien embebe el núcleo
+// (TiPrinterTransport, punteros a función). El resto del núcleo sólo ve
+// esta interfaz. Todas se pueden usar desde varios hilos.
+class PrinterTransport
+{
+public:
+  virtual ~PrinterTransport() = default;
+
+  // Escribe todo 'data' y espera a que salga. 0 o errno.
+  virtual int write(const uint8_t *data, size_t length) = 0;
+
+  // Escribe 'command' y devuelve la respuesta de los próximos 'timeout_ms'
+  // (con 'expected', hasta juntar esa cantidad; ver device_transact).
+  // 'error' recibe el errno si la escritura falló (0 si no).
+  virtual std::vector<uint8_t> transact(const uint8_t *command, size_t length,
+                                        int timeout_ms, size_t expected,
+                                        int &error) = 0;
+
+  // Escribe los primeros 'length' bytes de 'file_fd' (con pread, o
+  // sendfile() en TCP). 'progress' recibe los bytes enviados y devuelve
+  // false para cancelar (ECANCELED). 0 o errno.
+  virtual int send_file(int file_fd, size_t length,
+                        const std::function<bool(size_t sent)> &progress);
+
+  // LPGETSTATUS (sólo usblp). 0 o errno; ENOTSUP si el transporte no
+  // tiene un canal aparte del stream.
+  virtual int port_status(int &raw);
+
+  // Espera lo pendiente y suelta el dispositivo. Idempotente; el
+  // destructor lo llama.
+  virtual void close() = 0;
+};
+
+// nullptr si no se pudo abrir (errno en 'error').
+std::unique_ptr<PrinterTransport> open_usb_transport(const std::string &path,
+                                                     int &error);
+std::unique_ptr<PrinterTransport> open_tcp_transport(const std::string &host,
+                                                     int port, int &error);
+
+// Adopta 'transport' (y su 'context'). nullptr con EINVAL si no tiene
+// 'write'.
+std::unique_ptr<PrinterTransport> adopt_transport(const TiPrinterTransport &transport,
+                                                  int &error);
+
+#endif // FLUTTER_PLUGIN_TI_PRINTER_PRINTER_TRANSPORT_H_
@@ -0,0 +1,400 @@
+#include "raster_cache.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "checksum.h"
+#include "file_lock.h"
+
+namespace
+{
+
+constexpr char kMagic[8] = {'T', 'I', 'R', 'C', 'A', 'C', 'H', '1'};
+constexpr uint32_t kRecordMagic = 0x31545352; // "RST1"
+
+size_t align8(size_t n)
+{
+  return (n + 7) & ~static_cast<size_t>(7);
+}
+
+} // namespace
+
+struct RasterCache::FileHeader
+{
+  char magic[8];
+  uint64_t used;
+  uint64_t generation; // cambia al compactar o vaciar
+};
+
+struct RasterCache::Record
+{
+  uint32_t magic;
+  uint32_t crc;
+  uint64_t hash;
+  uint64_t source_length;
+  int32_t width;
+  uint8_t dither;
+  uint8_t command;
+  uint8_t density;
+  uint8_t pad;
+  uint64_t length;
+
+  size_t total_size() const { return align8(sizeof(Record) + length); }
+  const uint8_t *payload() const { return reinterpret_cast<const uint8_t *>(this + 1); }
+  RasterCacheKey key() const
+  {
+    RasterCacheKey k;
+    k.hash = hash;
+    k.source_length = source_length;
+    k.width = width;
+    k.dither = dither;
+    k.command = command;
+    k.density = density;
+    return k;
+  }
+};
+
+RasterCacheKey raster_cache_key(const uint8_t *source, size_t length, int width,
+                                uint8_t dither, uint8_t command, uint8_t density)
+{
+  RasterCacheKey key;
+  key.hash = hash64(source, length);
+  key.source_length = length;
+  key.width = width;
+  key.dither = dither;
+  key.command = command;
+  key.density = density;
+  return key;
+}
+
+RasterCache::RasterCache(size_t memory_budget, size_t disk_capacity)
+    : memory_budget_(memory_budget),
+      disk_capacity_(std::max(disk_capacity, sizeof(FileHeader) + 4096))
+{
+}
+
+RasterCache::~RasterCache()
+{
+  close();
+}
+
+bool RasterCache::open(const std::string &path)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (fd_ >= 0)
+    return true;
+
+  const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+  if (fd < 0)
+    return false;
+
+  {
+    FileLock file_lock(fd);
+    struct stat st{};
+    fstat(fd, &st);
+    const size_t size = static_cast<size_t>(st.st_size);
+    void *mem = MAP_FAILED;
+    if (ftruncate(fd, static_cast<off_t>(disk_capacity_)) == 0)
+      mem = mmap(nullptr, disk_capacity_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mem != MAP_FAILED)
+    {
+      fd_ = fd;
+      base_ = static_cast<uint8_t *>(mem);
+      index_disk_locked(size);
+      return true;
+    }
+  }
+  ::close(fd);
+  return false;
+}
+
+// Con el archivo recién mapeado (y bloqueado): lo inicializa si es nuevo o
+// irreconocible, indexa los registros y descarta lo que sigue al primero
+// incompleto o corrupto.
+void RasterCache::index_disk_locked(size_t size)
+{
+  auto *hdr = reinterpret_cast<FileHeader *>(base_);
+  if (size < sizeof(FileHeader) || std::memcmp(hdr->magic, kMagic, sizeof(kMagic)) != 0 ||
+      hdr->used < sizeof(FileHeader) || hdr->used > disk_capacity_)
+  {
+    reset_disk_locked();
+    return;
+  }
+
+  generation_ = hdr->generation;
+  indexed_ = sizeof(FileHeader);
+  refresh_index_locked();
+  if (indexed_ < hdr->used)
+  {
+    hdr->used = indexed_;
+    sync_range(0, sizeof(FileHeader));
+  }
+}
+
+void RasterCache::close()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (base_)
+  {
+    msync(base_, disk_capacity_, MS_SYNC);
+    munmap(base_, disk_capacity_);
+    base_ = nullptr;
+  }
+  if (fd_ >= 0)
+  {
+    ::close(fd_);
+    fd_ = -1;
+  }
+  disk_.clear();
+}
+
+void RasterCache::sync_range(size_t offset, size_t length)
+{
+  // Asíncrono: es una caché, y al abrir se valida cada registro por CRC.
+  const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  const size_t start = offset & ~(page - 1);
+  msync(base_ + start, offset + length - start, MS_ASYNC);
+}
+
+void RasterCache::reset_disk_locked()
+{
+  auto *hdr = reinterpret_cast<FileHeader *>(base_);
+  const uint64_t generation = hdr->generation + 1;
+  std::memset(base_, 0, sizeof(FileHeader));
+  std::memcpy(hdr->magic, kMagic, sizeof(kMagic));
+  hdr->used = sizeof(FileHeader);
+  hdr->generation = generation;
+  sync_range(0, sizeof(FileHeader));
+  disk_.clear();
+  generation_ = generation;
+  indexed_ = sizeof(FileHeader);
+}
+
+// El registro en 'offset' si está entero dentro de lo commiteado y su
+// payload coincide con el CRC; si no, nullptr.
+const RasterCache::Record *RasterCache::record_at_locked(size_t offset) const
+{
+  const auto *hdr = reinterpret_cast<const FileHeader *>(base_);
+  const size_t used = std::min<size_t>(hdr->used, disk_capacity_);
+  if (offset < sizeof(FileHeader) || offset + sizeof(Record) > used)
+    return nullptr;
+  const auto *rec = reinterpret_cast<const Record *>(base_ + offset);
+  if (rec->magic != kRecordMagic || rec->length > used - offset - sizeof(Record) ||
+      offset + rec->total_size() > used ||
+      crc32(rec->payload(), rec->length) != rec->crc)
+    return nullptr;
+  return rec;
+}
+
+// Con el flock tomado: otro proceso pudo agregar registros (se indexan) o
+// compactar/vaciar el archivo (otra generación: los offsets de disk_ ya no
+// valen y se indexa de nuevo).
+void RasterCache::refresh_index_locked()
+{
+  const auto *hdr = reinterpret_cast<const FileHeader *>(base_);
+  if (hdr->generation != generation_ || hdr->used < indexed_)
+  {
+    disk_.clear();
+    generation_ = hdr->generation;
+    indexed_ = sizeof(FileHeader);
+  }
+  while (const Record *rec = record_at_locked(indexed_))
+  {
+    disk_.emplace(rec->key(), DiskEntry{indexed_, 0});
+    indexed_ += rec->total_size();
+  }
+}
+
+bool RasterCache::lookup(const RasterCacheKey &key, std::vector<uint8_t> &out)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = memory_.find(key);
+  if (it != memory_.end())
+  {
+    lru_.splice(lru_.begin(), lru_, it->second);
+    out = *it->second->bytes;
+    hits_++;
+    return true;
+  }
+
+  if (read_disk_locked(key, out))
+  {
+    remember_locked(key, std::make_shared<const std::vector<uint8_t>>(out));
+    hits_++;
+    return true;
+  }
+
+  misses_++;
+  return false;
+}
+
+void RasterCache::store(const RasterCacheKey &key, const std::vector<uint8_t> &bytes)
+{
+  if (bytes.empty())
+    return;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (memory_.count(key) == 0)
+    remember_locked(key, std::make_shared<const std::vector<uint8_t>>(bytes));
+  write_disk_locked(key, bytes);
+}
+
+void RasterCache::remember_locked(const RasterCacheKey &key,
+                                  std::shared_ptr<const std::vector<uint8_t>> bytes)
+{
+  // Una entrada más grande que todo el presupuesto sólo vive en disco.
+  if (bytes->size() > memory_budget_)
+    return;
+
+  lru_.push_front(MemoryEntry{key, bytes});
+  memory_[key] = lru_.begin();
+  memory_bytes_ += bytes->size();
+
+  while (memory_bytes_ > memory_budget_ && !lru_.empty())
+  {
+    MemoryEntry &victim = lru_.back();
+    memory_bytes_ -= victim.bytes->size();
+    memory_.erase(victim.key);
+    lru_.pop_back();
+  }
+}
+
+bool RasterCache::read_disk_locked(const RasterCacheKey &key, std::vector<uint8_t> &out)
+{
+  if (!base_)
+    return false;
+  FileLock file_lock(fd_, true);
+  refresh_index_locked();
+  auto it = disk_.find(key);
+  if (it == disk_.end())
+    return false;
+
+  const Record *rec = record_at_locked(it->second.offset);
+  if (!rec || !(rec->key() == key))
+  {
+    disk_.erase(it);
+    return false;
+  }
+  out.assign(rec->payload(), rec->payload() + rec->length);
+  it->second.last_use = ++clock_;
+  return true;
+}
+
+void RasterCache::write_disk_locked(const RasterCacheKey &key,
+                                    const std::vector<uint8_t> &bytes)
+{
+  const size_t total = align8(sizeof(Record) + bytes.size());
+  // Nunca más de la mitad del archivo por entrada, para que compactar sirva.
+  if (!base_ || total > (disk_capacity_ - sizeof(FileHeader)) / 2)
+    return;
+
+  FileLock file_lock(fd_);
+  refresh_index_locked();
+  if (disk_.count(key) > 0)
+    return;
+
+  auto *hdr = reinterpret_cast<FileHeader *>(base_);
+  if (hdr->used + total > disk_capacity_)
+    compact_locked(total);
+
+  const size_t offset = hdr->used;
+  auto *rec = reinterpret_cast<Record *>(base_ + offset);
+  rec->magic = kRecordMagic;
+  rec->crc = crc32(bytes.data(), bytes.size());
+  rec->hash = key.hash;
+  rec->source_length = key.source_length;
+  rec->width = key.width;
+  rec->dither = key.dither;
+  rec->command = key.command;
+  rec->density = key.density;
+  rec->pad = 0;
+  rec->length = bytes.size();
+  std::memcpy(rec + 1, bytes.data(), bytes.size());
+  sync_range(offset, total);
+
+  // Commit: recién ahora el registro cuenta al volver a abrir.
+  hdr->used = offset + total;
+  sync_range(0, sizeof(FileHeader));
+  disk_[key] = DiskEntry{offset, ++clock_};
+  indexed_ = hdr->used;
+}
+
+// Reescribe el archivo con las entradas usadas más recientemente hasta la
+// mitad de la capacidad (dejando lugar para 'needed' bytes más).
+void RasterCache::compact_locked(size_t needed)
+{
+  std::vector<std::pair<RasterCacheKey, DiskEntry>> entries(disk_.begin(), disk_.end());
+  std::sort(entries.begin(), entries.end(), [](const auto &a, const auto &b) {
+    return a.second.last_use > b.second.last_use;
+  });
+
+  const size_t room = disk_capacity_ - sizeof(FileHeader);
+  const size_t keep_limit = room / 2 > needed ? room / 2 - needed : 0;
+  std::vector<uint8_t> kept;
+  std::vector<std::pair<RasterCacheKey, uint64_t>> kept_entries;
+  for (const auto &entry : entries)
+  {
+    const Record *rec = record_at_locked(entry.second.offset);
+    if (!rec)
+      continue;
+    const size_t total = rec->total_size();
+    if (kept.size() + total > keep_limit)
+      continue;
+    const uint8_t *start = base_ + entry.second.offset;
+    kept.insert(kept.end(), start, start + total);
+    kept_entries.emplace_back(entry.first, entry.second.last_use);
+  }
+
+  auto *hdr = reinterpret_cast<FileHeader *>(base_);
+  // Primero se invalida el contenido (used) y se pasa a otra generación,
+  // después se reescribe.
+  hdr->used = sizeof(FileHeader);
+  hdr->generation++;
+  sync_range(0, sizeof(FileHeader));
+  std::memcpy(base_ + sizeof(FileHeader), kept.data(), kept.size());
+  sync_range(sizeof(FileHeader), kept.size());
+  hdr->used = sizeof(FileHeader) + kept.size();
+  sync_range(0, sizeof(FileHeader));
+  generation_ = hdr->generation;
+  indexed_ = hdr->used;
+
+  disk_.clear();
+  size_t pos = sizeof(FileHeader);
+  for (const auto &entry : kept_entries)
+  {
+    disk_[entry.first] = DiskEntry{pos, entry.second};
+    pos += reinterpret_cast<const Record *>(base_ + pos)->total_size();
+  }
+}
+
+void RasterCache::clear()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  lru_.clear();
+  memory_.clear();
+  memory_bytes_ = 0;
+  if (base_)
+  {
+    FileLock file_lock(fd_);
+    reset_disk_locked();
+  }
+}
+
+RasterCacheStats RasterCache::stats()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  RasterCacheStats s;
+  s.hits = hits_;
+  s.misses = misses_;
+  s.memory_entries = lru_.size();
+  s.memory_bytes = memory_bytes_;
+  s.disk_entries = disk_.size();
+  if (base_)
+    s.disk_bytes = reinterpret_cast<const FileHeader *>(base_)->used;
+  return s;
+}
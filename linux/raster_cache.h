@@ -0,0 +1,141 @@
+#ifndef FLUTTER_PLUGIN_TI_PRINTER_RASTER_CACHE_H_
+#define FLUTTER_PLUGIN_TI_PRINTER_RASTER_CACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Caché de imágenes ya convertidas a comandos (GS v 0 / GS ( L).
+//
+// La clave es el contenido: hash + largo de los bytes originales (PNG,
+// JPEG...) más los parámetros de conversión. Logos, banners y QR fijos se
+// convierten una sola vez; un acierto devuelve el stream exacto sin
+// decodificar ni hacer dither.
+//
+// Dos niveles:
+//   - memoria: LRU acotado por bytes;
+//   - disco: archivo mapeado (MAP_SHARED) de tamaño fijo que sobrevive a
+//     reinicios. Append-only; cuando se llena se compacta dejando las
+//     entradas usadas más recientemente.
+//
+// Layout del archivo:
+//   FileHeader | Record | payload | padding(8) | Record | ...
+// 'used' en el header es el punto de commit, como en el spool.
+//
+// El archivo es uno por usuario y lo comparten todas las apps; el índice
+// clave → offset es de cada proceso. Escribir, compactar y vaciar toman un
+// flock exclusivo, leer uno compartido. Compactar o vaciar incrementa
+// 'generation' en el header: un proceso que ve otra generación vuelve a
+// indexar. Además cada lectura valida magic, clave, límites y CRC del
+// registro; si no coinciden es un fallo de caché.
+
+struct RasterCacheKey
+{
+  uint64_t hash = 0;
+  uint64_t source_length = 0;
+  int32_t width = 0;
+  uint8_t dither = 0;
+  uint8_t command = 0;
+  uint8_t density = 0;
+
+  bool operator==(const RasterCacheKey &other) const
+  {
+    return hash == other.hash && source_length == other.source_length &&
+           width == other.width && dither == other.dither &&
+           command == other.command && density == other.density;
+  }
+};
+
+RasterCacheKey raster_cache_key(const uint8_t *source, size_t length, int width,
+                                uint8_t dither, uint8_t command, uint8_t density);
+
+struct RasterCacheStats
+{
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  size_t memory_entries = 0;
+  size_t memory_bytes = 0;
+  size_t disk_entries = 0;
+  size_t disk_bytes = 0;
+};
+
+class RasterCache
+{
+public:
+  RasterCache(size_t memory_budget, size_t disk_capacity);
+  ~RasterCache();
+
+  RasterCache(const RasterCache &) = delete;
+  RasterCache &operator=(const RasterCache &) = delete;
+
+  // Abre (o crea) el nivel en disco. Sin él la caché funciona sólo en memoria.
+  bool open(const std::string &path);
+  void close();
+
+  // Copia en 'out' los comandos guardados para 'key'. Un acierto en disco
+  // se promueve a memoria.
+  bool lookup(const RasterCacheKey &key, std::vector<uint8_t> &out);
+
+  void store(const RasterCacheKey &key, const std::vector<uint8_t> &bytes);
+
+  void clear();
+  RasterCacheStats stats();
+
+private:
+  struct KeyHash
+  {
+    size_t operator()(const RasterCacheKey &key) const
+    {
+      return static_cast<size_t>(key.hash ^ (static_cast<uint64_t>(key.width) << 32) ^
+                                 (key.dither << 16) ^ (key.command << 8) ^ key.density);
+    }
+  };
+  struct MemoryEntry
+  {
+    RasterCacheKey key;
+    std::shared_ptr<const std::vector<uint8_t>> bytes;
+  };
+  struct DiskEntry
+  {
+    size_t offset; // del Record dentro del archivo
+    uint64_t last_use;
+  };
+  struct FileHeader;
+  struct Record;
+
+  void remember_locked(const RasterCacheKey &key,
+                       std::shared_ptr<const std::vector<uint8_t>> bytes);
+  bool read_disk_locked(const RasterCacheKey &key, std::vector<uint8_t> &out);
+  void write_disk_locked(const RasterCacheKey &key, const std::vector<uint8_t> &bytes);
+  void compact_locked(size_t needed);
+  void refresh_index_locked();
+  const Record *record_at_locked(size_t offset) const;
+  void index_disk_locked(size_t size);
+  void reset_disk_locked();
+  void sync_range(size_t offset, size_t length);
+
+  std::mutex mutex_;
+  const size_t memory_budget_;
+  const size_t disk_capacity_;
+
+  std::list<MemoryEntry> lru_; // el más reciente al frente
+  std::unordered_map<RasterCacheKey, std::list<MemoryEntry>::iterator, KeyHash> memory_;
+  size_t memory_bytes_ = 0;
+
+  std::unordered_map<RasterCacheKey, DiskEntry, KeyHash> disk_;
+  int fd_ = -1;
+  uint8_t *base_ = nullptr;
+  uint64_t generation_ = 0; // del header cuando se armó disk_
+  size_t indexed_ = 0;      // disk_ cubre los registros hasta acá
+  uint64_t clock_ = 0;
+
+  uint64_t hits_ = 0;
+  uint64_t misses_ = 0;
+};
+
+#endif // FLUTTER_PLUGIN_TI_PRINTER_RASTER_CACHE_H_
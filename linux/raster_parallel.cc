@@ -0,0 +1,260 @@
+#include "raster_parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace
+{
+
+// Puntos que una fila avanza antes de publicar su progreso a la de abajo.
+constexpr int kWavefrontChunk = 64;
+
+// Reordena bandas que terminan en cualquier orden.
+class BandReorder
+{
+public:
+  BandReorder(size_t count, const RasterBandSink &sink)
+      : bands_(count), ready_(count, 0), sink_(sink)
+  {
+  }
+
+  void complete(size_t index, std::vector<uint8_t> band)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      bands_[index] = std::move(band);
+      ready_[index] = 1;
+      if (emitting_)
+        return; // la entrega el que ya está entregando
+      emitting_ = true;
+    }
+    for (;;)
+    {
+      std::vector<uint8_t> next;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (next_ >= bands_.size() || !ready_[next_])
+        {
+          emitting_ = false;
+          return;
+        }
+        next.swap(bands_[next_]);
+        next_++;
+      }
+      if (!aborted_ && !sink_(std::move(next)))
+        aborted_ = true;
+    }
+  }
+
+  bool aborted() const { return aborted_; }
+  bool finished() const { return next_ == bands_.size(); }
+
+private:
+  std::mutex mutex_;
+  std::vector<std::vector<uint8_t>> bands_;
+  std::vector<uint8_t> ready_;
+  size_t next_ = 0;
+  bool emitting_ = false;
+  std::atomic<bool> aborted_{false};
+  const RasterBandSink &sink_;
+};
+
+void band_bounds(int band, int height, int &y0, int &rows)
+{
+  y0 = band * kRasterBandRows;
+  rows = std::min(kRasterBandRows, height - y0);
+}
+
+// Umbral o trama ordenada: una banda, sin depender de las demás.
+std::vector<uint8_t> pack_band(const uint8_t *gray, int width, int height, int band,
+                               RasterDither dither, RasterCommand command, int density)
+{
+  int y0;
+  int rows;
+  band_bounds(band, height, y0, rows);
+  const size_t stride = static_cast<size_t>(width + 7) / 8;
+
+  std::vector<uint8_t> out;
+  out.reserve(24 + stride * rows);
+  escpos_raster_band_header(command, width, rows, density, out);
+  std::vector<uint8_t> row;
+  if (dither == RasterDither::kOrdered)
+    row.resize(width);
+  for (int r = 0; r < rows; r++)
+  {
+    const uint8_t *src = gray + static_cast<size_t>(y0 + r) * width;
+    if (dither == RasterDither::kOrdered)
+    {
+      std::copy_n(src, width, row.begin());
+      escpos_ordered_row(row.data(), width, y0 + r);
+      src = row.data();
+    }
+    // escpos_pack_row ya es un umbral en 128.
+    const size_t offset = out.size();
+    out.resize(offset + stride);
+    escpos_pack_row(src, width, out.data() + offset);
+  }
+  escpos_raster_band_footer(command, out);
+  return out;
+}
+
+// Floyd-Steinberg en frente de onda. El error hacia abajo vive en un anillo
+// de filas: la fila y lee errors[y % ring] y escribe errors[(y + 1) % ring].
+class Wavefront
+{
+public:
+  Wavefront(const uint8_t *gray, int width, int height, RasterCommand command,
+            int density, int threads, BandReorder &reorder)
+      : gray_(gray), width_(width), height_(height), command_(command),
+        density_(density), stride_(static_cast<size_t>(width + 7) / 8),
+        ring_(threads * 2 + 2), packed_(stride_ * height, 0),
+        progress_(new std::atomic<int>[height]),
+        band_rows_(new std::atomic<int>[(height + kRasterBandRows - 1) / kRasterBandRows]),
+        errors_(ring_, std::vector<int>(width + 2, 0)), reorder_(reorder)
+  {
+    for (int y = 0; y < height; y++)
+      progress_[y].store(0, std::memory_order_relaxed);
+    for (int b = 0; b < (height + kRasterBandRows - 1) / kRasterBandRows; b++)
+      band_rows_[b].store(0, std::memory_order_relaxed);
+  }
+
+  // Cuerpo de cada hilo: toma filas en orden hasta que no quedan.
+  void run()
+  {
+    for (;;)
+    {
+      const int y = next_row_.fetch_add(1);
+      if (y >= height_ || reorder_.aborted())
+        return;
+      // El anillo tiene lugar cuando terminó la fila que usó este hueco.
+      if (y + 1 - ring_ >= 0 && !wait(y + 1 - ring_, width_))
+        return;
+      if (!dither_row(y))
+        return;
+
+      const int band = y / kRasterBandRows;
+      int y0;
+      int rows;
+      band_bounds(band, height_, y0, rows);
+      if (band_rows_[band].fetch_add(1) + 1 == rows)
+      {
+        std::vector<uint8_t> out;
+        out.reserve(24 + stride_ * rows);
+        escpos_raster_band_header(command_, width_, rows, density_, out);
+        const uint8_t *data = packed_.data() + static_cast<size_t>(y0) * stride_;
+        out.insert(out.end(), data, data + stride_ * rows);
+        escpos_raster_band_footer(command_, out);
+        reorder_.complete(static_cast<size_t>(band), std::move(out));
+      }
+    }
+  }
+
+private:
+  // Espera a que la fila 'y' haya procesado 'x' puntos.
+  bool wait(int y, int x)
+  {
+    while (progress_[y].load(std::memory_order_acquire) < x)
+    {
+      if (reorder_.aborted())
+        return false;
+      std::this_thread::yield();
+    }
+    return true;
+  }
+
+  bool dither_row(int y)
+  {
+    const std::vector<int> &in = errors_[y % ring_];
+    std::vector<int> &below = errors_[(y + 1) % ring_];
+    std::fill(below.begin(), below.end(), 0);
+    const uint8_t *src = gray_ + static_cast<size_t>(y) * width_;
+    uint8_t *dst = packed_.data() + static_cast<size_t>(y) * stride_;
+
+    int carry = 0; // error hacia la derecha (7/16)
+    for (int x0 = 0; x0 < width_; x0 += kWavefrontChunk)
+    {
+      const int x1 = std::min(width_, x0 + kWavefrontChunk);
+      // El punto x lee el error de los puntos x-1, x y x+1 de arriba.
+      if (y > 0 && !wait(y - 1, std::min(width_, x1 + 1)))
+        return false;
+      for (int x = x0; x < x1; x++)
+      {
+        const int value = src[x] + in[x + 1] + carry;
+        const int error = value < 128 ? value : value - 255;
+        if (value < 128)
+          dst[x >> 3] |= static_cast<uint8_t>(0x80 >> (x & 7));
+        carry = (error * 7) >> 4;
+        below[x] += (error * 3) >> 4;
+        below[x + 1] += (error * 5) >> 4;
+        below[x + 2] += error >> 4;
+      }
+      progress_[y].store(x1, std::memory_order_release);
+    }
+    return true;
+  }
+
+  const uint8_t *gray_;
+  int width_;
+  int height_;
+  RasterCommand command_;
+  int density_;
+  size_t stride_;
+  int ring_;
+  std::vector<uint8_t> packed_;
+  std::unique_ptr<std::atomic<int>[]> progress_;  // puntos listos por fila
+  std::unique_ptr<std::atomic<int>[]> band_rows_; // filas listas por banda
+  std::vector<std::vector<int>> errors_;
+  std::atomic<int> next_row_{0};
+  BandReorder &reorder_;
+};
+
+} // namespace
+
+bool escpos_raster_parallel(const uint8_t *gray, int width, int height,
+                            RasterDither dither, RasterCommand command, int density,
+                            WorkStealingPool &pool, const RasterBandSink &sink)
+{
+  if (!gray || width <= 0 || height <= 0 || density < 0 || density > 3 || !sink ||
+      command == RasterCommand::kStarRaster)
+    return false;
+  const size_t stride = static_cast<size_t>(width + 7) / 8;
+  // GS ( L lleva el largo en 2 bytes: la banda entera tiene que entrar.
+  if (command == RasterCommand::kGraphics && 10 + stride * kRasterBandRows > 0xFFFF)
+    return false;
+
+  const size_t bands = static_cast<size_t>(height + kRasterBandRows - 1) / kRasterBandRows;
+  BandReorder reorder(bands, sink);
+
+  if (dither == RasterDither::kFloydSteinberg)
+  {
+    Wavefront wavefront(gray, width, height, command, density, pool.concurrency(), reorder);
+    pool.run(static_cast<size_t>(pool.concurrency()), [&](size_t) { wavefront.run(); });
+  }
+  else
+  {
+    pool.run(bands, [&](size_t band) {
+      if (!reorder.aborted())
+        reorder.complete(band, pack_band(gray, width, height, static_cast<int>(band), dither,
+                                         command, density));
+    });
+  }
+  return !reorder.aborted() && reorder.finished();
+}
+
+std::vector<uint8_t> escpos_raster_image_parallel(const uint8_t *gray, int width,
+                                                  int height, RasterDither dither,
+                                                  RasterCommand command, int density,
+                                                  WorkStealingPool &pool)
+{
+  std::vector<uint8_t> out;
+  const bool ok = escpos_raster_parallel(gray, width, height, dither, command, density, pool,
+                                         [&](std::vector<uint8_t> band) {
+                                           out.insert(out.end(), band.begin(), band.end());
+                                           return true;
+                                         });
+  if (!ok)
+    out.clear();
+  return out;
+}
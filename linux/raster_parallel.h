@@ -0,0 +1,39 @@
+#ifndef FLUTTER_PLUGIN_TI_PRINTER_RASTER_PARALLEL_H_
+#define FLUTTER_PLUGIN_TI_PRINTER_RASTER_PARALLEL_H_
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "escpos_image.h"
+#include "work_pool.h"
+
+// Conversión de imágenes altas (un ticket entero como imagen, 576 x 8000) a
+// comandos raster repartida entre los núcleos.
+//
+// El umbral y la trama ordenada no miran filas vecinas: cada banda de
+// kRasterBandRows filas es una tarea del pool. Floyd-Steinberg sí: la fila
+// y necesita el error de la y-1 hasta x+1. Se recorre en frente de onda:
+// cada hilo toma la próxima fila y avanza de a tramos detrás de la fila de
+// arriba, así N hilos trabajan N filas a la vez y el resultado es idéntico
+// al de escpos_raster_image.
+//
+// Las bandas se terminan en cualquier orden y se entregan a 'sink' en
+// orden apenas está lista la que sigue, desde el hilo que la completó
+// (nunca dos llamadas a la vez). Si 'sink' devuelve false se abandona el
+// resto.
+
+using RasterBandSink = std::function<bool(std::vector<uint8_t> band)>;
+
+// false si los parámetros no son válidos o 'sink' abortó.
+bool escpos_raster_parallel(const uint8_t *gray, int width, int height,
+                            RasterDither dither, RasterCommand command, int density,
+                            WorkStealingPool &pool, const RasterBandSink &sink);
+
+// Lo mismo, juntando todas las bandas.
+std::vector<uint8_t> escpos_raster_image_parallel(const uint8_t *gray, int width,
+                                                  int height, RasterDither dither,
+                                                  RasterCommand command, int density,
+                                                  WorkStealingPool &pool);
+
+#endif // FLUTTER_PLUGIN_TI_PRINTER_RASTER_PARALLEL_H_
@@ -0,0 +1,212 @@
+#include "raster_pipeline.h"
+
+#include <algorithm>
+
+#include "escpos_image.h"
+#include "star_raster.h"
+
+namespace
+{
+
+// Luma BT.601 en enteros (77 + 150 + 29 = 256).
+inline uint8_t luma(const uint8_t *p)
+{
+  return static_cast<uint8_t>((p[0] * 77 + p[1] * 150 + p[2] * 29) >> 8);
+}
+
+} // namespace
+
+RasterPipeline::~RasterPipeline()
+{
+  cancel();
+  for (std::thread &thread : threads_)
+  {
+    if (thread.joinable())
+      thread.join();
+  }
+}
+
+bool RasterPipeline::start(std::vector<uint8_t> pixels, int width, int height,
+                           int channels, const RasterPipelineOptions &options,
+                           SinkFn sink, DoneFn done)
+{
+  if (threads_[0].joinable() || width <= 0 || height <= 0 || !sink ||
+      (channels != 1 && channels != 3 && channels != 4) ||
+      pixels.size() < static_cast<size_t>(width) * height * channels)
+    return false;
+
+  pixels_ = std::move(pixels);
+  width_ = width;
+  height_ = height;
+  channels_ = channels;
+  options_ = options;
+  // GS v 0: yL yH admite hasta 2047 filas por comando en la mayoría de
+  // los modelos; las bandas son mucho más chicas.
+  options_.band_rows = std::max(1, std::min(options_.band_rows, 2047));
+  // GS ( L lleva el largo en 2 bytes: la banda entera tiene que entrar.
+  if (options_.command == RasterCommand::kGraphics)
+  {
+    const int stride = (width + 7) / 8;
+    const int max_rows = (0xFFFF - 10) / stride;
+    if (max_rows < 1)
+      options_.command = RasterCommand::kBitImage;
+    else
+      options_.band_rows = std::min(options_.band_rows, max_rows);
+  }
+  sink_ = std::move(sink);
+  done_ = std::move(done);
+
+  to_dither_ = std::make_unique<BandQueue>(options_.queue_depth);
+  to_pack_ = std::make_unique<BandQueue>(options_.queue_depth);
+  to_write_ = std::make_unique<BandQueue>(options_.queue_depth);
+
+  threads_[0] = std::thread(&RasterPipeline::run_source, this);
+  threads_[1] = std::thread(&RasterPipeline::run_dither, this);
+  threads_[2] = std::thread(&RasterPipeline::run_pack, this);
+  threads_[3] = std::thread(&RasterPipeline::run_write, this);
+  return true;
+}
+
+void RasterPipeline::cancel()
+{
+  cancelled_ = true;
+  if (to_dither_)
+  {
+    to_dither_->close();
+    to_pack_->close();
+    to_write_->close();
+  }
+}
+
+// Etapa 1: corta la banda y la convierte a gris de 8 bits.
+void RasterPipeline::run_source()
+{
+  for (int y0 = 0; y0 < height_ && !cancelled_; y0 += options_.band_rows)
+  {
+    Band band;
+    band.y0 = y0;
+    band.rows = std::min(options_.band_rows, height_ - y0);
+    const size_t count = static_cast<size_t>(width_) * band.rows;
+    const uint8_t *src = pixels_.data() + static_cast<size_t>(y0) * width_ * channels_;
+
+    if (channels_ == 1)
+    {
+      band.data.assign(src, src + count);
+    }
+    else
+    {
+      band.data.resize(count);
+      for (size_t i = 0; i < count; i++, src += channels_)
+      {
+        uint8_t gray = luma(src);
+        if (channels_ == 4)
+          gray = static_cast<uint8_t>((gray * src[3] + 255 * (255 - src[3])) / 255);
+        band.data[i] = gray;
+      }
+    }
+
+    if (!to_dither_->push(std::move(band)))
+      break;
+  }
+  to_dither_->close();
+}
+
+// Etapa 2: lleva cada punto a 0 o 255. Floyd-Steinberg arrastra el error
+// de la última fila de una banda a la primera de la siguiente, así no se
+// notan las costuras.
+void RasterPipeline::run_dither()
+{
+  ErrorDiffuser diffuser(width_);
+
+  Band band;
+  while (!cancelled_ && to_dither_->pop(band))
+  {
+    for (int r = 0; r < band.rows; r++)
+    {
+      uint8_t *row = band.data.data() + static_cast<size_t>(r) * width_;
+      if (options_.dither == RasterDither::kFloydSteinberg)
+        diffuser.dither_row(row);
+      else if (options_.dither == RasterDither::kOrdered)
+        escpos_ordered_row(row, width_, band.y0 + r);
+      else
+        escpos_threshold_row(row, width_);
+    }
+
+    if (!to_pack_->push(std::move(band)))
+      break;
+  }
+  to_pack_->close();
+}
+
+// Etapa 3: empaqueta a 1 bit y arma el comando de la banda.
+void RasterPipeline::run_pack()
+{
+  const size_t stride = static_cast<size_t>(width_ + 7) / 8;
+  const bool star = options_.command == RasterCommand::kStarRaster;
+  StarRasterEncoder star_encoder;
+  std::vector<uint8_t> packed(star ? stride : 0);
+
+  Band band;
+  while (!cancelled_ && to_pack_->pop(band))
+  {
+    std::vector<uint8_t> out;
+    if (star)
+    {
+      // Una banda toda en blanco puede quedar vacía: sus filas se avanzan
+      // junto con la próxima que tenga tinta.
+      if (band.y0 == 0)
+        star_encoder.begin(out);
+      for (int r = 0; r < band.rows; r++)
+      {
+        escpos_pack_row(band.data.data() + static_cast<size_t>(r) * width_, width_,
+                        packed.data());
+        star_encoder.row(packed.data(), stride, out);
+      }
+      if (band.y0 + band.rows == height_)
+        star_encoder.end(out);
+    }
+    else
+    {
+      // GS v 0, o GS ( L fn 112 + fn 50 en las que lo contestaron al probe.
+      escpos_raster_band_header(options_.command, width_, band.rows, 0, out);
+      const size_t offset = out.size();
+      out.resize(offset + stride * band.rows);
+      for (int r = 0; r < band.rows; r++)
+      {
+        escpos_pack_row(band.data.data() + static_cast<size_t>(r) * width_, width_,
+                        out.data() + offset + r * stride);
+      }
+      escpos_raster_band_footer(options_.command, out);
+    }
+
+    band.data.swap(out);
+    if (!to_write_->push(std::move(band)))
+      break;
+  }
+  to_write_->close();
+}
+
+// Etapa 4: entrega las bandas en orden al destino (el fd de la impresora).
+void RasterPipeline::run_write()
+{
+  bool ok = true;
+  int written_rows = 0;
+
+  Band band;
+  while (!cancelled_ && to_write_->pop(band))
+  {
+    if (!band.data.empty() && !sink_(std::move(band.data)))
+    {
+      ok = false;
+      cancel();
+      break;
+    }
+    written_rows += band.rows;
+  }
+
+  ok = ok && !cancelled_ && written_rows == height_;
+  if (!ok)
+    cancel(); // desbloquear etapas anteriores que esperan lugar en su cola
+  if (done_)
+    done_(ok);
+}
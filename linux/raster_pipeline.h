@@ -0,0 +1,90 @@
+#ifndef FLUTTER_PLUGIN_TI_PRINTER_RASTER_PIPELINE_H_
+#define FLUTTER_PLUGIN_TI_PRINTER_RASTER_PIPELINE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "bounded_queue.h"
+#include "escpos_image.h"
+
+// Pipeline de impresión de imágenes por bandas:
+//
+//   origen (gris) → dither → empaquetado GS v 0 → escritura
+//
+// Cada etapa corre en su propio hilo y se comunica con la siguiente por una
+// cola acotada, así la impresora empieza a imprimir la banda 1 mientras las
+// siguientes todavía se están procesando, y la memoria en vuelo queda
+// limitada a unas pocas bandas aunque la imagen sea muy alta.
+
+struct RasterPipelineOptions
+{
+  int band_rows = kRasterBandRows; // filas por banda (y por comando GS v 0)
+  RasterDither dither = RasterDither::kFloydSteinberg;
+  size_t queue_depth = 2; // bandas en cola entre dos etapas
+  // kBitImage arma un GS v 0 por banda; kGraphics un GS ( L (guardar +
+  // imprimir) por banda, achicando las bandas si no entran en su largo de
+  // 16 bits; kStarRaster una orden por fila, con el modo raster abierto en
+  // la primera banda y cerrado en la última.
+  RasterCommand command = RasterCommand::kBitImage;
+};
+
+class RasterPipeline
+{
+public:
+  // Última etapa: recibe cada banda lista para enviar (comando + datos), en
+  // orden. Devuelve false para abortar el resto.
+  using SinkFn = std::function<bool(std::vector<uint8_t> band)>;
+  // Se invoca una vez, desde el hilo de escritura, al terminar o abortar.
+  // No debe destruir el pipeline (el destructor espera a ese hilo).
+  using DoneFn = std::function<void(bool ok)>;
+
+  RasterPipeline() = default;
+  ~RasterPipeline();
+
+  RasterPipeline(const RasterPipeline &) = delete;
+  RasterPipeline &operator=(const RasterPipeline &) = delete;
+
+  // 'pixels' tiene 'channels' bytes por punto: 1 (gris), 3 (RGB) o 4 (RGBA,
+  // el alfa se compone sobre blanco). Devuelve false si los parámetros no
+  // son válidos (en ese caso 'done' no se invoca).
+  bool start(std::vector<uint8_t> pixels, int width, int height, int channels,
+             const RasterPipelineOptions &options, SinkFn sink, DoneFn done);
+
+  // Aborta todas las etapas; 'done' recibe false.
+  void cancel();
+
+private:
+  struct Band
+  {
+    int y0 = 0;
+    int rows = 0;
+    std::vector<uint8_t> data;
+  };
+  using BandQueue = BoundedQueue<Band>;
+
+  void run_source();
+  void run_dither();
+  void run_pack();
+  void run_write();
+
+  std::vector<uint8_t> pixels_;
+  int width_ = 0;
+  int height_ = 0;
+  int channels_ = 1;
+  RasterPipelineOptions options_;
+  SinkFn sink_;
+  DoneFn done_;
+
+  std::unique_ptr<BandQueue> to_dither_;
+  std::unique_ptr<BandQueue> to_pack_;
+  std::unique_ptr<BandQueue> to_write_;
+  std::atomic<bool> cancelled_{false};
+  std::thread threads_[4];
+};
+
+#endif // FLUTTER_PLUGIN_TI_PRINTER_RASTER_PIPELINE_H_
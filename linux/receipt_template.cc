@@ -0,0 +1,814 @@
+#include "receipt_template.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+
+namespace
+{
+
+constexpr uint8_t LF = 0x0A;
+constexpr uint8_t ESC = 0x1B;
+constexpr uint8_t FS = 0x1C;
+constexpr uint8_t GS = 0x1D;
+
+constexpr size_t kMaxColumns = 12;
+constexpr size_t kMaxDepth = 8;
+constexpr size_t kMaxQrData = 7089; // límite de GS ( k fn 80 (modelo 2)
+
+// GS ( k: modelo 2, tamaño de módulo (se completa al compilar) y
+// corrección M. Al final del prefijo va el print (fn 81) que sigue al store.
+constexpr uint8_t kQrPrefix[] = {
+    GS, '(', 'k', 4, 0, 49, 65, 50, 0,
+    GS, '(', 'k', 3, 0, 49, 67, 6,
+    GS, '(', 'k', 3, 0, 49, 69, 49,
+};
+constexpr size_t kQrSizeOffset = 16;
+constexpr uint8_t kQrPrint[] = {GS, '(', 'k', 3, 0, 49, 81, 48};
+
+bool is_name_char(char c)
+{
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+         c == '_' || c == '.' || c == '-';
+}
+
+bool is_name(std::string_view s)
+{
+  return !s.empty() && std::all_of(s.begin(), s.end(), is_name_char);
+}
+
+std::string_view trim(std::string_view s)
+{
+  while (!s.empty() && (s.front() == ' ' || s.front() == '\t'))
+    s.remove_prefix(1);
+  while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r'))
+    s.remove_suffix(1);
+  return s;
+}
+
+// Separa la primera palabra de 's' (que queda con el resto).
+std::string_view next_word(std::string_view &s)
+{
+  s = trim(s);
+  size_t n = 0;
+  while (n < s.size() && s[n] != ' ' && s[n] != '\t')
+    n++;
+  std::string_view word = s.substr(0, n);
+  s = trim(s.substr(n));
+  return word;
+}
+
+bool parse_int(std::string_view s, int min, int max, int &out)
+{
+  if (s.empty() || s.size() > 4)
+    return false;
+  int value = 0;
+  for (char c : s)
+  {
+    if (c < '0' || c > '9')
+      return false;
+    value = value * 10 + (c - '0');
+  }
+  if (value < min || value > max)
+    return false;
+  out = value;
+  return true;
+}
+
+} // namespace
+
+// ===================== Compilación =====================
+
+class ReceiptTemplate::Compiler
+{
+public:
+  explicit Compiler(ReceiptTemplate &tpl) : tpl_(tpl) {}
+
+  bool compile(const std::string &source, std::string *error)
+  {
+    size_t start = 0;
+    while (start < source.size())
+    {
+      size_t end = source.find('\n', start);
+      if (end == std::string::npos)
+        end = source.size();
+      line_number_++;
+      const std::string_view line(source.data() + start, end - start);
+      if (!compile_line(trim(line)))
+        return fail(error);
+      start = end + 1;
+    }
+    if (!blocks_.empty())
+    {
+      line_number_ = blocks_.back().line;
+      message_ = "block is never closed with @end";
+      return fail(error);
+    }
+    return true;
+  }
+
+private:
+  struct Part
+  {
+    bool field;
+    std::vector<uint8_t> text; // ya codificado, si no es campo
+    uint32_t name;
+  };
+
+  struct Block
+  {
+    bool loop;
+    size_t pc;    // kEach / kIf
+    size_t jump;  // kJump de @else (0 si no hubo)
+    size_t line;
+  };
+
+  bool fail(std::string *error)
+  {
+    if (error)
+      *error = "line " + std::to_string(line_number_) + ": " + message_;
+    return false;
+  }
+
+  bool error(const char *message)
+  {
+    message_ = message;
+    return false;
+  }
+
+  // Opciones de fila con el estado vigente: celdas de la fuente en este
+  // papel, sin dividir por el tamaño (de eso se ocupa escpos_layout).
+  EscPosRowOptions row_options() const
+  {
+    EscPosRowOptions options;
+    options.line_cells = paper_ == 58 ? (font_ == 1 ? 42 : 32) : (font_ == 1 ? 64 : 48);
+    options.cell_dots = font_ == 1 ? 9 : 12;
+    options.size = size_;
+    options.code_table = code_table_;
+    options.utf8 = utf8_;
+    return options;
+  }
+
+  bool compile_line(std::string_view line)
+  {
+    if (line.empty() || line[0] != '@')
+      return text_line(line);
+    if (line.size() > 1 && line[1] == '@')
+      return text_line(line.substr(1));
+    if (line.size() > 1 && line[1] == '#')
+      return true;
+
+    std::string_view rest = line.substr(1);
+    const std::string_view directive = next_word(rest);
+    if (directive == "row")
+      return row(rest);
+    if (directive == "each" || directive == "if")
+      return open_block(directive == "each", rest);
+    if (directive == "else")
+      return else_block();
+    if (directive == "end")
+      return end_block();
+    if (directive == "image")
+      return slot(Op::kRaw, rest);
+    if (directive == "qr")
+      return qr(rest);
+    if (directive == "hr")
+      return hr(rest);
+    if (directive == "raw")
+      return raw(rest);
+    return setting(directive, rest);
+  }
+
+  // Directivas que sólo emiten bytes fijos y/o cambian el estado de
+  // compilación.
+  bool setting(std::string_view directive, std::string_view arg)
+  {
+    int n = 0;
+    if (directive == "paper")
+    {
+      if (arg != "58" && arg != "80")
+        return error("@paper expects 58 or 80");
+      paper_ = arg == "58" ? 58 : 80;
+      return true;
+    }
+    if (directive == "align")
+    {
+      if (arg == "left")
+        n = 0;
+      else if (arg == "center")
+        n = 1;
+      else if (arg == "right")
+        n = 2;
+      else
+        return error("@align expects left, center or right");
+      return command3(ESC, 'a', n);
+    }
+    if (directive == "bold" || directive == "reverse")
+    {
+      if (!on_off(arg, n))
+        return error("expected on or off");
+      return directive == "bold" ? command3(ESC, 'E', n) : command3(GS, 'B', n);
+    }
+    if (directive == "underline")
+    {
+      if (arg == "double")
+        n = 2;
+      else if (!on_off(arg, n))
+        return error("@underline expects off, on or double");
+      return command3(ESC, '-', n);
+    }
+    if (directive == "font")
+    {
+      if (arg != "a" && arg != "b")
+        return error("@font expects a or b");
+      font_ = arg == "b" ? 1 : 0;
+      return command3(ESC, 'M', font_);
+    }
+    if (directive == "size")
+    {
+      int w = 0;
+      int h = 0;
+      const size_t x = arg.find('x');
+      if (x == std::string_view::npos)
+      {
+        if (!parse_int(arg, 1, 8, w))
+          return error("@size expects N or WxH between 1 and 8");
+        h = w;
+      }
+      else if (!parse_int(arg.substr(0, x), 1, 8, w) || !parse_int(arg.substr(x + 1), 1, 8, h))
+        return error("@size expects N or WxH between 1 and 8");
+      size_ = ((w - 1) << 4) | (h - 1);
+      return command3(GS, '!', size_);
+    }
+    if (directive == "codetable")
+    {
+      if (!parse_int(arg, 0, 255, n))
+        return error("@codetable expects a number between 0 and 255");
+      code_table_ = n;
+      return command3(ESC, 't', n);
+    }
+    if (directive == "utf8")
+    {
+      if (!on_off(arg, n))
+        return error("expected on or off");
+      // FS ( C fn 48: sistema de codificación (1 = un byte, 2 = UTF-8).
+      utf8_ = n == 1;
+      const uint8_t cmd[] = {FS, '(', 'C', 2, 0, 48, static_cast<uint8_t>(utf8_ ? 2 : 1)};
+      emit_bytes(cmd, sizeof(cmd));
+      return true;
+    }
+    if (directive == "feed")
+    {
+      if (!parse_int(arg, 0, 255, n))
+        return error("@feed expects a number between 0 and 255");
+      return command3(ESC, 'd', n);
+    }
+    if (directive == "cut")
+    {
+      if (!arg.empty() && arg != "partial")
+        return error("@cut expects nothing or partial");
+      return command3(GS, 'V', arg.empty() ? 0 : 1);
+    }
+    if (directive == "reset")
+    {
+      // ESC @ vuelve a los valores de encendido.
+      font_ = 0;
+      size_ = 0;
+      code_table_ = 0;
+      utf8_ = false;
+      const uint8_t cmd[] = {ESC, '@'};
+      emit_bytes(cmd, sizeof(cmd));
+      return true;
+    }
+    return error("unknown directive");
+  }
+
+  static bool on_off(std::string_view arg, int &out)
+  {
+    if (arg == "on")
+      out = 1;
+    else if (arg == "off")
+      out = 0;
+    else
+      return false;
+    return true;
+  }
+
+  bool command3(uint8_t a, uint8_t b, int n)
+  {
+    const uint8_t cmd[] = {a, b, static_cast<uint8_t>(n)};
+    emit_bytes(cmd, sizeof(cmd));
+    return true;
+  }
+
+  bool hr(std::string_view arg)
+  {
+    const char c = arg.empty() ? '-' : arg[0];
+    if (arg.size() > 1 || c < 0x21 || c > 0x7E)
+      return error("@hr expects a single ASCII character");
+    // Celdas de la fuente divididas por el ancho vigente.
+    const int count = row_options().line_cells / (((size_ >> 4) & 0x07) + 1);
+    std::vector<uint8_t> line(static_cast<size_t>(count), static_cast<uint8_t>(c));
+    line.push_back(LF);
+    emit_bytes(line.data(), line.size());
+    return true;
+  }
+
+  bool raw(std::string_view arg)
+  {
+    std::vector<uint8_t> bytes;
+    while (!arg.empty())
+    {
+      const std::string_view word = next_word(arg);
+      char *end = nullptr;
+      const std::string hex(word);
+      const long value = std::strtol(hex.c_str(), &end, 16);
+      if (hex.size() > 2 || *end != '\0' || value < 0)
+        return error("@raw expects hexadecimal bytes");
+      bytes.push_back(static_cast<uint8_t>(value));
+    }
+    if (bytes.empty())
+      return error("@raw expects hexadecimal bytes");
+    emit_bytes(bytes.data(), bytes.size());
+    return true;
+  }
+
+  bool slot(Op op, std::string_view arg)
+  {
+    if (!is_name(arg))
+      return error("expected a field name");
+    emit(op, intern(arg));
+    return true;
+  }
+
+  bool qr(std::string_view arg)
+  {
+    const std::string_view field = next_word(arg);
+    int size = 6;
+    if (!is_name(field))
+      return error("@qr expects a field name");
+    if (!arg.empty() && !parse_int(arg, 1, 16, size))
+      return error("@qr size must be between 1 and 16");
+
+    // Prefijo y print van al pool sin pasar por emit_bytes: los usa kQr.
+    const uint32_t offset = static_cast<uint32_t>(tpl_.pool_.size());
+    tpl_.pool_.insert(tpl_.pool_.end(), kQrPrefix, kQrPrefix + sizeof(kQrPrefix));
+    tpl_.pool_[offset + kQrSizeOffset] = static_cast<uint8_t>(size);
+    tpl_.pool_.insert(tpl_.pool_.end(), kQrPrint, kQrPrint + sizeof(kQrPrint));
+    emit(Op::kQr, intern(field), offset);
+    return true;
+  }
+
+  bool open_block(bool loop, std::string_view arg)
+  {
+    if (blocks_.size() == kMaxDepth)
+      return error("blocks are nested too deeply");
+    const bool negated = !loop && !arg.empty() && arg[0] == '!';
+    if (negated)
+      arg.remove_prefix(1);
+    if (!is_name(arg))
+      return error("expected a field name");
+    blocks_.push_back(Block{loop, tpl_.code_.size(), 0, line_number_});
+    emit(loop ? Op::kEach : Op::kIf, intern(arg), 0, negated ? 1 : 0);
+    return true;
+  }
+
+  bool else_block()
+  {
+    if (blocks_.empty() || blocks_.back().loop || blocks_.back().jump != 0)
+      return error("@else without @if");
+    Block &block = blocks_.back();
+    block.jump = tpl_.code_.size();
+    emit(Op::kJump, 0);
+    tpl_.code_[block.pc].b = label();
+    return true;
+  }
+
+  bool end_block()
+  {
+    if (blocks_.empty())
+      return error("@end without @each or @if");
+    const Block block = blocks_.back();
+    blocks_.pop_back();
+    const uint32_t target = label();
+    if (block.loop)
+      tpl_.code_[block.pc].b = target;
+    else if (block.jump != 0)
+      tpl_.code_[block.jump].a = target;
+    else
+      tpl_.code_[block.pc].b = target;
+    return true;
+  }
+
+  bool text_line(std::string_view line)
+  {
+    std::vector<Part> parts;
+    if (!parse_parts(line, true, parts))
+      return false;
+    const uint8_t lf = LF;
+    if (parts.size() <= 1 && (parts.empty() || !parts[0].field))
+    {
+      if (!parts.empty())
+        emit_bytes(parts[0].text.data(), parts[0].text.size());
+      emit_bytes(&lf, 1);
+      return true;
+    }
+    for (const Part &part : parts)
+      emit_part(part);
+    emit_bytes(&lf, 1);
+    return true;
+  }
+
+  // "6 2 >4 | a | {{b}} | c"
+  bool row(std::string_view arg)
+  {
+    const size_t bar = arg.find('|');
+    if (bar == std::string_view::npos)
+      return error("@row expects column widths followed by | cells");
+
+    // "<6", ">4", "^2x2": alineación, doceavos y multiplicador de ancho.
+    std::vector<Column> columns;
+    std::string_view spec = trim(arg.substr(0, bar));
+    int total = 0;
+    while (!spec.empty())
+    {
+      std::string_view word = next_word(spec);
+      EscPosAlign align = EscPosAlign::kLeft;
+      if (word[0] == '>' || word[0] == '^' || word[0] == '<')
+      {
+        align = word[0] == '>' ? EscPosAlign::kRight
+              : word[0] == '^' ? EscPosAlign::kCenter
+                               : EscPosAlign::kLeft;
+        word.remove_prefix(1);
+      }
+      int size = -1;
+      const size_t x = word.find('x');
+      if (x != std::string_view::npos)
+      {
+        int scale = 0;
+        if (!parse_int(word.substr(x + 1), 1, 8, scale))
+          return error("column width multiplier must be between 1 and 8");
+        size = ((scale - 1) << 4) | (size_ & 0x0F);
+        word = word.substr(0, x);
+      }
+      int twelfths = 0;
+      if (!parse_int(word, 1, 12, twelfths))
+        return error("column widths must be between 1 and 12");
+      total += twelfths;
+      columns.push_back(Column{static_cast<uint8_t>(twelfths), align,
+                               static_cast<int16_t>(size), 0});
+    }
+    if (columns.empty() || columns.size() > kMaxColumns || total > 12)
+      return error("columns must add up to at most 12");
+
+    // Cada columna tiene que poder mostrar al menos un carácter.
+    const EscPosRowOptions options = row_options();
+    int twelfths = 0;
+    for (size_t i = 0; i < columns.size(); i++)
+    {
+      const int start = options.line_cells * twelfths / 12;
+      twelfths += columns[i].width;
+      const int cells = options.line_cells * twelfths / 12 - start - (i + 1 < columns.size() ? 1 : 0);
+      const int size = columns[i].size < 0 ? size_ : columns[i].size;
+      if (cells / (((size >> 4) & 0x07) + 1) < 1)
+        return error("column is too narrow for this paper and size");
+    }
+
+    // Las celdas quedan en UTF-8: se miden y codifican al armar la fila.
+    std::vector<std::vector<Part>> cells;
+    std::string_view rest = arg.substr(bar + 1);
+    while (true)
+    {
+      const size_t next = rest.find('|');
+      cells.emplace_back();
+      if (!parse_parts(trim(rest.substr(0, next)), false, cells.back()))
+        return false;
+      if (next == std::string_view::npos)
+        break;
+      rest = rest.substr(next + 1);
+    }
+    if (cells.size() != columns.size())
+      return error("number of cells does not match the columns");
+
+    bool dynamic = false;
+    for (const auto &cell : cells)
+      for (const Part &part : cell)
+        dynamic = dynamic || part.field;
+
+    if (!dynamic)
+    {
+      // Fila fija: se arma ahora y queda como bytes.
+      EscPosColumn layout[kMaxColumns];
+      for (size_t i = 0; i < columns.size(); i++)
+      {
+        if (!cells[i].empty())
+          layout[i].text = std::string_view(reinterpret_cast<const char *>(cells[i][0].text.data()),
+                                            cells[i][0].text.size());
+        layout[i].width = columns[i].width;
+        layout[i].align = columns[i].align;
+        layout[i].size = columns[i].size;
+      }
+      std::vector<uint8_t> bytes;
+      EscPosRowLayout().layout(layout, columns.size(), options, bytes);
+      emit_bytes(bytes.data(), bytes.size());
+      return true;
+    }
+
+    tpl_.rows_.push_back(Row{options, static_cast<uint32_t>(tpl_.columns_.size()),
+                             static_cast<uint32_t>(columns.size())});
+    const size_t row_pc = tpl_.code_.size();
+    emit(Op::kRow, static_cast<uint32_t>(tpl_.rows_.size() - 1));
+    uint32_t total_parts = 0;
+    for (size_t i = 0; i < cells.size(); i++)
+    {
+      columns[i].parts = static_cast<uint16_t>(cells[i].size());
+      total_parts += columns[i].parts;
+      tpl_.columns_.push_back(columns[i]);
+      for (const Part &part : cells[i])
+        emit_part(part);
+    }
+    tpl_.code_[row_pc].c = total_parts;
+    // Lo que sigue no se puede fusionar con las partes de la fila.
+    label();
+    return true;
+  }
+
+  // Texto con {{campo}} → partes. Con 'encode' el texto fijo se codifica ya
+  // con la tabla vigente; si no, queda en UTF-8.
+  bool parse_parts(std::string_view text, bool encode, std::vector<Part> &parts)
+  {
+    while (!text.empty())
+    {
+      const size_t open = text.find("{{");
+      if (open != 0)
+      {
+        Part part{false, {}, 0};
+        const std::string_view literal = text.substr(0, open);
+        if (encode)
+          escpos_encode_text(literal, code_table_, utf8_, part.text);
+        else
+          part.text.assign(literal.begin(), literal.end());
+        if (!part.text.empty())
+          parts.push_back(std::move(part));
+        if (open == std::string_view::npos)
+          break;
+      }
+      const size_t close = text.find("}}", open + 2);
+      if (close == std::string_view::npos)
+        return error("unterminated {{");
+      const std::string_view name = trim(text.substr(open + 2, close - open - 2));
+      if (!is_name(name))
+        return error("invalid field name");
+      parts.push_back(Part{true, {}, intern(name)});
+      text = text.substr(close + 2);
+    }
+    return true;
+  }
+
+  void emit_part(const Part &part)
+  {
+    if (part.field)
+    {
+      emit(Op::kField, part.name, static_cast<uint32_t>(code_table_), utf8_ ? 1 : 0);
+      return;
+    }
+    const uint32_t offset = static_cast<uint32_t>(tpl_.pool_.size());
+    tpl_.pool_.insert(tpl_.pool_.end(), part.text.begin(), part.text.end());
+    emit(Op::kBytes, offset, static_cast<uint32_t>(part.text.size()));
+  }
+
+  // Bytes fijos: se pegan al kBytes anterior si es contiguo y nadie salta
+  // entre los dos.
+  void emit_bytes(const uint8_t *data, size_t length)
+  {
+    const uint32_t offset = static_cast<uint32_t>(tpl_.pool_.size());
+    tpl_.pool_.insert(tpl_.pool_.end(), data, data + length);
+    if (tpl_.code_.size() > label_ && tpl_.code_.back().op == Op::kBytes &&
+        tpl_.code_.back().a + tpl_.code_.back().b == offset)
+    {
+      tpl_.code_.back().b += static_cast<uint32_t>(length);
+      return;
+    }
+    emit(Op::kBytes, offset, static_cast<uint32_t>(length));
+  }
+
+  void emit(Op op, uint32_t a, uint32_t b = 0, uint32_t c = 0)
+  {
+    tpl_.code_.push_back(Instr{op, a, b, c});
+  }
+
+  // Marca la posición actual como destino de salto.
+  uint32_t label()
+  {
+    label_ = tpl_.code_.size();
+    return static_cast<uint32_t>(label_);
+  }
+
+  uint32_t intern(std::string_view name)
+  {
+    for (size_t i = 0; i < tpl_.names_.size(); i++)
+    {
+      if (tpl_.names_[i] == name)
+        return static_cast<uint32_t>(i);
+    }
+    tpl_.names_.emplace_back(name);
+    return static_cast<uint32_t>(tpl_.names_.size() - 1);
+  }
+
+  ReceiptTemplate &tpl_;
+  std::vector<Block> blocks_;
+  size_t line_number_ = 0;
+  size_t label_ = 0;
+  std::string message_;
+
+  int paper_ = 80;
+  int font_ = 0;
+  int size_ = 0;       // GS !
+  int code_table_ = 0; // PC437, la de encendido de casi todas
+  bool utf8_ = false;
+};
+
+bool ReceiptTemplate::compile(const std::string &source, std::string *error)
+{
+  code_.clear();
+  pool_.clear();
+  names_.clear();
+  columns_.clear();
+  rows_.clear();
+  Compiler compiler(*this);
+  if (compiler.compile(source, error))
+    return true;
+  code_.clear();
+  pool_.clear();
+  return false;
+}
+
+// ===================== Ejecución =====================
+
+class ReceiptTemplate::EachVisitor : public ReceiptScope::Visitor
+{
+public:
+  EachVisitor(ReceiptTemplate &tpl, size_t begin, size_t end)
+      : tpl_(tpl), begin_(begin), end_(end) {}
+
+  void item(const ReceiptScope &scope) override
+  {
+    tpl_.scopes_.push_back(&scope);
+    tpl_.run(begin_, end_);
+    tpl_.scopes_.pop_back();
+  }
+
+private:
+  ReceiptTemplate &tpl_;
+  size_t begin_;
+  size_t end_;
+};
+
+const std::vector<uint8_t> &ReceiptTemplate::render(const ReceiptScope &data)
+{
+  // clear() conserva la capacidad: después del primer ticket ya no se
+  // reserva memoria.
+  out_.clear();
+  scopes_.clear();
+  scopes_.push_back(&data);
+  run(0, code_.size());
+  scopes_.clear();
+  return out_;
+}
+
+bool ReceiptTemplate::lookup(uint32_t name, std::string_view &out) const
+{
+  const char *key = names_[name].c_str();
+  for (size_t i = scopes_.size(); i > 0; i--)
+  {
+    if (scopes_[i - 1]->lookup(key, out))
+      return true;
+  }
+  return false;
+}
+
+bool ReceiptTemplate::truthy(uint32_t name) const
+{
+  const char *key = names_[name].c_str();
+  for (size_t i = scopes_.size(); i > 0; i--)
+  {
+    std::string_view value;
+    if (scopes_[i - 1]->lookup(key, value))
+      return !value.empty() && value != "0" && value != "false";
+    if (scopes_[i - 1]->count(key) > 0)
+      return true;
+  }
+  return false;
+}
+
+void ReceiptTemplate::run(size_t pc, size_t end)
+{
+  while (pc < end)
+  {
+    const Instr &in = code_[pc];
+    switch (in.op)
+    {
+    case Op::kBytes:
+      out_.insert(out_.end(), pool_.data() + in.a, pool_.data() + in.a + in.b);
+      pc++;
+      break;
+    case Op::kField:
+    {
+      std::string_view value;
+      if (lookup(in.a, value))
+        escpos_encode_text(value, static_cast<int>(in.b), in.c != 0, out_);
+      pc++;
+      break;
+    }
+    case Op::kRaw:
+    {
+      std::string_view value;
+      if (lookup(in.a, value))
+        out_.insert(out_.end(), value.begin(), value.end());
+      pc++;
+      break;
+    }
+    case Op::kQr:
+    {
+      std::string_view value;
+      if (lookup(in.a, value) && !value.empty() && value.size() <= kMaxQrData)
+      {
+        const uint8_t *prefix = pool_.data() + in.b;
+        out_.insert(out_.end(), prefix, prefix + sizeof(kQrPrefix));
+        const size_t length = value.size() + 3;
+        const uint8_t store[] = {GS, '(', 'k', static_cast<uint8_t>(length & 0xFF),
+                                 static_cast<uint8_t>(length >> 8), 49, 80, 48};
+        out_.insert(out_.end(), store, store + sizeof(store));
+        out_.insert(out_.end(), value.begin(), value.end());
+        out_.insert(out_.end(), prefix + sizeof(kQrPrefix),
+                    prefix + sizeof(kQrPrefix) + sizeof(kQrPrint));
+      }
+      pc++;
+      break;
+    }
+    case Op::kRow:
+      pc = run_row(pc);
+      break;
+    case Op::kEach:
+    {
+      const char *key = names_[in.a].c_str();
+      for (size_t i = scopes_.size(); i > 0; i--)
+      {
+        if (scopes_[i - 1]->count(key) > 0)
+        {
+          EachVisitor visitor(*this, pc + 1, in.b);
+          scopes_[i - 1]->each(key, visitor);
+          break;
+        }
+      }
+      pc = in.b;
+      break;
+    }
+    case Op::kIf:
+      pc = truthy(in.a) != (in.c != 0) ? pc + 1 : in.b;
+      break;
+    case Op::kJump:
+      pc = in.a;
+      break;
+    }
+  }
+}
+
+size_t ReceiptTemplate::run_row(size_t pc)
+{
+  const Row &row = rows_[code_[pc].a];
+  const Column *columns = columns_.data() + row.first_column;
+  size_t bounds[kMaxColumns + 1];
+
+  // Cada celda se arma en UTF-8 en cells_; escpos_layout la mide, la corta
+  // y la codifica.
+  cells_.clear();
+  size_t part = pc + 1;
+  for (uint32_t i = 0; i < row.count; i++)
+  {
+    bounds[i] = cells_.size();
+    for (uint16_t j = 0; j < columns[i].parts; j++, part++)
+    {
+      const Instr &in = code_[part];
+      std::string_view value;
+      if (in.op == Op::kBytes)
+        cells_.insert(cells_.end(), pool_.data() + in.a, pool_.data() + in.a + in.b);
+      else if (lookup(in.a, value))
+        cells_.insert(cells_.end(), value.begin(), value.end());
+    }
+  }
+  bounds[row.count] = cells_.size();
+
+  EscPosColumn layout[kMaxColumns];
+  for (uint32_t i = 0; i < row.count; i++)
+  {
+    layout[i].text = std::string_view(reinterpret_cast<const char *>(cells_.data()) + bounds[i],
+                                      bounds[i + 1] - bounds[i]);
+    layout[i].width = columns[i].width;
+    layout[i].align = columns[i].align;
+    layout[i].size = columns[i].size;
+  }
+  layout_.layout(layout, row.count, row.options, out_);
+  return pc + 1 + code_[pc].c;
+}
@@ -0,0 +1,138 @@
+#ifndef FLUTTER_PLUGIN_TI_PRINTER_RECEIPT_TEMPLATE_H_
+#define FLUTTER_PLUGIN_TI_PRINTER_RECEIPT_TEMPLATE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "escpos_layout.h"
+
+// Templates de ticket compilados: el texto del template se analiza una sola
+// vez y queda como bytecode más un bloque de bytes ESC/POS ya codificados
+// (texto fijo, estilos, filas sin campos). Imprimir un pedido sólo ejecuta
+// el bytecode sobre un buffer que se reutiliza entre llamadas.
+//
+// Sintaxis, una instrucción por línea:
+//
+//   texto con {{campo}}     línea de texto (UTF-8) + LF; "@@" escapa una @
+//   @paper 80|58            ancho del papel para filas y @hr (80 por defecto)
+//   @align left|center|right
+//   @bold on|off            @underline off|on|double    @reverse on|off
+//   @font a|b               @size N | WxH (1..8)        @codetable N (ESC t)
+//   @utf8 on|off            la impresora recibe UTF-8 (FS ( C) en vez de ESC t
+//   @row 6 2 >4x2 | a | {{b}} | c
+//                           fila en columnas de doceavos ('>' derecha,
+//                           '^' centro, 'xN' ancho propio); el texto que no
+//                           entra sigue abajo (ver escpos_layout.h)
+//   @hr [c]                 línea de 'c' ('-' por defecto)
+//   @each lista ... @end    repite el bloque por cada elemento
+//   @if [!]campo ... [@else ...] @end
+//   @image campo            bytes ESC/POS tal cual (p. ej. de rasterizeImage)
+//   @qr campo [tamaño]      código QR (GS ( k, modelo 2) con el texto del campo
+//   @feed N                 @cut [partial]              @reset (ESC @)
+//   @raw 1B 70 00 19 FA     bytes fijos en hexadecimal
+//   @# comentario
+//
+// Dentro de @each los campos se buscan primero en el elemento y después
+// hacia afuera. Un campo que no existe se imprime vacío. Los caracteres de
+// control de los campos se descartan: un dato no puede inyectar comandos.
+
+// Datos de un pedido. La capa que llama lo implementa sobre lo que ya tiene
+// (en el plugin, el FlValue del method channel) sin copiar nada.
+class ReceiptScope
+{
+public:
+  class Visitor
+  {
+  public:
+    virtual void item(const ReceiptScope &scope) = 0;
+
+  protected:
+    ~Visitor() = default;
+  };
+
+  virtual ~ReceiptScope() = default;
+
+  // Texto (UTF-8) o bytes del campo. 'out' sólo tiene que seguir siendo
+  // válido hasta la siguiente llamada.
+  virtual bool lookup(const char *name, std::string_view &out) const = 0;
+  // Elementos de la lista 'name' (0 si no existe o no es una lista).
+  virtual size_t count(const char *name) const = 0;
+  // Llama a visitor.item() con cada elemento de la lista 'name', en orden.
+  virtual void each(const char *name, Visitor &visitor) const = 0;
+};
+
+class ReceiptTemplate
+{
+public:
+  // false si el template tiene errores; 'error' queda como
+  // "line N: descripción".
+  bool compile(const std::string &source, std::string *error = nullptr);
+
+  // Ejecuta el template con 'data'. El resultado vive en un buffer interno
+  // que se pisa en la próxima llamada: no es thread-safe.
+  const std::vector<uint8_t> &render(const ReceiptScope &data);
+
+  size_t instruction_count() const { return code_.size(); }
+  size_t static_bytes() const { return pool_.size(); }
+
+private:
+  enum class Op : uint8_t
+  {
+    kBytes, // a = offset en pool_, b = largo
+    kField, // a = nombre, b = tabla de caracteres, c = 1 si es UTF-8
+    kRaw,   // a = nombre: bytes del campo tal cual
+    kQr,    // a = nombre, b = offset del prefijo en pool_
+    kRow,   // a = índice en rows_, c = partes que siguen
+    kEach,  // a = nombre, b = fin del cuerpo
+    kIf,    // a = nombre, b = destino si es falso, c = 1 si está negado
+    kJump,  // a = destino
+  };
+
+  struct Instr
+  {
+    Op op;
+    uint32_t a;
+    uint32_t b;
+    uint32_t c;
+  };
+
+  struct Column
+  {
+    uint8_t width; // doceavos
+    EscPosAlign align;
+    int16_t size;   // GS ! propio (-1 = el de la fila)
+    uint16_t parts; // instrucciones kBytes/kField que arman la celda
+  };
+
+  struct Row
+  {
+    EscPosRowOptions options;
+    uint32_t first_column; // en columns_
+    uint32_t count;
+  };
+
+  class Compiler;
+  class EachVisitor;
+
+  void run(size_t pc, size_t end);
+  size_t run_row(size_t pc);
+  bool lookup(uint32_t name, std::string_view &out) const;
+  bool truthy(uint32_t name) const;
+
+  std::vector<Instr> code_;
+  std::vector<uint8_t> pool_;
+  std::vector<std::string> names_;
+  std::vector<Column> columns_;
+  std::vector<Row> rows_;
+
+  // Estado de render: se reutiliza para no reservar memoria en cada ticket.
+  std::vector<uint8_t> out_;
+  std::vector<uint8_t> cells_; // texto UTF-8 de las celdas de una fila
+  EscPosRowLayout layout_;
+  std::vector<const ReceiptScope *> scopes_;
+};
+
+#endif // FLUTTER_PLUGIN_TI_PRINTER_RECEIPT_TEMPLATE_H_
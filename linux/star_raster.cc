@@ -0,0 +1,127 @@
+#include "star_raster.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace
+{
+
+constexpr uint8_t ESC = 0x1B;
+
+// ESC * r Y lleva la cantidad en decimal ASCII; la tanda se parte para no
+// depender de cuántos dígitos acepta cada modelo.
+constexpr int kMaxVerticalMove = 255;
+
+// "b n1 n2": hasta 65535 bytes por fila, de sobra para cualquier cabezal.
+constexpr size_t kMaxRowBytes = 0xFFFF;
+
+struct StarUsbModel
+{
+  int vid;
+  int pid;
+};
+
+// Mismo criterio que 'escpos/starprnt' en database_printer.dart.
+constexpr StarUsbModel kStarRasterModels[] = {
+    {0x0519, 0x0003}, // TSP100ECO / TSP100II
+};
+
+void append_command(std::vector<uint8_t> &out, char op, const char *value)
+{
+  out.push_back(ESC);
+  out.push_back('*');
+  out.push_back('r');
+  out.push_back(static_cast<uint8_t>(op));
+  if (value != nullptr)
+  {
+    for (const char *p = value; *p; p++)
+      out.push_back(static_cast<uint8_t>(*p));
+    out.push_back(0);
+  }
+}
+
+} // namespace
+
+void StarRasterEncoder::begin(std::vector<uint8_t> &out)
+{
+  blank_ = 0;
+  append_command(out, 'R', nullptr); // inicializar
+  append_command(out, 'A', nullptr); // entrar al modo raster
+  append_command(out, 'P', "0");     // página continua (largo = la imagen)
+}
+
+void StarRasterEncoder::row(const uint8_t *packed, size_t stride,
+                            std::vector<uint8_t> &out)
+{
+  size_t length = std::min(stride, kMaxRowBytes);
+  while (length > 0 && packed[length - 1] == 0)
+    length--;
+  if (length == 0)
+  {
+    blank_++;
+    return;
+  }
+
+  flush_blank(out);
+  out.push_back('b');
+  out.push_back(static_cast<uint8_t>(length & 0xFF));
+  out.push_back(static_cast<uint8_t>(length >> 8));
+  out.insert(out.end(), packed, packed + length);
+}
+
+void StarRasterEncoder::end(std::vector<uint8_t> &out)
+{
+  flush_blank(out);
+  append_command(out, 'B', nullptr); // salir: avance/corte del EOT
+}
+
+void StarRasterEncoder::flush_blank(std::vector<uint8_t> &out)
+{
+  while (blank_ > 0)
+  {
+    const int rows = std::min(blank_, kMaxVerticalMove);
+    char value[8];
+    snprintf(value, sizeof(value), "%d", rows);
+    append_command(out, 'Y', value);
+    blank_ -= rows;
+  }
+}
+
+std::vector<uint8_t> star_raster_image(const uint8_t *gray, int width, int height,
+                                       RasterDither dither)
+{
+  std::vector<uint8_t> out;
+  if (!gray || width <= 0 || height <= 0)
+    return out;
+
+  const size_t stride = static_cast<size_t>(width + 7) / 8;
+  out.reserve(16 + (stride + 3) * height);
+
+  StarRasterEncoder encoder;
+  encoder.begin(out);
+  ErrorDiffuser diffuser(width);
+  std::vector<uint8_t> row(width);
+  std::vector<uint8_t> packed(stride);
+  for (int y = 0; y < height; y++)
+  {
+    std::copy_n(gray + static_cast<size_t>(y) * width, width, row.begin());
+    if (dither == RasterDither::kFloydSteinberg)
+      diffuser.dither_row(row.data());
+    else if (dither == RasterDither::kOrdered)
+      escpos_ordered_row(row.data(), width, y);
+    escpos_pack_row(row.data(), width, packed.data());
+    encoder.row(packed.data(), stride, out);
+  }
+  encoder.end(out);
+  return out;
+}
+
+bool star_raster_device(int vid, int pid)
+{
+  for (const StarUsbModel &model : kStarRasterModels)
+  {
+    if (model.vid == vid && model.pid == pid)
+      return true;
+  }
+  return false;
+}
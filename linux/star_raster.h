@@ -0,0 +1,53 @@
+#ifndef FLUTTER_PLUGIN_TI_PRINTER_STAR_RASTER_H_
+#define FLUTTER_PLUGIN_TI_PRINTER_STAR_RASTER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "escpos_image.h"
+
+// Modo gráfico de Star (Star Graphic Mode / raster), el que usan las TSP100
+// y las StarPRNT. La emulación ESC/POS de esas impresoras recibe GS v 0
+// pero imprime lento; en modo raster van a la velocidad nominal.
+//
+// Cada fila es una orden "b n1 n2 datos" que imprime y avanza una línea.
+// Para mandar menos bytes:
+//   - los bytes en blanco al final de la fila no se envían (la impresora
+//     completa la línea con blanco);
+//   - las filas en blanco no se envían: se juntan en un solo avance
+//     vertical ESC * r Y n NUL.
+//
+// El trabajo va entre ESC * r A (entrar al modo raster, página continua)
+// y ESC * r B (salir), que además ejecuta el avance/corte configurado en
+// la impresora.
+
+class StarRasterEncoder
+{
+public:
+  // Inicializa el modo raster y entra en él.
+  void begin(std::vector<uint8_t> &out);
+
+  // Una fila de 1 bit ('stride' bytes, MSB primero, 1 = negro).
+  void row(const uint8_t *packed, size_t stride, std::vector<uint8_t> &out);
+
+  // Avanza las filas en blanco pendientes y sale del modo raster.
+  void end(std::vector<uint8_t> &out);
+
+private:
+  void flush_blank(std::vector<uint8_t> &out);
+
+  int blank_ = 0; // filas en blanco todavía sin avanzar
+};
+
+// Imagen en grises (0 = negro) → trabajo Star raster completo. Vacío si los
+// parámetros no son válidos.
+std::vector<uint8_t> star_raster_image(const uint8_t *gray, int width, int height,
+                                       RasterDither dither);
+
+// true si la impresora USB es una Star que hay que manejar en modo raster.
+// Son las marcadas 'starprnt' en knownThermalUsbPrinters
+// (lib/database_printer.dart).
+bool star_raster_device(int vid, int pid);
+
+#endif // FLUTTER_PLUGIN_TI_PRINTER_STAR_RASTER_H_
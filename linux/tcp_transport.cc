@@ -0,0 +1,410 @@
+#include "tcp_transport.h"
+
+#include "core_log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Linux system headers para sockets no bloqueantes
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/sendfile.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+namespace
+{
+
+constexpr int kConnectTimeoutMs = 3000;
+// Tiempo máximo sin poder avanzar en un envío (impresora sin papel, buffer
+// lleno, etc.) antes de darlo por fallido.
+constexpr int kSendStallTimeoutMs = 5000;
+// A partir de este tamaño el envío se considera "bulk" (raster, logos).
+constexpr size_t kBulkThreshold = 4096;
+constexpr int kSendBufferBytes = 256 * 1024;
+// Bytes por llamada a sendfile(): el progreso se informa entre llamadas.
+constexpr size_t kSendFileChunk = 1024 * 1024;
+
+// Keepalive: detectar impresoras apagadas mientras la conexión está ociosa.
+constexpr int kKeepIdleSec = 30;
+constexpr int kKeepIntervalSec = 5;
+constexpr int kKeepCount = 3;
+
+void set_int_opt(int fd, int level, int name, int value)
+{
+  setsockopt(fd, level, name, &value, sizeof(value));
+}
+
+// Espera 'events' sobre el socket de la conexión. Devuelve los eventos
+// recibidos, 0 en timeout o -1 en error.
+int wait_for(TcpConnection &conn, uint32_t events, int timeout_ms)
+{
+  struct epoll_event ev{};
+  ev.events = events;
+  ev.data.fd = conn.fd;
+  if (epoll_ctl(conn.epoll_fd, EPOLL_CTL_MOD, conn.fd, &ev) != 0)
+    return -1;
+
+  struct epoll_event out{};
+  while (true)
+  {
+    int n = epoll_wait(conn.epoll_fd, &out, 1, timeout_ms);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return n;
+    return static_cast<int>(out.events);
+  }
+}
+
+int connect_one(const struct addrinfo *ai, int epoll_fd, TcpConnection &conn)
+{
+  int fd = socket(ai->ai_family, ai->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                  ai->ai_protocol);
+  if (fd < 0)
+    return -1;
+
+  // Consultas de estado: sin Nagle para que DLE EOT salga en el acto.
+  set_int_opt(fd, IPPROTO_TCP, TCP_NODELAY, 1);
+  // Raster: buffer de envío grande para no bloquear en cada banda.
+  set_int_opt(fd, SOL_SOCKET, SO_SNDBUF, kSendBufferBytes);
+  set_int_opt(fd, SOL_SOCKET, SO_KEEPALIVE, 1);
+  set_int_opt(fd, IPPROTO_TCP, TCP_KEEPIDLE, kKeepIdleSec);
+  set_int_opt(fd, IPPROTO_TCP, TCP_KEEPINTVL, kKeepIntervalSec);
+  set_int_opt(fd, IPPROTO_TCP, TCP_KEEPCNT, kKeepCount);
+
+  struct epoll_event ev{};
+  ev.events = EPOLLOUT;
+  ev.data.fd = fd;
+  if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev) != 0)
+  {
+    close(fd);
+    return -1;
+  }
+
+  conn.fd = fd;
+  conn.epoll_fd = epoll_fd;
+
+  if (connect(fd, ai->ai_addr, ai->ai_addrlen) != 0)
+  {
+    if (errno != EINPROGRESS)
+    {
+      epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+      close(fd);
+      conn.fd = -1;
+      return -1;
+    }
+
+    int soerr = 0;
+    socklen_t len = sizeof(soerr);
+    if (wait_for(conn, EPOLLOUT, kConnectTimeoutMs) <= 0 ||
+        getsockopt(fd, SOL_SOCKET, SO_ERROR, &soerr, &len) != 0 || soerr != 0)
+    {
+      epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+      close(fd);
+      conn.fd = -1;
+      return -1;
+    }
+  }
+
+  return fd;
+}
+
+// Descarta bytes pendientes (respuestas tardías de consultas anteriores o
+// ASB) para que la próxima lectura corresponda al comando enviado.
+void drain_input(TcpConnection &conn)
+{
+  uint8_t buffer[256];
+  while (recv(conn.fd, buffer, sizeof(buffer), MSG_DONTWAIT) > 0)
+  {
+  }
+}
+
+bool is_disconnect_error(int err)
+{
+  return err == EPIPE || err == ECONNRESET || err == ENOTCONN ||
+         err == ETIMEDOUT || err == EHOSTUNREACH || err == ENETUNREACH;
+}
+
+bool send_all(TcpConnection &conn, const uint8_t *data, size_t length,
+              size_t &sent)
+{
+  sent = 0;
+  while (sent < length)
+  {
+    ssize_t n = send(conn.fd, data + sent, length - sent, MSG_NOSIGNAL);
+    if (n >= 0)
+    {
+      sent += static_cast<size_t>(n);
+      continue;
+    }
+    if (errno == EINTR)
+      continue;
+    if (errno == EAGAIN || errno == EWOULDBLOCK)
+    {
+      int ev = wait_for(conn, EPOLLOUT, kSendStallTimeoutMs);
+      if (ev > 0 && !(ev & (EPOLLERR | EPOLLHUP)))
+        continue;
+      if (ev == 0)
+        errno = ETIMEDOUT;
+      else
+        errno = EPIPE;
+    }
+    return false;
+  }
+  return true;
+}
+
+} // namespace
+
+bool tcp_close(TcpConnection &conn)
+{
+  bool ok = true;
+  if (conn.fd >= 0)
+  {
+    ok = close(conn.fd) == 0;
+    conn.fd = -1;
+  }
+  if (conn.epoll_fd >= 0)
+  {
+    close(conn.epoll_fd);
+    conn.epoll_fd = -1;
+  }
+  return ok;
+}
+
+bool tcp_is_alive(TcpConnection &conn)
+{
+  if (conn.fd < 0)
+    return false;
+
+  uint8_t probe;
+  ssize_t n = recv(conn.fd, &probe, 1, MSG_PEEK | MSG_DONTWAIT);
+  if (n > 0)
+    return true;
+  if (n == 0)
+    return false; // el peer cerró (FIN)
+  return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+}
+
+bool tcp_open(TcpConnection &conn, const std::string &host, int port)
+{
+  if (host.empty() || port <= 0 || port > 65535)
+    return false;
+
+  // Reutilizar la conexión si apunta al mismo destino y sigue viva.
+  if (conn.fd >= 0 && conn.host == host && conn.port == port &&
+      tcp_is_alive(conn))
+  {
+    return true;
+  }
+  tcp_close(conn);
+
+  struct addrinfo hints{};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  hints.ai_flags = AI_NUMERICSERV;
+
+  std::string port_str = std::to_string(port);
+  struct addrinfo *res = nullptr;
+  int gai = getaddrinfo(host.c_str(), port_str.c_str(), &hints, &res);
+  if (gai != 0)
+  {
+    core_log("No se pudo resolver %s: %s\n", host.c_str(), gai_strerror(gai));
+    return false;
+  }
+
+  int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  if (epoll_fd < 0)
+  {
+    freeaddrinfo(res);
+    return false;
+  }
+
+  int fd = -1;
+  for (struct addrinfo *ai = res; ai != nullptr && fd < 0; ai = ai->ai_next)
+  {
+    fd = connect_one(ai, epoll_fd, conn);
+  }
+  freeaddrinfo(res);
+
+  if (fd < 0)
+  {
+    core_log("No se pudo conectar a %s:%d\n", host.c_str(), port);
+    close(epoll_fd);
+    conn.epoll_fd = -1;
+    return false;
+  }
+
+  conn.host = host;
+  conn.port = port;
+  return true;
+}
+
+bool tcp_send(TcpConnection &conn, const uint8_t *data, size_t length)
+{
+  if (conn.fd < 0 || !data || length == 0)
+    return false;
+
+  // Una conexión reutilizada puede haber sido cerrada por la impresora
+  // (timeout de inactividad). Si todavía no se envió nada, reconectar una
+  // vez de forma transparente.
+  if (!tcp_is_alive(conn))
+  {
+    std::string host = conn.host;
+    int port = conn.port;
+    tcp_close(conn);
+    if (!tcp_open(conn, host, port))
+      return false;
+  }
+
+  const bool bulk = length >= kBulkThreshold;
+  if (bulk)
+    set_int_opt(conn.fd, IPPROTO_TCP, TCP_CORK, 1);
+
+  size_t sent = 0;
+  bool ok = send_all(conn, data, length, sent);
+  int err = errno;
+
+  if (conn.fd >= 0 && bulk)
+    set_int_opt(conn.fd, IPPROTO_TCP, TCP_CORK, 0); // flush del último segmento
+
+  if (!ok)
+  {
+    core_log("Error escribiendo en TCP %s:%d: %s\n", conn.host.c_str(),
+             conn.port, core_strerror(err));
+    if (is_disconnect_error(err))
+      tcp_close(conn);
+  }
+  return ok;
+}
+
+bool tcp_send_file(TcpConnection &conn, int file_fd, size_t length,
+                   const std::function<bool(size_t sent)> &progress)
+{
+  if (conn.fd < 0 || file_fd < 0 || length == 0)
+    return false;
+
+  if (!tcp_is_alive(conn))
+  {
+    std::string host = conn.host;
+    int port = conn.port;
+    tcp_close(conn);
+    if (!tcp_open(conn, host, port))
+      return false;
+  }
+
+  // sendfile() no tiene MSG_NOSIGNAL: si la impresora corta la conexión
+  // llega un SIGPIPE. Se bloquea en este hilo y se descarta al final.
+  sigset_t pipe_set;
+  sigset_t old_set;
+  sigemptyset(&pipe_set);
+  sigaddset(&pipe_set, SIGPIPE);
+  pthread_sigmask(SIG_BLOCK, &pipe_set, &old_set);
+
+  set_int_opt(conn.fd, IPPROTO_TCP, TCP_CORK, 1);
+
+  off_t offset = 0;
+  int err = 0;
+  while (static_cast<size_t>(offset) < length)
+  {
+    const size_t chunk = std::min(kSendFileChunk, length - static_cast<size_t>(offset));
+    ssize_t n = sendfile(conn.fd, file_fd, &offset, chunk);
+    if (n > 0)
+    {
+      if (progress && !progress(static_cast<size_t>(offset)))
+      {
+        err = ECANCELED;
+        break;
+      }
+      continue;
+    }
+    if (n == 0)
+    {
+      err = EIO; // el archivo se achicó mientras se enviaba
+      break;
+    }
+    if (errno == EINTR)
+      continue;
+    if (errno == EAGAIN || errno == EWOULDBLOCK)
+    {
+      int ev = wait_for(conn, EPOLLOUT, kSendStallTimeoutMs);
+      if (ev > 0 && !(ev & (EPOLLERR | EPOLLHUP)))
+        continue;
+      err = ev == 0 ? ETIMEDOUT : EPIPE;
+      break;
+    }
+    err = errno;
+    break;
+  }
+
+  if (conn.fd >= 0)
+    set_int_opt(conn.fd, IPPROTO_TCP, TCP_CORK, 0); // flush del último segmento
+
+  if (err == EPIPE)
+  {
+    const struct timespec zero = {0, 0};
+    sigtimedwait(&pipe_set, nullptr, &zero);
+  }
+  pthread_sigmask(SIG_SETMASK, &old_set, nullptr);
+
+  if (err != 0)
+  {
+    core_log("Error enviando archivo a TCP %s:%d: %s\n", conn.host.c_str(),
+             conn.port, core_strerror(err));
+    if (is_disconnect_error(err))
+      tcp_close(conn);
+    return false;
+  }
+  return true;
+}
+
+std::vector<uint8_t> tcp_read_status(TcpConnection &conn,
+                                     const std::vector<uint8_t> &command,
+                                     size_t expected, int timeout_ms)
+{
+  std::vector<uint8_t> result;
+  if (conn.fd < 0)
+    return result;
+
+  drain_input(conn);
+
+  if (!command.empty() && !tcp_send(conn, command.data(), command.size()))
+    return result;
+
+  // Las respuestas de varias consultas pueden llegar en segmentos separados.
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::milliseconds(std::max(0, timeout_ms));
+  do
+  {
+    const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+        deadline - std::chrono::steady_clock::now());
+    int ev = wait_for(conn, EPOLLIN, std::max(0, static_cast<int>(left.count())));
+    if (ev <= 0 || !(ev & EPOLLIN))
+      break;
+
+    uint8_t buffer[256];
+    ssize_t n = recv(conn.fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+    if (n > 0)
+    {
+      result.insert(result.end(), buffer, buffer + n);
+    }
+    else
+    {
+      if (n == 0)
+        tcp_close(conn); // la impresora cerró la conexión
+      break;
+    }
+  } while (result.size() < expected);
+
+  return result;
+}
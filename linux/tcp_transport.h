@@ -0,0 +1,61 @@
+#ifndef FLUTTER_PLUGIN_TI_PRINTER_TCP_TRANSPORT_H_
+#define FLUTTER_PLUGIN_TI_PRINTER_TCP_TRANSPORT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Transporte TCP "raw" (puerto 9100 / JetDirect) para impresoras de red.
+//
+// Expone la misma forma que el camino USB (open / send / read_status) para
+// que la lógica de estado DLE EOT y de trabajos sea compartida. El socket es
+// no bloqueante y todas las esperas se hacen sobre un epoll propio de la
+// conexión, así cada operación tiene un timeout acotado.
+//
+// La conexión se mantiene abierta entre trabajos: un tcp_open() al mismo
+// host:puerto reutiliza el socket si el peer sigue vivo.
+
+constexpr int kTcpDefaultPort = 9100;
+// Igual que read_status_usb: 500 ms de espera para la respuesta DLE EOT.
+constexpr int kTcpStatusTimeoutMs = 500;
+
+struct TcpConnection
+{
+  int fd = -1;
+  int epoll_fd = -1;
+  std::string host;
+  int port = 0;
+};
+
+// Conecta (o reutiliza la conexión viva) a host:port.
+bool tcp_open(TcpConnection &conn, const std::string &host, int port);
+
+// Cierra el socket y el epoll asociado. Idempotente.
+bool tcp_close(TcpConnection &conn);
+
+// true si hay socket abierto y el peer no cerró la conexión.
+bool tcp_is_alive(TcpConnection &conn);
+
+// Envía todo el buffer. Los trabajos grandes (raster) se agrupan con
+// TCP_CORK para llenar segmentos completos; los chicos salen inmediatamente
+// gracias a TCP_NODELAY.
+bool tcp_send(TcpConnection &conn, const uint8_t *data, size_t length);
+
+// Envía los primeros 'length' bytes de 'file_fd' con sendfile(), sin
+// copiarlos al proceso, agrupados con TCP_CORK. 'progress' recibe los bytes
+// enviados hasta el momento; si devuelve false el envío se corta.
+bool tcp_send_file(TcpConnection &conn, int file_fd, size_t length,
+                   const std::function<bool(size_t sent)> &progress);
+
+// Descarta bytes viejos, envía 'command' (ej. DLE EOT n) y devuelve los
+// bytes de la primera lectura (vacío si no hubo respuesta en
+// 'timeout_ms'). Con 'expected' sigue leyendo hasta juntar esa cantidad de
+// bytes y vuelve apenas los tiene.
+std::vector<uint8_t> tcp_read_status(TcpConnection &conn,
+                                     const std::vector<uint8_t> &command,
+                                     size_t expected = 0,
+                                     int timeout_ms = kTcpStatusTimeoutMs);
+
+#endif // FLUTTER_PLUGIN_TI_PRINTER_TCP_TRANSPORT_H_
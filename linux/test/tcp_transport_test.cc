@@ -0,0 +1,237 @@
+// tcp_open / tcp_send / tcp_read_status contra un servidor en 127.0.0.1:
+// reutilización de la conexión, reconexión después de que la impresora
+// cerró el socket, lectura de estado con varias respuestas y el timeout de
+// tcp_read_status.
+//
+// Sin dependencias: cada CHECK que falla se informa y el proceso termina
+// con 1 (ctest lo cuenta como fallido).
+
+#include "tcp_transport.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace
+{
+
+int failures = 0;
+
+#define CHECK(cond)                                                       \
+  do                                                                      \
+  {                                                                       \
+    if (!(cond))                                                          \
+    {                                                                     \
+      std::fprintf(stderr, "%s:%d: falló %s\n", __FILE__, __LINE__, #cond); \
+      failures++;                                                         \
+    }                                                                     \
+  } while (0)
+
+// "Impresora" en un puerto libre de loopback.
+class FakePrinter
+{
+public:
+  FakePrinter()
+  {
+    listen_fd_ = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t length = sizeof(address);
+    if (listen_fd_ < 0 || bind(listen_fd_, reinterpret_cast<sockaddr *>(&address), length) != 0 ||
+        listen(listen_fd_, 4) != 0 ||
+        getsockname(listen_fd_, reinterpret_cast<sockaddr *>(&address), &length) != 0)
+      return;
+    port_ = ntohs(address.sin_port);
+  }
+
+  ~FakePrinter()
+  {
+    if (listen_fd_ >= 0)
+      close(listen_fd_);
+  }
+
+  int port() const { return port_; }
+
+  // Próxima conexión del cliente (-1 si no llega en 'timeout_ms').
+  int accept_client(int timeout_ms = 1000)
+  {
+    pollfd pfd = {listen_fd_, POLLIN, 0};
+    if (poll(&pfd, 1, timeout_ms) <= 0)
+      return -1;
+    return accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+  }
+
+private:
+  int listen_fd_ = -1;
+  int port_ = 0;
+};
+
+// Lee hasta 'length' bytes de 'fd' (o lo que llegue en 'timeout_ms').
+std::vector<uint8_t> receive(int fd, size_t length, int timeout_ms = 1000)
+{
+  std::vector<uint8_t> data;
+  while (data.size() < length)
+  {
+    pollfd pfd = {fd, POLLIN, 0};
+    if (poll(&pfd, 1, timeout_ms) <= 0)
+      break;
+    uint8_t buffer[256];
+    const ssize_t n = read(fd, buffer, std::min(sizeof(buffer), length - data.size()));
+    if (n <= 0)
+      break;
+    data.insert(data.end(), buffer, buffer + n);
+  }
+  return data;
+}
+
+void send_bytes(int fd, const std::vector<uint8_t> &data)
+{
+  CHECK(write(fd, data.data(), data.size()) == static_cast<ssize_t>(data.size()));
+}
+
+long elapsed_ms(std::chrono::steady_clock::time_point start)
+{
+  return static_cast<long>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                               std::chrono::steady_clock::now() - start)
+                               .count());
+}
+
+void test_send_and_reuse(FakePrinter &printer)
+{
+  TcpConnection conn;
+  CHECK(tcp_open(conn, "127.0.0.1", printer.port()));
+  const int peer = printer.accept_client();
+  CHECK(peer >= 0);
+
+  const std::vector<uint8_t> ticket = {0x1B, '@', 'h', 'o', 'l', 'a', '\n'};
+  CHECK(tcp_send(conn, ticket.data(), ticket.size()));
+  CHECK(receive(peer, ticket.size()) == ticket);
+
+  // Mismo destino y el peer sigue vivo: no abre otra conexión.
+  const int fd = conn.fd;
+  CHECK(tcp_open(conn, "127.0.0.1", printer.port()));
+  CHECK(conn.fd == fd);
+  CHECK(printer.accept_client(100) < 0);
+
+  tcp_close(conn);
+  CHECK(conn.fd < 0);
+  close(peer);
+}
+
+void test_reconnect_after_peer_close(FakePrinter &printer)
+{
+  TcpConnection conn;
+  CHECK(tcp_open(conn, "127.0.0.1", printer.port()));
+  int peer = printer.accept_client();
+  CHECK(peer >= 0);
+
+  // La impresora corta por inactividad: el próximo envío reconecta solo y
+  // los bytes llegan enteros por la conexión nueva.
+  close(peer);
+  pollfd pfd = {conn.fd, POLLIN, 0};
+  poll(&pfd, 1, 1000); // esperar a que llegue el FIN
+  CHECK(!tcp_is_alive(conn));
+
+  const std::vector<uint8_t> ticket = {'o', 't', 'r', 'o', '\n'};
+  CHECK(tcp_send(conn, ticket.data(), ticket.size()));
+  peer = printer.accept_client();
+  CHECK(peer >= 0);
+  CHECK(receive(peer, ticket.size()) == ticket);
+  CHECK(tcp_is_alive(conn));
+
+  tcp_close(conn);
+  close(peer);
+}
+
+void test_read_status(FakePrinter &printer)
+{
+  TcpConnection conn;
+  CHECK(tcp_open(conn, "127.0.0.1", printer.port()));
+  const int peer = printer.accept_client();
+  CHECK(peer >= 0);
+
+  // Dos DLE EOT en una escritura; la impresora contesta cada uno por
+  // separado y la lectura junta los dos.
+  const std::vector<uint8_t> query = {0x10, 0x04, 0x01, 0x10, 0x04, 0x04};
+  std::thread responder([&] {
+    CHECK(receive(peer, query.size()) == query);
+    send_bytes(peer, {0x16});
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    send_bytes(peer, {0x12});
+  });
+  const auto start = std::chrono::steady_clock::now();
+  const std::vector<uint8_t> reply = tcp_read_status(conn, query, 2, 2000);
+  responder.join();
+  CHECK(reply == std::vector<uint8_t>({0x16, 0x12}));
+  CHECK(elapsed_ms(start) < 1000); // vuelve apenas tiene los bytes
+
+  tcp_close(conn);
+  close(peer);
+}
+
+void test_read_status_timeout(FakePrinter &printer)
+{
+  TcpConnection conn;
+  CHECK(tcp_open(conn, "127.0.0.1", printer.port()));
+  const int peer = printer.accept_client();
+  CHECK(peer >= 0);
+
+  // Sin respuesta: vacío después de 'timeout_ms', no del default.
+  const std::vector<uint8_t> query = {0x10, 0x04, 0x01};
+  auto start = std::chrono::steady_clock::now();
+  CHECK(tcp_read_status(conn, query, 0, 100).empty());
+  long waited = elapsed_ms(start);
+  CHECK(waited >= 90 && waited < kTcpStatusTimeoutMs);
+
+  start = std::chrono::steady_clock::now();
+  CHECK(tcp_read_status(conn, query, 0, kTcpStatusTimeoutMs + 300).empty());
+  waited = elapsed_ms(start);
+  CHECK(waited >= kTcpStatusTimeoutMs + 290 && waited < kTcpStatusTimeoutMs + 1300);
+
+  // Una respuesta que llega tarde se descarta en la consulta siguiente.
+  CHECK(receive(peer, 2 * query.size()).size() == 2 * query.size());
+  send_bytes(peer, {0x7F});
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  std::thread responder([&] {
+    CHECK(receive(peer, query.size()) == query);
+    send_bytes(peer, {0x16});
+  });
+  CHECK(tcp_read_status(conn, query, 1, 1000) == std::vector<uint8_t>({0x16}));
+  responder.join();
+
+  tcp_close(conn);
+  close(peer);
+}
+
+} // namespace
+
+int main()
+{
+  FakePrinter printer;
+  if (printer.port() == 0)
+  {
+    std::fprintf(stderr, "no se pudo escuchar en 127.0.0.1\n");
+    return 1;
+  }
+
+  test_send_and_reuse(printer);
+  test_reconnect_after_peer_close(printer);
+  test_read_status(printer);
+  test_read_status_timeout(printer);
+
+  if (failures > 0)
+  {
+    std::fprintf(stderr, "%d verificaciones fallidas\n", failures);
+    return 1;
+  }
+  std::printf("tcp_transport_test: ok\n");
+  return 0;
+}
@@ -0,0 +1,656 @@
+#include "text_raster.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "escpos_image.h"
+
+#ifdef TI_PRINTER_HAVE_FREETYPE
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#ifdef TI_PRINTER_HAVE_HARFBUZZ
+#include <hb-ft.h>
+#include <hb.h>
+#endif
+#endif
+
+struct TextRasterizer::Face
+{
+  std::string path;
+#ifdef TI_PRINTER_HAVE_FREETYPE
+  FT_Face face = nullptr;
+  int size = 0;
+  // 16.16. Las fuentes de mapa de bits (emoji a color) sólo traen algunos
+  // tamaños: se elige el más cercano y se escala al armar el glifo.
+  int32_t scale = 0x10000;
+#ifdef TI_PRINTER_HAVE_HARFBUZZ
+  hb_font_t *font = nullptr;
+#endif
+#endif
+};
+
+#ifdef TI_PRINTER_HAVE_FREETYPE
+
+namespace
+{
+
+constexpr uint8_t GS = 0x1D;
+
+// Pasado este tamaño el atlas se vacía entero: unos miles de glifos de
+// ticket entran holgados.
+constexpr size_t kMaxAtlasBytes = 4 * 1024 * 1024;
+
+// Los glifos en escala de grises se llevan a 1 bit con umbral fijo; los de
+// color (emoji) con una matriz de Bayer 4x4, para que se vea algo más que
+// el contorno.
+constexpr int kGlyphThreshold = 128;
+constexpr uint8_t kBayer4[4][4] = {
+    {0, 8, 2, 10},
+    {12, 4, 14, 6},
+    {3, 11, 1, 9},
+    {15, 7, 13, 5},
+};
+
+constexpr uint8_t kLeft = 0;
+constexpr uint8_t kRight = 1;
+constexpr uint8_t kNeutral = 2;
+
+// Clase bidi reducida: letras de derecha a izquierda (hebreo, árabe, siríaco,
+// thaana, nko...), neutros (espacios, puntuación, símbolos, emoji) y el
+// resto de izquierda a derecha. Los números cuentan como izquierda a
+// derecha, también los arábigos.
+uint8_t bidi_class(uint32_t cp)
+{
+  if (cp < 0x80)
+  {
+    const uint32_t lower = cp | 0x20;
+    return (cp >= '0' && cp <= '9') || (lower >= 'a' && lower <= 'z') ? kLeft : kNeutral;
+  }
+  if ((cp >= 0x0660 && cp <= 0x0669) || (cp >= 0x06F0 && cp <= 0x06F9))
+    return kLeft;
+  if ((cp >= 0x0590 && cp <= 0x08FF) || (cp >= 0xFB1D && cp <= 0xFDFF) ||
+      (cp >= 0xFE70 && cp <= 0xFEFF) || (cp >= 0x10800 && cp <= 0x10FFF) ||
+      (cp >= 0x1E800 && cp <= 0x1EFFF))
+    return kRight;
+  if ((cp >= 0x00A0 && cp <= 0x00BF) || cp == 0x00D7 || cp == 0x00F7 ||
+      (cp >= 0x2000 && cp <= 0x2BFF) || (cp >= 0x3000 && cp <= 0x303F) ||
+      (cp >= 0xFE00 && cp <= 0xFE0F) || (cp >= 0x1F000 && cp <= 0x1FAFF))
+    return kNeutral;
+  return kLeft;
+}
+
+// ORea un bitmap de 1 bit ('width' x 'rows', filas de (width + 7) / 8
+// bytes) en 'dst' con la esquina arriba a la izquierda en (x, y).
+void blit(const uint8_t *src, int width, int rows, uint8_t *dst, int dst_width,
+          int dst_rows, int x, int y)
+{
+  const size_t src_stride = static_cast<size_t>(width + 7) / 8;
+  const size_t dst_stride = static_cast<size_t>(dst_width + 7) / 8;
+  const int row0 = std::max(0, -y);
+  const int row1 = std::min(rows, dst_rows - y);
+
+  if (x >= 0 && x + width <= dst_width)
+  {
+    // Caso normal: byte a byte, partido en dos por el desplazamiento.
+    const int shift = x & 7;
+    const size_t last = static_cast<size_t>(((x + width - 1) >> 3) - (x >> 3));
+    for (int r = row0; r < row1; r++)
+    {
+      const uint8_t *s = src + r * src_stride;
+      uint8_t *d = dst + (y + r) * dst_stride + (x >> 3);
+      if (shift == 0)
+      {
+        for (size_t i = 0; i < src_stride; i++)
+          d[i] |= s[i];
+        continue;
+      }
+      for (size_t i = 0; i < src_stride; i++)
+      {
+        d[i] |= s[i] >> shift;
+        if (i + 1 <= last)
+          d[i + 1] |= static_cast<uint8_t>(s[i] << (8 - shift));
+      }
+    }
+    return;
+  }
+
+  // Glifo que se sale por un costado: bit a bit, recortando.
+  for (int r = row0; r < row1; r++)
+  {
+    const uint8_t *s = src + r * src_stride;
+    uint8_t *d = dst + (y + r) * dst_stride;
+    for (int c = 0; c < width; c++)
+    {
+      const int dx = x + c;
+      if (dx >= 0 && dx < dst_width && (s[c >> 3] & (0x80 >> (c & 7))))
+        d[dx >> 3] |= static_cast<uint8_t>(0x80 >> (dx & 7));
+    }
+  }
+}
+
+// Filas empaquetadas → GS v 0 en bandas de kRasterBandRows.
+void emit_raster(const uint8_t *rows, size_t stride, int count, std::vector<uint8_t> &out)
+{
+  for (int y0 = 0; y0 < count; y0 += kRasterBandRows)
+  {
+    const int n = std::min(kRasterBandRows, count - y0);
+    const uint8_t header[] = {GS, 'v', '0', 0,
+                              static_cast<uint8_t>(stride & 0xFF),
+                              static_cast<uint8_t>(stride >> 8),
+                              static_cast<uint8_t>(n & 0xFF),
+                              static_cast<uint8_t>(n >> 8)};
+    out.insert(out.end(), header, header + sizeof(header));
+    const uint8_t *band = rows + static_cast<size_t>(y0) * stride;
+    out.insert(out.end(), band, band + static_cast<size_t>(n) * stride);
+  }
+}
+
+int32_t scale_16(int64_t value, int32_t scale)
+{
+  return static_cast<int32_t>((value * scale) >> 16);
+}
+
+} // namespace
+
+TextRasterizer::TextRasterizer()
+{
+  if (FT_Init_FreeType(&library_) != 0)
+    library_ = nullptr;
+#ifdef TI_PRINTER_HAVE_HARFBUZZ
+  buffer_ = hb_buffer_create();
+#endif
+}
+
+TextRasterizer::~TextRasterizer()
+{
+  for (auto &face : faces_)
+  {
+#ifdef TI_PRINTER_HAVE_HARFBUZZ
+    hb_font_destroy(face->font);
+#endif
+    FT_Done_Face(face->face);
+  }
+  faces_.clear();
+#ifdef TI_PRINTER_HAVE_HARFBUZZ
+  hb_buffer_destroy(buffer_);
+#endif
+  if (library_ != nullptr)
+    FT_Done_FreeType(library_);
+}
+
+bool TextRasterizer::available()
+{
+  return true;
+}
+
+size_t TextRasterizer::cached_glyphs()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return glyphs_.size();
+}
+
+bool TextRasterizer::open_fonts(const std::vector<std::string> &fonts, std::string *error)
+{
+  order_.clear();
+  for (const std::string &path : fonts)
+  {
+    auto it = std::find_if(faces_.begin(), faces_.end(),
+                           [&](const std::unique_ptr<Face> &face) { return face->path == path; });
+    if (it != faces_.end())
+    {
+      order_.push_back(static_cast<size_t>(it - faces_.begin()));
+      continue;
+    }
+
+    FT_Face ft_face;
+    if (FT_New_Face(library_, path.c_str(), 0, &ft_face) != 0)
+    {
+      if (error)
+        *error = "cannot open font " + path;
+      return false;
+    }
+    auto face = std::make_unique<Face>();
+    face->path = path;
+    face->face = ft_face;
+#ifdef TI_PRINTER_HAVE_HARFBUZZ
+    face->font = hb_ft_font_create_referenced(ft_face);
+#endif
+    order_.push_back(faces_.size());
+    faces_.push_back(std::move(face));
+  }
+  if (order_.empty())
+  {
+    if (error)
+      *error = "no fonts given";
+    return false;
+  }
+  return true;
+}
+
+void TextRasterizer::set_size(Face &face, int size)
+{
+  if (face.size == size)
+    return;
+  FT_Face f = face.face;
+  if (FT_IS_SCALABLE(f))
+  {
+    FT_Set_Pixel_Sizes(f, 0, static_cast<FT_UInt>(size));
+    face.scale = 0x10000;
+  }
+  else if (f->num_fixed_sizes > 0)
+  {
+    // El tamaño más chico que alcanza (reducir se ve mejor que agrandar) o,
+    // si ninguno alcanza, el más grande.
+    int best = -1;
+    int largest = 0;
+    for (int i = 0; i < f->num_fixed_sizes; i++)
+    {
+      const int ppem = static_cast<int>((f->available_sizes[i].y_ppem + 32) >> 6);
+      const int best_ppem =
+          best < 0 ? 0 : static_cast<int>((f->available_sizes[best].y_ppem + 32) >> 6);
+      if (ppem >= size && (best < 0 || ppem < best_ppem))
+        best = i;
+      if (ppem > static_cast<int>((f->available_sizes[largest].y_ppem + 32) >> 6))
+        largest = i;
+    }
+    if (best < 0)
+      best = largest;
+    FT_Select_Size(f, best);
+    const int ppem = std::max(1, static_cast<int>((f->available_sizes[best].y_ppem + 32) >> 6));
+    face.scale = static_cast<int32_t>((static_cast<int64_t>(size) << 16) / ppem);
+  }
+  face.size = size;
+#ifdef TI_PRINTER_HAVE_HARFBUZZ
+  hb_ft_font_changed(face.font);
+#endif
+}
+
+const TextRasterizer::Glyph &TextRasterizer::glyph(size_t face_index, uint32_t id)
+{
+  const uint64_t key = (static_cast<uint64_t>(face_index) << 48) |
+                       (static_cast<uint64_t>(size_) << 32) | id;
+  auto it = glyphs_.find(key);
+  if (it != glyphs_.end())
+    return it->second;
+
+  Face &face = *faces_[face_index];
+  FT_Face f = face.face;
+  Glyph g{};
+  g.offset = static_cast<uint32_t>(atlas_.size());
+
+  FT_Int32 flags = FT_LOAD_DEFAULT;
+  if (FT_HAS_COLOR(f))
+    flags |= FT_LOAD_COLOR;
+  if (FT_Load_Glyph(f, id, flags) == 0 &&
+      (f->glyph->format == FT_GLYPH_FORMAT_BITMAP ||
+       FT_Render_Glyph(f->glyph, FT_RENDER_MODE_NORMAL) == 0))
+  {
+    const FT_GlyphSlot slot = f->glyph;
+    const FT_Bitmap &bitmap = slot->bitmap;
+    const int32_t scale = face.scale;
+    const int width = scale_16(bitmap.width, scale);
+    const int rows = scale_16(bitmap.rows, scale);
+    g.left = static_cast<int16_t>(scale_16(slot->bitmap_left, scale));
+    g.top = static_cast<int16_t>(scale_16(slot->bitmap_top, scale));
+    g.advance = scale_16(slot->advance.x, scale);
+
+    if (width > 0 && rows > 0 && bitmap.pitch > 0)
+    {
+      g.width = static_cast<uint16_t>(width);
+      g.rows = static_cast<uint16_t>(rows);
+      const size_t stride = static_cast<size_t>(width + 7) / 8;
+      atlas_.resize(atlas_.size() + stride * rows, 0);
+      uint8_t *out = atlas_.data() + g.offset;
+      for (int ty = 0; ty < rows; ty++)
+      {
+        const int sy = static_cast<int>(static_cast<int64_t>(ty) * bitmap.rows / rows);
+        const uint8_t *src = bitmap.buffer + static_cast<size_t>(sy) * bitmap.pitch;
+        for (int tx = 0; tx < width; tx++)
+        {
+          const int sx = static_cast<int>(static_cast<int64_t>(tx) * bitmap.width / width);
+          bool ink = false;
+          switch (bitmap.pixel_mode)
+          {
+          case FT_PIXEL_MODE_MONO:
+            ink = (src[sx >> 3] & (0x80 >> (sx & 7))) != 0;
+            break;
+          case FT_PIXEL_MODE_GRAY:
+            ink = src[sx] >= kGlyphThreshold;
+            break;
+          case FT_PIXEL_MODE_BGRA:
+          {
+            // Premultiplicado: se compone sobre blanco y se tramea.
+            const uint8_t *p = src + sx * 4;
+            const int luma = 255 - p[3] + ((29 * p[0] + 150 * p[1] + 77 * p[2]) >> 8);
+            ink = luma < kBayer4[ty & 3][tx & 3] * 16 + 8;
+            break;
+          }
+          default:
+            break;
+          }
+          if (ink)
+            out[ty * stride + (tx >> 3)] |= static_cast<uint8_t>(0x80 >> (tx & 7));
+        }
+      }
+    }
+  }
+  return glyphs_.emplace(key, g).first->second;
+}
+
+// Separa 'text' en tramos de una fuente y una dirección, ya en orden visual.
+void TextRasterizer::itemize(std::string_view text)
+{
+  chars_.clear();
+  runs_.clear();
+
+  const uint8_t *begin = reinterpret_cast<const uint8_t *>(text.data());
+  const uint8_t *end = begin + text.size();
+  uint32_t face = static_cast<uint32_t>(order_[0]);
+  uint8_t base = kNeutral;
+  for (const uint8_t *p = begin; p < end;)
+  {
+    uint32_t cp;
+    const size_t length = escpos_decode_utf8(p, end, cp);
+    const bool mark = escpos_display_width(cp) == 0 && !chars_.empty();
+
+    // Marcas, ZWJ y selectores de variante siguen al carácter anterior,
+    // así un cluster no se parte entre fuentes ni direcciones.
+    uint8_t bidi = mark ? chars_.back().level : bidi_class(cp);
+    if (!mark && !(cp == ' ' && FT_Get_Char_Index(faces_[face]->face, cp) != 0))
+    {
+      for (size_t index : order_)
+      {
+        if (FT_Get_Char_Index(faces_[index]->face, cp) != 0)
+        {
+          face = static_cast<uint32_t>(index);
+          break;
+        }
+      }
+    }
+    if (base == kNeutral && bidi != kNeutral)
+      base = bidi;
+    chars_.push_back(Char{static_cast<uint32_t>(p - begin), cp, face, bidi});
+    p += length;
+  }
+  if (base == kNeutral)
+    base = kLeft;
+
+  // Los neutros toman la dirección de sus vecinos si coinciden, si no la
+  // del párrafo. Después, niveles: en un párrafo de izquierda a derecha
+  // L = 0 y R = 1; en uno de derecha a izquierda R = 1 y L = 2.
+  const size_t count = chars_.size();
+  for (size_t i = 0; i < count;)
+  {
+    if (chars_[i].level != kNeutral)
+    {
+      i++;
+      continue;
+    }
+    size_t j = i;
+    while (j < count && chars_[j].level == kNeutral)
+      j++;
+    const uint8_t before = i > 0 ? chars_[i - 1].level : base;
+    const uint8_t after = j < count ? chars_[j].level : base;
+    const uint8_t resolved = before == after ? before : base;
+    for (size_t k = i; k < j; k++)
+      chars_[k].level = resolved;
+    i = j;
+  }
+  uint8_t max_level = 0;
+  for (Char &c : chars_)
+  {
+    if (base == kRight)
+      c.level = c.level == kRight ? 1 : 2;
+    else
+      c.level = c.level == kRight ? 1 : 0;
+    max_level = std::max(max_level, c.level);
+  }
+
+  for (size_t i = 0; i < count;)
+  {
+    size_t j = i + 1;
+    while (j < count && chars_[j].face == chars_[i].face && chars_[j].level == chars_[i].level)
+      j++;
+    runs_.push_back(Run{i, j});
+    i = j;
+  }
+
+  // Regla L2: de mayor a menor nivel, se invierte cada secuencia de tramos
+  // con nivel mayor o igual.
+  for (uint8_t level = max_level; level >= 1; level--)
+  {
+    for (size_t i = 0; i < runs_.size();)
+    {
+      if (chars_[runs_[i].first].level < level)
+      {
+        i++;
+        continue;
+      }
+      size_t j = i;
+      while (j < runs_.size() && chars_[runs_[j].first].level >= level)
+        j++;
+      std::reverse(runs_.begin() + i, runs_.begin() + j);
+      i = j;
+    }
+  }
+}
+
+// Da forma a una línea: placed_ queda en orden visual y advances_ con el
+// avance de cada cluster en su primer byte. Devuelve el ancho (26.6).
+int32_t TextRasterizer::shape(std::string_view text)
+{
+  itemize(text);
+  placed_.clear();
+  advances_.assign(text.size(), 0);
+
+  int32_t pen = 0;
+  for (const Run &run : runs_)
+  {
+    const Char &first = chars_[run.first];
+    const size_t face_index = first.face;
+    Face &face = *faces_[face_index];
+    const bool rtl = (first.level & 1) != 0;
+#ifdef TI_PRINTER_HAVE_HARFBUZZ
+    const size_t begin = first.begin;
+    const size_t end = run.last < chars_.size() ? chars_[run.last].begin : text.size();
+    hb_buffer_clear_contents(buffer_);
+    // Se pasa el texto entero para que las formas contextuales vean a los
+    // vecinos del tramo.
+    hb_buffer_add_utf8(buffer_, text.data(), static_cast<int>(text.size()),
+                       static_cast<unsigned>(begin), static_cast<int>(end - begin));
+    hb_buffer_set_direction(buffer_, rtl ? HB_DIRECTION_RTL : HB_DIRECTION_LTR);
+    hb_buffer_guess_segment_properties(buffer_);
+    hb_shape(face.font, buffer_, nullptr, 0);
+
+    unsigned int count = 0;
+    const hb_glyph_info_t *info = hb_buffer_get_glyph_infos(buffer_, &count);
+    const hb_glyph_position_t *pos = hb_buffer_get_glyph_positions(buffer_, nullptr);
+    for (unsigned int k = 0; k < count; k++)
+    {
+      const Glyph &g = glyph(face_index, info[k].codepoint);
+      const int32_t advance = scale_16(pos[k].x_advance, face.scale);
+      placed_.push_back(Placed{g, pen + scale_16(pos[k].x_offset, face.scale),
+                               scale_16(pos[k].y_offset, face.scale)});
+      pen += advance;
+      advances_[info[k].cluster] += advance;
+    }
+#else
+    // Sin HarfBuzz: un glifo por carácter, con kerning en los tramos de
+    // izquierda a derecha; los de derecha a izquierda se recorren al revés.
+    const bool kerning = !rtl && FT_HAS_KERNING(face.face);
+    FT_UInt previous = 0;
+    for (size_t n = 0; n < run.last - run.first; n++)
+    {
+      const Char &c = chars_[rtl ? run.last - 1 - n : run.first + n];
+      const FT_UInt id = FT_Get_Char_Index(face.face, c.codepoint);
+      if (id == 0 && escpos_display_width(c.codepoint) == 0)
+        continue;
+      int32_t advance = 0;
+      if (kerning && previous != 0)
+      {
+        FT_Vector delta;
+        if (FT_Get_Kerning(face.face, previous, id, FT_KERNING_DEFAULT, &delta) == 0)
+          advance = scale_16(delta.x, face.scale);
+      }
+      pen += advance;
+      const Glyph &g = glyph(face_index, id);
+      placed_.push_back(Placed{g, pen, 0});
+      pen += g.advance;
+      advances_[c.begin] += advance + g.advance;
+      previous = id;
+    }
+#endif
+  }
+  return pen;
+}
+
+// Dibuja placed_ en una tira del alto de la línea y la agrega como GS v 0.
+void TextRasterizer::draw_line(int32_t width, const TextRasterOptions &options,
+                               std::vector<uint8_t> &out)
+{
+  const Face &primary = *faces_[order_[0]];
+  const FT_Size_Metrics &metrics = primary.face->size->metrics;
+  int ascent = (scale_16(metrics.ascender, primary.scale) + 63) >> 6;
+  int descent = (scale_16(-metrics.descender, primary.scale) + 63) >> 6;
+  for (const Placed &p : placed_)
+  {
+    if (p.glyph.rows == 0)
+      continue;
+    const int top = p.glyph.top + (p.y >> 6);
+    ascent = std::max(ascent, top);
+    descent = std::max(descent, p.glyph.rows - top);
+  }
+  const int rows = ascent + descent;
+  if (rows <= 0)
+    return;
+
+  const size_t stride = static_cast<size_t>(options.width + 7) / 8;
+  line_.assign(stride * rows, 0);
+
+  const int32_t space = std::max(0, (options.width << 6) - width);
+  int32_t origin = 0;
+  if (options.align == EscPosAlign::kCenter)
+    origin = space / 2;
+  else if (options.align == EscPosAlign::kRight)
+    origin = space;
+
+  for (const Placed &p : placed_)
+  {
+    if (p.glyph.rows == 0)
+      continue;
+    const int x = ((origin + p.x + 32) >> 6) + p.glyph.left;
+    const int y = ascent - (p.glyph.top + (p.y >> 6));
+    blit(atlas_.data() + p.glyph.offset, p.glyph.width, p.glyph.rows, line_.data(),
+         options.width, rows, x, y);
+  }
+  emit_raster(line_.data(), stride, rows, out);
+}
+
+bool TextRasterizer::render(std::string_view text, const std::vector<std::string> &fonts,
+                            const TextRasterOptions &options, std::vector<uint8_t> &out,
+                            std::string *error)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (library_ == nullptr)
+  {
+    if (error)
+      *error = "FreeType could not be initialized";
+    return false;
+  }
+  if (options.size < 4 || options.size > 512 || options.width < 8 || options.width > 4096)
+  {
+    if (error)
+      *error = "size must be 4..512 and width 8..4096";
+    return false;
+  }
+  if (!open_fonts(fonts, error))
+    return false;
+
+  if (atlas_.size() > kMaxAtlasBytes)
+  {
+    glyphs_.clear();
+    atlas_.clear();
+  }
+  size_ = options.size;
+  for (size_t index : order_)
+    set_size(*faces_[index], size_);
+
+  const int32_t limit = options.width << 6;
+  size_t start = 0;
+  while (start < text.size())
+  {
+    size_t end = text.find('\n', start);
+    if (end == std::string_view::npos)
+      end = text.size();
+    std::string_view paragraph = text.substr(start, end - start);
+    if (!paragraph.empty() && paragraph.back() == '\r')
+      paragraph.remove_suffix(1);
+    start = end + 1;
+
+    const int32_t width = shape(paragraph);
+    if (width <= limit)
+    {
+      draw_line(width, options, out);
+      continue;
+    }
+
+    // No entra: se corta en el último espacio que entra o, si no hay, en
+    // el último cluster. Cada línea se vuelve a dar forma por separado.
+    measure_ = advances_;
+    const size_t n = paragraph.size();
+    size_t line_begin = 0;
+    while (line_begin < n)
+    {
+      int32_t used = 0;
+      size_t brk = std::string_view::npos;
+      size_t stop = n;
+      for (size_t i = line_begin; i < n; i++)
+      {
+        const int32_t w = measure_[i];
+        if (paragraph[i] == ' ' && i > line_begin)
+          brk = i;
+        if (w > 0 && used + w > limit && i > line_begin)
+        {
+          stop = brk != std::string_view::npos ? brk : i;
+          break;
+        }
+        used += w;
+      }
+      std::string_view line = paragraph.substr(line_begin, stop - line_begin);
+      while (!line.empty() && line.back() == ' ')
+        line.remove_suffix(1);
+      draw_line(shape(line), options, out);
+
+      line_begin = stop;
+      while (line_begin < n && paragraph[line_begin] == ' ')
+        line_begin++;
+    }
+  }
+  return true;
+}
+
+#else // !TI_PRINTER_HAVE_FREETYPE
+
+TextRasterizer::TextRasterizer() = default;
+TextRasterizer::~TextRasterizer() = default;
+
+bool TextRasterizer::available()
+{
+  return false;
+}
+
+size_t TextRasterizer::cached_glyphs()
+{
+  return 0;
+}
+
+bool TextRasterizer::render(std::string_view, const std::vector<std::string> &,
+                            const TextRasterOptions &, std::vector<uint8_t> &,
+                            std::string *error)
+{
+  if (error)
+    *error = "built without FreeType";
+  return false;
+}
+
+#endif // TI_PRINTER_HAVE_FREETYPE
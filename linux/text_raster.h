@@ -0,0 +1,128 @@
+#ifndef FLUTTER_PLUGIN_TI_PRINTER_TEXT_RASTER_H_
+#define FLUTTER_PLUGIN_TI_PRINTER_TEXT_RASTER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "escpos_layout.h"
+
+// Texto → imagen GS v 0 con fuentes TrueType/OpenType, para escrituras que
+// la impresora no tiene en sus tablas (árabe, hebreo, tailandés, emoji...).
+//
+// FreeType dibuja cada glifo una sola vez por fuente y tamaño; el bitmap se
+// guarda ya llevado a 1 bit en un atlas y las líneas se arman copiando esos
+// bits con desplazamientos, sin volver a pasar por FreeType ni por grises.
+// Con HarfBuzz el texto se da forma (ligaduras, formas contextuales del
+// árabe, marcas del tailandés); sin HarfBuzz se usan los glifos por
+// carácter con kerning. En los dos casos las partes de derecha a izquierda
+// se ordenan con una versión reducida del algoritmo bidi (UAX #9: sin
+// incrustaciones ni espejado).
+//
+// Depende de FreeType en tiempo de compilación (TI_PRINTER_HAVE_FREETYPE,
+// TI_PRINTER_HAVE_HARFBUZZ en CMakeLists.txt); sin FreeType render()
+// siempre falla.
+
+struct FT_LibraryRec_;
+struct hb_buffer_t;
+
+struct TextRasterOptions
+{
+  int size = 24;   // alto del em en puntos de la impresora
+  int width = 576; // ancho de la imagen en puntos
+  EscPosAlign align = EscPosAlign::kLeft;
+};
+
+class TextRasterizer
+{
+public:
+  TextRasterizer();
+  ~TextRasterizer();
+
+  TextRasterizer(const TextRasterizer &) = delete;
+  TextRasterizer &operator=(const TextRasterizer &) = delete;
+
+  // false si el plugin se compiló sin FreeType.
+  static bool available();
+
+  // Agrega a 'out' 'text' (UTF-8, '\n' separa párrafos) como comandos GS v 0
+  // en bandas de kRasterBandRows filas. 'fonts' son rutas a .ttf/.otf/.ttc en
+  // orden de preferencia: cada carácter sale de la primera que lo tiene. Lo
+  // que no entra en el ancho sigue en la línea de abajo. Las fuentes quedan
+  // abiertas para las próximas llamadas. Thread-safe.
+  bool render(std::string_view text, const std::vector<std::string> &fonts,
+              const TextRasterOptions &options, std::vector<uint8_t> &out,
+              std::string *error = nullptr);
+
+  size_t cached_glyphs();
+
+private:
+  struct Face;
+
+  // Glifo ya dibujado: filas de (width + 7) / 8 bytes en atlas_.
+  struct Glyph
+  {
+    int16_t left; // desde el lápiz
+    int16_t top;  // filas por encima de la línea base
+    uint16_t width;
+    uint16_t rows;
+    int32_t advance; // 26.6
+    uint32_t offset;
+  };
+
+  struct Placed
+  {
+    Glyph glyph;
+    int32_t x; // 26.6, desde el comienzo de la línea
+    int32_t y; // 26.6, hacia arriba
+  };
+
+  struct Char
+  {
+    uint32_t begin; // byte en el texto
+    uint32_t codepoint;
+    uint32_t face;  // en faces_
+    uint8_t level;  // bidi: par = izquierda a derecha
+  };
+
+  // Tramo de chars_ [first, last) con una sola fuente y un solo nivel.
+  struct Run
+  {
+    size_t first;
+    size_t last;
+  };
+
+  bool open_fonts(const std::vector<std::string> &fonts, std::string *error);
+  void set_size(Face &face, int size);
+  const Glyph &glyph(size_t face, uint32_t id);
+  void itemize(std::string_view text);
+  int32_t shape(std::string_view text);
+  void draw_line(int32_t width, const TextRasterOptions &options,
+                 std::vector<uint8_t> &out);
+
+  std::mutex mutex_;
+  FT_LibraryRec_ *library_ = nullptr;
+  hb_buffer_t *buffer_ = nullptr;
+  std::vector<std::unique_ptr<Face>> faces_; // todas las abiertas
+  std::vector<size_t> order_;                // las del pedido, en orden
+  int size_ = 0;
+
+  // Caché de glifos: (fuente, tamaño, glifo) → bitmap de 1 bit en atlas_.
+  std::unordered_map<uint64_t, Glyph> glyphs_;
+  std::vector<uint8_t> atlas_;
+
+  // Buffers de trabajo que se reutilizan entre líneas.
+  std::vector<Char> chars_;
+  std::vector<Run> runs_;
+  std::vector<Placed> placed_;
+  std::vector<int32_t> advances_; // por byte del texto: avance de su cluster
+  std::vector<int32_t> measure_;  // advances_ del párrafo entero
+  std::vector<uint8_t> line_;
+};
+
+#endif // FLUTTER_PLUGIN_TI_PRINTER_TEXT_RASTER_H_
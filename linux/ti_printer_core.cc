@@ -0,0 +1,171 @@
+#include "include/ti_printer_core/ti_printer_core.h"
+
+#include <errno.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include "escpos_status.h"
+#include "printer_transport.h"
+#include "usb_devices.h"
+
+// El handle de la API C es sólo el dueño del transporte: todo lo demás
+// (bloques, tiempo real, reconexión TCP) lo hace el transporte.
+struct TiPrinter
+{
+  std::unique_ptr<PrinterTransport> transport;
+};
+
+namespace
+{
+
+template <size_t N>
+void copy_text(char (&out)[N], const std::string &text)
+{
+  std::snprintf(out, N, "%s", text.c_str());
+}
+
+TiPrinter *wrap(std::unique_ptr<PrinterTransport> transport, int *error, int open_error)
+{
+  if (error)
+    *error = open_error;
+  if (!transport)
+    return nullptr;
+  TiPrinter *printer = new (std::nothrow) TiPrinter;
+  if (!printer)
+  {
+    if (error)
+      *error = ENOMEM;
+    return nullptr;
+  }
+  printer->transport = std::move(transport);
+  return printer;
+}
+
+} // namespace
+
+size_t ti_printer_enumerate(TiPrinterInfo *out, size_t capacity)
+{
+  const std::vector<UsbPrinterInfo> printers = list_usb_printers();
+  for (size_t i = 0; out && i < printers.size() && i < capacity; i++)
+  {
+    const UsbPrinterInfo &printer = printers[i];
+    TiPrinterInfo &info = out[i];
+    copy_text(info.path, printer.instance_id);
+    copy_text(info.display_name, printer.display_name);
+    copy_text(info.manufacturer, printer.ieee1284.manufacturer);
+    copy_text(info.model, printer.ieee1284.model);
+    copy_text(info.protocol, printer.ieee1284.protocol);
+    info.vid = printer.vid;
+    info.pid = printer.pid;
+  }
+  return printers.size();
+}
+
+TiPrinter *ti_printer_open_usb(const char *path, int *error)
+{
+  if (!path || !*path)
+    return wrap(nullptr, error, EINVAL);
+  int open_error = 0;
+  auto transport = open_usb_transport(path, open_error);
+  return wrap(std::move(transport), error, open_error);
+}
+
+TiPrinter *ti_printer_open_tcp(const char *host, int port, int *error)
+{
+  if (!host || !*host || port < 0 || port > 65535)
+    return wrap(nullptr, error, EINVAL);
+  int open_error = 0;
+  auto transport = open_tcp_transport(host, port, open_error);
+  return wrap(std::move(transport), error, open_error);
+}
+
+TiPrinter *ti_printer_open_transport(const TiPrinterTransport *transport, int *error)
+{
+  if (!transport)
+    return wrap(nullptr, error, EINVAL);
+  int open_error = 0;
+  auto adopted = adopt_transport(*transport, open_error);
+  return wrap(std::move(adopted), error, open_error);
+}
+
+int ti_printer_write(TiPrinter *printer, const uint8_t *data, size_t length)
+{
+  if (!printer || (!data && length > 0))
+    return EINVAL;
+  return printer->transport->write(data, length);
+}
+
+int ti_printer_send_file(TiPrinter *printer, int fd, uint64_t length,
+                         TiPrinterProgress progress, void *context)
+{
+  if (!printer || fd < 0)
+    return EINVAL;
+  return printer->transport->send_file(fd, static_cast<size_t>(length), [&](size_t sent) {
+    return !progress || progress(sent, context) != 0;
+  });
+}
+
+int ti_printer_transact(TiPrinter *printer, const uint8_t *command, size_t length,
+                        int timeout_ms, size_t expected, uint8_t *reply, size_t capacity)
+{
+  if (!printer || !command || length == 0 || (!reply && capacity > 0))
+    return -EINVAL;
+  int error = 0;
+  const std::vector<uint8_t> bytes =
+      printer->transport->transact(command, length, timeout_ms, expected, error);
+  if (error)
+    return -error;
+  // Si no entra, lo último es lo más nuevo (como en las consultas de estado).
+  const size_t n = bytes.size() < capacity ? bytes.size() : capacity;
+  std::copy(bytes.end() - n, bytes.end(), reply);
+  return static_cast<int>(n);
+}
+
+int ti_printer_query_status(TiPrinter *printer, const int *queries, size_t count,
+                            int timeout_ms, int *replies)
+{
+  if (!printer || !queries || !replies || count == 0)
+    return -EINVAL;
+  std::vector<int> list(queries, queries + count);
+  for (int n : list)
+  {
+    if (!escpos_status_query_valid(n))
+      return -EINVAL;
+  }
+
+  const std::vector<uint8_t> request = escpos_status_request(list);
+  int error = 0;
+  const std::vector<uint8_t> reply = printer->transport->transact(
+      request.data(), request.size(), timeout_ms, list.size(), error);
+  if (error)
+    return -error;
+
+  const std::vector<int> matched = escpos_status_match(list, reply);
+  int answered = 0;
+  for (size_t i = 0; i < count; i++)
+  {
+    replies[i] = matched[i];
+    if (matched[i] >= 0)
+      answered++;
+  }
+  return answered;
+}
+
+int ti_printer_port_status(TiPrinter *printer, int *raw)
+{
+  if (!printer || !raw)
+    return EINVAL;
+  return printer->transport->port_status(*raw);
+}
+
+void ti_printer_close(TiPrinter *printer)
+{
+  if (!printer)
+    return;
+  printer->transport->close();
+  delete printer;
+}
@@ -1,4 +1,5 @@
 #include "include/ti_printer_plugin/ti_printer_plugin.h"
+#include "include/ti_printer_core/ti_printer_core.h"
 
 #include <flutter_linux/flutter_linux.h>
 #include <gtk/gtk.h>
@@ -11,21 +12,44 @@
 // Linux system headers para acceso a dispositivos
 #include <fcntl.h>
 #include <unistd.h>
-#include <dirent.h>
-#include <sys/stat.h>
-#include <sys/sysmacros.h>  // major(), minor()
-#include <sys/select.h>
 #include <errno.h>
 
-// Para lectura de sysfs (idVendor / idProduct)
-#include <fstream>
-#include <sstream>
-#include <climits>   // PATH_MAX
-#include <cstdlib>   // realpath
-#include <utility>   // std::pair
+#include <chrono>
+#include <cinttypes> // PRId64
 #include <cstdio>    // snprintf
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
 
 #include "ti_printer_plugin_private.h"
+#include "tcp_transport.h"
+#include "job_spool.h"
+#include "escpos_lexer.h"
+#include "escpos_optimizer.h"
+#include "escpos_render.h"
+#include "usb_devices.h"
+#include "usb_reconnect.h"
+#include "job_scheduler.h"
+#include "lane_writer.h"
+#include "escpos_image.h"
+#include "raster_pipeline.h"
+#include "image_decode.h"
+#include "raster_cache.h"
+#include "raster_parallel.h"
+#include "escpos_layout.h"
+#include "receipt_template.h"
+#include "text_raster.h"
+#include "file_sender.h"
+#include "label_image.h"
+#include "star_raster.h"
+#include "print_daemon.h"
+#include "job_ring.h"
+#include "escpos_status.h"
+#include "usblp.h"
+#include "capability_probe.h"
 
 #define TI_PRINTER_PLUGIN(obj)                                     \
   (G_TYPE_CHECK_INSTANCE_CAST((obj), ti_printer_plugin_get_type(), \
@@ -37,6 +61,86 @@ struct _TiPrinterPlugin
 
   // File descriptor de la impresora USB (o -1 si no hay ninguno)
   int usb_fd;
+
+  // Hilo de escritura del fd USB: trabajos en bloques con un carril de
+  // tiempo real por delante (consultas de estado, pulso de cajón).
+  LaneWriter *usb_writer;
+
+  // Ids del spool que ya están en la cola del escritor (sólo hilo principal).
+  std::set<uint64_t> *usb_inflight;
+
+  // Imagen que se está imprimiendo por bandas (nullptr si no hay ninguna).
+  RasterPipeline *usb_image;
+
+  // Clave estable del dispositivo abierto (UsbDeviceIdentity::key()); es la
+  // clave de sus trabajos en el spool.
+  std::string *usb_device;
+
+  // Conexión con ti_printer_daemon. Si el servicio está corriendo, la
+  // impresora es de él: openUsbPort la abre allá, usb_fd queda en -1 y
+  // 'usb_daemon_device' tiene la ruta (vacía si el puerto es local).
+  PrintDaemonClient *daemon;
+  std::string *usb_daemon_device;
+
+  // Ring compartido con Dart por FFI que se vacía en usb_writer (nullptr si
+  // la app no abrió ninguno). Se detiene junto con el escritor, pero la
+  // memoria sigue mapeada hasta closeUsbJobRing: Dart puede tener el
+  // puntero.
+  JobRing *usb_ring;
+
+  // Perfiles de capacidades ya medidos, por identidad USB, y el del
+  // dispositivo abierto (válido si 'usb_capabilities_known'). Mientras corre
+  // el probe, los getUsbCapabilities que llegan esperan en
+  // 'usb_probe_calls' (referencias fuertes).
+  CapabilityCache *capabilities;
+  PrinterCapabilities *usb_capabilities;
+  bool usb_capabilities_known;
+  bool usb_probing;
+  std::vector<FlMethodCall *> *usb_probe_calls;
+
+  // Identidad del último dispositivo abierto y watcher que lo re-enlaza
+  // cuando vuelve a aparecer tras una desconexión.
+  UsbDeviceIdentity *usb_identity;
+  UsbReconnectWatcher *reconnect;
+
+  // Journal de trabajos pendientes (nullptr si no se pudo abrir).
+  JobSpool *spool;
+
+  // Colas por dispositivo/grupo para el modo multi-impresora.
+  JobScheduler *scheduler;
+
+  // Imágenes ya convertidas a comandos, por contenido (memoria + disco).
+  RasterCache *raster_cache;
+
+  // Hilos para convertir imágenes altas por bandas en paralelo.
+  WorkStealingPool *raster_pool;
+
+  // Templates de ticket compilados, por id (sólo hilo principal).
+  std::map<int64_t, std::unique_ptr<ReceiptTemplate>> *receipt_templates;
+  int64_t next_receipt_template;
+
+  // Fuentes abiertas y glifos ya dibujados para rasterizeText.
+  TextRasterizer *text_rasterizer;
+
+  // Impresora de red (puerto 9100), abierta con la API C de ti_printer_core
+  // (nullptr si no hay). 'tcp_target' es "host:port", para reutilizar la
+  // conexión si se vuelve a abrir el mismo destino; se reserva con new en
+  // init porque GObject no ejecuta constructores C++ sobre la instancia.
+  TiPrinter *tcp;
+  std::string *tcp_target;
+
+  // Un sendFile por TCP tiene el socket en otro hilo: el resto de los
+  // métodos TCP falla hasta que termine (sólo hilo principal).
+  bool tcp_busy;
+
+  // Canal de eventos con el avance de sendFile; los eventos se descartan
+  // mientras Dart no escucha.
+  FlEventChannel *file_progress;
+  bool file_progress_listening;
+
+  // Canal de eventos con el avance del ring de trabajos.
+  FlEventChannel *job_ring_events;
+  bool job_ring_listening;
 };
 
 struct _TiPrinterPluginClass
@@ -46,145 +150,177 @@ struct _TiPrinterPluginClass
 
 G_DEFINE_TYPE(TiPrinterPlugin, ti_printer_plugin, g_object_get_type())
 
-// ===================== Helpers internos de Linux =====================
+// ===================== Perfil de capacidades =====================
 
-// Agrega a 'out' todos los dispositivos en 'dir_path' cuyo nombre
-// empieza por 'prefix' (ej: /dev/usb/lp0, ttyUSB0, etc.)
-static void add_dev_entries_with_prefix(const char *dir_path,
-                                        const char *prefix,
-                                        std::vector<std::string> &out)
+static FlValue *capabilities_value(const PrinterCapabilities &caps)
 {
-  DIR *d = opendir(dir_path);
-  if (!d)
-    return;
-
-  struct dirent *entry;
-  while ((entry = readdir(d)) != nullptr)
-  {
-    if (entry->d_name[0] == '.')
-      continue;
-    if (std::strncmp(entry->d_name, prefix, std::strlen(prefix)) == 0)
-    {
-      std::string full = std::string(dir_path) + "/" + entry->d_name;
-      struct stat st{};
-      if (stat(full.c_str(), &st) == 0 && S_ISCHR(st.st_mode))
-      {
-        out.push_back(full);
-      }
-    }
-  }
-
-  closedir(d);
+  FlValue *map = fl_value_new_map();
+  fl_value_set_string_take(map, "answered", fl_value_new_bool(caps.answered));
+  fl_value_set_string_take(map, "modelId", fl_value_new_int(caps.model_id));
+  fl_value_set_string_take(map, "typeId", fl_value_new_int(caps.type_id));
+  fl_value_set_string_take(map, "romVersion", fl_value_new_int(caps.rom_version));
+  fl_value_set_string_take(map, "firmware", fl_value_new_string(caps.firmware.c_str()));
+  fl_value_set_string_take(map, "maker", fl_value_new_string(caps.maker.c_str()));
+  fl_value_set_string_take(map, "model", fl_value_new_string(caps.model.c_str()));
+  fl_value_set_string_take(map, "graphics", fl_value_new_bool(caps.graphics));
+  fl_value_set_string_take(map, "symbols", fl_value_new_bool(caps.symbols));
+  fl_value_set_string_take(map, "autoStatusBack", fl_value_new_bool(caps.auto_status_back));
+  fl_value_set_string_take(map, "probedAt", fl_value_new_int(caps.probed_at));
+  return map;
 }
 
-// Resuelve la ruta sysfs real para un dispositivo /dev/...
-// Ejemplo: /dev/usb/lp0 → /sys/devices/.../1-2:1.0/usbmisc/lp0
-static std::string resolve_sysfs_path(const std::string &dev_path) {
-    struct stat st;
-    if (stat(dev_path.c_str(), &st) != 0 || !S_ISCHR(st.st_mode))
-        return "";
-
-    char link_path[PATH_MAX];
-    snprintf(link_path, sizeof(link_path), "/sys/dev/char/%u:%u",
-             major(st.st_rdev), minor(st.st_rdev));
-
-    char resolved[PATH_MAX];
-    if (!realpath(link_path, resolved))
-        return "";
-
-    return resolved;
+static void respond_usb_capabilities(FlMethodCall *method_call, const PrinterCapabilities *caps)
+{
+  g_autoptr(FlValue) result = caps ? capabilities_value(*caps) : fl_value_new_null();
+  g_autoptr(FlMethodResponse) response =
+      FL_METHOD_RESPONSE(fl_method_success_response_new(result));
+  fl_method_call_respond(method_call, response, nullptr);
 }
 
-// Camina desde sysfs_path hacia arriba buscando idVendor/idProduct
-// en el árbol de dispositivos USB.
-static std::pair<int, int> read_vid_pid_from_sysfs(const std::string &sysfs_path) {
-    std::string dir = sysfs_path;
+static void start_usb_probe(TiPrinterPlugin *self);
 
-    while (true) {
-        std::string vendor_path = dir + "/idVendor";
-        std::string product_path = dir + "/idProduct";
+struct UsbProbeEvent
+{
+  TiPrinterPlugin *plugin; // referencia fuerte: el hilo usa el escritor
+  std::string device;      // usb_device al empezar
+  PrinterCapabilities caps;
+};
 
-        std::ifstream vf(vendor_path);
-        std::ifstream pf(product_path);
+static gboolean on_usb_probe_done(gpointer user_data)
+{
+  std::unique_ptr<UsbProbeEvent> event(static_cast<UsbProbeEvent *>(user_data));
+  TiPrinterPlugin *self = event->plugin;
+  self->usb_probing = false;
 
-        if (vf.good() && pf.good()) {
-            int vid = 0, pid = 0;
-            vf >> std::hex >> vid;
-            pf >> std::hex >> pid;
-            return {vid, pid};
-        }
+  // Si mientras tanto se abrió otra impresora, el perfil no es de ella.
+  const bool current = event->device == *self->usb_device;
+  if (current)
+  {
+    *self->usb_capabilities = event->caps;
+    self->usb_capabilities_known = true;
+  }
+  // Sólo se recuerda lo que contestó una impresora con identidad estable:
+  // una apagada se vuelve a medir la próxima vez.
+  if (event->caps.answered && self->usb_identity->valid() && current)
+    self->capabilities->store(event->device, event->caps);
 
-        auto pos = dir.rfind('/');
-        if (pos == std::string::npos || pos == 0)
-            break;
-        dir = dir.substr(0, pos);
+  if (!current && !self->usb_capabilities_known &&
+      (self->usb_fd >= 0 || !self->usb_daemon_device->empty()))
+  {
+    // La impresora nueva se abrió con este probe en curso: le toca a ella,
+    // y los que esperan reciben su perfil.
+    start_usb_probe(self);
+  }
+  else
+  {
+    std::vector<FlMethodCall *> calls;
+    calls.swap(*self->usb_probe_calls);
+    for (FlMethodCall *call : calls)
+    {
+      respond_usb_capabilities(call, current ? &event->caps : nullptr);
+      g_object_unref(call);
     }
+  }
 
-    return {0, 0};
+  g_object_unref(self);
+  return G_SOURCE_REMOVE;
 }
 
-// Devuelve posibles rutas de impresoras térmicas USB.
-struct PrinterDeviceInfo {
-  std::string instanceId;
-  std::string displayName;
-  int vid;
-  int pid;
-};
-
-static std::vector<PrinterDeviceInfo> list_usb_printers()
+// Mide el dispositivo abierto en otro hilo. Las consultas van por el carril
+// de tiempo real (o por el servicio), así que no esperan a un trabajo en
+// curso más de un bloque.
+static void start_usb_probe(TiPrinterPlugin *self)
 {
-  std::vector<PrinterDeviceInfo> printers;
-
-  auto add_entries = [&](const std::string &dir_prefix, const std::string &dev_prefix) {
-    std::vector<std::string> paths;
-    add_dev_entries_with_prefix(dir_prefix.c_str(), dev_prefix.c_str(), paths);
-    for (const auto &path : paths) {
-      PrinterDeviceInfo info;
-      info.instanceId = path;
-      info.vid = 0;
-      info.pid = 0;
+  if (self->usb_probing)
+    return;
+  self->usb_probing = true;
 
-      // Resolver VID/PID real desde sysfs
-      std::string sysfs_path = resolve_sysfs_path(path);
-      if (!sysfs_path.empty()) {
-        auto vid_pid = read_vid_pid_from_sysfs(sysfs_path);
-        info.vid = vid_pid.first;
-        info.pid = vid_pid.second;
-      }
+  ProbeTransact transact;
+  if (!self->usb_daemon_device->empty())
+  {
+    PrintDaemonClient *daemon = self->daemon;
+    const std::string device = *self->usb_daemon_device;
+    transact = [daemon, device](const std::vector<uint8_t> &command, size_t expected,
+                                int timeout_ms) {
+      std::vector<uint8_t> reply;
+      daemon->status_sync(device, command.data(), command.size(), timeout_ms, expected,
+                          reply);
+      return reply;
+    };
+  }
+  else
+  {
+    LaneWriter *writer = self->usb_writer;
+    transact = [writer](const std::vector<uint8_t> &command, size_t expected,
+                        int timeout_ms) {
+      return writer->realtime(command.data(), command.size(), timeout_ms > 0, timeout_ms,
+                              nullptr, expected);
+    };
+  }
 
-      // displayName: si tenemos VID/PID, usamos un nombre descriptivo
-      if (info.vid > 0 || info.pid > 0) {
-        char buf[64];
-        snprintf(buf, sizeof(buf), "USB Printer (VID:0x%04X, PID:0x%04X)",
-                 info.vid, info.pid);
-        info.displayName = buf;
-      } else {
-        auto pos = path.rfind('/');
-        info.displayName = (pos != std::string::npos) ? path.substr(pos + 1) : path;
-      }
+  auto *event = new UsbProbeEvent{TI_PRINTER_PLUGIN(g_object_ref(self)), *self->usb_device, {}};
+  std::thread([event, transact = std::move(transact)]() {
+    event->caps = probe_printer_capabilities(transact);
+    g_idle_add(on_usb_probe_done, event);
+  }).detach();
+}
 
-      printers.push_back(info);
-    }
-  };
+// Perfil del dispositivo recién abierto: del disco si ya se midió en otra
+// sesión; si no, se mide ahora en segundo plano.
+static void load_usb_capabilities(TiPrinterPlugin *self)
+{
+  self->usb_capabilities_known =
+      self->usb_identity->valid() &&
+      self->capabilities->lookup(*self->usb_device, *self->usb_capabilities);
+  if (!self->usb_capabilities_known)
+    start_usb_probe(self);
+}
 
-  add_entries("/dev/usb", "lp");
-  add_entries("/dev", "ttyUSB");
-  add_entries("/dev", "ttyACM");
+static void stop_usb_ring(TiPrinterPlugin *self, int error);
 
-  return printers;
-}
+// Espera de la respuesta del servicio al abrir: si no contesta en este
+// tiempo se abre el dispositivo localmente.
+constexpr int kDaemonOpenTimeoutMs = 1000;
 
 static bool open_usb_port(TiPrinterPlugin *self, const std::string &device_path)
 {
   if (!self)
     return false;
 
-  // Cerrar si ya había un descriptor abierto
+  // Una apertura explícita reemplaza cualquier reconexión en curso.
+  self->reconnect->stop();
+
+  // Cerrar si ya había un descriptor abierto; lo que estaba en cola queda
+  // en el spool.
   if (self->usb_fd >= 0)
   {
+    stop_usb_ring(self, EBADF);
+    self->usb_writer->stop(false);
     close(self->usb_fd);
     self->usb_fd = -1;
   }
+  self->usb_daemon_device->clear();
+
+  // Con el servicio corriendo no se abre el nodo acá: lo tiene abierto él
+  // y lo comparte con las otras apps. Si se cayó, se abre localmente.
+  if (self->daemon->connected() || self->daemon->connect(print_daemon_socket_path()))
+  {
+    const int err = self->daemon->open_sync(device_path, kDaemonOpenTimeoutMs);
+    if (err == 0)
+    {
+      *self->usb_daemon_device = device_path;
+      *self->usb_identity = read_usb_identity(device_path);
+      *self->usb_device = self->usb_identity->key();
+      load_usb_capabilities(self);
+      return true;
+    }
+    if (err != EPIPE && err != ETIMEDOUT)
+    {
+      g_printerr("ti_printer_daemon no pudo abrir %s: %s\n", device_path.c_str(),
+                 g_strerror(err));
+      return false;
+    }
+  }
 
   int fd = open(device_path.c_str(), O_RDWR /*| O_NONBLOCK*/);
   if (fd < 0)
@@ -194,6 +330,12 @@ static bool open_usb_port(TiPrinterPlugin *self, const std::string &device_path)
   }
 
   self->usb_fd = fd;
+  self->usb_writer->start(fd);
+  *self->usb_identity = read_usb_identity(device_path);
+  *self->usb_device = self->usb_identity->key();
+  if (self->usb_identity->device_id.empty())
+    self->usb_identity->device_id = usblp_get_device_id(fd);
+  load_usb_capabilities(self);
   return true;
 }
 
@@ -201,10 +343,22 @@ static bool close_usb_port(TiPrinterPlugin *self)
 {
   if (!self)
     return false;
+
+  // Cierre explícito: no reconectar más este dispositivo.
+  self->reconnect->stop();
+
+  // El servicio deja el dispositivo abierto para los demás clientes.
+  if (!self->usb_daemon_device->empty())
+  {
+    self->usb_daemon_device->clear();
+    return true;
+  }
   if (self->usb_fd >= 0)
   {
-
-    // Para asegurar que todos los datos se envíen antes de cerrar
+    // Terminar los trabajos en cola y asegurar que todos los datos se
+    // envíen antes de cerrar
+    stop_usb_ring(self, EBADF);
+    self->usb_writer->stop(true);
     fsync(self->usb_fd);
 
     if (close(self->usb_fd) == 0)
@@ -217,274 +371,2295 @@ static bool close_usb_port(TiPrinterPlugin *self)
   return true; // ya estaba cerrado
 }
 
-static bool send_command_to_usb(TiPrinterPlugin *self,
+static int resume_spooled_jobs(TiPrinterPlugin *self);
+
+struct UsbReappearedEvent
+{
+  TiPrinterPlugin *plugin; // referencia fuerte, se libera en el callback
+  std::string dev_path;
+};
+
+// Corre en el hilo principal (g_idle_add): re-abre el nodo nuevo y continúa
+// los trabajos que quedaron en el spool.
+static gboolean on_usb_device_reappeared(gpointer user_data)
+{
+  std::unique_ptr<UsbReappearedEvent> event(
+      static_cast<UsbReappearedEvent *>(user_data));
+  TiPrinterPlugin *self = event->plugin;
+
+  // Si mientras tanto la app abrió otro puerto o lo cerró a mano, ignorar.
+  if (self->usb_fd < 0 && self->usb_identity->valid())
+  {
+    int fd = open(event->dev_path.c_str(), O_RDWR);
+    if (fd >= 0)
+    {
+      self->usb_fd = fd;
+      self->usb_writer->start(fd);
+      *self->usb_identity = read_usb_identity(event->dev_path);
+      *self->usb_device = self->usb_identity->key();
+      g_printerr("Impresora reconectada en %s\n", event->dev_path.c_str());
+      resume_spooled_jobs(self);
+    }
+    else
+    {
+      g_printerr("No se pudo reabrir %s: %s\n", event->dev_path.c_str(),
+                 g_strerror(errno));
+    }
+  }
+
+  g_object_unref(self);
+  return G_SOURCE_REMOVE;
+}
+
+// Arranca la vigilancia del dispositivo que acaba de desaparecer. El watcher
+// corre en su propio hilo; el callback sólo agenda la reapertura en el main
+// loop, y usa una referencia débil para no revivir un plugin en dispose.
+static void start_usb_reconnect(TiPrinterPlugin *self)
+{
+  if (!self->usb_identity->valid())
+    return;
+
+  std::shared_ptr<GWeakRef> weak(new GWeakRef, [](GWeakRef *ref) {
+    g_weak_ref_clear(ref);
+    delete ref;
+  });
+  g_weak_ref_init(weak.get(), self);
+
+  self->reconnect->start(*self->usb_identity, [weak](const std::string &path) {
+    gpointer plugin = g_weak_ref_get(weak.get());
+    if (plugin == nullptr)
+      return;
+    g_idle_add(on_usb_device_reappeared,
+               new UsbReappearedEvent{TI_PRINTER_PLUGIN(plugin), path});
+  });
+}
+
+// Maneja un error de escritura en el descriptor 'fd' (hilo principal).
+static void handle_usb_write_error(TiPrinterPlugin *self, int fd, int err)
+{
+  // El fd ya se cerró o se reabrió otro dispositivo: nada que hacer.
+  if (fd < 0 || fd != self->usb_fd)
+    return;
+
+  // Si el dispositivo no esta disponible "desapareció", cerramos el
+  // descriptor y esperamos a que vuelva a aparecer (aunque sea con otro
+  // nombre de nodo).
+  if (err == ENODEV || err == EIO || err == EBADF)
+  {
+    stop_usb_ring(self, err);
+    self->usb_writer->stop(false);
+    close(self->usb_fd);
+    self->usb_fd = -1;
+    if (err != EBADF)
+    {
+      start_usb_reconnect(self);
+    }
+    return;
+  }
+
+  // Error transitorio: el fd sigue abierto y se aceptan trabajos nuevos.
+  self->usb_writer->clear_error();
+}
+
+static void respond_usb_send(FlMethodCall *method_call, bool ok)
+{
+  g_autoptr(FlMethodResponse) response = nullptr;
+  if (ok)
+  {
+    g_autoptr(FlValue) result = fl_value_new_bool(TRUE);
+    response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
+  }
+  else
+  {
+    response = FL_METHOD_RESPONSE(
+        fl_method_error_response_new("ERROR",
+                                     "Failed to send data to USB.",
+                                     nullptr));
+  }
+  fl_method_call_respond(method_call, response, nullptr);
+}
+
+struct UsbJobDoneEvent
+{
+  TiPrinterPlugin *plugin;   // referencia fuerte, se libera en el callback
+  FlMethodCall *method_call; // nullptr para trabajos retomados del spool
+  uint64_t job_id;
+  int fd;
+  bool ok;
+  int error;
+};
+
+// Corre en el hilo principal cuando el escritor termina (o cancela) un
+// trabajo: lo marca en el spool y responde al sendCommandToUsb pendiente.
+static gboolean on_usb_job_done(gpointer user_data)
+{
+  std::unique_ptr<UsbJobDoneEvent> event(static_cast<UsbJobDoneEvent *>(user_data));
+  TiPrinterPlugin *self = event->plugin;
+
+  self->usb_inflight->erase(event->job_id);
+  if (event->ok)
+  {
+    if (event->job_id != 0 && self->spool)
+      self->spool->complete(event->job_id);
+  }
+  else if (event->error != ECANCELED)
+  {
+    handle_usb_write_error(self, event->fd, event->error);
+  }
+
+  if (event->method_call)
+  {
+    // Un trabajo en el spool con reconexión activa se imprime solo al
+    // volver el dispositivo: para la app ya está enviado.
+    const bool sent = event->ok || (event->job_id != 0 && self->reconnect->active());
+    // Si a la app se le responde que falló, el reintento es suyo: el
+    // trabajo sale del spool para que openUsbPort no lo vuelva a imprimir.
+    if (!sent && event->job_id != 0 && self->spool)
+      self->spool->complete(event->job_id);
+    respond_usb_send(event->method_call, sent);
+    g_object_unref(event->method_call);
+  }
+
+  g_object_unref(self);
+  return G_SOURCE_REMOVE;
+}
+
+// Final de un trabajo del escritor USB: pasa el resultado a
+// on_usb_job_done en el hilo principal.
+static LaneWriter::DoneCallback usb_job_done_callback(TiPrinterPlugin *self,
+                                                      uint64_t job_id,
+                                                      FlMethodCall *method_call)
+{
+  auto *event = new UsbJobDoneEvent{
+      TI_PRINTER_PLUGIN(g_object_ref(self)),
+      method_call ? FL_METHOD_CALL(g_object_ref(method_call)) : nullptr,
+      job_id, self->usb_fd, false, 0};
+  return [event](bool ok, int error) {
+    event->ok = ok;
+    event->error = error;
+    g_idle_add(on_usb_job_done, event);
+  };
+}
+
+// Encola 'payload' en el escritor USB. Si 'job_id' no es 0, cada bloque
+// escrito se registra en el spool como offset 'ack_base' + bytes escritos
+// después de los primeros 'skip' (el prefijo modal de un trabajo retomado).
+static void submit_usb_job(TiPrinterPlugin *self,
+                           std::vector<uint8_t> payload,
+                           size_t skip,
+                           uint64_t job_id,
+                           uint64_t ack_base,
+                           FlMethodCall *method_call)
+{
+  LaneWriter::BulkJob job;
+  job.data = std::move(payload);
+  job.skip = skip;
+
+  JobSpool *spool = self->spool;
+  if (job_id != 0 && spool)
+  {
+    self->usb_inflight->insert(job_id);
+    job.progress = [spool, job_id, ack_base](size_t written) {
+      spool->ack(job_id, ack_base + written);
+    };
+  }
+
+  job.done = usb_job_done_callback(self, job_id, method_call);
+  self->usb_writer->submit(std::move(job));
+}
+
+struct DaemonSendEvent
+{
+  TiPrinterPlugin *plugin;   // referencia fuerte, se libera en el callback
+  FlMethodCall *method_call; // referencia fuerte
+  int error;
+};
+
+// Corre en el hilo principal cuando el servicio terminó un trabajo.
+static gboolean on_daemon_sent(gpointer user_data)
+{
+  std::unique_ptr<DaemonSendEvent> event(static_cast<DaemonSendEvent *>(user_data));
+  TiPrinterPlugin *self = event->plugin;
+
+  // El servicio se cerró: el puerto queda cerrado hasta que la app lo
+  // vuelva a abrir (con otro servicio o localmente).
+  if (event->error == EPIPE && !self->daemon->connected())
+    self->usb_daemon_device->clear();
+
+  respond_usb_send(event->method_call, event->error == 0);
+  g_object_unref(event->method_call);
+  g_object_unref(self);
+  return G_SOURCE_REMOVE;
+}
+
+// Respuesta del servicio (desde el hilo lector de la conexión) → responde
+// 'method_call' en el hilo principal.
+static PrintDaemonClient::ReplyCallback daemon_send_callback(TiPrinterPlugin *self,
+                                                            FlMethodCall *method_call)
+{
+  auto *event = new DaemonSendEvent{TI_PRINTER_PLUGIN(g_object_ref(self)),
+                                    FL_METHOD_CALL(g_object_ref(method_call)), 0};
+  return [event](int error, std::vector<uint8_t>) {
+    event->error = error;
+    g_idle_add(on_daemon_sent, event);
+  };
+}
+
+// sendCommandToUsb con la impresora en el servicio. Los comandos de tiempo
+// real van por su carril igual que con el puerto local; el resto es un
+// trabajo más en la cola del dispositivo, detrás de los de otras apps. No
+// pasa por el spool: del trabajo ya se hizo cargo el servicio.
+static void send_command_to_daemon(TiPrinterPlugin *self,
+                                   const uint8_t *data,
+                                   size_t length,
+                                   FlMethodCall *method_call)
+{
+  const std::string &device = *self->usb_daemon_device;
+  if (escpos_is_realtime(data, length))
+    self->daemon->status(device, data, length, 0, 0, daemon_send_callback(self, method_call));
+  else
+    self->daemon->print(device, data, length, daemon_send_callback(self, method_call));
+}
+
+// Envía un trabajo pasando por el spool: se persiste antes de escribirse y
+// sólo se marca terminado cuando llegó completo al dispositivo. Si la app se
+// cae o el dispositivo desaparece con la reconexión activa, el trabajo
+// queda pendiente para resume_spooled_jobs(); si a la app se le responde
+// que falló, sale del spool (el reintento es de ella). La escritura corre en
+// el hilo del escritor; 'method_call' se responde al terminar, así el main
+// loop queda libre para las consultas de estado.
+//
+// Mientras el dispositivo está desconectado y el watcher lo busca, los
+// trabajos se encolan en el spool y se informa éxito: se imprimen solos al
+// reconectar, sin que la app tenga que reabrir ni reenviar.
+static void send_command_to_usb(TiPrinterPlugin *self,
                                 const uint8_t *data,
-                                size_t length)
+                                size_t length,
+                                FlMethodCall *method_call)
+{
+  if (!self || !data || length == 0)
+  {
+    respond_usb_send(method_call, false);
+    return;
+  }
+
+  if (!self->usb_daemon_device->empty())
+  {
+    send_command_to_daemon(self, data, length, method_call);
+    return;
+  }
+
+  if (self->usb_fd < 0)
+  {
+    respond_usb_send(method_call,
+                     self->spool && self->reconnect->active() &&
+                         self->spool->append(*self->usb_device, data, length) != 0);
+    return;
+  }
+
+  // DLE EOT / DLE ENQ / pulso de cajón: van por el carril de tiempo real,
+  // por delante de cualquier trabajo en curso, y no se guardan en el spool.
+  if (escpos_is_realtime(data, length))
+  {
+    const int fd = self->usb_fd;
+    int err = 0;
+    self->usb_writer->realtime(data, length, false, 0, &err);
+    if (err != 0 && err != ETIMEDOUT)
+      handle_usb_write_error(self, fd, err);
+    respond_usb_send(method_call, err == 0);
+    return;
+  }
+
+  uint64_t job_id = 0;
+  if (self->spool)
+  {
+    job_id = self->spool->append(*self->usb_device, data, length);
+  }
+
+  submit_usb_job(self, std::vector<uint8_t>(data, data + length), 0, job_id, 0,
+                 method_call);
+}
+
+// Retoma los trabajos pendientes del dispositivo abierto. Cada uno continúa
+// desde el último fin de línea/banda ya escrito, precedido de los comandos
+// modales (estilos, alineación, code page) anteriores a ese punto para que
+// el resto del ticket salga igual. Devuelve la cantidad de trabajos
+// encolados en el escritor (o ya completos).
+static int resume_spooled_jobs(TiPrinterPlugin *self)
+{
+  if (!self || !self->spool || self->usb_fd < 0)
+    return 0;
+
+  int resumed = 0;
+  for (const SpooledJob &job : self->spool->pending(*self->usb_device))
+  {
+    // Ya está en la cola del escritor (enviado en esta sesión).
+    if (self->usb_inflight->count(job.id) > 0)
+      continue;
+
+    const uint8_t *data = job.data.data();
+    const size_t length = job.data.size();
+    const size_t boundary = escpos_safe_boundary(data, length, job.acked);
+    resumed++;
+
+    if (boundary >= length)
+    {
+      self->spool->complete(job.id);
+      continue;
+    }
+
+    std::vector<uint8_t> payload = escpos_modal_prefix(data, boundary);
+    const size_t prefix = payload.size();
+    payload.insert(payload.end(), data + boundary, data + length);
+    submit_usb_job(self, std::move(payload), prefix, job.id, boundary, nullptr);
+  }
+  return resumed;
+}
+
+// Consulta de estado por el carril de tiempo real: si hay un trabajo
+// escribiéndose, el comando sale en el próximo límite de bloque en lugar de
+// esperar a que termine todo el trabajo. Con 'expected' se lee hasta tener
+// esa cantidad de bytes (varias consultas en una escritura).
+static std::vector<uint8_t> read_status_usb(TiPrinterPlugin *self,
+                                            const std::vector<uint8_t> &command,
+                                            size_t expected)
+{
+  if (self && !self->usb_daemon_device->empty())
+  {
+    std::vector<uint8_t> reply;
+    const int err = self->daemon->status_sync(*self->usb_daemon_device, command.data(),
+                                              command.size(), 500, expected, reply);
+    if (err == EPIPE && !self->daemon->connected())
+      self->usb_daemon_device->clear();
+    return reply;
+  }
+
+  if (!self || self->usb_fd < 0)
+    return {};
+
+  const int fd = self->usb_fd;
+  int err = 0;
+  // Espera hasta 500 ms la respuesta y devuelve TODOS los bytes leídos
+  // (respuestas multi-byte como ESC u o auto status back).
+  std::vector<uint8_t> result =
+      self->usb_writer->realtime(command.data(), command.size(), true, 500, &err, expected);
+  if (err != 0 && err != ETIMEDOUT)
+  {
+    // Si falló la escritura y el dispositivo desapareció, devolvemos vacío
+    handle_usb_write_error(self, fd, err);
+  }
+  return result;
+}
+
+// Estado del puerto por LPGETSTATUS (sólo /dev/usb/lp*): papel, online y
+// error sin escribir nada en el stream, así que no espera al trabajo en
+// curso ni se cruza con respuestas DLE EOT. false si el nodo no es usblp o
+// no hay puerto abierto.
+static bool read_port_status_usb(TiPrinterPlugin *self, UsblpStatus &status)
 {
-  if (!self || self->usb_fd < 0 || !data || length == 0)
+  if (self && !self->usb_daemon_device->empty())
+  {
+    int raw = 0;
+    const int err = self->daemon->port_status_sync(*self->usb_daemon_device, 500, raw);
+    if (err == EPIPE && !self->daemon->connected())
+      self->usb_daemon_device->clear();
+    if (err != 0)
+      return false;
+    status = usblp_decode_status(raw);
+    return true;
+  }
+
+  if (!self || self->usb_fd < 0)
+    return false;
+
+  int err = 0;
+  if (!usblp_get_status(self->usb_fd, status, &err))
+  {
+    // Un control transfer que falla (EIO) no dice que se haya ido.
+    if (err == ENODEV)
+      handle_usb_write_error(self, self->usb_fd, err);
     return false;
+  }
+  return true;
+}
+
+// ===================== Impresión de imágenes por bandas =====================
+
+// Bandas entregadas al escritor y todavía no escritas. Acota la memoria en
+// vuelo y hace que el pipeline avance al ritmo de la impresora.
+constexpr int kMaxImageBandsInFlight = 2;
+
+struct UsbImageFlow
+{
+  std::mutex mutex;
+  std::condition_variable cv;
+  int outstanding = 0;
+  int error = 0; // errno de la primera banda que falló
+};
 
-  const uint8_t *ptr = data;
-  size_t left = length;
+struct UsbImageDoneEvent
+{
+  TiPrinterPlugin *plugin;   // referencia fuerte, se libera en el callback
+  FlMethodCall *method_call; // referencia fuerte
+  int fd;
+  bool ok;
+  int error;
+};
+
+static gboolean on_usb_image_done(gpointer user_data)
+{
+  std::unique_ptr<UsbImageDoneEvent> event(static_cast<UsbImageDoneEvent *>(user_data));
+  TiPrinterPlugin *self = event->plugin;
+
+  // Los hilos del pipeline ya terminaron (o están por hacerlo).
+  delete self->usb_image;
+  self->usb_image = nullptr;
+
+  if (!event->ok && event->error != 0 && event->error != ECANCELED)
+    handle_usb_write_error(self, event->fd, event->error);
+
+  respond_usb_send(event->method_call, event->ok);
+  g_object_unref(event->method_call);
+  g_object_unref(self);
+  return G_SOURCE_REMOVE;
+}
 
-  while (left > 0)
+// Imprime una imagen con el pipeline origen → dither → GS v 0 → escritura:
+// la primera banda sale hacia la impresora mientras las siguientes todavía
+// se procesan. Las bandas pasan por el escritor USB (el carril de tiempo
+// real sigue atendiéndose entre ellas) pero no por el spool, porque el
+// trabajo no existe completo hasta el final. Con ti_printer_daemon la
+// conversión sigue siendo por bandas pero se envía al final, como un solo
+// trabajo. 'method_call' se responde al terminar.
+static void print_image_usb(TiPrinterPlugin *self,
+                            std::vector<uint8_t> pixels,
+                            int width,
+                            int height,
+                            int channels,
+                            RasterDither dither,
+                            FlMethodCall *method_call)
+{
+  const std::string daemon_device = *self->usb_daemon_device;
+  if ((self->usb_fd < 0 && daemon_device.empty()) || self->usb_image != nullptr)
   {
-    ssize_t written = write(self->usb_fd, ptr, left);
-    if (written < 0)
+    respond_usb_send(method_call, false);
+    return;
+  }
+
+  LaneWriter *writer = self->usb_writer;
+  auto flow = std::make_shared<UsbImageFlow>();
+  auto *event = new UsbImageDoneEvent{
+      TI_PRINTER_PLUGIN(g_object_ref(self)),
+      FL_METHOD_CALL(g_object_ref(method_call)), self->usb_fd, false, 0};
+
+  RasterPipeline::SinkFn sink = [writer, flow](std::vector<uint8_t> band) {
     {
-      if (errno == EINTR)
+      std::unique_lock<std::mutex> lock(flow->mutex);
+      flow->cv.wait(lock, [&] {
+        return flow->error != 0 || flow->outstanding < kMaxImageBandsInFlight;
+      });
+      if (flow->error != 0)
+        return false;
+      flow->outstanding++;
+    }
+
+    LaneWriter::BulkJob job;
+    job.data = std::move(band);
+    job.done = [flow](bool ok, int error) {
+      std::lock_guard<std::mutex> lock(flow->mutex);
+      flow->outstanding--;
+      if (!ok && flow->error == 0)
+        flow->error = error != 0 ? error : EIO;
+      flow->cv.notify_all();
+    };
+    writer->submit(std::move(job));
+    return true;
+  };
+
+  RasterPipeline::DoneFn done = [flow, event](bool ok) {
+    // Esperar a que el escritor termine las últimas bandas.
+    std::unique_lock<std::mutex> lock(flow->mutex);
+    flow->cv.wait(lock, [&] { return flow->outstanding == 0; });
+    event->ok = ok && flow->error == 0;
+    event->error = flow->error;
+    g_idle_add(on_usb_image_done, event);
+  };
+
+  // Con el servicio la imagen se junta y va como un solo trabajo: bandas
+  // sueltas en la cola del dispositivo podrían quedar intercaladas con los
+  // trabajos de otra app.
+  if (!daemon_device.empty())
+  {
+    PrintDaemonClient *daemon = self->daemon;
+    auto image = std::make_shared<std::vector<uint8_t>>();
+    sink = [image](std::vector<uint8_t> band) {
+      image->insert(image->end(), band.begin(), band.end());
+      return true;
+    };
+    done = [daemon, daemon_device, image, event](bool ok) {
+      if (!ok)
+      {
+        g_idle_add(on_usb_image_done, event);
+        return;
+      }
+      daemon->print(daemon_device, image->data(), image->size(),
+                    [event](int error, std::vector<uint8_t>) {
+                      event->ok = error == 0;
+                      event->error = error;
+                      g_idle_add(on_usb_image_done, event);
+                    });
+    };
+  }
+
+  RasterPipelineOptions options;
+  options.dither = dither;
+  // Las Star imprimen GS v 0 en emulación, mucho más lento que en su modo
+  // raster nativo. Manda lo que informa la impresora en su device ID; la
+  // tabla por VID/PID queda para las que no lo tienen.
+  const std::string protocol = parse_ieee1284_id(self->usb_identity->device_id).protocol;
+  const bool star = protocol.empty()
+                        ? star_raster_device(self->usb_identity->vid, self->usb_identity->pid)
+                        : protocol.find("starprnt") != std::string::npos;
+  if (star)
+    options.command = RasterCommand::kStarRaster;
+  else if (self->usb_capabilities_known)
+    options.command = capability_raster_command(*self->usb_capabilities);
+  self->usb_image = new RasterPipeline();
+  if (!self->usb_image->start(std::move(pixels), width, height, channels, options,
+                              sink, done))
+  {
+    delete self->usb_image;
+    self->usb_image = nullptr;
+    g_object_unref(event->method_call);
+    g_object_unref(event->plugin);
+    delete event;
+    respond_usb_send(method_call, false);
+  }
+}
+
+// ===================== Envío de archivos =====================
+
+// Cada cuánto se informa el avance de sendFile a Dart (además del final).
+constexpr auto kFileProgressInterval = std::chrono::milliseconds(100);
+
+struct FileProgressEvent
+{
+  TiPrinterPlugin *plugin; // referencia fuerte, se libera en el callback
+  std::string path;
+  uint64_t sent;
+  uint64_t total;
+};
+
+static gboolean on_file_progress(gpointer user_data)
+{
+  std::unique_ptr<FileProgressEvent> event(static_cast<FileProgressEvent *>(user_data));
+  TiPrinterPlugin *self = event->plugin;
+
+  if (self->file_progress && self->file_progress_listening)
+  {
+    g_autoptr(FlValue) map = fl_value_new_map();
+    fl_value_set_string_take(map, "path", fl_value_new_string(event->path.c_str()));
+    fl_value_set_string_take(map, "sent", fl_value_new_int(static_cast<int64_t>(event->sent)));
+    fl_value_set_string_take(map, "total", fl_value_new_int(static_cast<int64_t>(event->total)));
+    fl_event_channel_send(self->file_progress, map, nullptr, nullptr);
+  }
+
+  g_object_unref(self);
+  return G_SOURCE_REMOVE;
+}
+
+// Avance de un envío, desde el hilo que escribe. Se llama en cada bloque;
+// al hilo principal sólo pasa un evento cada kFileProgressInterval.
+static std::function<void(size_t)> file_progress_reporter(TiPrinterPlugin *self,
+                                                          const std::string &path,
+                                                          size_t total)
+{
+  auto last = std::make_shared<std::chrono::steady_clock::time_point>();
+  return [self, path, total, last](size_t sent) {
+    const auto now = std::chrono::steady_clock::now();
+    if (sent < total && now - *last < kFileProgressInterval)
+      return;
+    *last = now;
+    g_idle_add(on_file_progress,
+               new FileProgressEvent{TI_PRINTER_PLUGIN(g_object_ref(self)), path, sent,
+                                     total});
+  };
+}
+
+// Con ti_printer_daemon el fd del archivo pasa por el socket y el servicio
+// lo lee por bloques: los bytes no pasan por el plugin. El avance sólo se
+// informa al final.
+static void send_file_daemon(TiPrinterPlugin *self,
+                             const std::string &path,
+                             FlMethodCall *method_call)
+{
+  MappedFile file;
+  int err = 0;
+  if (!file.open(path, false, &err))
+  {
+    g_printerr("No se pudo abrir %s: %s\n", path.c_str(), g_strerror(err));
+    respond_usb_send(method_call, false);
+    return;
+  }
+
+  auto report = file_progress_reporter(self, path, file.size());
+  auto sent = daemon_send_callback(self, method_call);
+  const size_t total = file.size();
+  self->daemon->print_fd(*self->usb_daemon_device, file.fd(),
+                         [report, sent, total](int error, std::vector<uint8_t> reply) {
+                           if (error == 0)
+                             report(total);
+                           sent(error, std::move(reply));
+                         });
+}
+
+// USB: el archivo pasa por el escritor como un trabajo más, leído con
+// pread() en bloques cortados en límites de comando (el carril de tiempo
+// real sigue atendiéndose), así la memoria no depende del tamaño del
+// archivo. No se mapea: si otro proceso lo trunca mientras se imprime, el
+// trabajo falla con EIO en lugar de un SIGBUS en la app. No pasa por el
+// spool: el archivo ya está en disco y la app puede volver a enviarlo.
+static void send_file_usb(TiPrinterPlugin *self,
+                          const std::string &path,
+                          FlMethodCall *method_call)
+{
+  if (!self->usb_daemon_device->empty())
+  {
+    send_file_daemon(self, path, method_call);
+    return;
+  }
+
+  if (self->usb_fd < 0)
+  {
+    respond_usb_send(method_call, false);
+    return;
+  }
+
+  auto file = std::make_shared<MappedFile>();
+  int err = 0;
+  if (!file->open(path, false, &err))
+  {
+    g_printerr("No se pudo abrir %s: %s\n", path.c_str(), g_strerror(err));
+    respond_usb_send(method_call, false);
+    return;
+  }
+
+  LaneWriter::BulkJob job;
+  job.file = file->fd();
+  job.view_length = file->size();
+  job.progress = file_progress_reporter(self, path, file->size());
+  job.owner = std::move(file);
+  job.done = usb_job_done_callback(self, 0, method_call);
+  self->usb_writer->submit(std::move(job));
+}
+
+struct TcpFileResult
+{
+  FlMethodCall *method_call; // referencia fuerte
+  TiPrinterPlugin *self;     // referencia fuerte
+  bool ok;
+};
+
+static gboolean on_tcp_file_sent(gpointer user_data)
+{
+  std::unique_ptr<TcpFileResult> result(static_cast<TcpFileResult *>(user_data));
+  result->self->tcp_busy = false;
+
+  g_autoptr(FlMethodResponse) response = nullptr;
+  if (result->ok)
+  {
+    g_autoptr(FlValue) value = fl_value_new_bool(TRUE);
+    response = FL_METHOD_RESPONSE(fl_method_success_response_new(value));
+  }
+  else
+  {
+    response = FL_METHOD_RESPONSE(
+        fl_method_error_response_new("ERROR", "Failed to send file to TCP.", nullptr));
+  }
+  fl_method_call_respond(result->method_call, response, nullptr);
+  g_object_unref(result->method_call);
+  g_object_unref(result->self);
+  return G_SOURCE_REMOVE;
+}
+
+// TCP: sendfile() del archivo al socket en un hilo aparte, sin pasar los
+// bytes por el proceso. El socket queda reservado (tcp_busy) hasta el final.
+static void send_file_tcp(TiPrinterPlugin *self,
+                          const std::string &path,
+                          FlMethodCall *method_call)
+{
+  if (!self->tcp || self->tcp_busy)
+  {
+    g_autoptr(FlMethodResponse) response = FL_METHOD_RESPONSE(
+        fl_method_error_response_new("ERROR", "Failed to send file to TCP.", nullptr));
+    fl_method_call_respond(method_call, response, nullptr);
+    return;
+  }
+
+  self->tcp_busy = true;
+  auto *result = new TcpFileResult{FL_METHOD_CALL(g_object_ref(method_call)),
+                                   TI_PRINTER_PLUGIN(g_object_ref(self)), false};
+  std::thread([result, path]() {
+    TiPrinterPlugin *plugin = result->self;
+    MappedFile file;
+    int err = 0;
+    if (file.open(path, false, &err))
+    {
+      auto report = file_progress_reporter(plugin, path, file.size());
+      result->ok = ti_printer_send_file(
+                       plugin->tcp, file.fd(), file.size(),
+                       [](uint64_t sent, void *context) {
+                         (*static_cast<decltype(report) *>(context))(static_cast<size_t>(sent));
+                         return 1;
+                       },
+                       &report) == 0;
+    }
+    else
+    {
+      g_printerr("No se pudo abrir %s: %s\n", path.c_str(), g_strerror(err));
+    }
+    g_idle_add(on_tcp_file_sent, result);
+  }).detach();
+}
+
+static FlMethodErrorResponse *on_file_progress_listen(FlEventChannel *channel,
+                                                      FlValue *args,
+                                                      gpointer user_data)
+{
+  TI_PRINTER_PLUGIN(user_data)->file_progress_listening = true;
+  return nullptr;
+}
+
+static FlMethodErrorResponse *on_file_progress_cancel(FlEventChannel *channel,
+                                                      FlValue *args,
+                                                      gpointer user_data)
+{
+  TI_PRINTER_PLUGIN(user_data)->file_progress_listening = false;
+  return nullptr;
+}
+
+// ===================== Ring de trabajos compartido con Dart =====================
+
+// Tamaño del ring si Dart no pide otro: ~1 s de datos a velocidad USB 1.1.
+constexpr size_t kDefaultJobRingBytes = 1024 * 1024;
+
+struct JobRingEvent
+{
+  TiPrinterPlugin *plugin; // referencia fuerte, se libera en el callback
+  int fd;
+  uint64_t consumed;
+  int error;
+};
+
+// Corre en el hilo principal cuando el escritor terminó un tramo del ring.
+static gboolean on_job_ring_progress(gpointer user_data)
+{
+  std::unique_ptr<JobRingEvent> event(static_cast<JobRingEvent *>(user_data));
+  TiPrinterPlugin *self = event->plugin;
+
+  // Un error del dispositivo se trata como el de cualquier trabajo USB.
+  if (event->error != 0 && event->error != ECANCELED)
+    handle_usb_write_error(self, event->fd, event->error);
+
+  if (self->job_ring_events && self->job_ring_listening)
+  {
+    g_autoptr(FlValue) map = fl_value_new_map();
+    fl_value_set_string_take(map, "consumed",
+                             fl_value_new_int(static_cast<int64_t>(event->consumed)));
+    fl_value_set_string_take(map, "error", fl_value_new_int(event->error));
+    fl_event_channel_send(self->job_ring_events, map, nullptr, nullptr);
+  }
+
+  g_object_unref(self);
+  return G_SOURCE_REMOVE;
+}
+
+// El ring deja de pasar bytes al escritor. Se avisa a Dart con un evento
+// para que no quede esperando espacio que ya no se va a liberar.
+static void stop_usb_ring(TiPrinterPlugin *self, int error)
+{
+  if (!self->usb_ring)
+    return;
+  self->usb_ring->stop(error);
+  g_idle_add(on_job_ring_progress,
+             new JobRingEvent{TI_PRINTER_PLUGIN(g_object_ref(self)), -1,
+                              self->usb_ring->consumed(), self->usb_ring->error()});
+}
+
+// Crea el ring sobre el puerto USB abierto localmente y devuelve su
+// dirección para que Dart lo use por FFI (0 si no se pudo).
+static int64_t open_usb_job_ring(TiPrinterPlugin *self, size_t capacity)
+{
+  if (self->usb_ring || self->usb_fd < 0 || !self->usb_daemon_device->empty())
+    return 0;
+
+  auto ring = std::make_unique<JobRing>();
+  const int fd = self->usb_fd;
+  int err = 0;
+  auto progress = [self, fd](uint64_t consumed, int error) {
+    g_idle_add(on_job_ring_progress,
+               new JobRingEvent{TI_PRINTER_PLUGIN(g_object_ref(self)), fd, consumed, error});
+  };
+  if (!ring->start(capacity, self->usb_writer, progress, &err))
+  {
+    g_printerr("No se pudo crear el ring de trabajos: %s\n", g_strerror(err));
+    return 0;
+  }
+  self->usb_ring = ring.release();
+  return static_cast<int64_t>(reinterpret_cast<intptr_t>(self->usb_ring));
+}
+
+static FlMethodErrorResponse *on_job_ring_listen(FlEventChannel *channel,
+                                                 FlValue *args,
+                                                 gpointer user_data)
+{
+  TI_PRINTER_PLUGIN(user_data)->job_ring_listening = true;
+  return nullptr;
+}
+
+static FlMethodErrorResponse *on_job_ring_cancel(FlEventChannel *channel,
+                                                 FlValue *args,
+                                                 gpointer user_data)
+{
+  TI_PRINTER_PLUGIN(user_data)->job_ring_listening = false;
+  return nullptr;
+}
+
+// ===================== Conversión de imágenes en segundo plano =====================
+
+// Presupuesto de la caché de imágenes: unos cuantos logos en memoria y
+// algunos cientos en disco (un logo de 576x200 son ~15 KB de comandos).
+constexpr size_t kRasterCacheMemoryBytes = 8 * 1024 * 1024;
+constexpr size_t kRasterCacheDiskBytes = 32 * 1024 * 1024;
+
+// Desde esta altura la conversión se reparte entre los núcleos; un logo
+// común se convierte más rápido de corrido.
+constexpr int kParallelRasterRows = 512;
+
+struct ImageBytesResult
+{
+  FlMethodCall *method_call; // referencia fuerte
+  TiPrinterPlugin *self;     // referencia fuerte: el hilo usa la caché
+  std::vector<uint8_t> bytes;
+};
+
+static gboolean on_image_bytes_ready(gpointer user_data)
+{
+  std::unique_ptr<ImageBytesResult> result(static_cast<ImageBytesResult *>(user_data));
+
+  g_autoptr(FlMethodResponse) response = nullptr;
+  if (!result->bytes.empty())
+  {
+    g_autoptr(FlValue) value =
+        fl_value_new_uint8_list(result->bytes.data(), result->bytes.size());
+    response = FL_METHOD_RESPONSE(fl_method_success_response_new(value));
+  }
+  else
+  {
+    response = FL_METHOD_RESPONSE(
+        fl_method_error_response_new("ERROR",
+                                     "No se pudo decodificar la imagen.",
+                                     nullptr));
+  }
+  fl_method_call_respond(result->method_call, response, nullptr);
+  g_object_unref(result->method_call);
+  g_object_unref(result->self);
+  return G_SOURCE_REMOVE;
+}
+
+// Decodifica PNG/JPEG, reduce al ancho de la impresora y arma los comandos
+// GS v 0 o GS ( L, todo fuera del hilo principal (una foto grande tarda
+// decenas de ms). Antes de decodificar se busca en la caché por contenido:
+// un logo repetido sale de memoria o del archivo mapeado sin conversión.
+// Las imágenes altas (un ticket entero) se convierten por bandas en
+// raster_pool. 'method_call' se responde desde el main loop al terminar.
+static void rasterize_image(TiPrinterPlugin *self,
+                            std::vector<uint8_t> encoded,
+                            int max_width,
+                            RasterDither dither,
+                            RasterCommand command,
+                            int density,
+                            FlMethodCall *method_call)
+{
+  auto *result = new ImageBytesResult{FL_METHOD_CALL(g_object_ref(method_call)),
+                                      TI_PRINTER_PLUGIN(g_object_ref(self)),
+                                      {}};
+  std::thread([result, encoded = std::move(encoded), max_width, dither, command,
+               density]() {
+    RasterCache *cache = result->self->raster_cache;
+    const RasterCacheKey key = raster_cache_key(
+        encoded.data(), encoded.size(), max_width, static_cast<uint8_t>(dither),
+        static_cast<uint8_t>(command), static_cast<uint8_t>(density));
+    if (cache == nullptr || !cache->lookup(key, result->bytes))
+    {
+      GrayImage image;
+      if (decode_image_gray(encoded.data(), encoded.size(), max_width, image))
+      {
+        WorkStealingPool *pool = result->self->raster_pool;
+        if (command == RasterCommand::kStarRaster)
+        {
+          result->bytes = star_raster_image(image.pixels.data(), image.width, image.height,
+                                            dither);
+        }
+        else if (pool != nullptr &&
+            (dither == RasterDither::kOrdered || image.height >= kParallelRasterRows))
+        {
+          result->bytes = escpos_raster_image_parallel(image.pixels.data(), image.width,
+                                                       image.height, dither, command,
+                                                       density, *pool);
+        }
+        else
+        {
+          result->bytes = escpos_raster_image(image.pixels.data(), image.width,
+                                              image.height,
+                                              dither == RasterDither::kFloydSteinberg,
+                                              command, density);
+        }
+      }
+      if (cache != nullptr)
+        cache->store(key, result->bytes);
+    }
+    g_idle_add(on_image_bytes_ready, result);
+  }).detach();
+}
+
+// Decodifica una imagen y la devuelve como etiqueta ZPL o TSPL, fuera del
+// hilo principal. No pasa por la caché: las etiquetas suelen cambiar en
+// cada impresión (precio, lote, destinatario).
+static void encode_label_image(TiPrinterPlugin *self,
+                               std::vector<uint8_t> encoded,
+                               int max_width,
+                               RasterDither dither,
+                               LabelImageFormat format,
+                               int x,
+                               int y,
+                               FlMethodCall *method_call)
+{
+  auto *result = new ImageBytesResult{FL_METHOD_CALL(g_object_ref(method_call)),
+                                      TI_PRINTER_PLUGIN(g_object_ref(self)),
+                                      {}};
+  std::thread([result, encoded = std::move(encoded), max_width, dither, format, x, y]() {
+    GrayImage image;
+    if (decode_image_gray(encoded.data(), encoded.size(), max_width, image))
+    {
+      result->bytes = label_image(image.pixels.data(), image.width, image.height, dither,
+                                  format, x, y);
+    }
+    g_idle_add(on_image_bytes_ready, result);
+  }).detach();
+}
+
+// Ejecuta un stream ESC/POS sobre una página de 1 bit y la devuelve como
+// PNG o PBM, fuera del hilo principal.
+static void render_escpos(TiPrinterPlugin *self,
+                          std::vector<uint8_t> data,
+                          int width,
+                          bool png,
+                          FlMethodCall *method_call)
+{
+  auto *result = new ImageBytesResult{FL_METHOD_CALL(g_object_ref(method_call)),
+                                      TI_PRINTER_PLUGIN(g_object_ref(self)),
+                                      {}};
+  std::thread([result, data = std::move(data), width, png]() {
+    EscPosRenderOptions options;
+    options.width = width;
+    EscPosPage page;
+    escpos_render(data.data(), data.size(), options, page);
+    result->bytes = png ? escpos_page_to_png(page) : escpos_page_to_pbm(page);
+    g_idle_add(on_image_bytes_ready, result);
+  }).detach();
+}
+
+// Dibuja texto con fuentes TrueType y lo devuelve como GS v 0, fuera del
+// hilo principal. El rasterizador guarda fuentes y glifos entre llamadas
+// (tiene su propio mutex).
+static void rasterize_text(TiPrinterPlugin *self,
+                           std::string text,
+                           std::vector<std::string> fonts,
+                           TextRasterOptions options,
+                           FlMethodCall *method_call)
+{
+  auto *result = new ImageBytesResult{FL_METHOD_CALL(g_object_ref(method_call)),
+                                      TI_PRINTER_PLUGIN(g_object_ref(self)),
+                                      {}};
+  std::thread([result, text = std::move(text), fonts = std::move(fonts), options]() {
+    std::string error;
+    if (!result->self->text_rasterizer->render(text, fonts, options, result->bytes, &error))
+    {
+      g_printerr("No se pudo dibujar el texto: %s\n", error.c_str());
+      result->bytes.clear();
+    }
+    g_idle_add(on_image_bytes_ready, result);
+  }).detach();
+}
+
+// ===================== Templates de ticket =====================
+
+// Datos de renderReceipt vistos como ReceiptScope: el mapa de Dart
+// (String → String/int/double/bool/Uint8List/List<Map>) se lee en el lugar,
+// sin copiarlo.
+class FlValueReceiptScope : public ReceiptScope
+{
+public:
+  explicit FlValueReceiptScope(FlValue *map) : map_(map) {}
+
+  bool lookup(const char *name, std::string_view &out) const override
+  {
+    FlValue *value = fl_value_lookup_string(map_, name);
+    if (value == nullptr)
+      return false;
+    switch (fl_value_get_type(value))
+    {
+    case FL_VALUE_TYPE_STRING:
+      out = fl_value_get_string(value);
+      return true;
+    case FL_VALUE_TYPE_UINT8_LIST:
+      out = std::string_view(reinterpret_cast<const char *>(fl_value_get_uint8_list(value)),
+                             fl_value_get_length(value));
+      return true;
+    case FL_VALUE_TYPE_INT:
+      snprintf(number_, sizeof(number_), "%" PRId64, fl_value_get_int(value));
+      out = number_;
+      return true;
+    case FL_VALUE_TYPE_FLOAT:
+      snprintf(number_, sizeof(number_), "%g", fl_value_get_float(value));
+      out = number_;
+      return true;
+    case FL_VALUE_TYPE_BOOL:
+      out = fl_value_get_bool(value) ? "true" : "false";
+      return true;
+    default:
+      return false;
+    }
+  }
+
+  size_t count(const char *name) const override
+  {
+    FlValue *value = fl_value_lookup_string(map_, name);
+    if (value == nullptr || fl_value_get_type(value) != FL_VALUE_TYPE_LIST)
+      return 0;
+    return fl_value_get_length(value);
+  }
+
+  void each(const char *name, Visitor &visitor) const override
+  {
+    const size_t length = count(name);
+    FlValue *list = length > 0 ? fl_value_lookup_string(map_, name) : nullptr;
+    for (size_t i = 0; i < length; i++)
+    {
+      FlValue *item = fl_value_get_list_value(list, i);
+      if (fl_value_get_type(item) != FL_VALUE_TYPE_MAP)
+        continue;
+      FlValueReceiptScope scope(item);
+      visitor.item(scope);
+    }
+  }
+
+private:
+  FlValue *map_;
+  mutable char number_[32];
+};
+
+// ===================== Filas en columnas =====================
+
+// Valores opcionales de un mapa de argumentos (layoutRow, rasterizeText).
+static int64_t map_get_int(FlValue *map, const char *key, int64_t fallback)
+{
+  FlValue *v = fl_value_lookup_string(map, key);
+  return v != nullptr && fl_value_get_type(v) == FL_VALUE_TYPE_INT ? fl_value_get_int(v)
+                                                                   : fallback;
+}
+
+static bool map_get_bool(FlValue *map, const char *key, bool fallback)
+{
+  FlValue *v = fl_value_lookup_string(map, key);
+  return v != nullptr && fl_value_get_type(v) == FL_VALUE_TYPE_BOOL ? fl_value_get_bool(v)
+                                                                    : fallback;
+}
+
+// ===================== Transporte TCP (red) =====================
+
+// Todo pasa por la API C de ti_printer_core: el socket, la reconexión y los
+// tiempos de espera son los mismos que ve cualquier otro programa que la
+// enlace.
+
+// Lo más que se devuelve de una respuesta de readStatusTcp.
+constexpr size_t kMaxStatusReply = 256;
+
+static bool close_tcp_port(TiPrinterPlugin *self)
+{
+  if (!self || self->tcp_busy)
+    return false;
+  ti_printer_close(self->tcp);
+  self->tcp = nullptr;
+  self->tcp_target->clear();
+  return true;
+}
+
+static bool open_tcp_port(TiPrinterPlugin *self, const std::string &host, int port)
+{
+  if (!self || self->tcp_busy)
+    return false;
+  const std::string target = host + ":" + std::to_string(port);
+  // Mismo destino: se sigue usando la conexión (si el peer la cortó, el
+  // próximo envío reconecta).
+  if (self->tcp && *self->tcp_target == target)
+    return true;
+
+  close_tcp_port(self);
+  int error = 0;
+  self->tcp = ti_printer_open_tcp(host.c_str(), port, &error);
+  if (!self->tcp)
+    return false;
+  *self->tcp_target = target;
+  return true;
+}
+
+static bool send_command_to_tcp(TiPrinterPlugin *self,
+                                const uint8_t *data,
+                                size_t length)
+{
+  if (!self || !self->tcp || self->tcp_busy)
+    return false;
+  return ti_printer_write(self->tcp, data, length) == 0;
+}
+
+static std::vector<uint8_t> read_status_tcp(TiPrinterPlugin *self,
+                                            const std::vector<uint8_t> &command)
+{
+  if (!self || !self->tcp || self->tcp_busy || command.empty())
+    return {};
+  uint8_t reply[kMaxStatusReply];
+  const int n = ti_printer_transact(self->tcp, command.data(), command.size(),
+                                    kTcpStatusTimeoutMs, 0, reply, sizeof(reply));
+  return n > 0 ? std::vector<uint8_t>(reply, reply + n) : std::vector<uint8_t>();
+}
+
+// DLE EOT n de 'queries' por ti_printer_query_status. -1 en las que no
+// contestaron.
+static std::vector<int> query_status_tcp(TiPrinterPlugin *self,
+                                         const std::vector<int> &queries)
+{
+  std::vector<int> replies(queries.size(), -1);
+  if (self && self->tcp && !self->tcp_busy)
+    ti_printer_query_status(self->tcp, queries.data(), queries.size(),
+                            kTcpStatusTimeoutMs, replies.data());
+  return replies;
+}
+
+// ===================== Consultas de estado en una escritura =====================
+
+// Lee la lista de DLE EOT n de queryStatusUsb/queryStatusTcp. false si no
+// es una lista de 1 a 4.
+static bool parse_status_queries(FlValue *args, std::vector<int> &queries)
+{
+  if (args == nullptr || fl_value_get_type(args) != FL_VALUE_TYPE_LIST ||
+      fl_value_get_length(args) == 0)
+    return false;
+  for (size_t i = 0; i < fl_value_get_length(args); i++)
+  {
+    FlValue *item = fl_value_get_list_value(args, i);
+    if (fl_value_get_type(item) != FL_VALUE_TYPE_INT ||
+        !escpos_status_query_valid(static_cast<int>(fl_value_get_int(item))))
+      return false;
+    queries.push_back(static_cast<int>(fl_value_get_int(item)));
+  }
+  return true;
+}
+
+// {replies: {n: byte}, <bit>: bool...}. Sólo aparecen las consultas que
+// tuvieron respuesta y sus bits.
+static FlValue *status_query_result(const std::vector<int> &queries,
+                                    const std::vector<int> &replies)
+{
+  FlValue *map = fl_value_new_map();
+  g_autoptr(FlValue) bytes = fl_value_new_map();
+  for (size_t i = 0; i < queries.size(); i++)
+  {
+    if (replies[i] < 0)
+      continue;
+    fl_value_set_take(bytes, fl_value_new_int(queries[i]), fl_value_new_int(replies[i]));
+    for (size_t b = 0; b < kEscPosStatusBitCount; b++)
+    {
+      const EscPosStatusBit &bit = kEscPosStatusBits[b];
+      if (bit.query == queries[i])
+        fl_value_set_string_take(
+            map, bit.name, fl_value_new_bool((replies[i] & bit.mask) == bit.mask));
+    }
+  }
+  fl_value_set_string(map, "replies", bytes);
+  return map;
+}
+
+// ===================== Helpers ya existentes =====================
+
+// Implementado acá para que pueda usarse desde private/test.
+FlMethodResponse *get_platform_version()
+{
+  struct utsname uname_data = {};
+  uname(&uname_data);
+  g_autofree gchar *version = g_strdup_printf("Linux %s", uname_data.version);
+  g_autoptr(FlValue) result = fl_value_new_string(version);
+  return FL_METHOD_RESPONSE(fl_method_success_response_new(result));
+}
+
+// ===================== Manejo de MethodChannel =====================
+
+// Called when a method call is received from Flutter.
+static void ti_printer_plugin_handle_method_call(
+    TiPrinterPlugin *self,
+    FlMethodCall *method_call)
+{
+  g_autoptr(FlMethodResponse) response = nullptr;
+
+  const gchar *method = fl_method_call_get_name(method_call);
+
+  if (std::strcmp(method, "getPlatformVersion") == 0)
+  {
+    response = get_platform_version();
+  }
+  else if (std::strcmp(method, "openSerialPort") == 0)
+  {
+    g_autoptr(FlValue) result = fl_value_new_bool(FALSE);
+    response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
+  }
+  else if (std::strcmp(method, "closeSerialPort") == 0)
+  {
+    g_autoptr(FlValue) result = fl_value_new_bool(FALSE);
+    response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
+  }
+  else if (std::strcmp(method, "sendCommandToSerial") == 0)
+  {
+    g_autoptr(FlValue) result = fl_value_new_bool(FALSE);
+    response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
+  }
+  else if (std::strcmp(method, "readStatusSerial") == 0)
+  {
+    g_autoptr(FlValue) result = fl_value_new_uint8_list(nullptr, 0);
+    response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
+  }
+  else if (std::strcmp(method, "getUsbPrinters") == 0)
+  {
+    auto printers = list_usb_printers();
+    g_autoptr(FlValue) result = fl_value_new_list();
+    for (const auto &printer : printers)
+    {
+      g_autoptr(FlValue) map = fl_value_new_map();
+      fl_value_set_string_take(map, "instanceId",
+          fl_value_new_string(printer.instance_id.c_str()));
+      fl_value_set_string_take(map, "displayName",
+          fl_value_new_string(printer.display_name.c_str()));
+      fl_value_set_string_take(map, "vid",
+          fl_value_new_int(printer.vid));
+      fl_value_set_string_take(map, "pid",
+          fl_value_new_int(printer.pid));
+      fl_value_set_string_take(map, "deviceId",
+          fl_value_new_string(printer.device_id.c_str()));
+      fl_value_set_string_take(map, "manufacturer",
+          fl_value_new_string(printer.ieee1284.manufacturer.c_str()));
+      fl_value_set_string_take(map, "model",
+          fl_value_new_string(printer.ieee1284.model.c_str()));
+      fl_value_set_string_take(map, "protocol",
+          fl_value_new_string(printer.ieee1284.protocol.c_str()));
+      fl_value_append_take(result, fl_value_ref(map));
+    }
+    response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
+  }
+  else if (std::strcmp(method, "openUsbPort") == 0)
+  {
+    FlValue *args = fl_method_call_get_args(method_call);
+    const gchar *device = nullptr;
+
+    if (args != nullptr && fl_value_get_type(args) == FL_VALUE_TYPE_MAP)
+    {
+      FlValue *v = fl_value_lookup_string(args, "deviceInstanceId");
+      if (v != nullptr && fl_value_get_type(v) == FL_VALUE_TYPE_STRING)
+      {
+        device = fl_value_get_string(v);
+      }
+    }
+
+    if (device != nullptr && open_usb_port(self, device))
+    {
+      // Si quedaron trabajos a medio imprimir (crash, desconexión), se
+      // retoman apenas el dispositivo vuelve a estar disponible.
+      resume_spooled_jobs(self);
+
+      g_autoptr(FlValue) result = fl_value_new_bool(TRUE);
+      response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
+    }
+    else
+    {
+      response = FL_METHOD_RESPONSE(
+          fl_method_error_response_new("ERROR",
+                                       "No se pudo abrir el puerto USB.",
+                                       nullptr));
+    }
+  }
+  else if (std::strcmp(method, "closeUsbPort") == 0)
+  {
+    bool ok = close_usb_port(self);
+    if (ok)
+    {
+      g_autoptr(FlValue) result = fl_value_new_bool(TRUE);
+      response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
+    }
+    else
+    {
+      response = FL_METHOD_RESPONSE(
+          fl_method_error_response_new("ERROR",
+                                       "No se pudo cerrar el puerto USB.",
+                                       nullptr));
+    }
+  }
+  else if (std::strcmp(method, "usbViaPrintDaemon") == 0)
+  {
+    g_autoptr(FlValue) result =
+        fl_value_new_bool(self->usb_daemon_device->empty() ? FALSE : TRUE);
+    response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
+  }
+  else if (std::strcmp(method, "openUsbJobRing") == 0)
+  {
+    // Argumento opcional: capacidad en bytes
+    FlValue *args = fl_method_call_get_args(method_call);
+    size_t capacity = kDefaultJobRingBytes;
+    if (args != nullptr && fl_value_get_type(args) == FL_VALUE_TYPE_INT &&
+        fl_value_get_int(args) > 0)
+    {
+      capacity = static_cast<size_t>(fl_value_get_int(args));
+    }
+
+    const int64_t ring = open_usb_job_ring(self, capacity);
+    if (ring != 0)
+    {
+      g_autoptr(FlValue) result = fl_value_new_int(ring);
+      response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
+    }
+    else
+    {
+      response = FL_METHOD_RESPONSE(fl_method_error_response_new(
+          "ERROR", "Failed to open job ring (USB port not open locally or ring already open).",
+          nullptr));
+    }
+  }
+  else if (std::strcmp(method, "closeUsbJobRing") == 0)
+  {
+    delete self->usb_ring;
+    self->usb_ring = nullptr;
+    g_autoptr(FlValue) result = fl_value_new_bool(TRUE);
+    response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
+  }
+  else if (std::strcmp(method, "sendCommandToUsb") == 0)
+  {
+    // Argumento: Uint8List directamente
+    FlValue *args = fl_method_call_get_args(method_call);
+    if (args != nullptr &&
+        fl_value_get_type(args) == FL_VALUE_TYPE_UINT8_LIST)
+    {
+      const uint8_t *data = fl_value_get_uint8_list(args);
+      size_t length = fl_value_get_length(args);
+
+      // Responde de forma asíncrona cuando el trabajo termina de escribirse.
+      send_command_to_usb(self, data, length, method_call);
+      return;
+    }
+    else
+    {
+      response = FL_METHOD_RESPONSE(
+          fl_method_error_response_new("INVALID_ARGUMENT",
+                                       "Expected Uint8List as argument.",
+                                       nullptr));
+    }
+  }
+  else if (std::strcmp(method, "printImageUsb") == 0)
+  {
+    // Argumento: {pixels: Uint8List, width, height, channels, dither}
+    FlValue *args = fl_method_call_get_args(method_call);
+    FlValue *pixels = nullptr;
+    int64_t width = 0;
+    int64_t height = 0;
+    int64_t channels = 4;
+    bool dither = true;
+
+    if (args != nullptr && fl_value_get_type(args) == FL_VALUE_TYPE_MAP)
+    {
+      FlValue *p = fl_value_lookup_string(args, "pixels");
+      if (p != nullptr && fl_value_get_type(p) == FL_VALUE_TYPE_UINT8_LIST)
+      {
+        pixels = p;
+      }
+      FlValue *w = fl_value_lookup_string(args, "width");
+      if (w != nullptr && fl_value_get_type(w) == FL_VALUE_TYPE_INT)
+      {
+        width = fl_value_get_int(w);
+      }
+      FlValue *h = fl_value_lookup_string(args, "height");
+      if (h != nullptr && fl_value_get_type(h) == FL_VALUE_TYPE_INT)
+      {
+        height = fl_value_get_int(h);
+      }
+      FlValue *c = fl_value_lookup_string(args, "channels");
+      if (c != nullptr && fl_value_get_type(c) == FL_VALUE_TYPE_INT)
+      {
+        channels = fl_value_get_int(c);
+      }
+      FlValue *d = fl_value_lookup_string(args, "dither");
+      if (d != nullptr && fl_value_get_type(d) == FL_VALUE_TYPE_BOOL)
+      {
+        dither = fl_value_get_bool(d);
+      }
+    }
+
+    if (pixels != nullptr && width > 0 && width <= 0xFFFF && height > 0 &&
+        height <= INT32_MAX && channels > 0 && channels <= 4 &&
+        fl_value_get_length(pixels) >= static_cast<size_t>(width * height * channels))
+    {
+      const uint8_t *data = fl_value_get_uint8_list(pixels);
+      // Responde de forma asíncrona cuando se escribió la última banda.
+      print_image_usb(self,
+                      std::vector<uint8_t>(data, data + fl_value_get_length(pixels)),
+                      static_cast<int>(width), static_cast<int>(height),
+                      static_cast<int>(channels),
+                      dither ? RasterDither::kFloydSteinberg : RasterDither::kThreshold,
+                      method_call);
+      return;
+    }
+
+    response = FL_METHOD_RESPONSE(
+        fl_method_error_response_new("INVALID_ARGUMENT",
+                                     "Expected {pixels, width, height, channels, dither}.",
+                                     nullptr));
+  }
+  else if (std::strcmp(method, "readStatusUsb") == 0)
+  {
+    // Argumento: Uint8List directamente (alineado con sendCommandToUsb)
+    FlValue *args = fl_method_call_get_args(method_call);
+    if (args != nullptr &&
+        fl_value_get_type(args) == FL_VALUE_TYPE_UINT8_LIST)
+    {
+      const uint8_t *cmd_bytes = fl_value_get_uint8_list(args);
+      size_t cmd_len = fl_value_get_length(args);
+      std::vector<uint8_t> command(cmd_bytes, cmd_bytes + cmd_len);
+
+      std::vector<uint8_t> status = read_status_usb(self, command, 0);
+
+      g_autoptr(FlValue) result = nullptr;
+      if (!status.empty())
+      {
+        result = fl_value_new_uint8_list(status.data(), status.size());
+      }
+      else
+      {
+        result = fl_value_new_uint8_list(nullptr, 0);
+      }
+      response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
+    }
+    else
+    {
+      response = FL_METHOD_RESPONSE(
+          fl_method_error_response_new("INVALID_ARGUMENT",
+                                       "Expected Uint8List as argument.",
+                                       nullptr));
+    }
+  }
+  else if (std::strcmp(method, "readUsbPortStatus") == 0)
+  {
+    UsblpStatus status;
+    g_autoptr(FlValue) result = nullptr;
+    if (read_port_status_usb(self, status))
+    {
+      result = fl_value_new_map();
+      fl_value_set_string_take(result, "paperOut", fl_value_new_bool(status.paper_out));
+      fl_value_set_string_take(result, "online", fl_value_new_bool(status.online));
+      fl_value_set_string_take(result, "error", fl_value_new_bool(status.error));
+      fl_value_set_string_take(result, "raw", fl_value_new_int(status.raw));
+    }
+    else
+    {
+      result = fl_value_new_null();
+    }
+    response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
+  }
+  else if (std::strcmp(method, "getUsbCapabilities") == 0)
+  {
+    // Argumento: {refresh: bool}; con refresh se descarta el perfil guardado
+    // y se vuelve a medir (p. ej. después de actualizar el firmware).
+    FlValue *args = fl_method_call_get_args(method_call);
+    const bool refresh = args != nullptr && fl_value_get_type(args) == FL_VALUE_TYPE_MAP &&
+                         map_get_bool(args, "refresh", false);
+    const bool open = self->usb_fd >= 0 || !self->usb_daemon_device->empty();
+    if (!open)
+    {
+      respond_usb_capabilities(method_call, nullptr);
+      return;
+    }
+    if (self->usb_capabilities_known && !refresh && !self->usb_probing)
+    {
+      respond_usb_capabilities(method_call, self->usb_capabilities);
+      return;
+    }
+    if (refresh && !self->usb_probing)
+    {
+      self->capabilities->forget(*self->usb_device);
+      self->usb_capabilities_known = false;
+    }
+    self->usb_probe_calls->push_back(FL_METHOD_CALL(g_object_ref(method_call)));
+    start_usb_probe(self);
+    return;
+  }
+  else if (std::strcmp(method, "resumePendingJobs") == 0)
+  {
+    g_autoptr(FlValue) result = fl_value_new_int(resume_spooled_jobs(self));
+    response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
+  }
+  else if (std::strcmp(method, "discardPendingJobs") == 0)
+  {
+    // Descarta los pendientes del dispositivo abierto (o todos si no hay).
+    bool ok = self->spool != nullptr;
+    if (ok)
+    {
+      self->spool->discard(self->usb_fd >= 0 ? *self->usb_device : std::string());
+    }
+    g_autoptr(FlValue) result = fl_value_new_bool(ok ? TRUE : FALSE);
+    response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
+  }
+  else if (std::strcmp(method, "registerPrinter") == 0)
+  {
+    FlValue *args = fl_method_call_get_args(method_call);
+    const gchar *device = nullptr;
+    const gchar *group = "";
+
+    if (args != nullptr && fl_value_get_type(args) == FL_VALUE_TYPE_MAP)
+    {
+      FlValue *d = fl_value_lookup_string(args, "deviceId");
+      if (d != nullptr && fl_value_get_type(d) == FL_VALUE_TYPE_STRING)
+      {
+        device = fl_value_get_string(d);
+      }
+      FlValue *g = fl_value_lookup_string(args, "group");
+      if (g != nullptr && fl_value_get_type(g) == FL_VALUE_TYPE_STRING)
+      {
+        group = fl_value_get_string(g);
+      }
+    }
+
+    bool ok = device != nullptr && self->scheduler->add_device(device, group);
+    g_autoptr(FlValue) result = fl_value_new_bool(ok ? TRUE : FALSE);
+    response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
+  }
+  else if (std::strcmp(method, "unregisterPrinter") == 0)
+  {
+    FlValue *args = fl_method_call_get_args(method_call);
+    bool ok = args != nullptr && fl_value_get_type(args) == FL_VALUE_TYPE_STRING &&
+              self->scheduler->remove_device(fl_value_get_string(args));
+    g_autoptr(FlValue) result = fl_value_new_bool(ok ? TRUE : FALSE);
+    response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
+  }
+  else if (std::strcmp(method, "submitJob") == 0)
+  {
+    FlValue *args = fl_method_call_get_args(method_call);
+    FlValue *target = nullptr;
+    FlValue *data = nullptr;
+    FlValue *priority = nullptr;
+
+    if (args != nullptr && fl_value_get_type(args) == FL_VALUE_TYPE_MAP)
+    {
+      target = fl_value_lookup_string(args, "target");
+      data = fl_value_lookup_string(args, "data");
+      priority = fl_value_lookup_string(args, "priority");
+    }
+
+    if (target != nullptr && fl_value_get_type(target) == FL_VALUE_TYPE_STRING &&
+        data != nullptr && fl_value_get_type(data) == FL_VALUE_TYPE_UINT8_LIST)
+    {
+      JobPriority prio = JobPriority::kNormal;
+      if (priority != nullptr && fl_value_get_type(priority) == FL_VALUE_TYPE_INT)
+      {
+        int64_t p = fl_value_get_int(priority);
+        if (p >= 0 && p < kJobPriorityCount)
+          prio = static_cast<JobPriority>(p);
+      }
+
+      const uint8_t *bytes = fl_value_get_uint8_list(data);
+      std::vector<uint8_t> job(bytes, bytes + fl_value_get_length(data));
+      uint64_t id = self->scheduler->submit(fl_value_get_string(target), prio,
+                                            std::move(job));
+
+      g_autoptr(FlValue) result = fl_value_new_int(static_cast<int64_t>(id));
+      response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
+    }
+    else
+    {
+      response = FL_METHOD_RESPONSE(
+          fl_method_error_response_new("INVALID_ARGUMENT",
+                                       "Expected {target, data, priority}.",
+                                       nullptr));
+    }
+  }
+  else if (std::strcmp(method, "getSchedulerStats") == 0)
+  {
+    g_autoptr(FlValue) result = fl_value_new_list();
+    for (const auto &st : self->scheduler->stats())
+    {
+      g_autoptr(FlValue) map = fl_value_new_map();
+      fl_value_set_string_take(map, "deviceId", fl_value_new_string(st.id.c_str()));
+      fl_value_set_string_take(map, "group", fl_value_new_string(st.group.c_str()));
+      fl_value_set_string_take(map, "online", fl_value_new_bool(st.online));
+      fl_value_set_string_take(map, "queuedJobs",
+          fl_value_new_int(static_cast<int64_t>(st.queued_jobs)));
+      fl_value_set_string_take(map, "queuedBytes",
+          fl_value_new_int(static_cast<int64_t>(st.queued_bytes)));
+      fl_value_set_string_take(map, "throughput", fl_value_new_float(st.throughput));
+      fl_value_set_string_take(map, "completedJobs",
+          fl_value_new_int(static_cast<int64_t>(st.completed_jobs)));
+      fl_value_append_take(result, fl_value_ref(map));
+    }
+    response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
+  }
+  else if (std::strcmp(method, "openTcpPort") == 0)
+  {
+    FlValue *args = fl_method_call_get_args(method_call);
+    const gchar *host = nullptr;
+    int port = kTcpDefaultPort;
+
+    if (args != nullptr && fl_value_get_type(args) == FL_VALUE_TYPE_MAP)
+    {
+      FlValue *h = fl_value_lookup_string(args, "host");
+      if (h != nullptr && fl_value_get_type(h) == FL_VALUE_TYPE_STRING)
+      {
+        host = fl_value_get_string(h);
+      }
+      FlValue *p = fl_value_lookup_string(args, "port");
+      if (p != nullptr && fl_value_get_type(p) == FL_VALUE_TYPE_INT)
+      {
+        port = static_cast<int>(fl_value_get_int(p));
+      }
+    }
+
+    if (host != nullptr && open_tcp_port(self, host, port))
+    {
+      g_autoptr(FlValue) result = fl_value_new_bool(TRUE);
+      response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
+    }
+    else
+    {
+      response = FL_METHOD_RESPONSE(
+          fl_method_error_response_new("ERROR",
+                                       "No se pudo conectar a la impresora TCP.",
+                                       nullptr));
+    }
+  }
+  else if (std::strcmp(method, "closeTcpPort") == 0)
+  {
+    bool ok = close_tcp_port(self);
+    g_autoptr(FlValue) result = fl_value_new_bool(ok ? TRUE : FALSE);
+    response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
+  }
+  else if (std::strcmp(method, "sendCommandToTcp") == 0)
+  {
+    FlValue *args = fl_method_call_get_args(method_call);
+    if (args != nullptr &&
+        fl_value_get_type(args) == FL_VALUE_TYPE_UINT8_LIST)
+    {
+      const uint8_t *data = fl_value_get_uint8_list(args);
+      size_t length = fl_value_get_length(args);
+
+      if (send_command_to_tcp(self, data, length))
+      {
+        g_autoptr(FlValue) result = fl_value_new_bool(TRUE);
+        response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
+      }
+      else
+      {
+        response = FL_METHOD_RESPONSE(
+            fl_method_error_response_new("ERROR",
+                                         "Failed to send data to TCP.",
+                                         nullptr));
+      }
+    }
+    else
+    {
+      response = FL_METHOD_RESPONSE(
+          fl_method_error_response_new("INVALID_ARGUMENT",
+                                       "Expected Uint8List as argument.",
+                                       nullptr));
+    }
+  }
+  else if (std::strcmp(method, "readStatusTcp") == 0)
+  {
+    FlValue *args = fl_method_call_get_args(method_call);
+    if (args != nullptr &&
+        fl_value_get_type(args) == FL_VALUE_TYPE_UINT8_LIST)
+    {
+      const uint8_t *cmd_bytes = fl_value_get_uint8_list(args);
+      size_t cmd_len = fl_value_get_length(args);
+      std::vector<uint8_t> command(cmd_bytes, cmd_bytes + cmd_len);
+
+      std::vector<uint8_t> status = read_status_tcp(self, command);
+
+      g_autoptr(FlValue) result =
+          fl_value_new_uint8_list(status.data(), status.size());
+      response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
+    }
+    else
+    {
+      response = FL_METHOD_RESPONSE(
+          fl_method_error_response_new("INVALID_ARGUMENT",
+                                       "Expected Uint8List as argument.",
+                                       nullptr));
+    }
+  }
+  else if (std::strcmp(method, "queryStatusUsb") == 0 ||
+           std::strcmp(method, "queryStatusTcp") == 0)
+  {
+    // Argumento: lista de n (DLE EOT n), todas en una sola escritura
+    std::vector<int> queries;
+    if (parse_status_queries(fl_method_call_get_args(method_call), queries))
+    {
+      std::vector<int> replies;
+      if (std::strcmp(method, "queryStatusUsb") == 0)
+      {
+        const std::vector<uint8_t> request = escpos_status_request(queries);
+        replies = escpos_status_match(queries,
+                                      read_status_usb(self, request, queries.size()));
+      }
+      else
+      {
+        replies = query_status_tcp(self, queries);
+      }
+      g_autoptr(FlValue) result = status_query_result(queries, replies);
+      response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
+    }
+    else
+    {
+      response = FL_METHOD_RESPONSE(
+          fl_method_error_response_new("INVALID_ARGUMENT",
+                                       "Expected a list of DLE EOT n values (1-4).",
+                                       nullptr));
+    }
+  }
+  else if (std::strcmp(method, "sendFile") == 0)
+  {
+    // Argumento: {path: archivo ya renderizado, target: 0 USB, 1 TCP}
+    FlValue *args = fl_method_call_get_args(method_call);
+    const gchar *path = nullptr;
+    int64_t target = 0;
+
+    if (args != nullptr && fl_value_get_type(args) == FL_VALUE_TYPE_MAP)
+    {
+      FlValue *p = fl_value_lookup_string(args, "path");
+      if (p != nullptr && fl_value_get_type(p) == FL_VALUE_TYPE_STRING)
+      {
+        path = fl_value_get_string(p);
+      }
+      target = map_get_int(args, "target", target);
+    }
+
+    if (path != nullptr && path[0] != '\0' && (target == 0 || target == 1))
+    {
+      // Responde de forma asíncrona cuando se envió el último byte.
+      if (target == 0)
+        send_file_usb(self, path, method_call);
+      else
+        send_file_tcp(self, path, method_call);
+      return;
+    }
+    else
+    {
+      response = FL_METHOD_RESPONSE(
+          fl_method_error_response_new("INVALID_ARGUMENT",
+                                       "Expected {path, target} with target 0 or 1.",
+                                       nullptr));
+    }
+  }
+  else if (std::strcmp(method, "rasterizeImage") == 0)
+  {
+    // Argumento: {data: Uint8List (PNG/JPEG), width: ancho en puntos, dither,
+    // ordered: trama Bayer en vez de Floyd-Steinberg, graphics: GS ( L en
+    // vez de GS v 0, star: modo raster de Star (ignora graphics y density),
+    // density: 0..3}
+    FlValue *args = fl_method_call_get_args(method_call);
+    FlValue *data = nullptr;
+    int64_t width = 0;
+    bool dither = true;
+    bool ordered = false;
+    bool graphics = false;
+    bool star = false;
+    int64_t density = 0;
+
+    if (args != nullptr && fl_value_get_type(args) == FL_VALUE_TYPE_MAP)
+    {
+      FlValue *d = fl_value_lookup_string(args, "data");
+      if (d != nullptr && fl_value_get_type(d) == FL_VALUE_TYPE_UINT8_LIST)
+      {
+        data = d;
+      }
+      FlValue *w = fl_value_lookup_string(args, "width");
+      if (w != nullptr && fl_value_get_type(w) == FL_VALUE_TYPE_INT)
+      {
+        width = fl_value_get_int(w);
+      }
+      FlValue *f = fl_value_lookup_string(args, "dither");
+      if (f != nullptr && fl_value_get_type(f) == FL_VALUE_TYPE_BOOL)
+      {
+        dither = fl_value_get_bool(f);
+      }
+      FlValue *o = fl_value_lookup_string(args, "ordered");
+      if (o != nullptr && fl_value_get_type(o) == FL_VALUE_TYPE_BOOL)
+      {
+        ordered = fl_value_get_bool(o);
+      }
+      FlValue *g = fl_value_lookup_string(args, "graphics");
+      if (g != nullptr && fl_value_get_type(g) == FL_VALUE_TYPE_BOOL)
+      {
+        graphics = fl_value_get_bool(g);
+      }
+      FlValue *st = fl_value_lookup_string(args, "star");
+      if (st != nullptr && fl_value_get_type(st) == FL_VALUE_TYPE_BOOL)
       {
-        continue;
+        star = fl_value_get_bool(st);
       }
-
-      g_printerr("Error escribiendo en USB: %s\n", g_strerror(errno));
-
-      // Si el dispositivo no esta disponible "desapareció", cerramos el descriptor
-      if (errno == ENODEV || errno == EIO || errno == EBADF)
+      FlValue *m = fl_value_lookup_string(args, "density");
+      if (m != nullptr && fl_value_get_type(m) == FL_VALUE_TYPE_INT)
       {
-        if (self->usb_fd >= 0)
-        {
-          close(self->usb_fd);
-          self->usb_fd = -1;
-        }
+        density = fl_value_get_int(m);
       }
-
-      return false;
     }
-    left -= written;
-    ptr += written;
-  }
-
-  // Forzar a que los datos se envíen al dispositivo
-  fsync(self->usb_fd);
-  return true;
-}
-
-static bool send_command_to_usb(TiPrinterPlugin *self,
-                                const std::vector<uint8_t> &command)
-{
-  if (command.empty()) return false;
-  return send_command_to_usb(self, command.data(), command.size());
-}
-
-static std::vector<uint8_t> read_status_usb(TiPrinterPlugin *self,
-                                            const std::vector<uint8_t> &command)
-{
-  std::vector<uint8_t> result;
-  if (!self || self->usb_fd < 0)
-    return result;
 
-  // Enviar comando de estado si se proporcionó (por ej. DLE EOT n)
-  if (!command.empty())
-  {
-    if (!send_command_to_usb(self, command))
+    if (data != nullptr && fl_value_get_length(data) > 0 && width > 0 &&
+        width <= 0xFFFF && density >= 0 && density <= 3)
     {
-      // Si send_command_to_usb falló y cerró el fd, devolvemos vacío
-      return result;
+      const uint8_t *bytes = fl_value_get_uint8_list(data);
+      // Responde de forma asíncrona cuando termina la conversión.
+      rasterize_image(self,
+                      std::vector<uint8_t>(bytes, bytes + fl_value_get_length(data)),
+                      static_cast<int>(width),
+                      !dither ? RasterDither::kThreshold
+                              : ordered ? RasterDither::kOrdered
+                                        : RasterDither::kFloydSteinberg,
+                      star ? RasterCommand::kStarRaster
+                           : graphics ? RasterCommand::kGraphics
+                                      : RasterCommand::kBitImage,
+                      static_cast<int>(density), method_call);
+      return;
     }
-  }
-
-  uint8_t buffer[256];
-  fd_set readfds;
-  FD_ZERO(&readfds);
-  FD_SET(self->usb_fd, &readfds);
 
-  struct timeval tv{};
-  tv.tv_sec = 0;
-  tv.tv_usec = 500000; // 500 ms
-
-  int ret = select(self->usb_fd + 1, &readfds, nullptr, nullptr, &tv);
-  if (ret <= 0)
+    response = FL_METHOD_RESPONSE(
+        fl_method_error_response_new("INVALID_ARGUMENT",
+                                     "Expected {data, width, dither, graphics, star, density}.",
+                                     nullptr));
+  }
+  else if (std::strcmp(method, "clearRasterCache") == 0)
   {
-    // timeout o error
-    return result;
+    // Sin argumentos: vacía la memoria y el archivo de la caché de imágenes.
+    if (self->raster_cache)
+      self->raster_cache->clear();
+    g_autoptr(FlValue) result = fl_value_new_bool(self->raster_cache != nullptr);
+    response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
   }
-
-  if (FD_ISSET(self->usb_fd, &readfds))
+  else if (std::strcmp(method, "encodeLabelImage") == 0)
   {
-    ssize_t n = read(self->usb_fd, buffer, sizeof(buffer));
-    if (n > 0)
+    // Argumento: {data: Uint8List (PNG/JPEG), width: ancho en puntos,
+    // format: 0 ZPL ASCII, 1 ZPL Z64, 2 TSPL BITMAP, dither, ordered, x, y}
+    FlValue *args = fl_method_call_get_args(method_call);
+    FlValue *data = nullptr;
+    int64_t width = 0;
+    int64_t format = 0;
+    bool dither = true;
+    bool ordered = false;
+    int64_t x = 0;
+    int64_t y = 0;
+
+    if (args != nullptr && fl_value_get_type(args) == FL_VALUE_TYPE_MAP)
     {
-      // FIX #6: Devolver TODOS los bytes leídos. La versión anterior
-      // hacía result.push_back(buffer[0]) y descartaba el resto, lo cual
-      // truncaba respuestas multi-byte (ESC u, auto status back, etc.).
-      result.assign(buffer, buffer + n);
+      FlValue *d = fl_value_lookup_string(args, "data");
+      if (d != nullptr && fl_value_get_type(d) == FL_VALUE_TYPE_UINT8_LIST)
+      {
+        data = d;
+      }
+      width = map_get_int(args, "width", width);
+      format = map_get_int(args, "format", format);
+      dither = map_get_bool(args, "dither", dither);
+      ordered = map_get_bool(args, "ordered", ordered);
+      x = map_get_int(args, "x", x);
+      y = map_get_int(args, "y", y);
     }
-  }
 
-  return result;
-}
-
-// ===================== Helpers ya existentes =====================
-
-// Implementado acá para que pueda usarse desde private/test.
-FlMethodResponse *get_platform_version()
-{
-  struct utsname uname_data = {};
-  uname(&uname_data);
-  g_autofree gchar *version = g_strdup_printf("Linux %s", uname_data.version);
-  g_autoptr(FlValue) result = fl_value_new_string(version);
-  return FL_METHOD_RESPONSE(fl_method_success_response_new(result));
-}
+    if (data != nullptr && fl_value_get_length(data) > 0 && width > 0 && width <= 0xFFFF &&
+        format >= 0 && format <= 2 && x >= 0 && x <= 0xFFFF && y >= 0 && y <= 0xFFFF)
+    {
+      const uint8_t *bytes = fl_value_get_uint8_list(data);
+      // Responde de forma asíncrona cuando termina la conversión.
+      encode_label_image(self,
+                         std::vector<uint8_t>(bytes, bytes + fl_value_get_length(data)),
+                         static_cast<int>(width),
+                         !dither ? RasterDither::kThreshold
+                                 : ordered ? RasterDither::kOrdered
+                                           : RasterDither::kFloydSteinberg,
+                         static_cast<LabelImageFormat>(format), static_cast<int>(x),
+                         static_cast<int>(y), method_call);
+      return;
+    }
 
-// ===================== Manejo de MethodChannel =====================
+    response = FL_METHOD_RESPONSE(
+        fl_method_error_response_new("INVALID_ARGUMENT",
+                                     "Expected {data, width, format 0..2, x, y}.",
+                                     nullptr));
+  }
+  else if (std::strcmp(method, "encodeColumnImage") == 0)
+  {
+    // Argumento: {pixels: Uint8List, width, height, bitsPerPixel (8 o 1)}
+    FlValue *args = fl_method_call_get_args(method_call);
+    FlValue *pixels = nullptr;
+    int64_t width = 0;
+    int64_t height = 0;
+    int64_t bits_per_pixel = 8;
 
-// Called when a method call is received from Flutter.
-static void ti_printer_plugin_handle_method_call(
-    TiPrinterPlugin *self,
-    FlMethodCall *method_call)
-{
-  g_autoptr(FlMethodResponse) response = nullptr;
+    if (args != nullptr && fl_value_get_type(args) == FL_VALUE_TYPE_MAP)
+    {
+      FlValue *p = fl_value_lookup_string(args, "pixels");
+      if (p != nullptr && fl_value_get_type(p) == FL_VALUE_TYPE_UINT8_LIST)
+      {
+        pixels = p;
+      }
+      FlValue *w = fl_value_lookup_string(args, "width");
+      if (w != nullptr && fl_value_get_type(w) == FL_VALUE_TYPE_INT)
+      {
+        width = fl_value_get_int(w);
+      }
+      FlValue *h = fl_value_lookup_string(args, "height");
+      if (h != nullptr && fl_value_get_type(h) == FL_VALUE_TYPE_INT)
+      {
+        height = fl_value_get_int(h);
+      }
+      FlValue *b = fl_value_lookup_string(args, "bitsPerPixel");
+      if (b != nullptr && fl_value_get_type(b) == FL_VALUE_TYPE_INT)
+      {
+        bits_per_pixel = fl_value_get_int(b);
+      }
+    }
 
-  const gchar *method = fl_method_call_get_name(method_call);
+    std::vector<uint8_t> bytes;
+    if (pixels != nullptr && width > 0 && width <= INT32_MAX && height > 0 &&
+        height <= INT32_MAX)
+    {
+      bytes = escpos_column_image(fl_value_get_uint8_list(pixels),
+                                  fl_value_get_length(pixels),
+                                  static_cast<int>(width),
+                                  static_cast<int>(height),
+                                  static_cast<int>(bits_per_pixel));
+    }
 
-  if (std::strcmp(method, "getPlatformVersion") == 0)
-  {
-    response = get_platform_version();
-  }
-  else if (std::strcmp(method, "openSerialPort") == 0)
-  {
-    g_autoptr(FlValue) result = fl_value_new_bool(FALSE);
-    response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
-  }
-  else if (std::strcmp(method, "closeSerialPort") == 0)
-  {
-    g_autoptr(FlValue) result = fl_value_new_bool(FALSE);
-    response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
-  }
-  else if (std::strcmp(method, "sendCommandToSerial") == 0)
-  {
-    g_autoptr(FlValue) result = fl_value_new_bool(FALSE);
-    response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
-  }
-  else if (std::strcmp(method, "readStatusSerial") == 0)
-  {
-    g_autoptr(FlValue) result = fl_value_new_uint8_list(nullptr, 0);
-    response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
+    if (!bytes.empty())
+    {
+      g_autoptr(FlValue) result = fl_value_new_uint8_list(bytes.data(), bytes.size());
+      response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
+    }
+    else
+    {
+      response = FL_METHOD_RESPONSE(
+          fl_method_error_response_new("INVALID_ARGUMENT",
+                                       "Expected {pixels, width, height, bitsPerPixel}.",
+                                       nullptr));
+    }
   }
-  else if (std::strcmp(method, "getUsbPrinters") == 0)
+  else if (std::strcmp(method, "renderEscPos") == 0)
   {
-    auto printers = list_usb_printers();
-    g_autoptr(FlValue) result = fl_value_new_list();
-    for (const auto &printer : printers)
+    // Argumento: {data: Uint8List, width: ancho en puntos, format: "png" | "pbm"}
+    FlValue *args = fl_method_call_get_args(method_call);
+    FlValue *data = nullptr;
+    int64_t width = 576;
+    bool png = true;
+    bool valid_format = true;
+
+    if (args != nullptr && fl_value_get_type(args) == FL_VALUE_TYPE_MAP)
     {
-      g_autoptr(FlValue) map = fl_value_new_map();
-      fl_value_set_string_take(map, "instanceId",
-          fl_value_new_string(printer.instanceId.c_str()));
-      fl_value_set_string_take(map, "displayName",
-          fl_value_new_string(printer.displayName.c_str()));
-      fl_value_set_string_take(map, "vid",
-          fl_value_new_int(printer.vid));
-      fl_value_set_string_take(map, "pid",
-          fl_value_new_int(printer.pid));
-      fl_value_append_take(result, fl_value_ref(map));
+      FlValue *d = fl_value_lookup_string(args, "data");
+      if (d != nullptr && fl_value_get_type(d) == FL_VALUE_TYPE_UINT8_LIST)
+      {
+        data = d;
+      }
+      FlValue *w = fl_value_lookup_string(args, "width");
+      if (w != nullptr && fl_value_get_type(w) == FL_VALUE_TYPE_INT)
+      {
+        width = fl_value_get_int(w);
+      }
+      FlValue *f = fl_value_lookup_string(args, "format");
+      if (f != nullptr && fl_value_get_type(f) == FL_VALUE_TYPE_STRING)
+      {
+        const gchar *format = fl_value_get_string(f);
+        png = std::strcmp(format, "png") == 0;
+        valid_format = png || std::strcmp(format, "pbm") == 0;
+      }
     }
-    response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
+
+    if (data != nullptr && width >= 8 && width <= 4096 && valid_format)
+    {
+      const uint8_t *bytes = fl_value_get_uint8_list(data);
+      // Responde de forma asíncrona cuando termina de dibujar.
+      render_escpos(self,
+                    std::vector<uint8_t>(bytes, bytes + fl_value_get_length(data)),
+                    static_cast<int>(width), png, method_call);
+      return;
+    }
+
+    response = FL_METHOD_RESPONSE(
+        fl_method_error_response_new("INVALID_ARGUMENT",
+                                     "Expected {data, width, format}.",
+                                     nullptr));
   }
-  else if (std::strcmp(method, "openUsbPort") == 0)
+  else if (std::strcmp(method, "rasterizeText") == 0)
   {
+    // Argumento: {text: String, fonts: [rutas], size: alto en puntos,
+    // width: ancho en puntos, align: 0 izquierda, 1 centro, 2 derecha}
     FlValue *args = fl_method_call_get_args(method_call);
-    const gchar *device = nullptr;
+    const gchar *text = nullptr;
+    std::vector<std::string> fonts;
+    TextRasterOptions options;
+    int64_t size = options.size;
+    int64_t width = options.width;
+    int64_t align = 0;
 
     if (args != nullptr && fl_value_get_type(args) == FL_VALUE_TYPE_MAP)
     {
-      FlValue *v = fl_value_lookup_string(args, "deviceInstanceId");
-      if (v != nullptr && fl_value_get_type(v) == FL_VALUE_TYPE_STRING)
+      FlValue *t = fl_value_lookup_string(args, "text");
+      if (t != nullptr && fl_value_get_type(t) == FL_VALUE_TYPE_STRING)
       {
-        device = fl_value_get_string(v);
+        text = fl_value_get_string(t);
+      }
+      FlValue *list = fl_value_lookup_string(args, "fonts");
+      if (list != nullptr && fl_value_get_type(list) == FL_VALUE_TYPE_LIST)
+      {
+        for (size_t i = 0; i < fl_value_get_length(list); i++)
+        {
+          FlValue *font = fl_value_get_list_value(list, i);
+          if (fl_value_get_type(font) == FL_VALUE_TYPE_STRING)
+          {
+            fonts.emplace_back(fl_value_get_string(font));
+          }
+        }
       }
+      size = map_get_int(args, "size", size);
+      width = map_get_int(args, "width", width);
+      align = map_get_int(args, "align", align);
     }
 
-    if (device != nullptr && open_usb_port(self, device))
+    if (!TextRasterizer::available())
     {
-      g_autoptr(FlValue) result = fl_value_new_bool(TRUE);
-      response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
+      response = FL_METHOD_RESPONSE(
+          fl_method_error_response_new("ERROR",
+                                       "Plugin built without FreeType.",
+                                       nullptr));
+    }
+    else if (text != nullptr && !fonts.empty() && size >= 4 && size <= 512 &&
+             width >= 8 && width <= 4096 && align >= 0 && align <= 2)
+    {
+      options.size = static_cast<int>(size);
+      options.width = static_cast<int>(width);
+      options.align = static_cast<EscPosAlign>(align);
+      // Responde de forma asíncrona cuando termina de dibujar.
+      rasterize_text(self, text, std::move(fonts), options, method_call);
+      return;
     }
     else
     {
       response = FL_METHOD_RESPONSE(
-          fl_method_error_response_new("ERROR",
-                                       "No se pudo abrir el puerto USB.",
+          fl_method_error_response_new("INVALID_ARGUMENT",
+                                       "Expected {text, fonts, size, width, align}.",
                                        nullptr));
     }
   }
-  else if (std::strcmp(method, "closeUsbPort") == 0)
+  else if (std::strcmp(method, "optimizeEscPos") == 0)
   {
-    bool ok = close_usb_port(self);
-    if (ok)
+    // Argumento: Uint8List directamente. Devuelve el stream optimizado y
+    // cuántos bytes se ahorraron.
+    FlValue *args = fl_method_call_get_args(method_call);
+    if (args != nullptr &&
+        fl_value_get_type(args) == FL_VALUE_TYPE_UINT8_LIST)
     {
-      g_autoptr(FlValue) result = fl_value_new_bool(TRUE);
+      EscPosOptimizeStats stats;
+      std::vector<uint8_t> bytes = escpos_optimize(fl_value_get_uint8_list(args),
+                                                   fl_value_get_length(args), &stats);
+
+      g_autoptr(FlValue) result = fl_value_new_map();
+      fl_value_set_string_take(result, "data",
+          fl_value_new_uint8_list(bytes.data(), bytes.size()));
+      fl_value_set_string_take(result, "inputBytes",
+          fl_value_new_int(static_cast<int64_t>(stats.input_bytes)));
+      fl_value_set_string_take(result, "outputBytes",
+          fl_value_new_int(static_cast<int64_t>(stats.output_bytes)));
+      fl_value_set_string_take(result, "droppedCommands",
+          fl_value_new_int(static_cast<int64_t>(stats.dropped_commands)));
+      fl_value_set_string_take(result, "mergedFeeds",
+          fl_value_new_int(static_cast<int64_t>(stats.merged_feeds)));
       response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
     }
     else
     {
       response = FL_METHOD_RESPONSE(
-          fl_method_error_response_new("ERROR",
-                                       "No se pudo cerrar el puerto USB.",
+          fl_method_error_response_new("INVALID_ARGUMENT",
+                                       "Expected Uint8List as argument.",
                                        nullptr));
     }
   }
-  else if (std::strcmp(method, "sendCommandToUsb") == 0)
+  else if (std::strcmp(method, "compileReceiptTemplate") == 0)
   {
-    // Argumento: Uint8List directamente
+    // Argumento: String con el template. Devuelve el id para renderReceipt.
     FlValue *args = fl_method_call_get_args(method_call);
-    if (args != nullptr &&
-        fl_value_get_type(args) == FL_VALUE_TYPE_UINT8_LIST)
+    if (args != nullptr && fl_value_get_type(args) == FL_VALUE_TYPE_STRING)
     {
-      const uint8_t *data = fl_value_get_uint8_list(args);
-      size_t length = fl_value_get_length(args);
-
-      bool ok = send_command_to_usb(self, data, length);
-      if (ok)
+      auto tpl = std::make_unique<ReceiptTemplate>();
+      std::string error;
+      if (tpl->compile(fl_value_get_string(args), &error))
       {
-        g_autoptr(FlValue) result = fl_value_new_bool(TRUE);
+        const int64_t id = self->next_receipt_template++;
+        (*self->receipt_templates)[id] = std::move(tpl);
+        g_autoptr(FlValue) result = fl_value_new_int(id);
         response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
       }
       else
       {
+        g_printerr("Template de ticket inválido: %s\n", error.c_str());
         response = FL_METHOD_RESPONSE(
-            fl_method_error_response_new("ERROR",
-                                         "Failed to send data to USB.",
-                                         nullptr));
+            fl_method_error_response_new("INVALID_ARGUMENT", error.c_str(), nullptr));
       }
     }
     else
     {
       response = FL_METHOD_RESPONSE(
           fl_method_error_response_new("INVALID_ARGUMENT",
-                                       "Expected Uint8List as argument.",
+                                       "Expected String as argument.",
                                        nullptr));
     }
   }
-  else if (std::strcmp(method, "readStatusUsb") == 0)
+  else if (std::strcmp(method, "renderReceipt") == 0)
   {
-    // Argumento: Uint8List directamente (alineado con sendCommandToUsb)
+    // Argumento: {template: id de compileReceiptTemplate, data: Map}
     FlValue *args = fl_method_call_get_args(method_call);
-    if (args != nullptr &&
-        fl_value_get_type(args) == FL_VALUE_TYPE_UINT8_LIST)
+    ReceiptTemplate *tpl = nullptr;
+    FlValue *data = nullptr;
+
+    if (args != nullptr && fl_value_get_type(args) == FL_VALUE_TYPE_MAP)
     {
-      const uint8_t *cmd_bytes = fl_value_get_uint8_list(args);
-      size_t cmd_len = fl_value_get_length(args);
-      std::vector<uint8_t> command(cmd_bytes, cmd_bytes + cmd_len);
+      FlValue *t = fl_value_lookup_string(args, "template");
+      if (t != nullptr && fl_value_get_type(t) == FL_VALUE_TYPE_INT)
+      {
+        auto it = self->receipt_templates->find(fl_value_get_int(t));
+        if (it != self->receipt_templates->end())
+        {
+          tpl = it->second.get();
+        }
+      }
+      FlValue *d = fl_value_lookup_string(args, "data");
+      if (d != nullptr && fl_value_get_type(d) == FL_VALUE_TYPE_MAP)
+      {
+        data = d;
+      }
+    }
 
-      std::vector<uint8_t> status = read_status_usb(self, command);
+    if (tpl != nullptr && data != nullptr)
+    {
+      // Son microsegundos: se ejecuta en el hilo principal.
+      const std::vector<uint8_t> &bytes = tpl->render(FlValueReceiptScope(data));
+      g_autoptr(FlValue) result = fl_value_new_uint8_list(bytes.data(), bytes.size());
+      response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
+    }
+    else
+    {
+      response = FL_METHOD_RESPONSE(
+          fl_method_error_response_new("INVALID_ARGUMENT",
+                                       "Expected {template, data} with a compiled template.",
+                                       nullptr));
+    }
+  }
+  else if (std::strcmp(method, "releaseReceiptTemplate") == 0)
+  {
+    // Argumento: int (id del template).
+    FlValue *args = fl_method_call_get_args(method_call);
+    if (args != nullptr && fl_value_get_type(args) == FL_VALUE_TYPE_INT)
+    {
+      const bool erased = self->receipt_templates->erase(fl_value_get_int(args)) > 0;
+      g_autoptr(FlValue) result = fl_value_new_bool(erased);
+      response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
+    }
+    else
+    {
+      response = FL_METHOD_RESPONSE(
+          fl_method_error_response_new("INVALID_ARGUMENT",
+                                       "Expected int as argument.",
+                                       nullptr));
+    }
+  }
+  else if (std::strcmp(method, "layoutRow") == 0)
+  {
+    // Argumento: {columns: [{text, width, align, scale}], lineChars, fontB,
+    // codeTable, utf8}. Devuelve la fila ya codificada (una o más líneas).
+    FlValue *args = fl_method_call_get_args(method_call);
+    FlValue *list = nullptr;
+    if (args != nullptr && fl_value_get_type(args) == FL_VALUE_TYPE_MAP)
+    {
+      list = fl_value_lookup_string(args, "columns");
+    }
 
-      g_autoptr(FlValue) result = nullptr;
-      if (!status.empty())
+    std::vector<EscPosColumn> columns;
+    bool valid = list != nullptr && fl_value_get_type(list) == FL_VALUE_TYPE_LIST &&
+                 fl_value_get_length(list) > 0;
+    int twelfths = 0;
+    for (size_t i = 0; valid && i < fl_value_get_length(list); i++)
+    {
+      FlValue *item = fl_value_get_list_value(list, i);
+      if (fl_value_get_type(item) != FL_VALUE_TYPE_MAP)
       {
-        result = fl_value_new_uint8_list(status.data(), status.size());
+        valid = false;
+        break;
       }
-      else
+      FlValue *text = fl_value_lookup_string(item, "text");
+      EscPosColumn column;
+      if (text != nullptr && fl_value_get_type(text) == FL_VALUE_TYPE_STRING)
       {
-        result = fl_value_new_uint8_list(nullptr, 0);
+        column.text = fl_value_get_string(text);
+      }
+      column.width = static_cast<int>(map_get_int(item, "width", 12));
+      const int64_t align = map_get_int(item, "align", 0);
+      const int64_t scale = map_get_int(item, "scale", 1);
+      if (column.width < 1 || align < 0 || align > 2 || scale < 1 || scale > 8)
+      {
+        valid = false;
+        break;
+      }
+      column.align = static_cast<EscPosAlign>(align);
+      if (scale > 1)
+      {
+        column.size = static_cast<int>(((scale - 1) << 4) | (scale - 1));
       }
+      twelfths += column.width;
+      columns.push_back(column);
+    }
+
+    EscPosRowOptions options;
+    if (valid)
+    {
+      options.line_cells = static_cast<int>(map_get_int(args, "lineChars", 48));
+      options.cell_dots = map_get_bool(args, "fontB", false) ? 9 : 12;
+      options.code_table = static_cast<int>(map_get_int(args, "codeTable", 0));
+      options.utf8 = map_get_bool(args, "utf8", false);
+      valid = twelfths <= 12 && options.line_cells > 0 && options.line_cells <= 255;
+    }
+
+    if (valid)
+    {
+      EscPosRowLayout layout;
+      std::vector<uint8_t> bytes;
+      layout.layout(columns.data(), columns.size(), options, bytes);
+      g_autoptr(FlValue) result = fl_value_new_uint8_list(bytes.data(), bytes.size());
       response = FL_METHOD_RESPONSE(fl_method_success_response_new(result));
     }
     else
     {
       response = FL_METHOD_RESPONSE(
           fl_method_error_response_new("INVALID_ARGUMENT",
-                                       "Expected Uint8List as argument.",
+                                       "Expected {columns: [{text, width, align, scale}]} "
+                                       "with widths adding up to at most 12.",
                                        nullptr));
     }
   }
@@ -501,6 +2676,17 @@ static void ti_printer_plugin_handle_method_call(
 static void ti_printer_plugin_dispose(GObject *object)
 {
   TiPrinterPlugin *self = TI_PRINTER_PLUGIN(object);
+  // Detener el escritor antes de cerrar el descriptor que usa.
+  delete self->usb_image;
+  self->usb_image = nullptr;
+  // El ring antes que el escritor en el que vacía.
+  delete self->usb_ring;
+  self->usb_ring = nullptr;
+  delete self->usb_writer;
+  self->usb_writer = nullptr;
+  delete self->usb_inflight;
+  self->usb_inflight = nullptr;
+
   // Asegurar que se cierre el descriptor USB
   if (self->usb_fd >= 0)
   {
@@ -508,6 +2694,67 @@ static void ti_printer_plugin_dispose(GObject *object)
     self->usb_fd = -1;
   }
 
+  // Después de la imagen en curso, que puede estar enviándose al servicio.
+  delete self->daemon;
+  self->daemon = nullptr;
+  delete self->usb_daemon_device;
+  self->usb_daemon_device = nullptr;
+
+  if (self->file_progress)
+  {
+    fl_event_channel_set_stream_handlers(self->file_progress, nullptr, nullptr,
+                                         nullptr, nullptr);
+    g_clear_object(&self->file_progress);
+  }
+  if (self->job_ring_events)
+  {
+    fl_event_channel_set_stream_handlers(self->job_ring_events, nullptr, nullptr,
+                                         nullptr, nullptr);
+    g_clear_object(&self->job_ring_events);
+  }
+
+  ti_printer_close(self->tcp);
+  self->tcp = nullptr;
+  delete self->tcp_target;
+  self->tcp_target = nullptr;
+
+  delete self->scheduler;
+  self->scheduler = nullptr;
+
+  // Los hilos de rasterize_image tienen una referencia al plugin: si se
+  // llegó acá ninguno está usando el pool.
+  delete self->raster_pool;
+  self->raster_pool = nullptr;
+
+  delete self->raster_cache;
+  self->raster_cache = nullptr;
+
+  delete self->receipt_templates;
+  self->receipt_templates = nullptr;
+
+  delete self->text_rasterizer;
+  self->text_rasterizer = nullptr;
+
+  // El hilo del probe tiene una referencia al plugin: si se llegó acá ya
+  // terminó y respondió a los que esperaban.
+  delete self->usb_probe_calls;
+  self->usb_probe_calls = nullptr;
+  delete self->usb_capabilities;
+  self->usb_capabilities = nullptr;
+  delete self->capabilities;
+  self->capabilities = nullptr;
+
+  // Parar el watcher antes de liberar la identidad que vigila.
+  delete self->reconnect;
+  self->reconnect = nullptr;
+  delete self->usb_identity;
+  self->usb_identity = nullptr;
+
+  delete self->spool;
+  self->spool = nullptr;
+  delete self->usb_device;
+  self->usb_device = nullptr;
+
   G_OBJECT_CLASS(ti_printer_plugin_parent_class)->dispose(object);
 }
 
@@ -519,6 +2766,62 @@ static void ti_printer_plugin_class_init(TiPrinterPluginClass *klass)
 static void ti_printer_plugin_init(TiPrinterPlugin *self)
 {
   self->usb_fd = -1;
+  self->usb_writer = new LaneWriter();
+  self->usb_inflight = new std::set<uint64_t>();
+  self->usb_image = nullptr;
+  self->tcp = nullptr;
+  self->tcp_target = new std::string();
+  self->tcp_busy = false;
+  self->file_progress = nullptr;
+  self->file_progress_listening = false;
+  self->usb_ring = nullptr;
+  self->job_ring_events = nullptr;
+  self->job_ring_listening = false;
+  self->usb_device = new std::string();
+  self->daemon = new PrintDaemonClient();
+  self->usb_daemon_device = new std::string();
+  self->usb_identity = new UsbDeviceIdentity();
+  self->capabilities = new CapabilityCache();
+  self->usb_capabilities = new PrinterCapabilities();
+  self->usb_capabilities_known = false;
+  self->usb_probing = false;
+  self->usb_probe_calls = new std::vector<FlMethodCall *>();
+  self->reconnect = new UsbReconnectWatcher();
+  self->scheduler = new JobScheduler();
+  self->receipt_templates = new std::map<int64_t, std::unique_ptr<ReceiptTemplate>>();
+  self->next_receipt_template = 1;
+  self->text_rasterizer = new TextRasterizer();
+
+  // ~/.local/share/ti_printer_plugin/spool.journal
+  g_autofree gchar *spool_dir =
+      g_build_filename(g_get_user_data_dir(), "ti_printer_plugin", nullptr);
+  g_autofree gchar *spool_path =
+      g_build_filename(spool_dir, "spool.journal", nullptr);
+  self->spool = new JobSpool();
+  if (g_mkdir_with_parents(spool_dir, 0700) != 0 || !self->spool->open(spool_path))
+  {
+    g_printerr("No se pudo abrir el spool %s\n", spool_path);
+    delete self->spool;
+    self->spool = nullptr;
+  }
+
+  // ~/.cache/ti_printer_plugin/raster.cache; sin disco queda sólo en memoria.
+  g_autofree gchar *cache_dir =
+      g_build_filename(g_get_user_cache_dir(), "ti_printer_plugin", nullptr);
+  g_autofree gchar *cache_path =
+      g_build_filename(cache_dir, "raster.cache", nullptr);
+  self->raster_cache = new RasterCache(kRasterCacheMemoryBytes, kRasterCacheDiskBytes);
+  if (g_mkdir_with_parents(cache_dir, 0700) != 0 || !self->raster_cache->open(cache_path))
+  {
+    g_printerr("No se pudo abrir la caché de imágenes %s\n", cache_path);
+  }
+
+  // ~/.cache/ti_printer_plugin/capabilities.ini: perfiles ya medidos.
+  g_autofree gchar *capabilities_path =
+      g_build_filename(cache_dir, "capabilities.ini", nullptr);
+  self->capabilities->open(capabilities_path);
+
+  self->raster_pool = new WorkStealingPool();
 }
 
 static void method_call_cb(FlMethodChannel *channel, FlMethodCall *method_call,
@@ -542,5 +2845,24 @@ void ti_printer_plugin_register_with_registrar(FlPluginRegistrar *registrar)
                                             g_object_ref(plugin),
                                             g_object_unref);
 
+  // Avance de sendFile: {path, sent, total}. El canal no toma referencia al
+  // plugin (el plugin es dueño del canal).
+  plugin->file_progress =
+      fl_event_channel_new(fl_plugin_registrar_get_messenger(registrar),
+                           "ti_printer_plugin/send_file_progress",
+                           FL_METHOD_CODEC(codec));
+  fl_event_channel_set_stream_handlers(plugin->file_progress,
+                                       on_file_progress_listen,
+                                       on_file_progress_cancel,
+                                       plugin, nullptr);
+  plugin->job_ring_events =
+      fl_event_channel_new(fl_plugin_registrar_get_messenger(registrar),
+                           "ti_printer_plugin/job_ring",
+                           FL_METHOD_CODEC(codec));
+  fl_event_channel_set_stream_handlers(plugin->job_ring_events,
+                                       on_job_ring_listen,
+                                       on_job_ring_cancel,
+                                       plugin, nullptr);
+
   g_object_unref(plugin);
 }
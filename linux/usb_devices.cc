@@ -0,0 +1,216 @@
+#include "usb_devices.h"
+
+#include <cstring>
+#include <strings.h> // strncasecmp
+
+#include "usblp.h"
+
+// Linux system headers para acceso a dispositivos
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>  // major(), minor()
+
+// Para lectura de sysfs (idVendor / idProduct / serial)
+#include <fstream>
+#include <climits>   // PATH_MAX
+#include <cstdlib>   // realpath
+#include <cstdio>    // snprintf
+
+namespace
+{
+
+std::string read_sysfs_line(const std::string &path)
+{
+  std::ifstream f(path);
+  std::string line;
+  if (f.good())
+    std::getline(f, line);
+  return line;
+}
+
+// Directorio del dispositivo USB (el que tiene idVendor) que contiene a
+// sysfs_path, o vacío si no se encontró.
+std::string find_usb_device_dir(const std::string &sysfs_path)
+{
+  std::string dir = sysfs_path;
+  while (true)
+  {
+    struct stat st{};
+    if (stat((dir + "/idVendor").c_str(), &st) == 0)
+      return dir;
+
+    auto pos = dir.rfind('/');
+    if (pos == std::string::npos || pos == 0)
+      break;
+    dir = dir.substr(0, pos);
+  }
+  return "";
+}
+
+} // namespace
+
+void add_dev_entries_with_prefix(const char *dir_path,
+                                 const char *prefix,
+                                 std::vector<std::string> &out)
+{
+  DIR *d = opendir(dir_path);
+  if (!d)
+    return;
+
+  struct dirent *entry;
+  while ((entry = readdir(d)) != nullptr)
+  {
+    if (entry->d_name[0] == '.')
+      continue;
+    if (std::strncmp(entry->d_name, prefix, std::strlen(prefix)) == 0)
+    {
+      std::string full = std::string(dir_path) + "/" + entry->d_name;
+      struct stat st{};
+      if (stat(full.c_str(), &st) == 0 && S_ISCHR(st.st_mode))
+      {
+        out.push_back(full);
+      }
+    }
+  }
+
+  closedir(d);
+}
+
+std::vector<std::string> list_printer_nodes()
+{
+  std::vector<std::string> nodes;
+  add_dev_entries_with_prefix("/dev/usb", "lp", nodes);
+  add_dev_entries_with_prefix("/dev", "ttyUSB", nodes);
+  add_dev_entries_with_prefix("/dev", "ttyACM", nodes);
+  return nodes;
+}
+
+std::string resolve_sysfs_path(const std::string &dev_path) {
+    struct stat st;
+    if (stat(dev_path.c_str(), &st) != 0 || !S_ISCHR(st.st_mode))
+        return "";
+
+    char link_path[PATH_MAX];
+    snprintf(link_path, sizeof(link_path), "/sys/dev/char/%u:%u",
+             major(st.st_rdev), minor(st.st_rdev));
+
+    char resolved[PATH_MAX];
+    if (!realpath(link_path, resolved))
+        return "";
+
+    return resolved;
+}
+
+std::pair<int, int> read_vid_pid_from_sysfs(const std::string &sysfs_path) {
+    std::string dir = sysfs_path;
+
+    while (true) {
+        std::string vendor_path = dir + "/idVendor";
+        std::string product_path = dir + "/idProduct";
+
+        std::ifstream vf(vendor_path);
+        std::ifstream pf(product_path);
+
+        if (vf.good() && pf.good()) {
+            int vid = 0, pid = 0;
+            vf >> std::hex >> vid;
+            pf >> std::hex >> pid;
+            return {vid, pid};
+        }
+
+        auto pos = dir.rfind('/');
+        if (pos == std::string::npos || pos == 0)
+            break;
+        dir = dir.substr(0, pos);
+    }
+
+    return {0, 0};
+}
+
+bool UsbDeviceIdentity::matches(const UsbDeviceIdentity &other) const
+{
+  if (!valid() || vid != other.vid || pid != other.pid)
+    return false;
+  if (!serial.empty() && !other.serial.empty())
+    return serial == other.serial;
+  return !port_path.empty() && port_path == other.port_path;
+}
+
+std::string UsbDeviceIdentity::key() const
+{
+  if (!valid())
+    return dev_path;
+
+  char buf[32];
+  snprintf(buf, sizeof(buf), "usb:%04x:%04x:", vid, pid);
+  return std::string(buf) + (serial.empty() ? "@" + port_path : serial);
+}
+
+UsbDeviceIdentity read_usb_identity(const std::string &dev_path)
+{
+  UsbDeviceIdentity id;
+  id.dev_path = dev_path;
+
+  std::string sysfs_path = resolve_sysfs_path(dev_path);
+  if (sysfs_path.empty())
+    return id;
+  id.device_id = usblp_read_device_id_sysfs(sysfs_path);
+
+  std::string usb_dir = find_usb_device_dir(sysfs_path);
+  if (usb_dir.empty())
+    return id;
+
+  auto vid_pid = read_vid_pid_from_sysfs(usb_dir);
+  id.vid = vid_pid.first;
+  id.pid = vid_pid.second;
+  id.serial = read_sysfs_line(usb_dir + "/serial");
+  id.port_path = usb_dir.substr(usb_dir.rfind('/') + 1);
+  return id;
+}
+
+std::vector<UsbPrinterInfo> list_usb_printers()
+{
+  std::vector<UsbPrinterInfo> printers;
+  for (const std::string &path : list_printer_nodes())
+  {
+    UsbPrinterInfo info;
+    info.instance_id = path;
+
+    // Resolver VID/PID real desde sysfs
+    std::string sysfs_path = resolve_sysfs_path(path);
+    if (!sysfs_path.empty())
+    {
+      auto vid_pid = read_vid_pid_from_sysfs(sysfs_path);
+      info.vid = vid_pid.first;
+      info.pid = vid_pid.second;
+      // Modelo y lenguajes según la propia impresora, sin abrirla.
+      info.device_id = usblp_read_device_id_sysfs(sysfs_path);
+      info.ieee1284 = parse_ieee1284_id(info.device_id);
+    }
+
+    // display_name: el modelo que informa la impresora; si no, VID/PID
+    const Ieee1284Id &id = info.ieee1284;
+    if (!id.model.empty())
+    {
+      const bool has_maker = !id.manufacturer.empty() &&
+          strncasecmp(id.model.c_str(), id.manufacturer.c_str(),
+                      id.manufacturer.size()) != 0;
+      info.display_name = has_maker ? id.manufacturer + " " + id.model : id.model;
+    }
+    else if (info.vid > 0 || info.pid > 0)
+    {
+      char buf[64];
+      snprintf(buf, sizeof(buf), "USB Printer (VID:0x%04X, PID:0x%04X)",
+               info.vid, info.pid);
+      info.display_name = buf;
+    }
+    else
+    {
+      auto pos = path.rfind('/');
+      info.display_name = (pos != std::string::npos) ? path.substr(pos + 1) : path;
+    }
+
+    printers.push_back(info);
+  }
+  return printers;
+}
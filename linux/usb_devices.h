@@ -0,0 +1,71 @@
+#ifndef FLUTTER_PLUGIN_TI_PRINTER_USB_DEVICES_H_
+#define FLUTTER_PLUGIN_TI_PRINTER_USB_DEVICES_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "usblp.h"
+
+// Helpers de enumeración de dispositivos y lectura de sysfs, compartidos por
+// list_usb_printers() y el motor de reconexión.
+
+// Agrega a 'out' todos los dispositivos en 'dir_path' cuyo nombre
+// empieza por 'prefix' (ej: /dev/usb/lp0, ttyUSB0, etc.)
+void add_dev_entries_with_prefix(const char *dir_path,
+                                 const char *prefix,
+                                 std::vector<std::string> &out);
+
+// Todos los nodos candidatos a impresora: /dev/usb/lp*, /dev/ttyUSB*,
+// /dev/ttyACM*.
+std::vector<std::string> list_printer_nodes();
+
+// Resuelve la ruta sysfs real para un dispositivo /dev/...
+// Ejemplo: /dev/usb/lp0 → /sys/devices/.../1-2:1.0/usbmisc/lp0
+std::string resolve_sysfs_path(const std::string &dev_path);
+
+// Camina desde sysfs_path hacia arriba buscando idVendor/idProduct
+// en el árbol de dispositivos USB.
+std::pair<int, int> read_vid_pid_from_sysfs(const std::string &sysfs_path);
+
+// Identidad estable de una impresora USB: sobrevive al renombre del nodo
+// (/dev/usb/lp0 → lp1) al reconectarla.
+struct UsbDeviceIdentity
+{
+  int vid = 0;
+  int pid = 0;
+  std::string serial;    // iSerialNumber (vacío si el equipo no tiene)
+  std::string port_path; // topología del puerto, ej. "1-2.3"
+  std::string dev_path;  // último nodo /dev/... conocido
+  std::string device_id; // IEEE 1284 device ID de usblp (vacío si no hay)
+
+  bool valid() const { return vid > 0 || pid > 0; }
+
+  // Misma impresora: VID/PID iguales y mismo serial; si no hay serial, el
+  // mismo puerto físico.
+  bool matches(const UsbDeviceIdentity &other) const;
+
+  // Clave para el spool: "usb:04b8:0202:<serial|@puerto>", o la ruta del
+  // nodo si no se pudo leer sysfs.
+  std::string key() const;
+};
+
+UsbDeviceIdentity read_usb_identity(const std::string &dev_path);
+
+// Una impresora candidata tal como la lista getUsbPrinters (y
+// ti_printer_enumerate en la API C del núcleo).
+struct UsbPrinterInfo
+{
+  std::string instance_id;  // nodo /dev/...
+  std::string display_name; // "MFG MDL" de usblp, o VID/PID, o el nodo
+  int vid = 0;
+  int pid = 0;
+  // IEEE 1284 device ID que dejó usblp en sysfs (vacío en ttyUSB/ttyACM).
+  std::string device_id;
+  Ieee1284Id ieee1284;
+};
+
+// Recorre /dev/usb/lp*, /dev/ttyUSB* y /dev/ttyACM* sin abrir ninguno.
+std::vector<UsbPrinterInfo> list_usb_printers();
+
+#endif // FLUTTER_PLUGIN_TI_PRINTER_USB_DEVICES_H_
@@ -0,0 +1,122 @@
+#include "usb_reconnect.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace
+{
+
+// Re-escaneo de respaldo por si se pierde algún evento de inotify (por
+// ejemplo si /dev/usb se crea y el lp aparece antes de poder vigilarlo).
+constexpr int kRescanIntervalMs = 250;
+
+constexpr uint32_t kWatchMask = IN_CREATE | IN_ATTRIB | IN_MOVED_TO;
+
+} // namespace
+
+UsbReconnectWatcher::~UsbReconnectWatcher()
+{
+  stop();
+}
+
+bool UsbReconnectWatcher::start(const UsbDeviceIdentity &identity,
+                                FoundCallback on_found)
+{
+  stop();
+  if (!identity.valid() || !on_found)
+    return false;
+
+  wake_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if (wake_fd_ < 0)
+    return false;
+
+  identity_ = identity;
+  on_found_ = std::move(on_found);
+  active_ = true;
+  thread_ = std::thread(&UsbReconnectWatcher::run, this);
+  return true;
+}
+
+void UsbReconnectWatcher::stop()
+{
+  active_ = false;
+  if (wake_fd_ >= 0)
+  {
+    uint64_t one = 1;
+    ssize_t ignored = write(wake_fd_, &one, sizeof(one));
+    (void)ignored;
+  }
+  if (thread_.joinable())
+    thread_.join();
+  if (wake_fd_ >= 0)
+  {
+    close(wake_fd_);
+    wake_fd_ = -1;
+  }
+  on_found_ = nullptr;
+}
+
+// Busca un nodo con la misma identidad y permisos de lectura/escritura.
+bool UsbReconnectWatcher::scan()
+{
+  for (const std::string &path : list_printer_nodes())
+  {
+    if (access(path.c_str(), R_OK | W_OK) != 0)
+      continue; // udev todavía no aplicó permisos: esperar IN_ATTRIB
+    if (identity_.matches(read_usb_identity(path)))
+    {
+      if (active_.exchange(false))
+        on_found_(path);
+      return true;
+    }
+  }
+  return false;
+}
+
+void UsbReconnectWatcher::run()
+{
+  int in_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  int dev_usb_wd = -1;
+  if (in_fd >= 0)
+    inotify_add_watch(in_fd, "/dev", kWatchMask | IN_ONLYDIR);
+
+  alignas(struct inotify_event) char events[4096];
+  while (active_)
+  {
+    // /dev/usb desaparece con el último lp y se recrea al reconectar.
+    if (in_fd >= 0 && dev_usb_wd < 0)
+      dev_usb_wd = inotify_add_watch(in_fd, "/dev/usb", kWatchMask | IN_ONLYDIR);
+
+    if (scan())
+      break;
+
+    struct pollfd fds[2] = {{wake_fd_, POLLIN, 0}, {in_fd, POLLIN, 0}};
+    int n = poll(fds, in_fd >= 0 ? 2 : 1, kRescanIntervalMs);
+    if (n < 0 && errno != EINTR)
+      break;
+    if (fds[0].revents & POLLIN)
+      break; // stop()
+
+    if (in_fd >= 0 && (fds[1].revents & POLLIN))
+    {
+      ssize_t len;
+      while ((len = read(in_fd, events, sizeof(events))) > 0)
+      {
+        for (char *p = events; p < events + len;)
+        {
+          auto *ev = reinterpret_cast<struct inotify_event *>(p);
+          if (ev->wd == dev_usb_wd && (ev->mask & IN_IGNORED))
+            dev_usb_wd = -1;
+          p += sizeof(struct inotify_event) + ev->len;
+        }
+      }
+    }
+  }
+
+  if (in_fd >= 0)
+    close(in_fd);
+  active_ = false;
+}
@@ -0,0 +1,48 @@
+#ifndef FLUTTER_PLUGIN_TI_PRINTER_USB_RECONNECT_H_
+#define FLUTTER_PLUGIN_TI_PRINTER_USB_RECONNECT_H_
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+
+#include "usb_devices.h"
+
+// Motor de reconexión: cuando una impresora desaparece (ENODEV/EIO), vigila
+// /dev con inotify hasta que vuelve a aparecer un nodo con la misma
+// identidad (VID/PID + serial o puerto físico), aunque cambie de nombre.
+//
+// El callback se invoca desde el hilo del watcher, una sola vez, con la
+// ruta del nodo nuevo ya accesible (permisos de udev aplicados). Quien lo
+// recibe es responsable de volver al hilo principal antes de tocar el fd.
+class UsbReconnectWatcher
+{
+public:
+  using FoundCallback = std::function<void(const std::string &dev_path)>;
+
+  UsbReconnectWatcher() = default;
+  ~UsbReconnectWatcher();
+
+  UsbReconnectWatcher(const UsbReconnectWatcher &) = delete;
+  UsbReconnectWatcher &operator=(const UsbReconnectWatcher &) = delete;
+
+  // Arranca (o reinicia) la vigilancia de 'identity'.
+  bool start(const UsbDeviceIdentity &identity, FoundCallback on_found);
+
+  // Detiene el hilo. Idempotente; después no se invoca más el callback.
+  void stop();
+
+  bool active() const { return active_.load(); }
+
+private:
+  void run();
+  bool scan();
+
+  UsbDeviceIdentity identity_;
+  FoundCallback on_found_;
+  std::thread thread_;
+  std::atomic<bool> active_{false};
+  int wake_fd_ = -1;
+};
+
+#endif // FLUTTER_PLUGIN_TI_PRINTER_USB_RECONNECT_H_
@@ -0,0 +1,157 @@
+#include "usblp.h"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include <errno.h>
+#include <linux/lp.h>
+#include <sys/ioctl.h>
+
+namespace
+{
+
+// ioctl de usblp para el device ID (drivers/usb/class/usblp.c; no está en
+// los headers de espacio de usuario). La respuesta empieza con el largo
+// total en dos bytes big-endian, incluidos esos dos.
+constexpr unsigned kIocnrGetDeviceId = 1;
+#define TI_LPIOC_GET_DEVICE_ID(len) _IOC(_IOC_READ, 'P', kIocnrGetDeviceId, len)
+
+constexpr size_t kMaxDeviceId = 1024;
+
+std::string trim(const std::string &value)
+{
+  size_t begin = 0;
+  size_t end = value.size();
+  while (begin < end && std::isspace(static_cast<unsigned char>(value[begin])))
+    begin++;
+  while (end > begin &&
+         (std::isspace(static_cast<unsigned char>(value[end - 1])) || value[end - 1] == '\0'))
+    end--;
+  return value.substr(begin, end - begin);
+}
+
+std::string upper(std::string value)
+{
+  for (char &c : value)
+    c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+  return value;
+}
+
+// Nombre de 'protocol' para un lenguaje de la lista CMD, o vacío.
+const char *protocol_name(const std::string &language)
+{
+  const std::string name = upper(trim(language));
+  if (name == "ESC/POS" || name == "ESCPOS" || name.compare(0, 7, "ESC/POS") == 0)
+    return "escpos";
+  if (name.compare(0, 4, "STAR") == 0)
+    return "starprnt";
+  if (name.compare(0, 3, "ZPL") == 0)
+    return "zpl";
+  if (name.compare(0, 3, "EPL") == 0)
+    return "epl";
+  if (name.compare(0, 4, "TSPL") == 0)
+    return "tspl";
+  return "";
+}
+
+} // namespace
+
+UsblpStatus usblp_decode_status(int raw)
+{
+  UsblpStatus status;
+  status.raw = raw;
+  status.paper_out = (raw & LP_POUTPA) != 0;
+  status.online = (raw & LP_PSELECD) != 0;
+  status.error = (raw & LP_PERRORP) == 0; // nFault: activa en 0
+  return status;
+}
+
+bool usblp_get_status(int fd, UsblpStatus &status, int *error)
+{
+  int raw = 0;
+  if (fd < 0 || ioctl(fd, LPGETSTATUS, &raw) != 0)
+  {
+    if (error)
+      *error = fd < 0 ? EBADF : errno;
+    return false;
+  }
+  status = usblp_decode_status(raw & 0xFF);
+  return true;
+}
+
+std::string usblp_get_device_id(int fd)
+{
+  std::vector<char> buffer(kMaxDeviceId, 0);
+  if (fd < 0 || ioctl(fd, TI_LPIOC_GET_DEVICE_ID(kMaxDeviceId), buffer.data()) < 0)
+    return "";
+  size_t length = (static_cast<unsigned char>(buffer[0]) << 8) |
+                  static_cast<unsigned char>(buffer[1]);
+  if (length < 2)
+    return "";
+  length = std::min(length, kMaxDeviceId);
+  return trim(std::string(buffer.data() + 2, length - 2));
+}
+
+std::string usblp_read_device_id_sysfs(const std::string &sysfs_path)
+{
+  // /sys/.../1-2:1.0/usbmisc/lp0 → el atributo está en la interfaz
+  // (1-2:1.0), dos niveles más arriba.
+  std::string dir = sysfs_path;
+  for (int level = 0; level < 3 && !dir.empty(); level++)
+  {
+    std::ifstream f(dir + "/ieee1284_id");
+    if (f.good())
+      return trim(std::string(std::istreambuf_iterator<char>(f), {}));
+    auto pos = dir.rfind('/');
+    if (pos == std::string::npos || pos == 0)
+      break;
+    dir = dir.substr(0, pos);
+  }
+  return "";
+}
+
+Ieee1284Id parse_ieee1284_id(const std::string &device_id)
+{
+  Ieee1284Id id;
+  size_t start = 0;
+  while (start < device_id.size())
+  {
+    size_t end = device_id.find(';', start);
+    if (end == std::string::npos)
+      end = device_id.size();
+    const std::string field = device_id.substr(start, end - start);
+    start = end + 1;
+
+    const size_t colon = field.find(':');
+    if (colon == std::string::npos)
+      continue;
+    const std::string key = upper(trim(field.substr(0, colon)));
+    const std::string value = trim(field.substr(colon + 1));
+    if (key == "MFG" || key == "MANUFACTURER")
+      id.manufacturer = value;
+    else if (key == "MDL" || key == "MODEL")
+      id.model = value;
+    else if (key == "CMD" || key == "COMMAND SET")
+      id.command_set = value;
+    else if (key == "DES" || key == "DESCRIPTION")
+      id.description = value;
+  }
+
+  // CMD es una lista separada por comas, en el orden que prefiere la
+  // impresora.
+  size_t from = 0;
+  while (from <= id.command_set.size())
+  {
+    size_t comma = id.command_set.find(',', from);
+    if (comma == std::string::npos)
+      comma = id.command_set.size();
+    const std::string name = protocol_name(id.command_set.substr(from, comma - from));
+    if (!name.empty() && ("/" + id.protocol + "/").find("/" + name + "/") == std::string::npos)
+      id.protocol += (id.protocol.empty() ? "" : "/") + name;
+    from = comma + 1;
+  }
+  return id;
+}
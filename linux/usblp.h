@@ -0,0 +1,60 @@
+#ifndef FLUTTER_PLUGIN_TI_PRINTER_USBLP_H_
+#define FLUTTER_PLUGIN_TI_PRINTER_USBLP_H_
+
+#include <string>
+
+// Lo que el driver usblp del kernel (/dev/usb/lp*) sabe de la impresora sin
+// pasar por el canal de datos.
+//
+//   - LPGETSTATUS: el driver pide el estado del puerto con un control
+//     transfer (GET_PORT_STATUS de la clase impresora). No escribe ni lee
+//     del stream, así que no se mezcla con un trabajo en curso ni con
+//     respuestas DLE EOT pendientes.
+//   - IEEE 1284 device ID ("MFG:EPSON;CMD:ESC/POS;MDL:TM-T20;..."): el
+//     driver lo lee al enchufar la impresora y lo deja en sysfs; con el fd
+//     abierto también se puede pedir de nuevo por ioctl.
+//
+// Los nodos ttyUSB/ttyACM no son usblp: las funciones fallan con ENOTTY o
+// devuelven vacío.
+
+// Estado del puerto según LPGETSTATUS.
+struct UsblpStatus
+{
+  bool paper_out = false; // sin papel (PE)
+  bool online = false;    // impresora seleccionada (SLCT)
+  bool error = false;     // línea nFault activa
+  int raw = 0;            // byte tal cual lo devolvió el driver
+};
+
+// Decodifica el byte de LPGETSTATUS.
+UsblpStatus usblp_decode_status(int raw);
+
+// false (con errno en 'error') si el ioctl falló, p. ej. ENOTTY en un nodo
+// que no es usblp. No toca el stream del fd.
+bool usblp_get_status(int fd, UsblpStatus &status, int *error);
+
+// IEEE 1284 device ID pedido por ioctl al fd abierto. Vacío si falla.
+std::string usblp_get_device_id(int fd);
+
+// IEEE 1284 device ID que usblp dejó en sysfs para el nodo 'sysfs_path'
+// (resolve_sysfs_path). No abre el dispositivo. Vacío si no hay.
+std::string usblp_read_device_id_sysfs(const std::string &sysfs_path);
+
+// Campos del device ID que interesan al plugin.
+struct Ieee1284Id
+{
+  std::string manufacturer; // MFG / MANUFACTURER
+  std::string model;        // MDL / MODEL
+  std::string command_set;  // CMD / COMMAND SET, tal cual
+  std::string description;  // DES / DESCRIPTION
+
+  // Lenguajes de 'command_set' con los nombres de 'protocol' de
+  // knownThermalUsbPrinters (lib/database_printer.dart): "escpos",
+  // "starprnt", "zpl", "epl", "tspl", separados por '/'. Vacío si ninguno
+  // es conocido.
+  std::string protocol;
+};
+
+Ieee1284Id parse_ieee1284_id(const std::string &device_id);
+
+#endif // FLUTTER_PLUGIN_TI_PRINTER_USBLP_H_
@@ -0,0 +1,129 @@
+#include "work_pool.h"
+
+#include <algorithm>
+
+WorkStealingPool::WorkStealingPool(int threads)
+{
+  if (threads <= 0)
+  {
+    const int cores = static_cast<int>(std::thread::hardware_concurrency());
+    threads = cores - 1;
+  }
+  threads = std::max(0, std::min(threads, kMaxThreads));
+
+  for (int i = 0; i <= threads; i++)
+    queues_.push_back(std::make_unique<Queue>());
+  for (int i = 0; i < threads; i++)
+    threads_.emplace_back(&WorkStealingPool::worker, this, static_cast<size_t>(i));
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  for (std::thread &thread : threads_)
+    thread.join();
+}
+
+void WorkStealingPool::run(size_t count, const std::function<void(size_t)> &body)
+{
+  if (count == 0)
+    return;
+
+  std::lock_guard<std::mutex> run_lock(run_mutex_);
+  const size_t participants = queues_.size();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Tramos contiguos: el participante p arranca en count * p / participants.
+    for (size_t p = 0; p < participants; p++)
+    {
+      std::lock_guard<std::mutex> queue_lock(queues_[p]->mutex);
+      for (size_t i = count * p / participants; i < count * (p + 1) / participants; i++)
+        queues_[p]->tasks.push_back(i);
+    }
+    body_ = &body;
+    pending_ = count;
+    generation_++;
+  }
+  wake_.notify_all();
+
+  work(participants - 1, body);
+
+  // Además de que no queden tareas, ningún hilo del pool puede seguir
+  // dentro de work(): si no, podría tomar una tarea del próximo trabajo con
+  // este 'body'.
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_.wait(lock, [&] { return pending_ == 0 && active_ == 0; });
+  body_ = nullptr;
+}
+
+void WorkStealingPool::worker(size_t index)
+{
+  uint64_t seen = 0;
+  for (;;)
+  {
+    const std::function<void(size_t)> *body;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+      if (stop_)
+        return;
+      seen = generation_;
+      body = body_;
+      if (body == nullptr)
+        continue; // se despertó tarde: ese trabajo ya terminó
+      active_++;
+    }
+
+    work(index, *body);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--active_ == 0 && pending_ == 0)
+      done_.notify_all();
+  }
+}
+
+void WorkStealingPool::work(size_t index, const std::function<void(size_t)> &body)
+{
+  size_t task;
+  while (pop(index, task) || steal(index, task))
+  {
+    body(task);
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--pending_ == 0)
+      done_.notify_all();
+  }
+}
+
+bool WorkStealingPool::pop(size_t index, size_t &task)
+{
+  Queue &queue = *queues_[index];
+  std::lock_guard<std::mutex> lock(queue.mutex);
+  if (queue.tasks.empty())
+    return false;
+  task = queue.tasks.front();
+  queue.tasks.pop_front();
+  return true;
+}
+
+// Roba del final de la cola de otro: lo más lejano a lo que está haciendo
+// su dueño.
+bool WorkStealingPool::steal(size_t index, size_t &task)
+{
+  const size_t participants = queues_.size();
+  for (size_t offset = 1; offset < participants; offset++)
+  {
+    Queue &queue = *queues_[(index + offset) % participants];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty())
+    {
+      task = queue.tasks.back();
+      queue.tasks.pop_back();
+      return true;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,65 @@
+#ifndef FLUTTER_PLUGIN_TI_PRINTER_WORK_POOL_H_
+#define FLUTTER_PLUGIN_TI_PRINTER_WORK_POOL_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Pool chico de hilos para repartir tareas de CPU (bandas de una imagen)
+// entre los núcleos. Cada participante tiene su propia cola: al empezar un
+// trabajo las tareas se reparten en tramos contiguos (cada hilo recorre
+// bandas vecinas, en orden) y el que se queda sin tareas le roba al final
+// de la cola de otro. El hilo que llama a run() también trabaja.
+class WorkStealingPool
+{
+public:
+  // 'threads' hilos propios además del que llama; con 0 uno menos que los
+  // núcleos disponibles (hasta kMaxThreads).
+  explicit WorkStealingPool(int threads = 0);
+  ~WorkStealingPool();
+
+  WorkStealingPool(const WorkStealingPool &) = delete;
+  WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+  static constexpr int kMaxThreads = 7;
+
+  // Hilos que ejecutan tareas en run(), contando al que llama.
+  int concurrency() const { return static_cast<int>(queues_.size()); }
+
+  // Ejecuta body(0) .. body(count - 1) y vuelve cuando terminaron todas.
+  // Un trabajo a la vez: si otro hilo ya está en run(), espera.
+  void run(size_t count, const std::function<void(size_t)> &body);
+
+private:
+  struct Queue
+  {
+    std::mutex mutex;
+    std::deque<size_t> tasks;
+  };
+
+  void worker(size_t index);
+  void work(size_t index, const std::function<void(size_t)> &body);
+  bool pop(size_t index, size_t &task);
+  bool steal(size_t index, size_t &task);
+
+  std::vector<std::unique_ptr<Queue>> queues_; // la última es la del que llama
+  std::vector<std::thread> threads_;
+
+  std::mutex run_mutex_; // serializa run()
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  const std::function<void(size_t)> *body_ = nullptr;
+  uint64_t generation_ = 0;
+  size_t pending_ = 0; // tareas sin terminar
+  int active_ = 0;     // hilos del pool dentro del trabajo actual
+  bool stop_ = false;
+};
+
+#endif // FLUTTER_PLUGIN_TI_PRINTER_WORK_POOL_H_
@@ -1,5 +1,14 @@
 import 'package:flutter/services.dart';
 import 'package:flutter_test/flutter_test.dart';
+import 'package:ti_printer_plugin/database_printer.dart';
+import 'package:ti_printer_plugin/escpos_layout.dart';
+import 'package:ti_printer_plugin/escpos_optimizer.dart';
+import 'package:ti_printer_plugin/escpos_preview.dart';
+import 'package:ti_printer_plugin/label_image.dart';
+import 'package:ti_printer_plugin/print_job_scheduler.dart';
+import 'package:ti_printer_plugin/printer_capabilities.dart';
+import 'package:ti_printer_plugin/printer_status.dart';
+import 'package:ti_printer_plugin/send_file.dart';
 import 'package:ti_printer_plugin/ti_printer_plugin_method_channel.dart';
 
 void main() {
@@ -78,4 +87,551 @@ void main() {
 
     expect(await platform.openSerialPort('COM3', 9600), isFalse);
   });
+
+  test('openTcpPort sends host and default port 9100', () async {
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+        .setMockMethodCallHandler(channel, (MethodCall methodCall) async {
+      expect(methodCall.method, 'openTcpPort');
+      expect(methodCall.arguments, <String, dynamic>{
+        'host': '192.168.0.50',
+        'port': 9100,
+      });
+      return true;
+    });
+
+    expect(await platform.openTcpPort('192.168.0.50'), isTrue);
+  });
+
+  test('readStatusTcp returns empty bytes on missing implementation', () async {
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+        .setMockMethodCallHandler(channel, (MethodCall methodCall) async {
+      throw MissingPluginException('unsupported');
+    });
+
+    expect(
+      await platform.readStatusTcp(Uint8List.fromList(<int>[0x10, 0x04, 0x01])),
+      isEmpty,
+    );
+  });
+
+  test('resumePendingJobs returns resumed count or 0 on error', () async {
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+        .setMockMethodCallHandler(channel, (MethodCall methodCall) async {
+      expect(methodCall.method, 'resumePendingJobs');
+      return 3;
+    });
+    expect(await platform.resumePendingJobs(), 3);
+
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+        .setMockMethodCallHandler(channel, (MethodCall methodCall) async {
+      throw MissingPluginException('unsupported');
+    });
+    expect(await platform.resumePendingJobs(), 0);
+  });
+
+  test('submitJob sends target, data and priority index', () async {
+    final Uint8List data = Uint8List.fromList(<int>[0x1B, 0x40, 0x0A]);
+
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+        .setMockMethodCallHandler(channel, (MethodCall methodCall) async {
+      expect(methodCall.method, 'submitJob');
+      expect(methodCall.arguments, <String, dynamic>{
+        'target': 'kitchen',
+        'data': data,
+        'priority': 0,
+      });
+      return 11;
+    });
+
+    expect(
+      await platform.submitJob('kitchen', data,
+          priority: PrintJobPriority.urgent),
+      11,
+    );
+  });
+
+  test('getSchedulerStats decodes native maps', () async {
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+        .setMockMethodCallHandler(channel, (MethodCall methodCall) async {
+      return <dynamic>[
+        <dynamic, dynamic>{
+          'deviceId': '/dev/usb/lp0',
+          'group': 'front',
+          'online': true,
+          'queuedJobs': 2,
+          'queuedBytes': 4096,
+          'throughput': 30000.0,
+          'completedJobs': 5,
+        },
+      ];
+    });
+
+    final stats = await platform.getSchedulerStats();
+    expect(stats.single.deviceId, '/dev/usb/lp0');
+    expect(stats.single.queuedBytes, 4096);
+    expect(stats.single.online, isTrue);
+  });
+
+  test('encodeColumnImage sends pixels and geometry', () async {
+    final Uint8List pixels = Uint8List(8 * 24);
+    final Uint8List encoded = Uint8List.fromList(<int>[0x1B, 0x33, 0x10]);
+
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+        .setMockMethodCallHandler(channel, (MethodCall methodCall) async {
+      expect(methodCall.method, 'encodeColumnImage');
+      expect(methodCall.arguments, <String, dynamic>{
+        'pixels': pixels,
+        'width': 8,
+        'height': 24,
+        'bitsPerPixel': 8,
+      });
+      return encoded;
+    });
+
+    expect(await platform.encodeColumnImage(pixels, width: 8, height: 24),
+        encoded);
+  });
+
+  test('printImageUsb sends pixels, geometry and dither mode', () async {
+    final Uint8List pixels = Uint8List(16 * 2);
+
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+        .setMockMethodCallHandler(channel, (MethodCall methodCall) async {
+      expect(methodCall.method, 'printImageUsb');
+      expect(methodCall.arguments, <String, dynamic>{
+        'pixels': pixels,
+        'width': 16,
+        'height': 2,
+        'channels': 1,
+        'dither': false,
+      });
+      return true;
+    });
+
+    expect(
+      await platform.printImageUsb(pixels,
+          width: 16, height: 2, channels: 1, dither: false),
+      isTrue,
+    );
+  });
+
+  test('rasterizeImage sends encoded bytes and target width', () async {
+    final Uint8List png = Uint8List.fromList(<int>[0x89, 0x50, 0x4E, 0x47]);
+    final Uint8List raster = Uint8List.fromList(<int>[0x1D, 0x76, 0x30, 0x00]);
+
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+        .setMockMethodCallHandler(channel, (MethodCall methodCall) async {
+      expect(methodCall.method, 'rasterizeImage');
+      expect(methodCall.arguments, <String, dynamic>{
+        'data': png,
+        'width': 576,
+        'dither': true,
+        'ordered': false,
+        'graphics': false,
+        'star': false,
+        'density': 0,
+      });
+      return raster;
+    });
+
+    expect(await platform.rasterizeImage(png, width: 576), raster);
+  });
+
+  test('rasterizeImage forwards graphics command and density', () async {
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+        .setMockMethodCallHandler(channel, (MethodCall methodCall) async {
+      expect(methodCall.arguments['graphics'], true);
+      expect(methodCall.arguments['density'], 3);
+      return Uint8List.fromList(<int>[0x1D, 0x28, 0x4C]);
+    });
+
+    expect(
+      await platform.rasterizeImage(Uint8List(4),
+          width: 384, graphics: true, density: 3),
+      isNotEmpty,
+    );
+  });
+
+  test('rasterizeImage returns empty list on native error', () async {
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+        .setMockMethodCallHandler(channel, (MethodCall methodCall) async {
+      throw PlatformException(code: 'ERROR');
+    });
+
+    expect(await platform.rasterizeImage(Uint8List(1), width: 384), isEmpty);
+  });
+
+  test('queryStatusUsb sends every query and decodes the bits', () async {
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+        .setMockMethodCallHandler(channel, (MethodCall methodCall) async {
+      expect(methodCall.method, 'queryStatusUsb');
+      expect(methodCall.arguments, <int>[1, 4]);
+      return <String, dynamic>{
+        'replies': <int, int>{1: 0x16, 4: 0x7E},
+        'drawerOpen': true,
+        'offline': false,
+        'waitingOnlineRecovery': false,
+        'feedButtonPressed': false,
+        'paperNearEnd': true,
+        'paperEnd': true,
+      };
+    });
+
+    final status = await platform.queryStatusUsb(
+        queries: [PrinterStatusQuery.printer, PrinterStatusQuery.paper]);
+    expect(status.answered, isTrue);
+    expect(status.replies, <int, int>{1: 0x16, 4: 0x7E});
+    expect(status.offline, isFalse);
+    expect(status.paperEnd, isTrue);
+    expect(status.has(PrinterStatusQuery.offlineCause), isFalse);
+    expect(status.coverOpen, isNull);
+  });
+
+  test('queryStatusTcp returns an empty status on error', () async {
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+        .setMockMethodCallHandler(channel, (MethodCall methodCall) async {
+      throw PlatformException(code: 'INVALID_ARGUMENT');
+    });
+
+    final status = await platform.queryStatusTcp();
+    expect(status.answered, isFalse);
+  });
+
+  test('readUsbPortStatus decodes the port bits and null for non-usblp',
+      () async {
+    Object? reply = <String, dynamic>{
+      'paperOut': true,
+      'online': true,
+      'error': false,
+      'raw': 0x38,
+    };
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+        .setMockMethodCallHandler(channel, (MethodCall methodCall) async {
+      expect(methodCall.method, 'readUsbPortStatus');
+      return reply;
+    });
+
+    final status = await platform.readUsbPortStatus();
+    expect(status!.paperOut, isTrue);
+    expect(status.online, isTrue);
+    expect(status.error, isFalse);
+    expect(status.raw, 0x38);
+
+    reply = null;
+    expect(await platform.readUsbPortStatus(), isNull);
+  });
+
+  test('getUsbCapabilities forwards refresh and decodes the profile', () async {
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+        .setMockMethodCallHandler(channel, (MethodCall methodCall) async {
+      expect(methodCall.method, 'getUsbCapabilities');
+      expect(methodCall.arguments, <String, dynamic>{'refresh': true});
+      return <String, dynamic>{
+        'answered': true,
+        'modelId': 0x20,
+        'typeId': 0x02,
+        'romVersion': 5,
+        'firmware': '1.01',
+        'maker': 'EPSON',
+        'model': 'TM-T20',
+        'graphics': true,
+        'symbols': false,
+        'autoStatusBack': true,
+        'probedAt': 1700000000,
+      };
+    });
+
+    final caps = await platform.getUsbCapabilities(refresh: true);
+    expect(caps, isA<PrinterCapabilities>());
+    expect(caps!.model, 'TM-T20');
+    expect(caps.graphics, isTrue);
+    expect(caps.symbols, isFalse);
+    expect(caps.hasCutter, isTrue);
+    expect(caps.probedAt.millisecondsSinceEpoch, 1700000000 * 1000);
+  });
+
+  test('getUsbCapabilities returns null without an open port', () async {
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+        .setMockMethodCallHandler(channel, (MethodCall methodCall) async => null);
+
+    expect(await platform.getUsbCapabilities(), isNull);
+  });
+
+  test('getUsbPrinters decodes the IEEE 1284 model and protocol', () async {
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+        .setMockMethodCallHandler(channel, (MethodCall methodCall) async {
+      return <dynamic>[
+        <String, dynamic>{
+          'instanceId': '/dev/usb/lp0',
+          'displayName': 'Star TSP143 (STR_T-001)',
+          'vid': 0x0519,
+          'pid': 0x0003,
+          'deviceId': 'MFG:Star;CMD:STAR;MDL:TSP143 (STR_T-001);',
+          'manufacturer': 'Star',
+          'model': 'TSP143 (STR_T-001)',
+          'protocol': 'starprnt',
+        },
+        <String, dynamic>{
+          'instanceId': '/dev/ttyUSB0',
+          'displayName': 'ttyUSB0',
+          'vid': 0x0A5F,
+          'pid': 0x0027,
+        },
+      ];
+    });
+
+    final printers = await platform.getUsbPrinters();
+    expect(printers[0].resolvedDisplayName, 'Star TSP143 (STR_T-001)');
+    expect(printers[0].resolvedProtocol, 'starprnt');
+    expect(printers[1].model, isEmpty);
+    expect(printers[1].resolvedProtocol, 'zpl');
+  });
+
+  test('usbViaPrintDaemon returns false when the platform is missing', () async {
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+        .setMockMethodCallHandler(channel, null);
+
+    expect(await platform.usbViaPrintDaemon(), isFalse);
+  });
+
+  test('openUsbJobRing forwards capacity and returns null on error', () async {
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+        .setMockMethodCallHandler(channel, (MethodCall methodCall) async {
+      expect(methodCall.method, 'openUsbJobRing');
+      expect(methodCall.arguments, 256 * 1024);
+      throw PlatformException(code: 'ERROR');
+    });
+
+    expect(await platform.openUsbJobRing(capacity: 256 * 1024), isNull);
+  });
+
+  test('clearRasterCache returns false when the platform is missing', () async {
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+        .setMockMethodCallHandler(channel, null);
+
+    expect(await platform.clearRasterCache(), isFalse);
+  });
+
+  test('optimizeEscPos decodes the optimized stream and stats', () async {
+    final Uint8List input = Uint8List.fromList(
+        <int>[0x1B, 0x45, 0x00, 0x1B, 0x45, 0x00, 0x41, 0x0A, 0x0A]);
+    final Uint8List output =
+        Uint8List.fromList(<int>[0x1B, 0x45, 0x00, 0x41, 0x0A, 0x0A]);
+
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+        .setMockMethodCallHandler(channel, (MethodCall methodCall) async {
+      expect(methodCall.method, 'optimizeEscPos');
+      expect(methodCall.arguments, input);
+      return <String, dynamic>{
+        'data': output,
+        'inputBytes': 9,
+        'outputBytes': 6,
+        'droppedCommands': 1,
+        'mergedFeeds': 1,
+      };
+    });
+
+    final EscPosOptimizeResult result = await platform.optimizeEscPos(input);
+    expect(result.data, output);
+    expect(result.savedBytes, 3);
+    expect(result.droppedCommands, 1);
+  });
+
+  test('optimizeEscPos returns the input unchanged on native error', () async {
+    final Uint8List input = Uint8List.fromList(<int>[0x41, 0x0A]);
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+        .setMockMethodCallHandler(channel, (MethodCall methodCall) async {
+      throw PlatformException(code: 'ERROR');
+    });
+
+    final EscPosOptimizeResult result = await platform.optimizeEscPos(input);
+    expect(result.data, input);
+    expect(result.savedBytes, 0);
+  });
+
+  test('renderEscPos sends stream, width and format', () async {
+    final Uint8List ticket = Uint8List.fromList(<int>[0x41, 0x0A]);
+    final Uint8List pbm = Uint8List.fromList('P4\n8 1\n\x00'.codeUnits);
+
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+        .setMockMethodCallHandler(channel, (MethodCall methodCall) async {
+      expect(methodCall.method, 'renderEscPos');
+      expect(methodCall.arguments, <String, dynamic>{
+        'data': ticket,
+        'width': 384,
+        'format': 'pbm',
+      });
+      return pbm;
+    });
+
+    expect(
+      await platform.renderEscPos(ticket,
+          width: 384, format: EscPosPreviewFormat.pbm),
+      pbm,
+    );
+  });
+
+  test('compileReceiptTemplate returns 0 on template errors', () async {
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+        .setMockMethodCallHandler(channel, (MethodCall methodCall) async {
+      expect(methodCall.method, 'compileReceiptTemplate');
+      if (methodCall.arguments == '@end') {
+        throw PlatformException(
+            code: 'INVALID_ARGUMENT',
+            message: 'line 1: @end without @each or @if');
+      }
+      return 7;
+    });
+
+    expect(await platform.compileReceiptTemplate('Hola {{nombre}}'), 7);
+    expect(await platform.compileReceiptTemplate('@end'), 0);
+  });
+
+  test('renderReceipt sends template id and order data', () async {
+    final Uint8List ticket = Uint8List.fromList(<int>[0x48, 0x0A]);
+    final Map<String, Object?> order = <String, Object?>{
+      'cliente': 'Juan',
+      'items': <Map<String, Object?>>[
+        <String, Object?>{'nombre': 'Café', 'cant': 2},
+      ],
+    };
+
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+        .setMockMethodCallHandler(channel, (MethodCall methodCall) async {
+      expect(methodCall.method, 'renderReceipt');
+      expect(methodCall.arguments, <String, dynamic>{
+        'template': 7,
+        'data': order,
+      });
+      return ticket;
+    });
+
+    expect(await platform.renderReceipt(7, order), ticket);
+  });
+
+  test('layoutRow sends columns and line options', () async {
+    final Uint8List row = Uint8List.fromList(<int>[0x41, 0x0A]);
+
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+        .setMockMethodCallHandler(channel, (MethodCall methodCall) async {
+      expect(methodCall.method, 'layoutRow');
+      expect(methodCall.arguments, <String, dynamic>{
+        'columns': <Map<String, Object>>[
+          <String, Object>{'text': '豚肉', 'width': 8, 'align': 0, 'scale': 1},
+          <String, Object>{'text': '\$9', 'width': 4, 'align': 2, 'scale': 2},
+        ],
+        'lineChars': 32,
+        'fontB': false,
+        'codeTable': 0,
+        'utf8': true,
+      });
+      return row;
+    });
+
+    expect(
+        await platform.layoutRow(const <EscPosRowColumn>[
+          EscPosRowColumn('豚肉', width: 8),
+          EscPosRowColumn('\$9',
+              width: 4, align: EscPosRowAlign.right, scale: 2),
+        ], lineChars: 32, utf8: true),
+        row);
+  });
+
+  test('rasterizeText returns empty bytes when fonts fail', () async {
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+        .setMockMethodCallHandler(channel, (MethodCall methodCall) async {
+      expect(methodCall.method, 'rasterizeText');
+      expect(methodCall.arguments, <String, dynamic>{
+        'text': 'مرحبا',
+        'fonts': <String>['/no/existe.ttf'],
+        'size': 32,
+        'width': 384,
+        'align': 2,
+      });
+      throw PlatformException(code: 'ERROR');
+    });
+
+    expect(
+        await platform.rasterizeText('مرحبا',
+            fonts: <String>['/no/existe.ttf'],
+            size: 32,
+            width: 384,
+            align: EscPosRowAlign.right),
+        isEmpty);
+  });
+
+  test('sendFile forwards path and target', () async {
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+        .setMockMethodCallHandler(channel, (MethodCall methodCall) async {
+      expect(methodCall.method, 'sendFile');
+      expect(methodCall.arguments, <String, dynamic>{
+        'path': '/var/lib/pos/cierre.bin',
+        'target': 1,
+      });
+      throw PlatformException(code: 'ERROR');
+    });
+
+    expect(
+        await platform.sendFile('/var/lib/pos/cierre.bin',
+            target: SendFileTarget.tcp),
+        isFalse);
+  });
+
+  test('sendFileProgress decodes native events', () async {
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+        .setMockStreamHandler(
+            platform.sendFileProgressChannel,
+            MockStreamHandler.inline(onListen: (arguments, events) {
+              events.success(<String, dynamic>{
+                'path': '/var/lib/pos/cierre.bin',
+                'sent': 4096,
+                'total': 8192,
+              });
+              events.endOfStream();
+            }));
+
+    final progress = await platform.sendFileProgress.first;
+    expect(progress.path, '/var/lib/pos/cierre.bin');
+    expect(progress.fraction, 0.5);
+    expect(progress.done, isFalse);
+  });
+
+  test('encodeLabelImage sends the format index', () async {
+    final label = Uint8List.fromList('^XA^FO0,0^GFA,1,1,1,,^FS^XZ'.codeUnits);
+    TestDefaultBinaryMessengerBinding.instance.defaultBinaryMessenger
+        .setMockMethodCallHandler(channel, (MethodCall methodCall) async {
+      expect(methodCall.method, 'encodeLabelImage');
+      expect(methodCall.arguments, <String, dynamic>{
+        'data': Uint8List.fromList([0x89, 0x50]),
+        'width': 812,
+        'format': 0,
+        'dither': false,
+        'ordered': false,
+        'x': 10,
+        'y': 20,
+      });
+      return label;
+    });
+
+    expect(
+        await platform.encodeLabelImage(Uint8List.fromList([0x89, 0x50]),
+            width: 812,
+            format: LabelImageFormat.zplAscii,
+            dither: false,
+            x: 10,
+            y: 20),
+        label);
+  });
+
+  test('LabelImageFormat follows the detected protocol', () {
+    expect(LabelImageFormat.forProtocol('zpl/epl'), LabelImageFormat.zplAscii);
+    expect(LabelImageFormat.forProtocol('escpos/tspl'), LabelImageFormat.tspl);
+    expect(LabelImageFormat.forProtocol('escpos'), isNull);
+    expect(LabelImageFormat.forDevice(0x1203, 0x0140), LabelImageFormat.tspl);
+  });
+
+  test('KnownUsbPrinter.starRaster follows the starprnt protocol tag', () {
+    expect(lookupPrinterInfo(0x0519, 0x0003)!.starRaster, isTrue);
+    expect(lookupPrinterInfo(0x04B8, 0x0E03)!.starRaster, isFalse);
+  });
 }
@@ -49,6 +49,152 @@ class MockTiPrinterPluginPlatform
 
   @override
   Future<bool> closeUsbPort() => Future.value(true);
+
+  @override
+  Future<bool> usbViaPrintDaemon() => Future.value(false);
+
+  @override
+  Future<JobRing?> openUsbJobRing({int capacity = 1024 * 1024}) =>
+      Future.value(null);
+
+  @override
+  Future<bool> openTcpPort(String host, {int port = 9100}) =>
+      Future.value(true);
+
+  @override
+  Future<bool> closeTcpPort() => Future.value(true);
+
+  @override
+  Future<bool> sendCommandToTcp(Uint8List command) => Future.value(true);
+
+  @override
+  Future<Uint8List> readStatusTcp(Uint8List command) =>
+      Future.value(Uint8List.fromList(<int>[0x12]));
+
+  @override
+  Future<PrinterStatus> queryStatusUsb(
+          {List<PrinterStatusQuery> queries = PrinterStatusQuery.values}) =>
+      Future.value(const PrinterStatus(replies: {1: 0x16}, offline: false));
+
+  @override
+  Future<UsbPortStatus?> readUsbPortStatus() => Future.value(
+      const UsbPortStatus(paperOut: false, online: true, error: false));
+
+  @override
+  Future<PrinterCapabilities?> getUsbCapabilities({bool refresh = false}) =>
+      Future.value(PrinterCapabilities(
+        answered: true,
+        model: 'TM-T20III',
+        graphics: true,
+        probedAt: DateTime.fromMillisecondsSinceEpoch(0),
+      ));
+
+  @override
+  Future<PrinterStatus> queryStatusTcp(
+          {List<PrinterStatusQuery> queries = PrinterStatusQuery.values}) =>
+      Future.value(PrinterStatus.empty);
+
+  @override
+  Future<int> resumePendingJobs() => Future.value(2);
+
+  @override
+  Future<bool> discardPendingJobs() => Future.value(true);
+
+  @override
+  Future<bool> registerPrinter(String deviceId, {String group = ''}) =>
+      Future.value(true);
+
+  @override
+  Future<bool> unregisterPrinter(String deviceId) => Future.value(true);
+
+  @override
+  Future<int> submitJob(String target, Uint8List data,
+          {PrintJobPriority priority = PrintJobPriority.normal}) =>
+      Future.value(7);
+
+  @override
+  Future<List<PrinterQueueStats>> getSchedulerStats() =>
+      Future.value(const <PrinterQueueStats>[]);
+
+  @override
+  Future<Uint8List> encodeColumnImage(Uint8List pixels,
+          {required int width, required int height, int bitsPerPixel = 8}) =>
+      Future.value(Uint8List(0));
+
+  @override
+  Future<bool> printImageUsb(Uint8List pixels,
+          {required int width,
+          required int height,
+          int channels = 4,
+          bool dither = true}) =>
+      Future.value(true);
+
+  @override
+  Future<Uint8List> rasterizeImage(Uint8List encoded,
+          {required int width,
+          bool dither = true,
+          bool ordered = false,
+          bool graphics = false,
+          bool star = false,
+          int density = 0}) =>
+      Future.value(Uint8List(0));
+
+  @override
+  Future<bool> clearRasterCache() => Future.value(true);
+
+  @override
+  Future<EscPosOptimizeResult> optimizeEscPos(Uint8List data) =>
+      Future.value(EscPosOptimizeResult.unchanged(data));
+
+  @override
+  Future<Uint8List> renderEscPos(Uint8List data,
+          {int width = 576,
+          EscPosPreviewFormat format = EscPosPreviewFormat.png}) =>
+      Future.value(Uint8List(0));
+
+  @override
+  Future<int> compileReceiptTemplate(String source) => Future.value(1);
+
+  @override
+  Future<Uint8List> renderReceipt(int template, Map<String, Object?> data) =>
+      Future.value(Uint8List(0));
+
+  @override
+  Future<Uint8List> layoutRow(List<EscPosRowColumn> columns,
+          {int lineChars = 48,
+          bool fontB = false,
+          int codeTable = 0,
+          bool utf8 = false}) =>
+      Future.value(Uint8List(0));
+
+  @override
+  Future<Uint8List> rasterizeText(String text,
+          {required List<String> fonts,
+          int size = 24,
+          int width = 576,
+          EscPosRowAlign align = EscPosRowAlign.left}) =>
+      Future.value(Uint8List(0));
+
+  @override
+  Future<bool> sendFile(String path,
+          {SendFileTarget target = SendFileTarget.usb}) =>
+      Future.value(true);
+
+  @override
+  Stream<SendFileProgress> get sendFileProgress => const Stream.empty();
+
+  @override
+  Future<Uint8List> encodeLabelImage(Uint8List encoded,
+          {required int width,
+          required LabelImageFormat format,
+          bool dither = true,
+          bool ordered = false,
+          int x = 0,
+          int y = 0}) =>
+      Future.value(Uint8List(0));
+
+  @override
+  Future<bool> releaseReceiptTemplate(int template) => Future.value(true);
 }
 
 void main() {
@@ -78,5 +224,19 @@ void main() {
       await tiPrinterPlugin.readStatusUsb(Uint8List.fromList(<int>[0x10])),
       Uint8List.fromList(<int>[0x16]),
     );
+    expect((await tiPrinterPlugin.queryStatusUsb()).offline, isFalse);
+    expect((await tiPrinterPlugin.readUsbPortStatus())!.online, isTrue);
+    expect((await tiPrinterPlugin.getUsbCapabilities())!.graphics, isTrue);
+    expect(await tiPrinterPlugin.openTcpPort('192.168.0.50'), isTrue);
+    expect(
+      await tiPrinterPlugin.readStatusTcp(Uint8List.fromList(<int>[0x10])),
+      Uint8List.fromList(<int>[0x12]),
+    );
+    expect(await tiPrinterPlugin.resumePendingJobs(), 2);
+    expect(
+      await tiPrinterPlugin.submitJob('front', Uint8List.fromList(<int>[0x0A]),
+          priority: PrintJobPriority.urgent),
+      7,
+    );
   });
 }